@@ -0,0 +1,136 @@
+#include "pch.h"
+#include "AdaptiveSubsteps.h"
+#include "../src/core/Components.h"
+#include "../src/systems/PhysicsSystem.h"
+#include <limits>
+
+namespace {
+    Registry MakeRegistry() {
+        Registry registry;
+        registry.RegisterComponent<TransformComponent>();
+        registry.RegisterComponent<PhysicsComponent>();
+        registry.RegisterComponent<ColliderComponent>();
+        return registry;
+    }
+
+    Entity AddBall(Registry& registry, const glm::vec3& velocity) {
+        const Entity e = registry.CreateEntity();
+        TransformComponent transform;
+        transform.UpdateMatrix();
+        registry.AddComponent(e, transform);
+
+        PhysicsComponent physics;
+        physics.isStatic = false;
+        physics.SetMass(1.0f);
+        physics.velocity = velocity;
+        registry.AddComponent(e, physics);
+
+        ColliderComponent collider;
+        collider.type = 0;
+        collider.radius = 0.5f;
+        registry.AddComponent(e, collider);
+        return e;
+    }
+
+    // The editor's timestep statics, put back as they were when the test ends
+    struct TimestepScope {
+        bool fixed = PhysicsSystem::useFixedTimestep;
+        float rate = PhysicsSystem::fixedRate;
+        ~TimestepScope() {
+            PhysicsSystem::useFixedTimestep = fixed;
+            PhysicsSystem::fixedRate = rate;
+        }
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Adaptive Substeps: Step Count
+// -----------------------------------------------------------------------------
+TEST(AdaptiveSubsteps, QuietSceneTakesMinimum) {
+    SubstepSettings settings;
+    EXPECT_EQ(ChooseSubsteps(0.0f, settings), 1);
+    EXPECT_EQ(ChooseSubsteps(0.3f, settings), 1);
+
+    settings.minSteps = 2;
+    EXPECT_EQ(ChooseSubsteps(0.0f, settings), 2);
+}
+
+TEST(AdaptiveSubsteps, StepsScaleWithMotion) {
+    // Half a radius per substep: a body crossing 3 radii in the frame needs 6
+    SubstepSettings settings;
+    settings.maxMotion = 0.5f;
+    EXPECT_EQ(ChooseSubsteps(0.5f, settings), 1);
+    EXPECT_EQ(ChooseSubsteps(0.51f, settings), 2);
+    EXPECT_EQ(ChooseSubsteps(3.0f, settings), 6);
+}
+
+TEST(AdaptiveSubsteps, ClampedToBounds) {
+    SubstepSettings settings;
+    settings.maxSteps = 8;
+    EXPECT_EQ(ChooseSubsteps(100.0f, settings), 8);
+    EXPECT_EQ(ChooseSubsteps(std::numeric_limits<float>::infinity(), settings), 8);
+    EXPECT_EQ(ChooseSubsteps(std::numeric_limits<float>::quiet_NaN(), settings), 1);
+
+    // A maximum below the minimum gives way to the minimum
+    settings.minSteps = 4;
+    settings.maxSteps = 2;
+    EXPECT_EQ(ChooseSubsteps(100.0f, settings), 4);
+}
+
+// -----------------------------------------------------------------------------
+// Adaptive Substeps: History
+// -----------------------------------------------------------------------------
+TEST(AdaptiveSubsteps, HistoryKeepsMostRecentOldestFirst) {
+    SampleHistory history(4);
+    EXPECT_EQ(history.Count(), 0);
+    EXPECT_EQ(history.Latest(), 0.0f);
+
+    history.Push(1.0f);
+    history.Push(2.0f);
+    EXPECT_EQ(history.Count(), 2);
+    EXPECT_EQ(history.Offset(), 0);
+    EXPECT_EQ(history.Data()[0], 1.0f);
+    EXPECT_FLOAT_EQ(history.Average(), 1.5f);
+
+    for (float v : { 3.0f, 4.0f, 5.0f, 6.0f }) history.Push(v);
+    ASSERT_EQ(history.Count(), 4);
+    for (int i = 0; i < history.Count(); ++i) {
+        EXPECT_EQ(history.Data()[(history.Offset() + i) % history.Count()], 3.0f + i);
+    }
+    EXPECT_EQ(history.Latest(), 6.0f);
+    EXPECT_EQ(history.Max(), 6.0f);
+    EXPECT_FLOAT_EQ(history.Average(), 4.5f);
+}
+
+// -----------------------------------------------------------------------------
+// Adaptive Substeps: Through the Physics System
+// -----------------------------------------------------------------------------
+TEST(AdaptiveSubsteps, DefaultSettingsSplitAFastFrame) {
+    Registry registry = MakeRegistry();
+    AddBall(registry, glm::vec3(100.0f, 0.0f, 0.0f));
+    PhysicsSystem physics;
+
+    // 100 m/s over a 60 Hz frame is 3.3 radii: 7 substeps of at most half a radius each
+    physics.Step(registry, 1.0f / 60.0f);
+    EXPECT_NEAR(physics.GetStats().maxMotionRatio, 100.0f / 60.0f / 0.5f, 1e-3f);
+    EXPECT_EQ(physics.GetStats().stepsThisFrame, 7);
+}
+
+TEST(AdaptiveSubsteps, FixedStepsAreSplitToo) {
+    TimestepScope scope;
+    PhysicsSystem::useFixedTimestep = true;
+    PhysicsSystem::fixedRate = 60.0f;
+
+    Registry registry = MakeRegistry();
+    const Entity ball = AddBall(registry, glm::vec3(100.0f, 0.0f, 0.0f));
+    PhysicsSystem physics;
+
+    // One fixed step, split like the frame above; the step itself keeps its length
+    physics.Step(registry, 1.0f / 60.0f + 1e-4f);
+    EXPECT_EQ(physics.GetStats().stepsThisFrame, 7);
+    EXPECT_NEAR(registry.GetComponent<TransformComponent>(ball).position.x, 100.0f / 60.0f, 0.05f);
+
+    // Interpolation still blends across the whole step, not the last substep
+    EXPECT_TRUE(registry.GetComponent<PhysicsComponent>(ball).hasPreviousPosition);
+    EXPECT_EQ(registry.GetComponent<PhysicsComponent>(ball).previousPosition.x, 0.0f);
+}
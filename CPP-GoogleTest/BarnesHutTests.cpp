@@ -0,0 +1,236 @@
+#include "pch.h"
+#include "BarnesHut.h"
+#include "../src/core/JobSystem.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    auto Serial = [](size_t count, size_t, auto&& fn) { fn(size_t(0), count); };
+
+    auto Parallel = [](size_t count, size_t minBatch, auto&& fn) { JobSystem::Get().ParallelFor(count, minBatch, fn); };
+
+    struct Bodies {
+        std::vector<float> x, y, z, mass;
+        std::vector<float> ax, ay, az;
+
+        size_t Size() const { return x.size(); }
+
+        void Add(const glm::vec3& p, float m) {
+            x.push_back(p.x); y.push_back(p.y); z.push_back(p.z); mass.push_back(m);
+            ax.push_back(0.0f); ay.push_back(0.0f); az.push_back(0.0f);
+        }
+
+        glm::vec3 Acceleration(size_t i) const { return glm::vec3(ax[i], ay[i], az[i]); }
+    };
+
+    // Plummer-like cluster: dense core, sparse halo, masses spread over an order of magnitude
+    Bodies MakeCluster(size_t count, float radius, unsigned seed = 7) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<float> gauss(0.0f, 1.0f);
+        std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+        Bodies bodies;
+        for (size_t i = 0; i < count; ++i) {
+            const glm::vec3 dir = glm::normalize(glm::vec3(gauss(rng), gauss(rng), gauss(rng)) + glm::vec3(1e-6f));
+            const float u = std::max(uniform(rng), 1e-3f);
+            const float r = radius * 0.3f / std::sqrt(std::pow(u, -2.0f / 3.0f) - 1.0f + 1e-3f);
+            bodies.Add(dir * std::min(r, radius * 4.0f), 0.5f + 4.5f * uniform(rng));
+        }
+        return bodies;
+    }
+
+    template <typename ParallelFor>
+    void TreeAccelerations(BarnesHutTree& tree, Bodies& bodies, const GravitySettings& settings, ParallelFor&& parallelFor) {
+        tree.Build(bodies.x.data(), bodies.y.data(), bodies.z.data(), bodies.mass.data(), bodies.Size(), parallelFor);
+        tree.SelfAccelerations(settings, bodies.ax.data(), bodies.ay.data(), bodies.az.data(), parallelFor);
+    }
+
+    // Exact accelerations at the first sampleCount bodies
+    Bodies BruteForce(const Bodies& bodies, size_t sampleCount, const GravitySettings& settings) {
+        Bodies exact = bodies;
+        BruteForceGravity(bodies.x.data(), bodies.y.data(), bodies.z.data(), bodies.mass.data(), bodies.Size(),
+            bodies.x.data(), bodies.y.data(), bodies.z.data(), sampleCount, settings,
+            exact.ax.data(), exact.ay.data(), exact.az.data());
+        return exact;
+    }
+
+    struct ErrorSummary {
+        double rms = 0.0;
+        double max = 0.0;
+    };
+
+    ErrorSummary RelativeError(const Bodies& approx, const Bodies& exact, size_t sampleCount) {
+        ErrorSummary e;
+        for (size_t i = 0; i < sampleCount; ++i) {
+            const double err = glm::length(approx.Acceleration(i) - exact.Acceleration(i)) / std::max(glm::length(exact.Acceleration(i)), 1e-12f);
+            e.rms += err * err;
+            e.max = std::max(e.max, err);
+        }
+        e.rms = std::sqrt(e.rms / static_cast<double>(sampleCount));
+        return e;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Barnes-Hut: Tree
+// -----------------------------------------------------------------------------
+TEST(BarnesHut, EmptyTreePullsNothing) {
+    BarnesHutTree tree;
+    tree.Build(nullptr, nullptr, nullptr, nullptr, 0, Serial);
+    EXPECT_TRUE(tree.Empty());
+    EXPECT_EQ(tree.Acceleration(glm::vec3(1.0f), GravitySettings{}), glm::vec3(0.0f));
+}
+
+TEST(BarnesHut, RootHoldsTotalMassAndCentreOfMass) {
+    Bodies bodies = MakeCluster(5000, 10.0f);
+    BarnesHutTree tree;
+    tree.Build(bodies.x.data(), bodies.y.data(), bodies.z.data(), bodies.mass.data(), bodies.Size(), Serial);
+
+    double mass = 0.0;
+    glm::dvec3 moment(0.0);
+    for (size_t i = 0; i < bodies.Size(); ++i) {
+        mass += bodies.mass[i];
+        moment += glm::dvec3(bodies.x[i], bodies.y[i], bodies.z[i]) * static_cast<double>(bodies.mass[i]);
+    }
+    EXPECT_NEAR(tree.TotalMass(), mass, mass * 1e-5);
+    const glm::vec3 com = glm::vec3(moment / mass);
+    EXPECT_LT(glm::length(tree.CenterOfMass() - com), 1e-3f);
+    EXPECT_GT(tree.NodeCount(), bodies.Size() / BarnesHutDetail::LEAF_SIZE);
+}
+
+TEST(BarnesHut, TwoBodiesPullEachOtherByNewton) {
+    Bodies bodies;
+    bodies.Add(glm::vec3(0.0f), 3.0f);
+    bodies.Add(glm::vec3(2.0f, 0.0f, 0.0f), 5.0f);
+    GravitySettings settings;
+    settings.G = 2.0f;
+    settings.softening = 0.0f;
+
+    BarnesHutTree tree;
+    TreeAccelerations(tree, bodies, settings, Serial);
+    EXPECT_NEAR(bodies.ax[0], 2.0f * 5.0f / 4.0f, 1e-5f);
+    EXPECT_NEAR(bodies.ax[1], -2.0f * 3.0f / 4.0f, 1e-5f);
+    EXPECT_EQ(bodies.ay[0], 0.0f);
+}
+
+TEST(BarnesHut, ThetaZeroMatchesBruteForce) {
+    Bodies bodies = MakeCluster(3000, 10.0f);
+    GravitySettings settings;
+    settings.theta = 0.0f;
+
+    BarnesHutTree tree;
+    TreeAccelerations(tree, bodies, settings, Serial);
+    const Bodies exact = BruteForce(bodies, bodies.Size(), settings);
+    EXPECT_LT(RelativeError(bodies, exact, bodies.Size()).max, 1e-4);
+    EXPECT_EQ(tree.LastInteractionCount(), static_cast<uint64_t>(bodies.Size()) * bodies.Size());
+}
+
+TEST(BarnesHut, OpeningAngleTradesAccuracyForWork) {
+    Bodies bodies = MakeCluster(20000, 10.0f);
+    const size_t samples = 500;
+    GravitySettings settings;
+    const Bodies exact = BruteForce(bodies, samples, settings);
+
+    BarnesHutTree tree;
+    settings.theta = 0.3f;
+    TreeAccelerations(tree, bodies, settings, Serial);
+    const ErrorSummary tight = RelativeError(bodies, exact, samples);
+    const uint64_t tightWork = tree.LastInteractionCount();
+
+    settings.theta = 0.7f;
+    TreeAccelerations(tree, bodies, settings, Serial);
+    const ErrorSummary loose = RelativeError(bodies, exact, samples);
+    const uint64_t looseWork = tree.LastInteractionCount();
+
+    EXPECT_LT(tight.rms, 2e-3);
+    EXPECT_LT(loose.rms, 1e-2);
+    EXPECT_LT(tight.rms, loose.rms);
+    EXPECT_LT(looseWork, tightWork);
+    // Well below the n^2 pairs of the direct sum
+    EXPECT_LT(looseWork, static_cast<uint64_t>(bodies.Size()) * bodies.Size() / 20);
+}
+
+TEST(BarnesHut, OutsideTargetsMatchBruteForce) {
+    // Probes around and inside the cluster that are not bodies themselves, walked one by one
+    Bodies bodies = MakeCluster(20000, 10.0f);
+    Bodies probes = MakeCluster(500, 30.0f, 11);
+    GravitySettings settings;
+    settings.theta = 0.5f;
+
+    BarnesHutTree tree;
+    tree.Build(bodies.x.data(), bodies.y.data(), bodies.z.data(), bodies.mass.data(), bodies.Size(), Serial);
+    tree.Accelerations(probes.x.data(), probes.y.data(), probes.z.data(), probes.Size(), settings,
+        probes.ax.data(), probes.ay.data(), probes.az.data(), Serial);
+
+    Bodies exact = probes;
+    BruteForceGravity(bodies.x.data(), bodies.y.data(), bodies.z.data(), bodies.mass.data(), bodies.Size(),
+        probes.x.data(), probes.y.data(), probes.z.data(), probes.Size(), settings, exact.ax.data(), exact.ay.data(), exact.az.data());
+    EXPECT_LT(RelativeError(probes, exact, probes.Size()).rms, 1e-2);
+    EXPECT_LT(glm::length(tree.Acceleration(glm::vec3(probes.x[3], probes.y[3], probes.z[3]), settings) - probes.Acceleration(3)), 1e-6f);
+}
+
+TEST(BarnesHut, CoincidentBodiesShareOneDeepLeaf) {
+    Bodies bodies;
+    for (int i = 0; i < 100; ++i) bodies.Add(glm::vec3(1.0f, 2.0f, 3.0f), 1.0f);
+    bodies.Add(glm::vec3(11.0f, 2.0f, 3.0f), 1.0f);
+    GravitySettings settings;
+
+    BarnesHutTree tree;
+    TreeAccelerations(tree, bodies, settings, Serial);
+    // The stacked bodies pull each other with zero offset, so only the lone body remains
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(std::isfinite(bodies.ax[i]));
+        EXPECT_NEAR(bodies.ax[i], 1.0f / 100.0f, 1e-4f);
+    }
+    EXPECT_NEAR(bodies.ax[100], -100.0f / 100.0f, 1e-3f);
+}
+
+TEST(BarnesHut, ParallelBuildMatchesSerial) {
+    Bodies serial = MakeCluster(60000, 10.0f);
+    Bodies parallel = serial;
+    GravitySettings settings;
+
+    BarnesHutTree serialTree, parallelTree;
+    TreeAccelerations(serialTree, serial, settings, Serial);
+    TreeAccelerations(parallelTree, parallel, settings, Parallel);
+
+    EXPECT_EQ(serialTree.NodeCount(), parallelTree.NodeCount());
+    EXPECT_EQ(serialTree.LastInteractionCount(), parallelTree.LastInteractionCount());
+    for (size_t i = 0; i < serial.Size(); ++i) {
+        ASSERT_EQ(serial.Acceleration(i), parallel.Acceleration(i)) << "body " << i;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Barnes-Hut: Orbits
+// -----------------------------------------------------------------------------
+TEST(BarnesHut, LightMoonKeepsACircularOrbit) {
+    // Semi-implicit Euler through the tree for ten orbits of r = 10 around a mass of 1000
+    Bodies bodies;
+    bodies.Add(glm::vec3(0.0f), 1000.0f);
+    bodies.Add(glm::vec3(10.0f, 0.0f, 0.0f), 1e-3f);
+    std::vector<glm::vec3> velocity = { glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, std::sqrt(1000.0f / 10.0f)) };
+    GravitySettings settings;
+    settings.softening = 0.0f;
+
+    const float period = 2.0f * 3.14159265f * 10.0f / velocity[1].z;
+    const float dt = period / 500.0f;
+    BarnesHutTree tree;
+    float minRadius = 1e9f, maxRadius = 0.0f;
+    for (int step = 0; step < 5000; ++step) {
+        TreeAccelerations(tree, bodies, settings, Serial);
+        for (size_t i = 0; i < bodies.Size(); ++i) {
+            velocity[i] += bodies.Acceleration(i) * dt;
+            bodies.x[i] += velocity[i].x * dt;
+            bodies.y[i] += velocity[i].y * dt;
+            bodies.z[i] += velocity[i].z * dt;
+        }
+        const float r = glm::length(glm::vec3(bodies.x[1] - bodies.x[0], bodies.y[1] - bodies.y[0], bodies.z[1] - bodies.z[0]));
+        minRadius = std::min(minRadius, r);
+        maxRadius = std::max(maxRadius, r);
+    }
+    EXPECT_GT(minRadius, 9.8f);
+    EXPECT_LT(maxRadius, 10.2f);
+}
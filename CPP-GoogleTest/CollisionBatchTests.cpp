@@ -0,0 +1,161 @@
+#include "pch.h"
+#include "CollisionBatch.h"
+#include "PhysicsHelper.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// The batch kernels repeat the scalar operations in the same order, so results are bit-identical in a
+// normal build. Floats are allowed MAX_ULPS of slack for builds that fuse the scalar multiply-adds.
+namespace {
+    constexpr int64_t MAX_ULPS = 2;
+
+    int64_t UlpDistance(float a, float b) {
+        int32_t ia, ib;
+        std::memcpy(&ia, &a, sizeof(float));
+        std::memcpy(&ib, &b, sizeof(float));
+        // Map the sign-magnitude bit patterns onto a monotonic integer line
+        const int64_t la = (ia < 0) ? int64_t(INT32_MIN) - ia : ia;
+        const int64_t lb = (ib < 0) ? int64_t(INT32_MIN) - ib : ib;
+        return (la > lb) ? la - lb : lb - la;
+    }
+
+    void ExpectUlpEq(const glm::vec3& expected, const glm::vec3& actual) {
+        EXPECT_LE(UlpDistance(expected.x, actual.x), MAX_ULPS) << expected.x << " vs " << actual.x;
+        EXPECT_LE(UlpDistance(expected.y, actual.y), MAX_ULPS) << expected.y << " vs " << actual.y;
+        EXPECT_LE(UlpDistance(expected.z, actual.z), MAX_ULPS) << expected.z << " vs " << actual.z;
+    }
+
+    // Random spheres around the origin; odd counts so the SIMD loops and the scalar tail both run
+    std::vector<MovingSphere> RandomSpheres(size_t count, uint32_t seed, float spread) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-spread, spread);
+        std::uniform_real_distribution<float> vel(-5.0f, 5.0f);
+        std::uniform_real_distribution<float> radius(0.2f, 1.5f);
+        std::uniform_real_distribution<float> mass(0.1f, 10.0f);
+        std::uniform_real_distribution<float> rest(0.0f, 1.0f);
+
+        std::vector<MovingSphere> spheres;
+        for (size_t i = 0; i < count; ++i) {
+            spheres.emplace_back(glm::vec3(pos(rng), pos(rng), pos(rng)), radius(rng),
+                glm::vec3(vel(rng), vel(rng), vel(rng)), mass(rng), rest(rng));
+        }
+        return spheres;
+    }
+
+    SphereSoA ToSoA(const std::vector<MovingSphere>& spheres) {
+        SphereSoA soa;
+        soa.Reserve(spheres.size());
+        for (const auto& s : spheres) soa.Add(s);
+        return soa;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Collision Batch: Sphere vs Sphere
+// -----------------------------------------------------------------------------
+TEST(CollisionBatch, CollideSpheresMatchesScalar) {
+    const auto a = RandomSpheres(1003, 1, 2.0f);
+    const auto b = RandomSpheres(1003, 2, 2.0f);
+    const SphereSoA soaA = ToSoA(a), soaB = ToSoA(b);
+
+    std::vector<uint8_t> hits(a.size());
+    CollideSpheresBatch(soaA, soaB, hits.data());
+
+    size_t hitCount = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(hits[i] != 0, a[i].sphere.CollideWith(b[i].sphere)) << "pair " << i;
+        hitCount += hits[i];
+    }
+    // Both outcomes must actually be exercised
+    EXPECT_GT(hitCount, 100u);
+    EXPECT_LT(hitCount, a.size() - 100);
+}
+
+TEST(CollisionBatch, TouchingSpheresHitLikeScalar) {
+    // Exactly touching pairs sit on the EPS boundary, where any reordering of the maths would show
+    std::vector<MovingSphere> a, b;
+    for (int i = 0; i < 13; ++i) {
+        const float r = 0.5f + 0.1f * i;
+        a.emplace_back(glm::vec3(0.0f), r, glm::vec3(0.0f));
+        b.emplace_back(glm::vec3(2.0f * r, 0.0f, 0.0f), r, glm::vec3(0.0f));
+    }
+
+    std::vector<uint8_t> hits(a.size());
+    CollideSpheresBatch(ToSoA(a), ToSoA(b), hits.data());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(hits[i] != 0, a[i].sphere.CollideWith(b[i].sphere));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Collision Batch: Sphere vs Plane
+// -----------------------------------------------------------------------------
+TEST(CollisionBatch, PlaneDistancesMatchScalar) {
+    const auto spheres = RandomSpheres(517, 3, 10.0f);
+    const SphereSoA soa = ToSoA(spheres);
+    const Plane plane(glm::vec3(1.0f, -2.0f, 0.5f), glm::vec3(0.3f, 1.0f, -0.2f));
+
+    std::vector<float> distances(spheres.size());
+    SpherePlaneDistancesBatch(soa, plane, distances.data());
+
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        EXPECT_LE(UlpDistance(distances[i], plane.GetSignedDistance(spheres[i].sphere.Position())), MAX_ULPS);
+    }
+}
+
+TEST(CollisionBatch, SpheresTouchPlaneMatchesIntersects) {
+    const auto spheres = RandomSpheres(517, 4, 4.0f);
+    const SphereSoA soa = ToSoA(spheres);
+
+    // Infinite and finite planes
+    for (float size : { 0.0f, 2.5f }) {
+        const Plane plane(glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(0.0f, 1.0f, 0.1f), size);
+        std::vector<float> distances(spheres.size());
+        std::vector<uint8_t> hits(spheres.size());
+        SpherePlaneDistancesBatch(soa, plane, distances.data());
+        SpheresTouchPlaneBatch(soa, plane, distances.data(), hits.data());
+
+        for (size_t i = 0; i < spheres.size(); ++i) {
+            EXPECT_EQ(hits[i] != 0, plane.Intersects(spheres[i].sphere)) << "sphere " << i << " size " << size;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Collision Batch: Elastic Response
+// -----------------------------------------------------------------------------
+TEST(CollisionBatch, ResolveElasticMatchesScalar) {
+    // Close pairs so most are overlapping and a mix approach or separate
+    auto a = RandomSpheres(1001, 5, 1.0f);
+    auto b = RandomSpheres(1001, 6, 1.0f);
+    SphereSoA soaA = ToSoA(a), soaB = ToSoA(b);
+
+    ResolveElasticBatch(soaA, soaB);
+    for (size_t i = 0; i < a.size(); ++i) {
+        ResolveElasticCollision(a[i], b[i]);
+        ExpectUlpEq(a[i].velocity, soaA.Velocity(i));
+        ExpectUlpEq(b[i].velocity, soaB.Velocity(i));
+    }
+}
+
+TEST(CollisionBatch, ResolveElasticSkipsSeparatingAndCoincidentPairs) {
+    std::vector<MovingSphere> a, b;
+    for (int i = 0; i < 8; ++i) {
+        // Even lanes move apart, odd lanes share a centre; neither may change
+        const glm::vec3 offset = (i % 2 == 0) ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f);
+        a.emplace_back(glm::vec3(0.0f), 1.0f, glm::vec3(-1.0f, 0.0f, 0.0f));
+        b.emplace_back(offset, 1.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    }
+    SphereSoA soaA = ToSoA(a), soaB = ToSoA(b);
+
+    ResolveElasticBatch(soaA, soaB);
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(soaA.Velocity(i), a[i].velocity);
+        EXPECT_EQ(soaB.Velocity(i), b[i].velocity);
+    }
+}
@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "ConstraintColoring.h"
+#include "PhysicsHelper.h"
+#include "Sphere.h"
+#include <glm/glm.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+    // Every constraint appears exactly once, and no parallel batch uses a body twice
+    void ExpectValidBatches(const ConstraintColoring& coloring, const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, size_t bodyCount) {
+        std::vector<int> seen(a.size(), 0);
+        for (const auto& batch : coloring.Batches()) {
+            std::vector<int> bodyUses(bodyCount, 0);
+            for (uint32_t k = batch.begin; k < batch.end; ++k) {
+                const uint32_t c = coloring.Order()[k];
+                seen[c]++;
+                if (batch.serial) continue;
+                EXPECT_EQ(++bodyUses[a[c]], 1);
+                if (b[c] != ConstraintColoring::NO_BODY) {
+                    EXPECT_EQ(++bodyUses[b[c]], 1);
+                }
+            }
+        }
+        for (int count : seen) EXPECT_EQ(count, 1);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Constraint Colouring: Batch Validity
+// -----------------------------------------------------------------------------
+TEST(ConstraintColoring, ChainNeedsTwoColours) {
+    // 0-1, 1-2, 2-3, ... alternates between two batches
+    std::vector<uint32_t> a, b;
+    for (uint32_t i = 0; i < 10; ++i) { a.push_back(i); b.push_back(i + 1); }
+
+    ConstraintColoring coloring;
+    coloring.Build(a, b, 11);
+    EXPECT_EQ(coloring.Batches().size(), 2u);
+    ExpectValidBatches(coloring, a, b, 11);
+}
+
+TEST(ConstraintColoring, StaticContactsOnlyConstrainTheirDynamicBody) {
+    // Three bodies each resting on the same static floor: nothing is shared, so one batch
+    std::vector<uint32_t> a = { 0, 1, 2 };
+    std::vector<uint32_t> b(3, ConstraintColoring::NO_BODY);
+
+    ConstraintColoring coloring;
+    coloring.Build(a, b, 3);
+    ASSERT_EQ(coloring.Batches().size(), 1u);
+    EXPECT_FALSE(coloring.Batches()[0].serial);
+}
+
+TEST(ConstraintColoring, OverflowGoesToSerialBatch) {
+    // One hub body in more contacts than there are colours
+    std::vector<uint32_t> a, b;
+    const uint32_t spokes = ConstraintColoring::MAX_COLORS + 10;
+    for (uint32_t i = 1; i <= spokes; ++i) { a.push_back(0); b.push_back(i); }
+
+    ConstraintColoring coloring;
+    coloring.Build(a, b, spokes + 1);
+    ASSERT_EQ(coloring.Batches().size(), ConstraintColoring::MAX_COLORS + 1);
+    EXPECT_TRUE(coloring.Batches().back().serial);
+    EXPECT_EQ(coloring.Batches().back().end - coloring.Batches().back().begin, 10u);
+    ExpectValidBatches(coloring, a, b, spokes + 1);
+}
+
+TEST(ConstraintColoring, RandomContactsProduceValidBatches) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> body(0, 499);
+    std::vector<uint32_t> a, b;
+    for (int i = 0; i < 3000; ++i) {
+        const uint32_t x = body(rng);
+        uint32_t y = body(rng);
+        if (y == x) y = ConstraintColoring::NO_BODY;
+        a.push_back(x);
+        b.push_back(y);
+    }
+
+    ConstraintColoring coloring;
+    coloring.Build(a, b, 500);
+    ExpectValidBatches(coloring, a, b, 500);
+}
+
+// -----------------------------------------------------------------------------
+// Constraint Colouring: Batched solve against the serial order
+// -----------------------------------------------------------------------------
+TEST(ConstraintColoring, BatchedSolveMatchesSerialMomentumAndEnergy) {
+    // A cloud of overlapping spheres with random velocities; one elastic pass in contact order
+    // versus one pass batch by batch
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(0.0f, 12.0f);
+    std::uniform_real_distribution<float> vel(-3.0f, 3.0f);
+
+    std::vector<MovingSphere> bodies;
+    for (int i = 0; i < 300; ++i) {
+        bodies.emplace_back(glm::vec3(pos(rng), pos(rng), pos(rng)), 0.6f, glm::vec3(vel(rng), vel(rng), vel(rng)), 1.0f + (i % 3), 0.8f);
+    }
+
+    std::vector<uint32_t> a, b;
+    for (uint32_t i = 0; i < bodies.size(); ++i) {
+        for (uint32_t j = i + 1; j < bodies.size(); ++j) {
+            if (bodies[i].sphere.CollideWith(bodies[j].sphere)) { a.push_back(i); b.push_back(j); }
+        }
+    }
+    ASSERT_GT(a.size(), 50u);
+
+    std::vector<MovingSphere> serial = bodies;
+    for (size_t c = 0; c < a.size(); ++c) ResolveElasticCollision(serial[a[c]], serial[b[c]]);
+
+    ConstraintColoring coloring;
+    coloring.Build(a, b, bodies.size());
+    ExpectValidBatches(coloring, a, b, bodies.size());
+    std::vector<MovingSphere> batched = bodies;
+    for (uint32_t c : coloring.Order()) ResolveElasticCollision(batched[a[c]], batched[b[c]]);
+
+    glm::vec3 momentumSerial(0.0f), momentumBatched(0.0f);
+    float energySerial = 0.0f, energyBatched = 0.0f;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        momentumSerial += GetMomentum(serial[i]);
+        momentumBatched += GetMomentum(batched[i]);
+        energySerial += GetKineticEnergy(serial[i]);
+        energyBatched += GetKineticEnergy(batched[i]);
+    }
+
+    EXPECT_NEAR(momentumSerial.x, momentumBatched.x, 1e-2f);
+    EXPECT_NEAR(momentumSerial.y, momentumBatched.y, 1e-2f);
+    EXPECT_NEAR(momentumSerial.z, momentumBatched.z, 1e-2f);
+    EXPECT_NEAR(energySerial, energyBatched, energySerial * 0.05f);
+}
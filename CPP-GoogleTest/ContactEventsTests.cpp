@@ -0,0 +1,176 @@
+#include "pch.h"
+#include "ContactEvents.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace {
+    const glm::vec3 UP(0.0f, 1.0f, 0.0f);
+
+    // One step in which each listed pair touches once, with impulse 1
+    void Step(ContactEventBuffer& buffer, const std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+        buffer.BeginStep();
+        for (const auto& pair : pairs) buffer.Record(pair.first, pair.second, glm::vec3(0.0f), UP, 1.0f);
+        buffer.EndStep();
+    }
+
+    const ContactEvent* Find(const ContactEventBuffer& buffer, uint32_t a, uint32_t b) {
+        for (const ContactEvent& e : buffer.Events()) {
+            if (e.a == a && e.b == b) return &e;
+        }
+        return nullptr;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Contact Events: Phases
+// -----------------------------------------------------------------------------
+TEST(ContactEvents, PairBeginsPersistsThenEnds) {
+    ContactEventBuffer buffer;
+
+    Step(buffer, { { 1, 2 } });
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::Begin);
+
+    Step(buffer, { { 1, 2 } });
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::Persist);
+    EXPECT_EQ(buffer.TouchingCount(), 1u);
+
+    // An end carries the last contact but no impulse
+    Step(buffer, {});
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::End);
+    EXPECT_EQ(buffer.Events()[0].normal, UP);
+    EXPECT_EQ(buffer.Events()[0].impulse, 0.0f);
+    EXPECT_EQ(buffer.TouchingCount(), 0u);
+
+    Step(buffer, {});
+    EXPECT_TRUE(buffer.Events().empty());
+}
+
+TEST(ContactEvents, MixedStepClassifiesEveryPair) {
+    ContactEventBuffer buffer;
+    Step(buffer, { { 1, 2 }, { 3, 4 } });
+    Step(buffer, { { 5, 6 }, { 3, 4 } });
+
+    ASSERT_EQ(buffer.Events().size(), 3u);
+    EXPECT_EQ(Find(buffer, 1, 2)->phase, ContactPhase::End);
+    EXPECT_EQ(Find(buffer, 3, 4)->phase, ContactPhase::Persist);
+    EXPECT_EQ(Find(buffer, 5, 6)->phase, ContactPhase::Begin);
+    EXPECT_EQ(buffer.Count(ContactPhase::Begin), 1u);
+    EXPECT_EQ(buffer.Count(ContactPhase::Persist), 1u);
+    EXPECT_EQ(buffer.Count(ContactPhase::End), 1u);
+
+    // Sorted by pair
+    EXPECT_EQ(buffer.Events()[0].a, 1u);
+    EXPECT_EQ(buffer.Events()[2].a, 5u);
+}
+
+TEST(ContactEvents, FrameWithoutStepsKeepsTheTouchingPairs) {
+    // PhysicsSystem begins a step every frame but only ends one when it simulated
+    ContactEventBuffer buffer;
+    Step(buffer, { { 1, 2 } });
+    buffer.BeginStep();
+    EXPECT_TRUE(buffer.Events().empty());
+
+    Step(buffer, { { 1, 2 } });
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::Persist);
+}
+
+TEST(ContactEvents, KeptPairsStayTouchingWithoutEvents) {
+    ContactEventBuffer buffer;
+    Step(buffer, { { 1, 2 }, { 3, 4 } });
+
+    // 1-2 fell asleep together and is no longer tested; 3-4 came apart
+    buffer.BeginStep();
+    buffer.EndStep([](uint32_t a, uint32_t) { return a == 1; });
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(Find(buffer, 3, 4)->phase, ContactPhase::End);
+    EXPECT_EQ(buffer.TouchingCount(), 1u);
+
+    // Woken and tested again, the pair carries on rather than starting over
+    Step(buffer, { { 1, 2 } });
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::Persist);
+}
+
+TEST(ContactEvents, ClearStartsEveryContactAfresh) {
+    ContactEventBuffer buffer;
+    Step(buffer, { { 1, 2 } });
+    buffer.Clear();
+    EXPECT_TRUE(buffer.Events().empty());
+    EXPECT_EQ(buffer.TouchingCount(), 0u);
+
+    Step(buffer, { { 1, 2 } });
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::Begin);
+}
+
+// -----------------------------------------------------------------------------
+// Contact Events: Merging
+// -----------------------------------------------------------------------------
+TEST(ContactEvents, SubstepsMergeIntoOneEvent) {
+    // Three substeps see the same pair: impulses add up, the last point and normal win
+    ContactEventBuffer buffer;
+    buffer.BeginStep();
+    buffer.Record(4, 7, glm::vec3(0.0f), UP, 1.0f);
+    buffer.Record(2, 3, glm::vec3(9.0f), UP, 5.0f);
+    buffer.Record(4, 7, glm::vec3(1.0f), UP, 0.5f);
+    buffer.Record(4, 7, glm::vec3(2.0f), glm::vec3(1.0f, 0.0f, 0.0f), 0.25f);
+    buffer.EndStep();
+
+    ASSERT_EQ(buffer.Events().size(), 2u);
+    const ContactEvent* e = Find(buffer, 4, 7);
+    ASSERT_NE(e, nullptr);
+    EXPECT_FLOAT_EQ(e->impulse, 1.75f);
+    EXPECT_EQ(e->point, glm::vec3(2.0f));
+    EXPECT_EQ(e->normal, glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_FLOAT_EQ(Find(buffer, 2, 3)->impulse, 5.0f);
+}
+
+TEST(ContactEvents, SwappedPairFlipsTheNormal) {
+    // Recorded from the higher id's side, the event still reads from a to b with a < b
+    ContactEventBuffer buffer;
+    buffer.BeginStep();
+    buffer.Record(9, 2, glm::vec3(0.0f), UP, 1.0f);
+    buffer.Record(2, 9, glm::vec3(0.0f), UP, 1.0f);
+    buffer.EndStep();
+
+    ASSERT_EQ(buffer.Events().size(), 1u);
+    EXPECT_EQ(buffer.Events()[0].a, 2u);
+    EXPECT_EQ(buffer.Events()[0].b, 9u);
+    EXPECT_EQ(buffer.Events()[0].normal, UP); // The later record wins
+
+    buffer.BeginStep();
+    buffer.Record(9, 2, glm::vec3(0.0f), UP, 1.0f);
+    buffer.EndStep();
+    EXPECT_EQ(buffer.Events()[0].normal, -UP);
+    EXPECT_EQ(buffer.Events()[0].phase, ContactPhase::Persist);
+}
+
+// -----------------------------------------------------------------------------
+// Contact Events: Allocation
+// -----------------------------------------------------------------------------
+TEST(ContactEvents, SteadyStepsReuseTheirStorage) {
+    // A pile of 1000 resting pairs, half of them swapping out every step
+    ContactEventBuffer buffer;
+    auto run = [&](int step) {
+        buffer.BeginStep();
+        for (uint32_t i = 0; i < 1000; ++i) {
+            const uint32_t a = (i % 2 == 0) ? i : i + 1000 * (step % 2);
+            for (int substep = 0; substep < 4; ++substep) buffer.Record(a, a + 5000, glm::vec3(0.0f), UP, 0.1f);
+        }
+        buffer.EndStep();
+    };
+    run(0);
+    run(1);
+    const ContactEvent* events = buffer.Events().data();
+
+    for (int step = 2; step < 20; ++step) {
+        run(step);
+        EXPECT_EQ(buffer.Count(ContactPhase::Persist), 500u);
+        EXPECT_EQ(buffer.Count(ContactPhase::Begin), 500u);
+        EXPECT_EQ(buffer.Count(ContactPhase::End), 500u);
+    }
+    EXPECT_EQ(buffer.Events().data(), events);
+}
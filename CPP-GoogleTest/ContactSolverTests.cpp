@@ -0,0 +1,185 @@
+#include "pch.h"
+#include "ContactSolver.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    SolverContact MakeContact(uint32_t a, uint32_t b, const glm::vec3& normal) {
+        SolverContact c;
+        c.a = a;
+        c.b = b;
+        c.normal = normal;
+        return c;
+    }
+
+    // A column of unit spheres (radius 0.5) resting on a floor at y = 0, moving only vertically.
+    // Each substep integrates, then solves velocities, then projects overlaps out like PhysicsSystem.
+    struct Column {
+        std::vector<float> y;
+        std::vector<SolverBody> bodies;
+        std::vector<SolverContact> contacts;
+        ContactCache cache;
+
+        explicit Column(int height) {
+            for (int i = 0; i < height; ++i) {
+                y.push_back(0.5f + i);
+                bodies.push_back({ glm::vec3(0.0f), 1.0f });
+            }
+        }
+
+        void Step(float dt, const ContactSolverSettings& settings) {
+            for (size_t i = 0; i < y.size(); ++i) {
+                bodies[i].velocity.y -= 9.81f * dt;
+                y[i] += bodies[i].velocity.y * dt;
+            }
+
+            // Touching counts as contact, as in Sphere::CollideWith
+            constexpr float EPS = 1e-4f;
+            contacts.clear();
+            if (y[0] <= 0.5f + EPS) contacts.push_back(MakeContact(0, SolverContact::NO_BODY, glm::vec3(0.0f, -1.0f, 0.0f)));
+            for (uint32_t i = 0; i + 1 < y.size(); ++i) {
+                if (y[i + 1] - y[i] <= 1.0f + EPS) contacts.push_back(MakeContact(i, i + 1, glm::vec3(0.0f, 1.0f, 0.0f)));
+            }
+            for (auto& c : contacts) {
+                c.key = ContactCache::Key(c.a, c.b);
+                PrepareContact(c, bodies, 0.0f, settings);
+                WarmStartContact(c, bodies, settings.warmStarting ? cache.Find(c.key) : 0.0f);
+            }
+            for (int it = 0; it < settings.iterations; ++it) {
+                for (auto& c : contacts) SolveContact(c, bodies);
+            }
+            for (const auto& c : contacts) cache.Store(c.key, c.impulse);
+            cache.EndStep();
+
+            y[0] = std::max(y[0], 0.5f);
+            for (size_t i = 0; i + 1 < y.size(); ++i) {
+                const float overlap = 1.0f - (y[i + 1] - y[i]);
+                if (overlap > 0.0f) y[i + 1] += overlap;
+            }
+        }
+
+        float MaxSpeed() const {
+            float speed = 0.0f;
+            for (const auto& b : bodies) speed = std::max(speed, glm::length(b.velocity));
+            return speed;
+        }
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Contact Solver: Single Contacts
+// -----------------------------------------------------------------------------
+TEST(ContactSolver, InelasticContactEqualisesNormalVelocity) {
+    // 1 kg at +2 m/s runs into 3 kg at -2 m/s; with no bounce both end at the common velocity
+    std::vector<SolverBody> bodies = { { glm::vec3(2.0f, 0.0f, 0.0f), 1.0f }, { glm::vec3(-2.0f, 0.0f, 0.0f), 1.0f / 3.0f } };
+    SolverContact c = MakeContact(0, 1, glm::vec3(1.0f, 0.0f, 0.0f));
+
+    PrepareContact(c, bodies, 0.0f, ContactSolverSettings());
+    SolveContact(c, bodies);
+
+    EXPECT_NEAR(bodies[0].velocity.x, -1.0f, 1e-5f);
+    EXPECT_NEAR(bodies[1].velocity.x, -1.0f, 1e-5f);
+    EXPECT_NEAR(c.impulse, 3.0f, 1e-5f);
+}
+
+TEST(ContactSolver, RestitutionOnlyAboveThreshold) {
+    ContactSolverSettings settings;
+    settings.restitutionThreshold = 1.0f;
+
+    // Fast impact against a static body bounces back at half speed
+    std::vector<SolverBody> fast = { { glm::vec3(0.0f, -4.0f, 0.0f), 1.0f } };
+    SolverContact c = MakeContact(0, SolverContact::NO_BODY, glm::vec3(0.0f, -1.0f, 0.0f));
+    PrepareContact(c, fast, 0.5f, settings);
+    SolveContact(c, fast);
+    EXPECT_NEAR(fast[0].velocity.y, 2.0f, 1e-5f);
+
+    // A slow one just stops
+    std::vector<SolverBody> slow = { { glm::vec3(0.0f, -0.5f, 0.0f), 1.0f } };
+    c = MakeContact(0, SolverContact::NO_BODY, glm::vec3(0.0f, -1.0f, 0.0f));
+    PrepareContact(c, slow, 0.5f, settings);
+    SolveContact(c, slow);
+    EXPECT_NEAR(slow[0].velocity.y, 0.0f, 1e-6f);
+}
+
+TEST(ContactSolver, SeparatingContactAppliesNoImpulse) {
+    std::vector<SolverBody> bodies = { { glm::vec3(-1.0f, 0.0f, 0.0f), 1.0f }, { glm::vec3(1.0f, 0.0f, 0.0f), 1.0f } };
+    SolverContact c = MakeContact(0, 1, glm::vec3(1.0f, 0.0f, 0.0f));
+
+    PrepareContact(c, bodies, 1.0f, ContactSolverSettings());
+    SolveContact(c, bodies);
+
+    EXPECT_EQ(c.impulse, 0.0f);
+    EXPECT_EQ(bodies[0].velocity.x, -1.0f);
+    EXPECT_EQ(bodies[1].velocity.x, 1.0f);
+}
+
+TEST(ContactSolver, OversizedWarmStartIsTakenBackButNeverPulls) {
+    // Resting on the floor after one step of gravity: the right impulse is m * g * dt
+    const float dt = 1.0f / 60.0f;
+    std::vector<SolverBody> bodies = { { glm::vec3(0.0f, -9.81f * dt, 0.0f), 1.0f } };
+    SolverContact c = MakeContact(0, SolverContact::NO_BODY, glm::vec3(0.0f, -1.0f, 0.0f));
+
+    PrepareContact(c, bodies, 0.0f, ContactSolverSettings());
+    WarmStartContact(c, bodies, 10.0f);
+    EXPECT_GT(bodies[0].velocity.y, 0.0f);
+
+    SolveContact(c, bodies);
+    EXPECT_NEAR(c.impulse, 9.81f * dt, 1e-5f);
+    EXPECT_NEAR(bodies[0].velocity.y, 0.0f, 1e-5f);
+
+    // A cached impulse can never be negative
+    std::vector<SolverBody> still = { { glm::vec3(0.0f), 1.0f } };
+    c = MakeContact(0, SolverContact::NO_BODY, glm::vec3(0.0f, -1.0f, 0.0f));
+    WarmStartContact(c, still, -5.0f);
+    EXPECT_EQ(c.impulse, 0.0f);
+    EXPECT_EQ(still[0].velocity, glm::vec3(0.0f));
+}
+
+// -----------------------------------------------------------------------------
+// Contact Solver: Cache
+// -----------------------------------------------------------------------------
+TEST(ContactSolver, CacheKeyIgnoresOrderAndForgetsUntouchedPairs) {
+    EXPECT_EQ(ContactCache::Key(3, 9), ContactCache::Key(9, 3));
+    EXPECT_NE(ContactCache::Key(3, 9), ContactCache::Key(3, 10));
+
+    ContactCache cache;
+    cache.Store(ContactCache::Key(1, 2), 0.5f);
+    cache.Store(ContactCache::Key(2, 3), 0.25f);
+    EXPECT_EQ(cache.Find(ContactCache::Key(1, 2)), 0.0f); // Not visible until the step ends
+    cache.EndStep();
+    EXPECT_EQ(cache.Size(), 2u);
+    EXPECT_EQ(cache.Find(ContactCache::Key(2, 1)), 0.5f);
+
+    // Only 2-3 stays in contact
+    cache.Store(ContactCache::Key(2, 3), 0.3f);
+    cache.EndStep();
+    EXPECT_EQ(cache.Size(), 1u);
+    EXPECT_EQ(cache.Find(ContactCache::Key(1, 2)), 0.0f);
+    EXPECT_EQ(cache.Find(ContactCache::Key(3, 2)), 0.3f);
+}
+
+// -----------------------------------------------------------------------------
+// Contact Solver: Stacking
+// -----------------------------------------------------------------------------
+TEST(ContactSolver, WarmStartedColumnComesToRest) {
+    // 60 Hz with two substeps and the default iterations, sweeping from the floor up (the slowest
+    // order for a load coming down from the top)
+    ContactSolverSettings settings;
+    const float dt = 1.0f / 120.0f;
+
+    Column warm(10);
+    for (int i = 0; i < 600; ++i) warm.Step(dt, settings);
+
+    settings.warmStarting = false;
+    Column cold(10);
+    for (int i = 0; i < 600; ++i) cold.Step(dt, settings);
+
+    // Warm starting carries the full weight of the column from step to step
+    EXPECT_LT(warm.MaxSpeed(), 1e-3f);
+    EXPECT_NEAR(warm.y.back(), 9.5f, 0.05f);
+    EXPECT_NEAR(warm.cache.Find(ContactCache::Key(0, SolverContact::NO_BODY)), 10.0f * 9.81f * dt, 1e-3f);
+
+    // Without it, the iterations of one step cannot pass the whole load down the column
+    EXPECT_GT(cold.MaxSpeed(), warm.MaxSpeed());
+}
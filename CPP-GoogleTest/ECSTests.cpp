@@ -0,0 +1,381 @@
+#include "pch.h"
+#include "../src/core/ECS.h"
+#include "../src/core/SymbolTable.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Position { float x = 0.0f; };
+    struct Velocity { float v = 0.0f; };
+    struct Tag {};
+}
+
+// -----------------------------------------------------------------------------
+// Registry Views: Joins
+// -----------------------------------------------------------------------------
+TEST(RegistryView, EachVisitsOnlyEntitiesWithAllComponents) {
+    Registry registry;
+    std::vector<Entity> expected;
+    for (int i = 0; i < 100; ++i) {
+        Entity e = registry.CreateEntity();
+        registry.AddComponent(e, Position{ static_cast<float>(i) });
+        if (i % 3 == 0) {
+            registry.AddComponent(e, Velocity{ 1.0f });
+            expected.push_back(e);
+        }
+    }
+
+    std::vector<Entity> visited;
+    registry.Each<Position, Velocity>([&](Entity e, Position& p, Velocity& v) {
+        EXPECT_EQ(p.x, static_cast<float>(e));
+        p.x += v.v;
+        visited.push_back(e);
+    });
+
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, expected);
+    EXPECT_FLOAT_EQ(registry.GetComponent<Position>(3).x, 4.0f);
+    EXPECT_FLOAT_EQ(registry.GetComponent<Position>(4).x, 4.0f);
+}
+
+TEST(RegistryView, RangeForMatchesEach) {
+    Registry registry;
+    for (int i = 0; i < 50; ++i) {
+        Entity e = registry.CreateEntity();
+        if (i % 2 == 0) registry.AddComponent(e, Position{});
+        if (i % 5 == 0) registry.AddComponent(e, Tag{});
+    }
+
+    std::vector<Entity> fromEach, fromRange;
+    registry.Each<Position, Tag>([&](Entity e, Position&, Tag&) { fromEach.push_back(e); });
+
+    auto view = registry.View<Position, Tag>();
+    for (Entity e : view) {
+        EXPECT_TRUE(registry.HasComponent<Tag>(e));
+        fromRange.push_back(e);
+    }
+
+    EXPECT_EQ(fromEach, fromRange);
+    EXPECT_EQ(fromEach.size(), 5u); // 0, 10, 20, 30, 40
+}
+
+TEST(RegistryView, EmptyPoolYieldsNothing) {
+    Registry registry;
+    Entity e = registry.CreateEntity();
+    registry.AddComponent(e, Position{});
+
+    int hits = 0;
+    registry.Each<Position, Velocity>([&](Entity, Position&, Velocity&) { hits++; });
+    for (Entity entity : registry.View<Velocity>()) { (void)entity; hits++; }
+    EXPECT_EQ(hits, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Registry Views: Structural Changes During Iteration
+// -----------------------------------------------------------------------------
+TEST(RegistryView, RemovingCurrentEntityDuringEachIsSafe) {
+    Registry registry;
+    for (int i = 0; i < 20; ++i) {
+        Entity e = registry.CreateEntity();
+        registry.AddComponent(e, Velocity{ static_cast<float>(i) });
+    }
+
+    int visits = 0;
+    registry.Each<Velocity>([&](Entity e, Velocity& v) {
+        visits++;
+        if (static_cast<int>(v.v) % 2 == 0) registry.RemoveComponent<Velocity>(e);
+    });
+
+    EXPECT_EQ(visits, 20);
+    int remaining = 0;
+    registry.Each<Velocity>([&](Entity, Velocity& v) {
+        EXPECT_EQ(static_cast<int>(v.v) % 2, 1);
+        remaining++;
+    });
+    EXPECT_EQ(remaining, 10);
+}
+
+TEST(RegistryView, TryGetComponentReturnsNullWhenMissing) {
+    Registry registry;
+    Entity a = registry.CreateEntity();
+    Entity b = registry.CreateEntity();
+    registry.AddComponent(a, Position{ 2.0f });
+
+    ASSERT_NE(registry.TryGetComponent<Position>(a), nullptr);
+    EXPECT_FLOAT_EQ(registry.TryGetComponent<Position>(a)->x, 2.0f);
+    EXPECT_EQ(registry.TryGetComponent<Position>(b), nullptr);
+
+    const Registry& constRegistry = registry;
+    EXPECT_EQ(constRegistry.TryGetComponent<Velocity>(a), nullptr);
+}
+
+// -----------------------------------------------------------------------------
+// Component Storage: Growth and Stability
+// -----------------------------------------------------------------------------
+TEST(ComponentStorage, ReferencesSurviveGrowth) {
+    Registry registry;
+    Entity first = registry.CreateEntity();
+    registry.AddComponent(first, Position{ 42.0f });
+    Position& held = registry.GetComponent<Position>(first);
+
+    for (int i = 0; i < 10000; ++i) {
+        registry.AddComponent(registry.CreateEntity(), Position{ static_cast<float>(i) });
+    }
+
+    EXPECT_EQ(&held, &registry.GetComponent<Position>(first));
+    EXPECT_FLOAT_EQ(held.x, 42.0f);
+}
+
+TEST(ComponentStorage, NonTrivialComponentsAreMovedOnRemoval) {
+    struct Named { std::string name; };
+
+    Registry registry;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 200; ++i) {
+        entities.push_back(registry.CreateEntity());
+        registry.AddComponent(entities.back(), Named{ "Entity_" + std::to_string(i) });
+    }
+    for (int i = 0; i < 200; i += 2) {
+        registry.DestroyEntity(entities[i]);
+    }
+
+    for (int i = 1; i < 200; i += 2) {
+        ASSERT_TRUE(registry.HasComponent<Named>(entities[i]));
+        EXPECT_EQ(registry.GetComponent<Named>(entities[i]).name, "Entity_" + std::to_string(i));
+    }
+    EXPECT_FALSE(registry.HasComponent<Named>(entities[0]));
+}
+
+TEST(ComponentStorage, ScalesPastOneMillionEntities) {
+    const Entity count = 1100000;
+
+    Registry registry;
+    for (Entity i = 0; i < count; ++i) {
+        Entity e = registry.CreateEntity();
+        registry.AddComponent(e, Position{ static_cast<float>(i) });
+        if (i % 1000 == 0) registry.AddComponent(e, Tag{});
+    }
+
+    EXPECT_EQ(registry.GetEntityCount(), count);
+    EXPECT_FLOAT_EQ(registry.GetComponent<Position>(count - 1).x, static_cast<float>(count - 1));
+
+    size_t tagged = 0;
+    registry.Each<Tag>([&](Entity, Tag&) { tagged++; });
+    EXPECT_EQ(tagged, 1100u);
+}
+
+TEST(ComponentStorage, SentinelEntityHasNoComponents) {
+    Registry registry;
+    registry.AddComponent(registry.CreateEntity(), Position{});
+    EXPECT_FALSE(registry.HasComponent<Position>(MAX_ENTITIES));
+    EXPECT_EQ(registry.TryGetComponent<Position>(MAX_ENTITIES), nullptr);
+}
+
+// -----------------------------------------------------------------------------
+// Registry: Component Family IDs
+// -----------------------------------------------------------------------------
+TEST(RegistryFamily, IdsAreStableAndDistinct) {
+    const size_t positionId = ComponentFamily::Id<Position>();
+    EXPECT_EQ(ComponentFamily::Id<Position>(), positionId);
+    EXPECT_NE(ComponentFamily::Id<Velocity>(), positionId);
+    EXPECT_NE(ComponentFamily::Id<Tag>(), ComponentFamily::Id<Velocity>());
+}
+
+TEST(RegistryFamily, ConstLookupDoesNotCreatePools) {
+    struct NeverAdded { int value = 0; };
+
+    Registry registry;
+    Entity e = registry.CreateEntity();
+    const Registry& constRegistry = registry;
+
+    EXPECT_FALSE(constRegistry.HasComponent<NeverAdded>(e));
+    EXPECT_THROW(constRegistry.GetComponent<NeverAdded>(e), std::runtime_error);
+
+    // The non-const path still creates the pool on demand
+    registry.AddComponent(e, NeverAdded{ 7 });
+    EXPECT_TRUE(constRegistry.HasComponent<NeverAdded>(e));
+    EXPECT_EQ(constRegistry.GetComponent<NeverAdded>(e).value, 7);
+}
+
+// -----------------------------------------------------------------------------
+// Registry: Change Tracking
+// -----------------------------------------------------------------------------
+TEST(RegistryChanges, OnlyMarkedEntitiesAreReported) {
+    Registry registry;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 50; ++i) {
+        Entity e = registry.CreateEntity();
+        registry.AddComponent(e, Position{});
+        entities.push_back(e);
+    }
+
+    const uint32_t since = registry.AdvanceChangeTick();
+    registry.MarkChanged<Position>(entities[7]);
+    registry.MarkChanged<Position>(entities[21]);
+    registry.MarkChanged<Position>(entities[7]);
+
+    std::vector<Entity> changed;
+    registry.ForEachChangedSince<Position>(since, [&](Entity e) { changed.push_back(e); });
+    std::sort(changed.begin(), changed.end());
+
+    EXPECT_EQ(changed, (std::vector<Entity>{ entities[7], entities[21] }));
+    EXPECT_TRUE(registry.ChangedSince<Position>(entities[21], since));
+    EXPECT_FALSE(registry.ChangedSince<Position>(entities[0], since));
+}
+
+TEST(RegistryChanges, AddingComponentCountsAsChange) {
+    Registry registry;
+    Entity old = registry.CreateEntity();
+    registry.AddComponent(old, Position{});
+
+    const uint32_t since = registry.AdvanceChangeTick();
+    Entity fresh = registry.CreateEntity();
+    registry.AddComponent(fresh, Position{});
+
+    std::vector<Entity> changed;
+    registry.ForEachChangedSince<Position>(since, [&](Entity e) { changed.push_back(e); });
+    EXPECT_EQ(changed, std::vector<Entity>{ fresh });
+}
+
+TEST(RegistryChanges, RemovedEntitiesAreSkipped) {
+    Registry registry;
+    Entity a = registry.CreateEntity();
+    Entity b = registry.CreateEntity();
+    registry.AddComponent(a, Position{});
+    registry.AddComponent(b, Position{});
+
+    const uint32_t since = registry.AdvanceChangeTick();
+    registry.MarkChanged<Position>(a);
+    registry.MarkChanged<Position>(b);
+    const uint64_t versionBefore = registry.GetStructureVersion<Position>();
+    registry.DestroyEntity(a);
+
+    std::vector<Entity> changed;
+    registry.ForEachChangedSince<Position>(since, [&](Entity e) { changed.push_back(e); });
+    EXPECT_EQ(changed, std::vector<Entity>{ b });
+    EXPECT_NE(registry.GetStructureVersion<Position>(), versionBefore);
+}
+
+TEST(RegistryChanges, EntityChangedAcrossTicksIsReportedOnce) {
+    Registry registry;
+    Entity e = registry.CreateEntity();
+    registry.AddComponent(e, Position{});
+
+    const uint32_t since = registry.AdvanceChangeTick();
+    for (int frame = 0; frame < 5000; ++frame) {
+        registry.MarkChanged<Position>(e);
+        registry.AdvanceChangeTick();
+    }
+
+    // The log is compacted as it grows, but the entity must still appear exactly once
+    int reports = 0;
+    registry.ForEachChangedSince<Position>(since, [&](Entity) { reports++; });
+    EXPECT_EQ(reports, 1);
+
+    int latest = 0;
+    registry.ForEachChangedSince<Position>(registry.GetChangeTick(), [&](Entity) { latest++; });
+    EXPECT_EQ(latest, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Registry: Snapshots
+// -----------------------------------------------------------------------------
+namespace {
+    struct Label { std::string text; std::shared_ptr<int> resource; };
+}
+
+TEST(RegistrySnapshot, RestoreReturnsExactState) {
+    Registry registry;
+    auto shared = std::make_shared<int>(7);
+    std::vector<Entity> entities;
+    for (int i = 0; i < 300; ++i) {
+        Entity e = registry.CreateEntity();
+        registry.AddComponent(e, Position{ static_cast<float>(i) });
+        if (i % 2 == 0) registry.AddComponent(e, Velocity{ static_cast<float>(-i) });
+        if (i % 5 == 0) registry.AddComponent(e, Label{ "entity" + std::to_string(i), shared });
+        entities.push_back(e);
+    }
+    registry.DestroyEntity(entities[10]);
+
+    const RegistrySnapshot snapshot = registry.SaveSnapshot();
+
+    // Diverge: move, destroy, create, and add a pool that did not exist at save time
+    registry.Each<Position>([](Entity, Position& p) { p.x += 100.0f; });
+    registry.DestroyEntity(entities[20]);
+    Entity extra = registry.CreateEntity();
+    registry.AddComponent(extra, Position{ -1.0f });
+    registry.AddComponent(extra, Tag{});
+    registry.GetComponent<Label>(entities[0]).text = "changed";
+
+    registry.RestoreSnapshot(snapshot);
+
+    for (int i = 0; i < 300; ++i) {
+        const Entity e = entities[i];
+        if (i == 10) {
+            EXPECT_FALSE(registry.HasComponent<Position>(e));
+            continue;
+        }
+        ASSERT_TRUE(registry.HasComponent<Position>(e));
+        EXPECT_EQ(registry.GetComponent<Position>(e).x, static_cast<float>(i));
+        EXPECT_EQ(registry.HasComponent<Velocity>(e), i % 2 == 0);
+        EXPECT_EQ(registry.HasComponent<Label>(e), i % 5 == 0);
+    }
+    EXPECT_EQ(registry.GetComponent<Label>(entities[0]).text, "entity0");
+    EXPECT_EQ(registry.GetComponent<Label>(entities[0]).resource, shared);
+    EXPECT_FALSE(registry.HasComponent<Tag>(extra));
+
+    // The allocator is restored too: the freed ID is reused first, exactly as before the divergence
+    EXPECT_EQ(registry.CreateEntity(), entities[10]);
+}
+
+TEST(RegistrySnapshot, CanBeRestoredRepeatedly) {
+    Registry registry;
+    Entity e = registry.CreateEntity();
+    registry.AddComponent(e, Position{ 1.0f });
+    const RegistrySnapshot snapshot = registry.SaveSnapshot();
+
+    for (int branch = 0; branch < 3; ++branch) {
+        registry.GetComponent<Position>(e).x = 50.0f + branch;
+        registry.RestoreSnapshot(snapshot);
+        EXPECT_EQ(registry.GetComponent<Position>(e).x, 1.0f);
+    }
+}
+
+TEST(RegistrySnapshot, RestoredComponentsAreReportedAsChanged) {
+    Registry registry;
+    Entity e = registry.CreateEntity();
+    registry.AddComponent(e, Position{ 1.0f });
+    const RegistrySnapshot snapshot = registry.SaveSnapshot();
+
+    const uint32_t since = registry.AdvanceChangeTick();
+    const uint64_t version = registry.GetStructureVersion<Position>();
+    registry.RestoreSnapshot(snapshot);
+
+    EXPECT_TRUE(registry.ChangedSince<Position>(e, since));
+    EXPECT_NE(registry.GetStructureVersion<Position>(), version);
+}
+
+// -----------------------------------------------------------------------------
+// Symbol Table: Interned Names
+// -----------------------------------------------------------------------------
+TEST(SymbolTable, InterningIsStableAndDense) {
+    SymbolTable symbols;
+    const Symbol sun = symbols.Intern("Sun");
+    const Symbol moon = symbols.Intern("Moon");
+
+    EXPECT_EQ(sun, 0u);
+    EXPECT_EQ(moon, 1u);
+    EXPECT_EQ(symbols.Intern("Sun"), sun);
+    EXPECT_EQ(symbols.Find("Moon"), moon);
+    EXPECT_EQ(symbols.Name(moon), "Moon");
+    EXPECT_EQ(symbols.Size(), 2u);
+}
+
+TEST(SymbolTable, UnknownNamesAreNotInterned) {
+    SymbolTable symbols;
+    EXPECT_EQ(symbols.Find("Missing"), INVALID_SYMBOL);
+    EXPECT_EQ(symbols.Size(), 0u);
+    EXPECT_TRUE(symbols.Name(INVALID_SYMBOL).empty());
+}
@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "Heightfield.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/noise.hpp>
+#include <cmath>
+#include <vector>
+
+namespace {
+    float Ramp(float x, float z) { return 0.5f * x - 0.25f * z + 2.0f; }
+
+    float Bumps(float x, float z) {
+        return glm::perlin(glm::vec2(x, z) * 0.05f) + glm::perlin(glm::vec2(x, z) * 0.1f) * 0.25f;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Heightfield: Sampling
+// -----------------------------------------------------------------------------
+TEST(Heightfield, EmptyFieldIsFlat) {
+    Heightfield field;
+    EXPECT_TRUE(field.Empty());
+    EXPECT_FALSE(field.Contains(0.0f, 0.0f));
+    EXPECT_EQ(field.Height(3.0f, 4.0f), 0.0f);
+    EXPECT_EQ(field.Normal(3.0f, 4.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+TEST(Heightfield, ExactAtGridNodes) {
+    Heightfield field;
+    field.Build(10.0f, 20, Bumps);
+    ASSERT_EQ(field.Resolution(), 20);
+    EXPECT_FLOAT_EQ(field.CellSize(), 1.0f);
+
+    for (float x : { -10.0f, -3.0f, 0.0f, 7.0f, 10.0f }) {
+        for (float z : { -10.0f, 1.0f, 10.0f }) {
+            EXPECT_NEAR(field.Height(x, z), Bumps(x, z), 1e-5f);
+        }
+    }
+}
+
+TEST(Heightfield, BilinearBetweenNodes) {
+    // Corners of cell (0, 0) hold 0, 1, 2 and 3; its centre is their average
+    Heightfield field;
+    field.Build(1.0f, 2, [](float x, float z) { return (x > -0.5f ? 1.0f : 0.0f) + (z > -0.5f ? 2.0f : 0.0f); });
+    EXPECT_FLOAT_EQ(field.Height(-0.5f, -0.5f), 1.5f);
+    EXPECT_FLOAT_EQ(field.Height(-0.75f, -1.0f), 0.25f);
+}
+
+TEST(Heightfield, ReproducesPlanesWithTheirNormal) {
+    Heightfield field;
+    field.Build(8.0f, 16, Ramp);
+
+    const glm::vec3 expected = glm::normalize(glm::vec3(-0.5f, 1.0f, 0.25f));
+    for (const glm::vec2 p : { glm::vec2(0.3f, -2.7f), glm::vec2(-7.9f, 7.9f), glm::vec2(4.25f, 0.5f) }) {
+        float height;
+        glm::vec3 normal;
+        field.Sample(p.x, p.y, height, normal);
+        EXPECT_NEAR(height, Ramp(p.x, p.y), 1e-5f);
+        EXPECT_NEAR(glm::length(normal - expected), 0.0f, 1e-5f);
+    }
+}
+
+TEST(Heightfield, ClampsOutsideTheRaster) {
+    Heightfield field;
+    field.Build(4.0f, 8, Ramp);
+    EXPECT_TRUE(field.Contains(4.0f, -4.0f));
+    EXPECT_FALSE(field.Contains(4.5f, 0.0f));
+    EXPECT_NEAR(field.Height(100.0f, 0.0f), Ramp(4.0f, 0.0f), 1e-5f);
+    EXPECT_NEAR(field.Height(-6.0f, -6.0f), Ramp(-4.0f, -4.0f), 1e-5f);
+}
+
+TEST(Heightfield, TangentPlaneTouchesTheSurface) {
+    Heightfield field;
+    field.Build(8.0f, 16, Ramp);
+    const Plane tangent = field.TangentPlane(1.5f, -2.0f);
+
+    EXPECT_NEAR(tangent.GetSignedDistance(glm::vec3(1.5f, Ramp(1.5f, -2.0f), -2.0f)), 0.0f, 1e-5f);
+    EXPECT_GT(tangent.GetSignedDistance(glm::vec3(1.5f, 10.0f, -2.0f)), 0.0f);
+}
+
+// -----------------------------------------------------------------------------
+// Heightfield: Batch Queries
+// -----------------------------------------------------------------------------
+TEST(Heightfield, BatchMatchesSingleQueries) {
+    Heightfield field;
+    field.Build(20.0f, 40, Bumps);
+
+    std::vector<glm::vec2> points;
+    for (int i = 0; i < 50; ++i) points.emplace_back(-25.0f + i * 1.03f, 19.0f - i * 0.77f);
+
+    std::vector<float> heights(points.size()), sampled(points.size());
+    std::vector<glm::vec3> normals(points.size());
+    field.Heights(points.data(), points.size(), heights.data());
+    field.Samples(points.data(), points.size(), sampled.data(), normals.data());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(heights[i], field.Height(points[i].x, points[i].y));
+        EXPECT_EQ(sampled[i], heights[i]);
+        EXPECT_EQ(normals[i], field.Normal(points[i].x, points[i].y));
+    }
+}
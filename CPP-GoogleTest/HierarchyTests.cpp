@@ -0,0 +1,188 @@
+#include "pch.h"
+#include "../src/core/TransformHierarchy.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace {
+    // Translation-only stand-in for TransformComponent (same matrix/LocalMatrix contract)
+    struct TestTransform {
+        glm::mat4 matrix = glm::mat4(1.0f);
+        glm::vec3 position = glm::vec3(0.0f);
+
+        glm::mat4 LocalMatrix() const { return glm::translate(glm::mat4(1.0f), position); }
+    };
+
+    Entity MakeNode(Registry& registry, const glm::vec3& position, Entity parent = MAX_ENTITIES) {
+        const Entity e = registry.CreateEntity();
+        TestTransform transform;
+        transform.position = position;
+        transform.matrix = transform.LocalMatrix();
+        registry.AddComponent<TestTransform>(e, transform);
+        if (parent != MAX_ENTITIES) registry.AddComponent<HierarchyComponent>(e, HierarchyComponent{ parent });
+        return e;
+    }
+
+    glm::vec3 WorldPosition(Registry& registry, Entity e) {
+        return glm::vec3(registry.GetComponent<TestTransform>(e).matrix[3]);
+    }
+
+    void Move(Registry& registry, Entity e, const glm::vec3& position) {
+        auto& transform = registry.GetComponent<TestTransform>(e);
+        transform.position = position;
+        transform.matrix = transform.LocalMatrix();
+        registry.MarkChanged<TestTransform>(e);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Transform Hierarchy: Ordering
+// -----------------------------------------------------------------------------
+TEST(TransformHierarchy, NodesAreGroupedByRootAndSortedByDepth) {
+    Registry registry;
+    const Entity rootA = MakeNode(registry, glm::vec3(0.0f));
+    const Entity rootB = MakeNode(registry, glm::vec3(0.0f));
+
+    // Created deepest-first so creation order cannot hide a missing sort
+    const Entity placeholder = registry.CreateEntity();
+    const Entity grandChild = MakeNode(registry, glm::vec3(0.0f), placeholder);
+    const Entity child = MakeNode(registry, glm::vec3(0.0f), rootA);
+    registry.GetComponent<HierarchyComponent>(grandChild).parent = child;
+    const Entity otherChild = MakeNode(registry, glm::vec3(0.0f), rootB);
+
+    TransformHierarchy hierarchy;
+    hierarchy.Propagate<TestTransform>(registry);
+
+    const auto& nodes = hierarchy.GetNodes();
+    const auto& subtrees = hierarchy.GetSubtrees();
+    ASSERT_EQ(nodes.size(), 3u);
+    ASSERT_EQ(subtrees.size(), 2u);
+
+    for (const auto& subtree : subtrees) {
+        for (size_t i = subtree.begin; i < subtree.end; ++i) {
+            const auto& node = nodes[i];
+            if (node.parentIndex == TransformHierarchy::ROOT_PARENT) {
+                EXPECT_EQ(node.parent, subtree.root);
+            }
+            else {
+                EXPECT_LT(node.parentIndex, i);
+                EXPECT_GE(node.parentIndex, subtree.begin);
+                EXPECT_EQ(nodes[node.parentIndex].entity, node.parent);
+            }
+        }
+    }
+
+    EXPECT_EQ(subtrees[0].root, rootA);
+    EXPECT_EQ(nodes[subtrees[0].begin].entity, child);
+    EXPECT_EQ(nodes[subtrees[0].begin + 1].entity, grandChild);
+    EXPECT_EQ(nodes[subtrees[1].begin].entity, otherChild);
+}
+
+TEST(TransformHierarchy, CyclesAreLeftOut) {
+    Registry registry;
+    const Entity a = MakeNode(registry, glm::vec3(0.0f));
+    const Entity b = MakeNode(registry, glm::vec3(0.0f), a);
+    registry.AddComponent<HierarchyComponent>(a, HierarchyComponent{ b });
+
+    TransformHierarchy hierarchy;
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_TRUE(hierarchy.GetNodes().empty());
+}
+
+// -----------------------------------------------------------------------------
+// Transform Hierarchy: Propagation
+// -----------------------------------------------------------------------------
+TEST(TransformHierarchy, ChildrenFollowTheirParents) {
+    Registry registry;
+    const Entity root = MakeNode(registry, glm::vec3(10.0f, 0.0f, 0.0f));
+    const Entity child = MakeNode(registry, glm::vec3(0.0f, 1.0f, 0.0f), root);
+    const Entity grandChild = MakeNode(registry, glm::vec3(0.0f, 0.0f, 2.0f), child);
+
+    TransformHierarchy hierarchy;
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(WorldPosition(registry, child), glm::vec3(10.0f, 1.0f, 0.0f));
+    EXPECT_EQ(WorldPosition(registry, grandChild), glm::vec3(10.0f, 1.0f, 2.0f));
+
+    Move(registry, root, glm::vec3(-5.0f, 0.0f, 0.0f));
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(WorldPosition(registry, child), glm::vec3(-5.0f, 1.0f, 0.0f));
+    EXPECT_EQ(WorldPosition(registry, grandChild), glm::vec3(-5.0f, 1.0f, 2.0f));
+
+    // Moving a child only touches it and its descendants
+    Move(registry, child, glm::vec3(0.0f, 3.0f, 0.0f));
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(hierarchy.GetLastRecomputedCount(), 2u);
+    EXPECT_EQ(WorldPosition(registry, grandChild), glm::vec3(-5.0f, 3.0f, 2.0f));
+}
+
+TEST(TransformHierarchy, OnlyDirtySubtreesAreRecomputed) {
+    Registry registry;
+    std::vector<Entity> roots;
+    for (int i = 0; i < 8; ++i) {
+        const Entity root = MakeNode(registry, glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+        const Entity child = MakeNode(registry, glm::vec3(0.0f, 1.0f, 0.0f), root);
+        MakeNode(registry, glm::vec3(0.0f, 1.0f, 0.0f), child);
+        roots.push_back(root);
+    }
+
+    TransformHierarchy hierarchy;
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(hierarchy.GetLastRecomputedCount(), 16u);
+
+    // Nothing moved: the hierarchy's own marks from the last pass must not count as edits
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(hierarchy.GetLastRecomputedCount(), 0u);
+
+    Move(registry, roots[3], glm::vec3(100.0f, 0.0f, 0.0f));
+    const uint32_t tickBefore = registry.GetChangeTick();
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(hierarchy.GetLastRecomputedCount(), 2u);
+
+    // Consumers see the recomputed children as changed
+    size_t changed = 0;
+    registry.ForEachChangedSince<TestTransform>(tickBefore, [&](Entity) { ++changed; });
+    EXPECT_EQ(changed, 3u); // The moved root plus its two descendants
+}
+
+TEST(TransformHierarchy, ReparentingRebuildsTheOrder) {
+    Registry registry;
+    const Entity a = MakeNode(registry, glm::vec3(1.0f, 0.0f, 0.0f));
+    const Entity b = MakeNode(registry, glm::vec3(0.0f, 0.0f, 5.0f));
+    const Entity child = MakeNode(registry, glm::vec3(0.0f, 1.0f, 0.0f), a);
+
+    TransformHierarchy hierarchy;
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(WorldPosition(registry, child), glm::vec3(1.0f, 1.0f, 0.0f));
+
+    registry.GetComponent<HierarchyComponent>(child).parent = b;
+    registry.MarkChanged<HierarchyComponent>(child);
+    hierarchy.Propagate<TestTransform>(registry);
+    EXPECT_EQ(WorldPosition(registry, child), glm::vec3(0.0f, 1.0f, 5.0f));
+    ASSERT_EQ(hierarchy.GetSubtrees().size(), 1u);
+    EXPECT_EQ(hierarchy.GetSubtrees()[0].root, b);
+}
+
+TEST(TransformHierarchy, ParallelMatchesSequential) {
+    auto build = [](Registry& registry) {
+        for (int r = 0; r < 64; ++r) {
+            Entity parent = MakeNode(registry, glm::vec3(static_cast<float>(r), 0.0f, 0.0f));
+            for (int d = 0; d < 6; ++d) {
+                parent = MakeNode(registry, glm::vec3(0.0f, 1.0f, static_cast<float>(d)), parent);
+            }
+        }
+    };
+
+    Registry sequential, parallel;
+    build(sequential);
+    build(parallel);
+
+    TransformHierarchy seqHierarchy, parHierarchy;
+    TransformHierarchy::runParallel = false;
+    seqHierarchy.Propagate<TestTransform>(sequential);
+    TransformHierarchy::runParallel = true;
+    parHierarchy.Propagate<TestTransform>(parallel);
+
+    for (Entity e = 0; e < sequential.GetEntityCount(); ++e) {
+        EXPECT_EQ(WorldPosition(sequential, e), WorldPosition(parallel, e));
+    }
+}
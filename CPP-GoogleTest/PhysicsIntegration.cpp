@@ -2,7 +2,13 @@
 #include <gtest/gtest.h>
 #include "Sphere.h"
 #include "PhysicsHelper.h"
+#include "BodySoA.h"
+#include "FixedTimestep.h"
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
 
 // Helper macro to compare glm vectors
 #define ExpectVec3Near(a, b, tolerance) \
@@ -134,4 +140,185 @@ TEST(PhysicsIntegration, RK4_PerfectAccuracy_WithGravity) {
 
     // RK4 handles constant acceleration perfectly! Tolerance is microscopic.
     ExpectVec3Near(position, exactPos, 1e-4f);
-}
\ No newline at end of file
+}
+
+
+// -----------------------------------------------------------------------------
+// SoA Integrator: must match the per-component (AoS) integrator
+// -----------------------------------------------------------------------------
+namespace {
+    // Mirrors the hot and cold fields of TransformComponent + PhysicsComponent
+    struct AoSBody {
+        glm::mat4 matrix = glm::mat4(1.0f);
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 rotation = glm::vec3(0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+        glm::vec3 velocity = glm::vec3(0.0f);
+        glm::vec3 forceAccumulator = glm::vec3(0.0f);
+        float mass = 1.0f;
+        float inverseMass = 1.0f;
+        bool isStatic = false;
+        float friction = 0.98f;
+        float restitution = 1.0f;
+    };
+
+    // Same steps as PhysicsSystem::Integrate, minus the matrix rebuild
+    void IntegrateAoS(std::vector<AoSBody>& bodies, float dt, IntegrationMethod method) {
+        const float damping = std::pow(0.999f, dt * 60.0f);
+        for (auto& body : bodies) {
+            if (body.isStatic || body.inverseMass <= 0.0f) continue;
+
+            body.forceAccumulator += glm::vec3(0.0f, -9.81f, 0.0f) * body.mass;
+            const glm::vec3 acceleration = body.forceAccumulator * body.inverseMass;
+
+            if (method == IntegrationMethod::ExplicitEuler) {
+                body.position += body.velocity * dt;
+                body.velocity += acceleration * dt;
+            }
+            else if (method == IntegrationMethod::SemiImplicitEuler) {
+                body.velocity += acceleration * dt;
+                body.position += body.velocity * dt;
+            }
+            else {
+                const glm::vec3 k1_x = body.velocity;
+                const glm::vec3 k2_x = body.velocity + acceleration * (dt * 0.5f);
+                const glm::vec3 k3_x = body.velocity + acceleration * (dt * 0.5f);
+                const glm::vec3 k4_x = body.velocity + acceleration * dt;
+                body.velocity += acceleration * dt;
+                body.position += (k1_x + 2.0f * k2_x + 2.0f * k3_x + k4_x) * (dt / 6.0f);
+            }
+
+            body.forceAccumulator = glm::vec3(0.0f);
+            body.velocity *= damping;
+        }
+    }
+
+    std::vector<AoSBody> MakeBodies(size_t count, unsigned int seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> range(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> massRange(0.5f, 5.0f);
+
+        std::vector<AoSBody> bodies(count);
+        for (auto& body : bodies) {
+            body.position = glm::vec3(range(gen), range(gen), range(gen));
+            body.velocity = glm::vec3(range(gen), range(gen), range(gen));
+            body.forceAccumulator = glm::vec3(range(gen), range(gen), range(gen));
+            body.mass = massRange(gen);
+            body.inverseMass = 1.0f / body.mass;
+        }
+        return bodies;
+    }
+
+    BodySoA ToSoA(const std::vector<AoSBody>& bodies) {
+        BodySoA soa;
+        soa.Reserve(bodies.size());
+        for (const auto& body : bodies) {
+            soa.Add(body.position, body.velocity, body.forceAccumulator, body.inverseMass);
+        }
+        return soa;
+    }
+}
+
+TEST(PhysicsIntegration, SoA_MatchesAoS_AllMethods) {
+    const IntegrationMethod methods[] = { IntegrationMethod::ExplicitEuler, IntegrationMethod::SemiImplicitEuler, IntegrationMethod::RK4 };
+    const float dt = 0.004f;
+
+    for (IntegrationMethod method : methods) {
+        // 37 bodies: exercises both the 4-wide loop and the scalar tail
+        std::vector<AoSBody> aos = MakeBodies(37, 42);
+        BodySoA soa = ToSoA(aos);
+
+        for (int step = 0; step < 200; ++step) {
+            IntegrateAoS(aos, dt, method);
+            IntegrateBodies(soa, dt, glm::vec3(0.0f, -9.81f, 0.0f), method, std::pow(0.999f, dt * 60.0f));
+        }
+
+        for (size_t i = 0; i < aos.size(); ++i) {
+            ExpectVec3Near(soa.Position(i), aos[i].position, 1e-3f);
+            ExpectVec3Near(soa.Velocity(i), aos[i].velocity, 1e-3f);
+            ExpectVec3Near(soa.Force(i), glm::vec3(0.0f), 0.0f);
+        }
+    }
+}
+
+TEST(PhysicsIntegration, SoA_RK4_PerfectAccuracy_WithGravity) {
+    BodySoA soa;
+    soa.Add(glm::vec3(0.0f, 100.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f), 1.0f);
+
+    float dt = 0.016f;
+    int steps = static_cast<int>(2.0f / dt);
+    float actualSimulatedTime = steps * dt;
+
+    for (int i = 0; i < steps; ++i) {
+        IntegrateBodies(soa, dt, glm::vec3(0.0f, -9.81f, 0.0f), IntegrationMethod::RK4, 1.0f);
+    }
+
+    glm::vec3 exactPos = glm::vec3(0.0f, 100.0f, 0.0f) +
+        (0.5f * glm::vec3(0.0f, -9.81f, 0.0f) * (actualSimulatedTime * actualSimulatedTime));
+
+    ExpectVec3Near(soa.Position(0), exactPos, 1e-3f);
+}
+
+
+// -----------------------------------------------------------------------------
+// Fixed Timestep: results must not depend on the frame rate
+// -----------------------------------------------------------------------------
+namespace {
+    // Drops one body under gravity for totalSteps fixed steps, feeding the clock frames of frameTime
+    glm::vec3 SimulateFixed(float frameTime, int totalSteps, int maxSteps = 1000) {
+        const float stepTime = 1.0f / 240.0f;
+        FixedTimestep clock;
+        BodySoA bodies;
+        bodies.Add(glm::vec3(0.0f, 100.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(0.0f), 1.0f);
+
+        int taken = 0;
+        while (taken < totalSteps) {
+            const int steps = std::min(clock.Advance(frameTime, stepTime, maxSteps), totalSteps - taken);
+            for (int i = 0; i < steps; ++i) {
+                IntegrateBodies(bodies, stepTime, glm::vec3(0.0f, -9.81f, 0.0f), IntegrationMethod::SemiImplicitEuler, 1.0f);
+            }
+            taken += steps;
+        }
+        return bodies.Position(0);
+    }
+}
+
+TEST(FixedTimestep, SameStepsAtAnyFrameRate) {
+    const glm::vec3 at30 = SimulateFixed(1.0f / 30.0f, 240);
+    const glm::vec3 at144 = SimulateFixed(1.0f / 144.0f, 240);
+    const glm::vec3 atUneven = SimulateFixed(0.0123f, 240);
+
+    // Identical step sequences give bit-identical results
+    EXPECT_EQ(at30, at144);
+    EXPECT_EQ(at30, atUneven);
+}
+
+TEST(FixedTimestep, AccumulatesAndReportsAlpha) {
+    const float stepTime = 0.01f;
+    FixedTimestep clock;
+
+    EXPECT_EQ(clock.Advance(0.004f, stepTime, 8), 0);
+    EXPECT_NEAR(clock.Alpha(stepTime), 0.4f, 1e-4f);
+
+    EXPECT_EQ(clock.Advance(0.0085f, stepTime, 8), 1);
+    EXPECT_NEAR(clock.Alpha(stepTime), 0.25f, 1e-4f);
+
+    // Alpha always stays a valid blend factor
+    for (int i = 0; i < 100; ++i) {
+        clock.Advance(0.0037f, stepTime, 8);
+        EXPECT_GE(clock.Alpha(stepTime), 0.0f);
+        EXPECT_LT(clock.Alpha(stepTime), 1.0f);
+    }
+}
+
+TEST(FixedTimestep, SlowFrameIsCappedAndBacklogDropped) {
+    const float stepTime = 1.0f / 240.0f;
+    FixedTimestep clock;
+
+    // A one-second hitch would owe 240 steps; only the cap is run and nothing is carried over
+    EXPECT_EQ(clock.Advance(1.0f, stepTime, 8), 8);
+    EXPECT_FLOAT_EQ(clock.accumulator, 0.0f);
+
+    // The next normal frame is back to normal cost
+    EXPECT_EQ(clock.Advance(1.0f / 60.0f, stepTime, 8), 4);
+}
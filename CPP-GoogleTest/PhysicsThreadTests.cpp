@@ -0,0 +1,155 @@
+#include "pch.h"
+#include "../src/systems/PhysicsEdits.h"
+#include "../src/systems/PhysicsThread.h"
+#include <chrono>
+#include <thread>
+
+namespace {
+    Registry MakeRegistry() {
+        Registry registry;
+        registry.RegisterComponent<TransformComponent>();
+        registry.RegisterComponent<PhysicsComponent>();
+        registry.RegisterComponent<ColliderComponent>();
+        return registry;
+    }
+
+    Entity AddBall(Registry& registry, const glm::vec3& position) {
+        const Entity e = registry.CreateEntity();
+        TransformComponent transform;
+        transform.position = position;
+        transform.UpdateMatrix();
+        registry.AddComponent(e, transform);
+
+        PhysicsComponent physics;
+        physics.isStatic = false;
+        physics.SetMass(1.0f);
+        registry.AddComponent(e, physics);
+
+        ColliderComponent collider;
+        collider.type = 0;
+        collider.radius = 0.5f;
+        registry.AddComponent(e, collider);
+        return e;
+    }
+
+    // One main-thread frame: a new change tick, then the exchange with the physics thread
+    void Frame(PhysicsThread& thread, Registry& registry) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        registry.AdvanceChangeTick();
+        thread.Sync(registry);
+    }
+
+    template <typename Done>
+    bool FrameUntil(PhysicsThread& thread, Registry& registry, Done&& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            Frame(thread, registry);
+        }
+        return true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Physics Thread: edits made on the main thread reach the mirror it simulates
+// -----------------------------------------------------------------------------
+TEST(PhysicsThread, SceneEditReachesTheRunningThread) {
+    Registry registry = MakeRegistry();
+    const Entity ball = AddBall(registry, glm::vec3(0.0f, 100.0f, 0.0f));
+    PhysicsThread thread;
+
+    // The ball is mirrored and falling
+    auto height = [&]() { return registry.GetComponent<TransformComponent>(ball).position.y; };
+    ASSERT_TRUE(FrameUntil(thread, registry, [&]() { return height() < 99.9f; }));
+
+    // Made static between frames, as Scene::SetObjectPhysics does. Had the thread not heard of it, the ball
+    // would go on falling in the mirror and the results would keep moving it here.
+    registry.AdvanceChangeTick();
+    SetBodyPhysics(registry, ball, true, 1.0f);
+    thread.Sync(registry);
+    const float frozenAt = height();
+
+    for (int frame = 0; frame < 50; ++frame) Frame(thread, registry);
+    EXPECT_EQ(height(), frozenAt);
+    EXPECT_TRUE(registry.GetComponent<PhysicsComponent>(ball).isStatic);
+}
+
+TEST(PhysicsThread, EditedVelocityIsNotOverwritten) {
+    Registry registry = MakeRegistry();
+    const Entity ball = AddBall(registry, glm::vec3(0.0f, 100.0f, 0.0f));
+    PhysicsThread thread;
+
+    auto height = [&]() { return registry.GetComponent<TransformComponent>(ball).position.y; };
+    ASSERT_TRUE(FrameUntil(thread, registry, [&]() { return height() < 99.9f; }));
+
+    // Thrown upwards the way the editor's velocity field does it; the ball climbs instead of carrying on down
+    registry.AdvanceChangeTick();
+    registry.GetComponent<PhysicsComponent>(ball).velocity = glm::vec3(0.0f, 50.0f, 0.0f);
+    registry.MarkChanged<PhysicsComponent>(ball);
+    thread.Sync(registry);
+    const float thrownFrom = height();
+
+    EXPECT_TRUE(FrameUntil(thread, registry, [&]() { return height() > thrownFrom + 1.0f; }));
+}
+
+TEST(PhysicsEdits, CollidersAreMarkedChanged) {
+    Registry registry = MakeRegistry();
+    const Entity ball = AddBall(registry, glm::vec3(0.0f));
+    auto changedSince = [&](uint32_t tick) {
+        bool found = false;
+        registry.ForEachChangedSince<ColliderComponent>(tick, [&](Entity e) { found |= (e == ball); });
+        return found;
+    };
+
+    const uint32_t first = registry.AdvanceChangeTick();
+    EXPECT_FALSE(changedSince(first));
+    SetBodyCollisionSize(registry, ball, 2.0f, 1.0f);
+    EXPECT_TRUE(changedSince(first));
+    EXPECT_FLOAT_EQ(registry.GetComponent<ColliderComponent>(ball).radius, 2.0f);
+
+    const uint32_t second = registry.AdvanceChangeTick();
+    SetBodyCollision(registry, ball, false);
+    EXPECT_TRUE(changedSince(second));
+    EXPECT_FALSE(registry.GetComponent<ColliderComponent>(ball).hasCollision);
+
+    const uint32_t third = registry.AdvanceChangeTick();
+    SetBodyCollider(registry, ball, 1, 1.0f, glm::vec3(0.0f, 2.0f, 0.0f));
+    EXPECT_TRUE(changedSince(third));
+    EXPECT_EQ(registry.GetComponent<ColliderComponent>(ball).normal, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+TEST(PhysicsThread, EditAtTheSyncTickIsKept) {
+    Registry registry = MakeRegistry();
+    const Entity ball = AddBall(registry, glm::vec3(0.0f, 100.0f, 0.0f));
+    PhysicsThread thread;
+
+    auto height = [&]() { return registry.GetComponent<TransformComponent>(ball).position.y; };
+    ASSERT_TRUE(FrameUntil(thread, registry, [&]() { return height() < 99.9f; }));
+
+    // Made static by a system scheduled after physics, in the same tick as the results were written
+    registry.AdvanceChangeTick();
+    thread.Sync(registry);
+    SetBodyPhysics(registry, ball, true, 1.0f);
+    const float frozenAt = height();
+
+    for (int frame = 0; frame < 50; ++frame) Frame(thread, registry);
+    EXPECT_EQ(height(), frozenAt);
+}
+
+TEST(PhysicsThread, ResultsAreNotSentBackAsEdits) {
+    Registry registry = MakeRegistry();
+    const Entity ball = AddBall(registry, glm::vec3(0.0f, 100.0f, 0.0f));
+    PhysicsThread thread;
+
+    // The first sync sends the new body; after that the ball only moves by the results written into it
+    Frame(thread, registry);
+    EXPECT_EQ(thread.GetEditsSent(), 1u);
+    auto height = [&]() { return registry.GetComponent<TransformComponent>(ball).position.y; };
+    size_t resent = 0;
+    for (int frame = 0; frame < 2000 && height() >= 99.0f; ++frame) {
+        Frame(thread, registry);
+        resent += thread.GetEditsSent();
+    }
+    EXPECT_LT(height(), 99.0f);
+    EXPECT_EQ(resent, 0u);
+}
@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "../src/core/JobSystem.h"
+#include "../src/systems/ISystem.h"
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Transform {};
+    struct Physics {};
+    struct Camera {};
+}
+
+// -----------------------------------------------------------------------------
+// System Access: Hazard Detection
+// -----------------------------------------------------------------------------
+TEST(SystemAccess, ReadersDoNotConflict) {
+    SystemAccess a, b;
+    a.Reads<Transform>();
+    b.Reads<Transform, Physics>();
+    EXPECT_FALSE(a.ConflictsWith(b));
+}
+
+TEST(SystemAccess, WriteAgainstReadOrWriteConflicts) {
+    SystemAccess writer, reader, otherWriter, unrelated;
+    writer.Writes<Transform>();
+    reader.Reads<Transform>();
+    otherWriter.Writes<Transform>();
+    unrelated.Writes<Camera>();
+
+    EXPECT_TRUE(writer.ConflictsWith(reader));
+    EXPECT_TRUE(reader.ConflictsWith(writer));
+    EXPECT_TRUE(writer.ConflictsWith(otherWriter));
+    EXPECT_FALSE(writer.ConflictsWith(unrelated));
+}
+
+TEST(SystemAccess, SceneStateAndExclusiveAccess) {
+    SystemAccess sceneWriter, sceneReader, plain, exclusive;
+    sceneWriter.WritesScene();
+    sceneReader.ReadsScene();
+    plain.Writes<Camera>();
+    exclusive.Exclusive();
+
+    EXPECT_TRUE(sceneWriter.ConflictsWith(sceneReader));
+    EXPECT_FALSE(sceneReader.ConflictsWith(SystemAccess().ReadsScene()));
+    EXPECT_FALSE(sceneWriter.ConflictsWith(plain));
+    EXPECT_TRUE(exclusive.ConflictsWith(plain));
+    EXPECT_TRUE(exclusive.ConflictsWith(SystemAccess()));
+}
+
+TEST(SystemAccess, CreatePoolsRegistersDeclaredComponents) {
+    SystemAccess access;
+    access.Reads<Transform>().Writes<Physics>();
+
+    Registry registry;
+    access.CreatePools(registry);
+
+    const Registry& constRegistry = registry;
+    Entity e = registry.CreateEntity();
+    registry.AddComponent(e, Physics{});
+    EXPECT_TRUE(constRegistry.HasComponent<Physics>(e));
+    EXPECT_FALSE(constRegistry.HasComponent<Transform>(e));
+}
+
+// -----------------------------------------------------------------------------
+// Job System
+// -----------------------------------------------------------------------------
+TEST(JobSystem, ParallelForCoversRangeExactlyOnce) {
+    JobSystem jobs(4);
+    std::vector<int> hits(10007, 0);
+
+    jobs.ParallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) hits[i]++;
+    });
+
+    for (int h : hits) ASSERT_EQ(h, 1);
+}
+
+TEST(JobSystem, NestedSubmitAndWaitCompletes) {
+    JobSystem jobs(2);
+    std::atomic<int> total{ 0 };
+
+    JobGroup outer;
+    for (int i = 0; i < 8; ++i) {
+        jobs.Submit(outer, [&]() {
+            // Jobs that wait on their own children must not deadlock the pool
+            jobs.ParallelFor(1000, 10, [&](size_t begin, size_t end) {
+                total.fetch_add(static_cast<int>(end - begin));
+            });
+        });
+    }
+    jobs.Wait(outer);
+
+    EXPECT_EQ(total.load(), 8000);
+}
+
+TEST(JobSystem, SingleWorkerPoolCompletes) {
+    JobSystem jobs(1);
+    std::vector<int> values(100);
+    jobs.ParallelFor(values.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) values[i] = static_cast<int>(i);
+    });
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 4950);
+}
+
+TEST(JobSystem, WaitOnlyHelpsWithItsOwnGroup) {
+    JobSystem jobs(1);
+    std::atomic<bool> started{ false }, release{ false }, otherRan{ false };
+
+    // Keep the only worker busy, so queued jobs wait for whoever helps
+    JobGroup busy;
+    jobs.Submit(busy, [&]() {
+        started = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!started) std::this_thread::yield();
+
+    JobGroup other;
+    jobs.Submit(other, [&]() { otherRan = true; });
+
+    // A thread outside the pool waiting on its own work runs that work and nothing else
+    JobGroup own;
+    bool ownRan = false;
+    jobs.Submit(own, [&]() { ownRan = true; });
+    jobs.Wait(own);
+    EXPECT_TRUE(ownRan);
+    EXPECT_FALSE(otherRan);
+
+    release = true;
+    jobs.Wait(busy);
+    jobs.Wait(other);
+    EXPECT_TRUE(otherRan);
+}
@@ -0,0 +1,99 @@
+#include "pch.h"
+#include "SleepIslands.h"
+#include "Sphere.h"
+#include "Plane.h"
+#include "PhysicsHelper.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Sleeping: Rest Detection
+// -----------------------------------------------------------------------------
+TEST(Sleep_RestDetection, BothThresholdsMustHold) {
+    SleepSettings settings;
+    settings.linearVelocity = 0.2f;
+    settings.kineticEnergy = 0.01f;
+
+    EXPECT_TRUE(IsAtRest(glm::vec3(0.0f), 1.0f, settings));
+    EXPECT_TRUE(IsAtRest(glm::vec3(0.1f, 0.0f, 0.0f), 1.0f, settings));  // KE 0.005
+    EXPECT_FALSE(IsAtRest(glm::vec3(0.3f, 0.0f, 0.0f), 1.0f, settings)); // Too fast
+    EXPECT_FALSE(IsAtRest(glm::vec3(0.1f, 0.0f, 0.0f), 5.0f, settings)); // Slow, but too much energy
+}
+
+TEST(Sleep_RestDetection, BouncingBallSettlesOnFloor) {
+    // Same loop shape as the physics system: substeps of gravity + plane response, then one rest check per frame
+    SleepSettings settings;
+    const Plane floor(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::vec3 position(0.0f, 3.0f, 0.0f);
+    glm::vec3 velocity(0.0f);
+    const float dt = (1.0f / 60.0f) / 4.0f;
+
+    int restFrames = 0;
+    int frame = 0;
+    for (; frame < 600 && restFrames < settings.framesToSleep; ++frame) {
+        for (int step = 0; step < 4; ++step) {
+            velocity.y += -9.81f * dt;
+            position += velocity * dt;
+
+            MovingSphere ball(position, 0.5f, velocity, 1.0f, 0.5f);
+            if (floor.Intersects(ball.sphere)) {
+                ResolveSpherePlaneCollision(ball, floor, 1.0f);
+                velocity = ball.velocity;
+                position.y = std::max(position.y, 0.5f);
+            }
+        }
+        restFrames = IsAtRest(velocity, 1.0f, settings) ? restFrames + 1 : 0;
+    }
+
+    EXPECT_GE(restFrames, settings.framesToSleep) << "Ball never came to rest";
+    EXPECT_NEAR(position.y, 0.5f, 0.05f);
+}
+
+// -----------------------------------------------------------------------------
+// Sleeping: Contact Islands
+// -----------------------------------------------------------------------------
+TEST(Sleep_Islands, ContactChainsShareAnIsland) {
+    IslandBuilder islands;
+    islands.Reset(6);
+
+    // 0-1-2 chain, 3-4 pair, 5 alone
+    islands.Union(0, 1);
+    islands.Union(2, 1);
+    islands.Union(3, 4);
+
+    std::vector<uint32_t> islandOf;
+    const size_t count = islands.Label(islandOf);
+
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(islandOf[0], islandOf[1]);
+    EXPECT_EQ(islandOf[1], islandOf[2]);
+    EXPECT_EQ(islandOf[3], islandOf[4]);
+    EXPECT_NE(islandOf[0], islandOf[3]);
+    EXPECT_NE(islandOf[5], islandOf[0]);
+    EXPECT_NE(islandOf[5], islandOf[3]);
+
+    // Labels are dense, starting at 0
+    for (uint32_t label : islandOf) EXPECT_LT(label, count);
+}
+
+TEST(Sleep_Islands, LongChainStaysOneIsland) {
+    const uint32_t n = 20000;
+    IslandBuilder islands;
+    islands.Reset(n);
+    for (uint32_t i = 1; i < n; ++i) islands.Union(i, i - 1);
+
+    std::vector<uint32_t> islandOf;
+    EXPECT_EQ(islands.Label(islandOf), 1u);
+}
+
+TEST(Sleep_Islands, ResetClearsPreviousFrame) {
+    IslandBuilder islands;
+    islands.Reset(4);
+    islands.Union(0, 3);
+
+    islands.Reset(4);
+    std::vector<uint32_t> islandOf;
+    EXPECT_EQ(islands.Label(islandOf), 4u);
+}
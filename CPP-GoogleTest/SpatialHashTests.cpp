@@ -0,0 +1,135 @@
+#include "pch.h"
+#include "SpatialHash.h"
+#include "Sphere.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+// Spatial Hash: Basic Queries
+// -----------------------------------------------------------------------------
+TEST(SpatialHash, EmptyGridReportsNothing) {
+    SpatialHash grid;
+    grid.Reset(2.0f, 0);
+    grid.Build();
+
+    int hits = 0;
+    grid.QueryNeighbours({ 0.0, 0.0, 0.0 }, [&](uint32_t) { hits++; });
+    EXPECT_EQ(hits, 0);
+    EXPECT_TRUE(grid.Empty());
+}
+
+TEST(SpatialHash, FindsPointInNeighbouringCell) {
+    SpatialHash grid;
+    grid.Reset(2.0f, 2);
+    grid.InsertPoint(7, { 1.9, 0.0, 0.0 });
+    grid.InsertPoint(9, { 50.0, 0.0, 0.0 });
+    grid.Build();
+
+    std::set<uint32_t> found;
+    grid.QueryNeighbours({ 2.1, 0.0, 0.0 }, [&](uint32_t id) { found.insert(id); });
+
+    EXPECT_EQ(found.count(7u), 1u);
+    EXPECT_EQ(found.count(9u), 0u);
+}
+
+TEST(SpatialHash, NegativeCoordinatesUseFloorCells) {
+    SpatialHash grid;
+    grid.Reset(1.0f, 1);
+    EXPECT_EQ(grid.CellOf({ -0.5, 0.5, -1.5 }), glm::ivec3(-1, 0, -2));
+}
+
+TEST(SpatialHash, BoundsInsertionCoversEveryOverlappedCell) {
+    SpatialHash grid;
+    grid.Reset(1.0f, 8);
+    grid.InsertBounds(3, { -5.0, -0.5, -0.5 }, { 5.0, 0.5, 0.5 });
+    grid.Build();
+
+    // Both far ends of the box must be reachable
+    int leftHits = 0, rightHits = 0;
+    grid.QueryBounds({ -4.9, 0.0, 0.0 }, { -4.9, 0.0, 0.0 }, [&](uint32_t id) { if (id == 3) leftHits++; });
+    grid.QueryBounds({ 4.9, 0.0, 0.0 }, { 4.9, 0.0, 0.0 }, [&](uint32_t id) { if (id == 3) rightHits++; });
+    EXPECT_GE(leftHits, 1);
+    EXPECT_GE(rightHits, 1);
+}
+
+TEST(SpatialHash, OversizedBoundsAreTestedWhole) {
+    // A static sphere of radius 50 in a grid sized for balls of radius 0.1: hashed per cell it would take
+    // 500^3 entries, so it is kept once and compared against each query's range instead
+    SpatialHash grid;
+    grid.Reset(0.2f, 8);
+    grid.InsertBounds(1, { -50.0, -50.0, -50.0 }, { 50.0, 50.0, 50.0 });
+    grid.InsertBounds(2, { 0.05, 0.05, 0.05 }, { 0.25, 0.25, 0.25 });
+    grid.Build();
+
+    EXPECT_EQ(grid.OversizedCount(), 1u);
+    EXPECT_EQ(grid.EntryCount(), 9u);
+
+    std::vector<uint32_t> nearEdge, inside, outside;
+    grid.QueryBounds({ 49.9, 0.0, 0.0 }, { 50.1, 0.1, 0.1 }, [&](uint32_t id) { nearEdge.push_back(id); });
+    grid.QueryNeighbours({ 0.1, 0.1, 0.1 }, [&](uint32_t id) { inside.push_back(id); });
+    grid.QueryBounds({ 60.0, 0.0, 0.0 }, { 61.0, 1.0, 1.0 }, [&](uint32_t id) { outside.push_back(id); });
+
+    // Buckets are shared, so the small box may come along anywhere; the large one exactly where it overlaps
+    EXPECT_EQ(std::count(nearEdge.begin(), nearEdge.end(), 1u), 1);
+    EXPECT_EQ(std::count(inside.begin(), inside.end(), 1u), 1);
+    EXPECT_GE(std::count(inside.begin(), inside.end(), 2u), 1);
+    EXPECT_EQ(std::count(outside.begin(), outside.end(), 1u), 0);
+}
+
+TEST(SpatialHash, HugeRangeVisitsEachEntryOnce) {
+    // A body crossing 20000 units in one step over 0.1 unit cells: about 8e15 cells, but only three ids
+    SpatialHash grid;
+    grid.Reset(0.1f, 3);
+    grid.InsertPoint(4, { -9000.0, 0.0, 0.0 });
+    grid.InsertPoint(5, { 0.0, 0.0, 0.0 });
+    grid.InsertPoint(6, { 9000.0, 0.0, 0.0 });
+    grid.Build();
+
+    std::vector<uint32_t> found;
+    grid.QueryBounds({ -10000.0, -10000.0, -10000.0 }, { 10000.0, 10000.0, 10000.0 }, [&](uint32_t id) { found.push_back(id); });
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, (std::vector<uint32_t>{ 4, 5, 6 }));
+}
+
+// -----------------------------------------------------------------------------
+// Spatial Hash: Broadphase Completeness (must match brute force exactly)
+// -----------------------------------------------------------------------------
+TEST(SpatialHash, PairsMatchBruteForce) {
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> rad(0.2f, 1.0f);
+
+    std::vector<Sphere> spheres;
+    float maxRadius = 0.0f;
+    for (int i = 0; i < 600; ++i) {
+        spheres.emplace_back(glm::vec3(pos(gen), pos(gen), pos(gen)), rad(gen));
+        maxRadius = std::max(maxRadius, spheres.back().m_radius);
+    }
+
+    std::set<std::pair<uint32_t, uint32_t>> expected;
+    for (uint32_t i = 0; i < spheres.size(); ++i)
+        for (uint32_t j = i + 1; j < spheres.size(); ++j)
+            if (spheres[i].CollideWith(spheres[j])) expected.insert({ i, j });
+
+    SpatialHash grid;
+    grid.Reset(2.0f * maxRadius, spheres.size());
+    for (uint32_t i = 0; i < spheres.size(); ++i) grid.InsertPoint(i, spheres[i].Position());
+    grid.Build();
+
+    std::set<std::pair<uint32_t, uint32_t>> found;
+    int duplicates = 0;
+    for (uint32_t i = 0; i < spheres.size(); ++i) {
+        grid.QueryNeighbours(spheres[i].Position(), [&](uint32_t j) {
+            if (j <= i || !spheres[i].CollideWith(spheres[j])) return;
+            if (!found.insert({ i, j }).second) duplicates++;
+        });
+    }
+
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(duplicates, 0);
+}
@@ -0,0 +1,191 @@
+#include "pch.h"
+#include "SphFluid.h"
+#include "../src/core/JobSystem.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    auto Serial = [](size_t count, size_t, auto&& fn) { fn(size_t(0), count); };
+
+    auto Parallel = [](size_t count, size_t minBatch, auto&& fn) { JobSystem::Get().ParallelFor(count, minBatch, fn); };
+
+    // Open-topped box of four walls and a floor, centred on the origin at floor height 0
+    ParticleColliders MakeTank(float halfWidth) {
+        ParticleColliders tank;
+        tank.planes.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        tank.planes.emplace_back(glm::vec3(-halfWidth, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+        tank.planes.emplace_back(glm::vec3(halfWidth, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f));
+        tank.planes.emplace_back(glm::vec3(0.0f, 0.0f, -halfWidth), glm::vec3(0.0f, 0.0f, 1.0f));
+        tank.planes.emplace_back(glm::vec3(0.0f, 0.0f, halfWidth), glm::vec3(0.0f, 0.0f, -1.0f));
+        return tank;
+    }
+
+    template <typename ParallelFor>
+    void Simulate(SphFluid& fluid, const ParticleColliders& colliders, int steps, ParallelFor&& parallelFor) {
+        for (int i = 0; i < steps; ++i) fluid.Step(fluid.MaxTimeStep(), colliders, parallelFor);
+    }
+
+    bool AllFinite(const SphFluid& fluid) {
+        for (size_t i = 0; i < fluid.Size(); ++i) {
+            const glm::vec3 p = fluid.Position(i);
+            const glm::vec3 v = fluid.Velocity(i);
+            if (!std::isfinite(p.x + p.y + p.z + v.x + v.y + v.z)) return false;
+        }
+        return true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// SPH Fluid: Setup
+// -----------------------------------------------------------------------------
+TEST(SphFluid, BlockFillsTheRestLattice) {
+    SphFluid fluid;
+    const size_t added = fluid.AddBlock(glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(0.0f), 100000);
+    EXPECT_EQ(added, 10u * 10u * 10u);
+    EXPECT_NEAR(fluid.Position(0).x, -0.9f, 1e-5f);
+
+    // The cap stops the fill part way
+    EXPECT_EQ(fluid.AddBlock(glm::vec3(5.0f), glm::vec3(1.0f), glm::vec3(0.0f), 1500), 500u);
+    EXPECT_EQ(fluid.Size(), 1500u);
+}
+
+TEST(SphFluid, InteriorStartsAtRestDensity) {
+    SphFluid fluid;
+    fluid.AddBlock(glm::vec3(0.0f), glm::vec3(1.2f), glm::vec3(0.0f), 100000);
+    fluid.Step(1e-4f, Serial);
+
+    // Particles at least h inside the block see a full neighbourhood
+    const float inner = 1.2f - fluid.SmoothingRadius() - 0.1f;
+    int interior = 0;
+    for (size_t i = 0; i < fluid.Size(); ++i) {
+        const glm::vec3 p = fluid.Position(i);
+        if (std::max({ std::abs(p.x), std::abs(p.y), std::abs(p.z) }) > inner) continue;
+        EXPECT_NEAR(fluid.density[i], fluid.Settings().restDensity, 1.0f);
+        EXPECT_NEAR(fluid.pressure[i], 0.0f, 1e-2f * fluid.Settings().soundSpeed * fluid.Settings().soundSpeed);
+        ++interior;
+    }
+    EXPECT_GT(interior, 0);
+}
+
+// -----------------------------------------------------------------------------
+// SPH Fluid: Neighbour Grid
+// -----------------------------------------------------------------------------
+TEST(SphFluid, GridFindsEveryNeighbourPair) {
+    SphFluid fluid;
+    uint32_t seed = 12345u;
+    auto next = [&seed]() { seed = seed * 1664525u + 1013904223u; return static_cast<float>(seed >> 8) / 16777216.0f; };
+    for (int i = 0; i < 2000; ++i) fluid.AddParticle(glm::vec3(next() * 4.0f, next() * 2.0f, next() * 3.0f), glm::vec3(0.0f));
+
+    uint64_t brute = 0;
+    const float h2 = fluid.SmoothingRadius() * fluid.SmoothingRadius();
+    for (size_t i = 0; i < fluid.Size(); ++i) {
+        for (size_t j = 0; j < fluid.Size(); ++j) {
+            const glm::vec3 d = fluid.Position(i) - fluid.Position(j);
+            if (i != j && glm::dot(d, d) < h2) ++brute;
+        }
+    }
+
+    fluid.Step(1e-6f, Serial);
+    EXPECT_EQ(fluid.LastNeighbourCount(), brute);
+}
+
+TEST(SphFluid, SparseFluidCoarsensTheGrid) {
+    SphFluid fluid;
+    fluid.AddParticle(glm::vec3(0.0f), glm::vec3(0.0f));
+    fluid.AddParticle(glm::vec3(0.1f, 0.0f, 0.0f), glm::vec3(0.0f));
+    fluid.AddParticle(glm::vec3(1000.0f, 500.0f, -800.0f), glm::vec3(0.0f));
+    fluid.Step(1e-6f, Serial);
+
+    EXPECT_LE(fluid.LastCellCount(), 4096u * 1.1f);
+    EXPECT_EQ(fluid.LastNeighbourCount(), 2u);
+}
+
+// -----------------------------------------------------------------------------
+// SPH Fluid: Dynamics
+// -----------------------------------------------------------------------------
+TEST(SphFluid, DamBreakSettlesInsideTheTank) {
+    SphFluid fluid;
+    fluid.AddBlock(glm::vec3(-0.9f, 1.0f, 0.0f), glm::vec3(0.6f, 1.0f, 1.5f), glm::vec3(0.0f), 100000);
+    const ParticleColliders tank = MakeTank(1.5f);
+
+    Simulate(fluid, tank, 800, Parallel);
+    ASSERT_TRUE(AllFinite(fluid));
+
+    float top = 0.0f, meanDensity = 0.0f;
+    for (size_t i = 0; i < fluid.Size(); ++i) {
+        const glm::vec3 p = fluid.Position(i);
+        EXPECT_GE(p.y, 0.0f);
+        EXPECT_LE(std::abs(p.x), 1.5f);
+        EXPECT_LE(std::abs(p.z), 1.5f);
+        top = std::max(top, p.y);
+        meanDensity += fluid.density[i];
+    }
+    meanDensity /= static_cast<float>(fluid.Size());
+
+    // The column collapsed across the whole floor without being crushed
+    EXPECT_LT(top, 1.4f);
+    EXPECT_GT(meanDensity, 0.8f * fluid.Settings().restDensity);
+    EXPECT_LT(meanDensity, 1.1f * fluid.Settings().restDensity);
+}
+
+TEST(SphFluid, FlowsAroundSpheresAndOverTerrain) {
+    Heightfield ground;
+    ground.Build(4.0f, 16, [](float x, float z) { return 0.1f * x + 0.05f * z; });
+
+    ParticleColliders colliders;
+    colliders.spheres.push_back({ glm::vec3(0.0f, 1.0f, 0.0f), 0.6f, glm::vec3(0.0f) });
+    colliders.heightfields.push_back({ &ground, glm::vec3(0.0f), 0.0f });
+
+    SphFluid fluid;
+    fluid.AddBlock(glm::vec3(0.0f, 2.5f, 0.0f), glm::vec3(0.5f, 0.3f, 0.5f), glm::vec3(0.0f), 100000);
+    Simulate(fluid, colliders, 300, Serial);
+    ASSERT_TRUE(AllFinite(fluid));
+
+    const float radius = fluid.Settings().ParticleRadius();
+    for (size_t i = 0; i < fluid.Size(); ++i) {
+        const glm::vec3 p = fluid.Position(i);
+        EXPECT_GE(glm::length(p - colliders.spheres[0].center), colliders.spheres[0].radius + radius * 0.5f);
+        if (ground.Contains(p.x, p.z)) {
+            EXPECT_GE(p.y - ground.Height(p.x, p.z), radius * 0.5f);
+        }
+    }
+}
+
+TEST(SphFluid, ParallelStepMatchesSerial) {
+    SphFluid serial, parallel;
+    for (SphFluid* fluid : { &serial, &parallel }) fluid->AddBlock(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f), glm::vec3(0.5f, 0.0f, 0.0f), 100000);
+    const ParticleColliders tank = MakeTank(1.2f);
+
+    Simulate(serial, tank, 20, Serial);
+    Simulate(parallel, tank, 20, Parallel);
+    ASSERT_EQ(serial.Size(), parallel.Size());
+    EXPECT_EQ(serial.posX, parallel.posX);
+    EXPECT_EQ(serial.velY, parallel.velY);
+    EXPECT_EQ(serial.LastNeighbourCount(), parallel.LastNeighbourCount());
+}
+
+TEST(SphFluid, RestoredStateStepsLikeTheOriginal) {
+    SphFluid original;
+    original.AddBlock(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(1.0f), glm::vec3(0.5f, 0.0f, 0.0f), 100000);
+    const ParticleColliders tank = MakeTank(1.2f);
+    Simulate(original, tank, 10, Serial);
+    const SphFluid::State state = original.SaveState();
+
+    // Restored into a fluid that has run with other particles and settings, whose grid and columns are stale
+    SphSettings other;
+    other.particleSpacing = 0.3f;
+    SphFluid restored;
+    restored.Configure(other);
+    restored.AddBlock(glm::vec3(3.0f), glm::vec3(0.5f), glm::vec3(0.0f), 100000);
+    Simulate(restored, tank, 5, Serial);
+    restored.RestoreState(state);
+    ASSERT_EQ(restored.Size(), original.Size());
+    EXPECT_FLOAT_EQ(restored.ParticleMass(), original.ParticleMass());
+
+    Simulate(original, tank, 10, Serial);
+    Simulate(restored, tank, 10, Serial);
+    EXPECT_EQ(restored.posX, original.posX);
+    EXPECT_EQ(restored.velY, original.velY);
+}
@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "SweptSphere.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include <glm/glm.hpp>
+
+// -----------------------------------------------------------------------------
+// Swept Sphere: Threshold
+// -----------------------------------------------------------------------------
+TEST(SweptSphere, OnlyFastBodiesNeedSweeping) {
+    EXPECT_FALSE(NeedsSweep(glm::vec3(0.2f, 0.0f, 0.0f), 0.5f, 0.5f));
+    EXPECT_TRUE(NeedsSweep(glm::vec3(0.0f, -0.3f, 0.0f), 0.5f, 0.5f));
+    EXPECT_FALSE(NeedsSweep(glm::vec3(0.0f), 0.5f, 0.0f));
+}
+
+// -----------------------------------------------------------------------------
+// Swept Sphere: Against Planes
+// -----------------------------------------------------------------------------
+TEST(SweptSphere, StepThroughPlaneIsCaught) {
+    // A single discrete test at either end of the step misses the floor entirely
+    const Plane floor(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const Sphere ball(glm::vec3(0.0f, 5.0f, 0.0f), 0.5f);
+    const glm::vec3 step(0.0f, -10.0f, 0.0f);
+    ASSERT_FALSE(floor.Intersects(Sphere(ball.Position() + step, 0.5f)));
+
+    float toi = -1.0f;
+    ASSERT_TRUE(SweepSpherePlane(ball, step, floor, toi));
+    EXPECT_NEAR(toi, 0.45f, 1e-6f);
+}
+
+TEST(SweptSphere, PlaneStopsSphereOnItsStartingSide) {
+    const Plane floor(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    float toi = -1.0f;
+    ASSERT_TRUE(SweepSpherePlane(Sphere(glm::vec3(0.0f, -5.0f, 0.0f), 0.5f), glm::vec3(0.0f, 10.0f, 0.0f), floor, toi));
+    EXPECT_NEAR(toi, 0.45f, 1e-6f);
+}
+
+TEST(SweptSphere, PlaneMissesLeaveToiAlone) {
+    const Plane floor(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    float toi = -1.0f;
+
+    // Falls short, moves away, or already touching at the start (left to the discrete pass)
+    EXPECT_FALSE(SweepSpherePlane(Sphere(glm::vec3(0.0f, 5.0f, 0.0f), 0.5f), glm::vec3(0.0f, -4.0f, 0.0f), floor, toi));
+    EXPECT_FALSE(SweepSpherePlane(Sphere(glm::vec3(0.0f, 5.0f, 0.0f), 0.5f), glm::vec3(0.0f, 4.0f, 0.0f), floor, toi));
+    EXPECT_FALSE(SweepSpherePlane(Sphere(glm::vec3(0.0f, 0.4f, 0.0f), 0.5f), glm::vec3(0.0f, -4.0f, 0.0f), floor, toi));
+    EXPECT_EQ(toi, -1.0f);
+}
+
+TEST(SweptSphere, FinitePlaneOnlyHitsInsideItsExtent) {
+    const Plane wall(glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), 2.0f);
+    float toi = -1.0f;
+
+    EXPECT_TRUE(SweepSpherePlane(Sphere(glm::vec3(0.0f, 1.0f, 0.0f), 0.5f), glm::vec3(20.0f, 0.0f, 0.0f), wall, toi));
+    EXPECT_NEAR(toi, 9.5f / 20.0f, 1e-6f);
+    EXPECT_FALSE(SweepSpherePlane(Sphere(glm::vec3(0.0f, 5.0f, 0.0f), 0.5f), glm::vec3(20.0f, 0.0f, 0.0f), wall, toi));
+}
+
+// -----------------------------------------------------------------------------
+// Swept Sphere: Against Spheres
+// -----------------------------------------------------------------------------
+TEST(SweptSphere, SphereAgainstStaticSphere) {
+    const Sphere target(glm::vec3(5.0f, 0.0f, 0.0f), 0.5f);
+    float toi = -1.0f;
+
+    ASSERT_TRUE(SweepSphereSphere(Sphere(glm::vec3(0.0f), 0.5f), glm::vec3(10.0f, 0.0f, 0.0f), target, glm::vec3(0.0f), toi));
+    EXPECT_NEAR(toi, 0.4f, 1e-6f);
+
+    // Passing 2 units to the side never comes within the 1 unit the radii add up to
+    EXPECT_FALSE(SweepSphereSphere(Sphere(glm::vec3(0.0f, 2.0f, 0.0f), 0.5f), glm::vec3(10.0f, 0.0f, 0.0f), target, glm::vec3(0.0f), toi));
+}
+
+TEST(SweptSphere, TwoMovingSpheresMeetEarlier) {
+    // Closing at 20 units per step with a 4 unit gap
+    float toi = -1.0f;
+    ASSERT_TRUE(SweepSphereSphere(Sphere(glm::vec3(0.0f), 0.5f), glm::vec3(10.0f, 0.0f, 0.0f),
+        Sphere(glm::vec3(5.0f, 0.0f, 0.0f), 0.5f), glm::vec3(-10.0f, 0.0f, 0.0f), toi));
+    EXPECT_NEAR(toi, 0.2f, 1e-6f);
+
+    // Same speed in the same direction: the gap never closes
+    EXPECT_FALSE(SweepSphereSphere(Sphere(glm::vec3(0.0f), 0.5f), glm::vec3(10.0f, 0.0f, 0.0f),
+        Sphere(glm::vec3(5.0f, 0.0f, 0.0f), 0.5f), glm::vec3(10.0f, 0.0f, 0.0f), toi));
+}
+
+TEST(SweptSphere, OverlappingOrSeparatingSpheresAreLeftAlone) {
+    float toi = -1.0f;
+    EXPECT_FALSE(SweepSphereSphere(Sphere(glm::vec3(0.0f), 0.5f), glm::vec3(10.0f, 0.0f, 0.0f),
+        Sphere(glm::vec3(0.8f, 0.0f, 0.0f), 0.5f), glm::vec3(0.0f), toi));
+    EXPECT_FALSE(SweepSphereSphere(Sphere(glm::vec3(0.0f), 0.5f), glm::vec3(-10.0f, 0.0f, 0.0f),
+        Sphere(glm::vec3(5.0f, 0.0f, 0.0f), 0.5f), glm::vec3(0.0f), toi));
+    EXPECT_EQ(toi, -1.0f);
+}
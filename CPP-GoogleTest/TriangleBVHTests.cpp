@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "TriangleBVH.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/noise.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    struct Mesh {
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    // Bumpy n x n quad grid over [-half, half] in X and Z: 2n^2 triangles
+    Mesh MakeGrid(int n, float half) {
+        Mesh mesh;
+        for (int z = 0; z <= n; ++z) {
+            for (int x = 0; x <= n; ++x) {
+                const float px = -half + 2.0f * half * x / n;
+                const float pz = -half + 2.0f * half * z / n;
+                mesh.positions.emplace_back(px, 2.0f * glm::perlin(glm::vec2(px, pz) * 0.2f), pz);
+            }
+        }
+        for (int z = 0; z < n; ++z) {
+            for (int x = 0; x < n; ++x) {
+                const uint32_t i = z * (n + 1) + x;
+                mesh.indices.insert(mesh.indices.end(), { i, i + n + 1, i + 1, i + 1, i + n + 1, i + n + 2 });
+            }
+        }
+        return mesh;
+    }
+
+    TriangleBVH Build(const Mesh& mesh) {
+        TriangleBVH bvh;
+        bvh.Build(mesh.positions.data(), mesh.positions.size(), mesh.indices.data(), mesh.indices.size());
+        return bvh;
+    }
+
+    float BruteClosest(const Mesh& mesh, const glm::vec3& p) {
+        float best = std::numeric_limits<float>::max();
+        for (size_t t = 0; t < mesh.indices.size(); t += 3) {
+            const glm::vec3 q = ClosestPointOnTriangle(p, mesh.positions[mesh.indices[t]], mesh.positions[mesh.indices[t + 1]], mesh.positions[mesh.indices[t + 2]]);
+            best = std::min(best, glm::length(p - q));
+        }
+        return best;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Triangle BVH: Build
+// -----------------------------------------------------------------------------
+TEST(TriangleBVH, EmptyMeshAnswersNothing) {
+    TriangleBVH bvh;
+    bvh.Build(nullptr, 0, nullptr, 0);
+    EXPECT_TRUE(bvh.Empty());
+
+    TriangleBVH::RayHit hit;
+    TriangleBVH::SurfacePoint point;
+    EXPECT_FALSE(bvh.Raycast(glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f, hit));
+    EXPECT_FALSE(bvh.ClosestPoint(glm::vec3(0.0f), 100.0f, point));
+}
+
+TEST(TriangleBVH, KeepsEveryTriangleInShallowTree) {
+    const Mesh mesh = MakeGrid(64, 32.0f);
+    const TriangleBVH bvh = Build(mesh);
+    EXPECT_EQ(bvh.TriangleCount(), 64u * 64u * 2u);
+    EXPECT_LT(bvh.NodeCount(), 2 * bvh.TriangleCount());
+    EXPECT_LE(bvh.Depth(), 24);
+    EXPECT_FLOAT_EQ(bvh.BoundsMin().x, -32.0f);
+    EXPECT_FLOAT_EQ(bvh.BoundsMax().z, 32.0f);
+}
+
+TEST(TriangleBVH, NonIndexedAndBadIndices) {
+    const glm::vec3 positions[] = { glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 0, 1) };
+    TriangleBVH bvh;
+    bvh.Build(positions, 3, nullptr, 0);
+    EXPECT_EQ(bvh.TriangleCount(), 1u);
+
+    const uint32_t indices[] = { 0, 1, 2, 0, 1, 7 };
+    bvh.Build(positions, 3, indices, 6);
+    EXPECT_EQ(bvh.TriangleCount(), 1u);
+}
+
+// -----------------------------------------------------------------------------
+// Triangle BVH: Queries
+// -----------------------------------------------------------------------------
+TEST(TriangleBVH, ClosestPointOnTriangleRegions) {
+    const glm::vec3 a(0, 0, 0), b(2, 0, 0), c(0, 0, 2);
+    EXPECT_EQ(ClosestPointOnTriangle(glm::vec3(0.5f, 3.0f, 0.5f), a, b, c), glm::vec3(0.5f, 0.0f, 0.5f));
+    EXPECT_EQ(ClosestPointOnTriangle(glm::vec3(-1.0f, 0.0f, -1.0f), a, b, c), a);
+    EXPECT_EQ(ClosestPointOnTriangle(glm::vec3(1.0f, 0.0f, -5.0f), a, b, c), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(ClosestPointOnTriangle(glm::vec3(2.0f, 0.0f, 2.0f), a, b, c), glm::vec3(1.0f, 0.0f, 1.0f));
+}
+
+TEST(TriangleBVH, RaycastMatchesSurface) {
+    const Mesh mesh = MakeGrid(40, 20.0f);
+    const TriangleBVH bvh = Build(mesh);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dist(-19.0f, 19.0f);
+    for (int i = 0; i < 200; ++i) {
+        const glm::vec3 origin(dist(gen), 10.0f, dist(gen));
+        TriangleBVH::RayHit hit;
+        ASSERT_TRUE(bvh.Raycast(origin, glm::vec3(0.0f, -2.0f, 0.0f), 100.0f, hit));
+
+        // Straight down onto the surface: the hit point is on the mesh, at distance zero
+        const glm::vec3 p = origin + glm::vec3(0.0f, -2.0f, 0.0f) * hit.t;
+        EXPECT_LT(BruteClosest(mesh, p), 1e-3f);
+        EXPECT_GT(hit.normal.y, 0.0f);
+    }
+
+    // From below, the grid is all back faces
+    TriangleBVH::RayHit hit;
+    EXPECT_TRUE(bvh.Raycast(glm::vec3(0.5f, -10.0f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f), 100.0f, hit));
+    EXPECT_FALSE(bvh.Raycast(glm::vec3(0.5f, -10.0f, 0.5f), glm::vec3(0.0f, 1.0f, 0.0f), 100.0f, hit, true));
+    EXPECT_TRUE(bvh.Raycast(glm::vec3(0.5f, 10.0f, 0.5f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f, hit, true));
+
+    // Too short, pointing away, or beside the mesh
+    EXPECT_FALSE(bvh.Raycast(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 3.0f, hit));
+    EXPECT_FALSE(bvh.Raycast(glm::vec3(0.0f, 10.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 100.0f, hit));
+    EXPECT_FALSE(bvh.Raycast(glm::vec3(30.0f, 10.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), 100.0f, hit));
+}
+
+TEST(TriangleBVH, ClosestPointMatchesBruteForce) {
+    const Mesh mesh = MakeGrid(24, 12.0f);
+    const TriangleBVH bvh = Build(mesh);
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-15.0f, 15.0f);
+    for (int i = 0; i < 200; ++i) {
+        const glm::vec3 p(dist(gen), dist(gen) * 0.3f, dist(gen));
+        TriangleBVH::SurfacePoint point;
+        ASSERT_TRUE(bvh.ClosestPoint(p, std::numeric_limits<float>::max(), point));
+        EXPECT_NEAR(point.distance, BruteClosest(mesh, p), 1e-4f);
+        EXPECT_NEAR(glm::length(p - point.point), point.distance, 1e-4f);
+    }
+
+    TriangleBVH::SurfacePoint point;
+    EXPECT_FALSE(bvh.ClosestPoint(glm::vec3(0.0f, 50.0f, 0.0f), 1.0f, point));
+}
+
+TEST(TriangleBVH, SphereQueryFindsTouchingTriangles) {
+    const Mesh mesh = MakeGrid(24, 12.0f);
+    const TriangleBVH bvh = Build(mesh);
+    const glm::vec3 center(1.3f, 0.5f, -2.2f);
+    const float radius = 1.5f;
+
+    std::vector<uint32_t> found;
+    bvh.QuerySphere(center, radius, [&](const TriangleBVH::SurfacePoint& p) {
+        EXPECT_LE(p.distance, radius);
+        found.push_back(p.triangle);
+    });
+
+    std::vector<uint32_t> expected;
+    for (size_t t = 0; t < mesh.indices.size(); t += 3) {
+        const glm::vec3 q = ClosestPointOnTriangle(center, mesh.positions[mesh.indices[t]], mesh.positions[mesh.indices[t + 1]], mesh.positions[mesh.indices[t + 2]]);
+        if (glm::length(center - q) <= radius) expected.push_back(static_cast<uint32_t>(t / 3));
+    }
+    std::sort(found.begin(), found.end());
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(found, expected);
+}
@@ -0,0 +1,78 @@
+#include "pch.h"
+#include "../src/core/TripleBuffer.h"
+#include <atomic>
+#include <thread>
+
+// -----------------------------------------------------------------------------
+// Triple Buffer: latest-value hand-off between the physics and main threads
+// -----------------------------------------------------------------------------
+TEST(TripleBuffer, NothingToConsumeUntilPublished) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.Consume());
+
+    buffer.WriteBuffer() = 7;
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Consume());
+    EXPECT_EQ(buffer.ReadBuffer(), 7);
+
+    // Consuming again without a new publish keeps the current value
+    EXPECT_FALSE(buffer.Consume());
+    EXPECT_EQ(buffer.ReadBuffer(), 7);
+}
+
+TEST(TripleBuffer, ConsumerSeesOnlyTheNewestValue) {
+    TripleBuffer<int> buffer;
+    for (int i = 1; i <= 5; ++i) {
+        buffer.WriteBuffer() = i;
+        buffer.Publish();
+    }
+
+    EXPECT_TRUE(buffer.Consume());
+    EXPECT_EQ(buffer.ReadBuffer(), 5);
+}
+
+TEST(TripleBuffer, ProducerNeverWritesTheSlotBeingRead) {
+    TripleBuffer<int> buffer;
+    buffer.WriteBuffer() = 1;
+    buffer.Publish();
+    ASSERT_TRUE(buffer.Consume());
+    const int* reading = &buffer.ReadBuffer();
+
+    // However often the producer publishes, the slot held by the consumer is left alone
+    for (int i = 2; i < 10; ++i) {
+        EXPECT_NE(&buffer.WriteBuffer(), reading);
+        buffer.WriteBuffer() = i;
+        buffer.Publish();
+    }
+    EXPECT_EQ(*reading, 1);
+}
+
+TEST(TripleBuffer, ConcurrentValuesArriveWholeAndInOrder) {
+    // Each value is an array filled with one number, so a torn read would show mixed entries
+    struct Payload { int values[64]; };
+    TripleBuffer<Payload> buffer;
+    const int publishCount = 20000;
+
+    std::thread producer([&]() {
+        for (int n = 1; n <= publishCount; ++n) {
+            Payload& out = buffer.WriteBuffer();
+            for (int& v : out.values) v = n;
+            buffer.Publish();
+        }
+    });
+
+    int last = 0;
+    bool torn = false;
+    bool backwards = false;
+    while (last < publishCount) {
+        if (!buffer.Consume()) continue;
+        const Payload& in = buffer.ReadBuffer();
+        for (int v : in.values) torn |= (v != in.values[0]);
+        backwards |= (in.values[0] <= last);
+        last = in.values[0];
+    }
+    producer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_FALSE(backwards);
+}
@@ -0,0 +1,249 @@
+#include "pch.h"
+#include "XpbdBody.h"
+#include "../src/core/JobSystem.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    auto Serial = [](size_t count, size_t, auto&& fn) { fn(size_t(0), count); };
+
+    auto Parallel = [](size_t count, size_t minBatch, auto&& fn) { JobSystem::Get().ParallelFor(count, minBatch, fn); };
+
+    struct Mesh {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<uint32_t> indices;
+    };
+
+    // Vertical sheet of side x side vertices in the XY plane, top edge at topY, facing +Z.
+    // Double-sided sheets repeat every vertex with a flipped normal and reversed winding.
+    Mesh MakeSheet(int side, float spacing, float topY, bool doubleSided = false) {
+        Mesh mesh;
+        const float half = 0.5f * spacing * (side - 1);
+        for (int row = 0; row < side; ++row) {
+            for (int col = 0; col < side; ++col) {
+                mesh.positions.emplace_back(col * spacing - half, topY - row * spacing, 0.0f);
+                mesh.normals.emplace_back(0.0f, 0.0f, 1.0f);
+            }
+        }
+        for (int row = 0; row + 1 < side; ++row) {
+            for (int col = 0; col + 1 < side; ++col) {
+                const uint32_t a = row * side + col, b = a + 1, c = a + side, d = c + 1;
+                mesh.indices.insert(mesh.indices.end(), { a, c, b, b, c, d });
+            }
+        }
+        if (doubleSided) {
+            const uint32_t count = static_cast<uint32_t>(mesh.positions.size());
+            const size_t frontIndices = mesh.indices.size();
+            for (uint32_t i = 0; i < count; ++i) {
+                mesh.positions.push_back(mesh.positions[i]);
+                mesh.normals.push_back(-mesh.normals[i]);
+            }
+            for (size_t i = 0; i < frontIndices; i += 3) {
+                mesh.indices.insert(mesh.indices.end(), { mesh.indices[i] + count, mesh.indices[i + 2] + count, mesh.indices[i + 1] + count });
+            }
+        }
+        return mesh;
+    }
+
+    // UV sphere with a seam column and a ring of vertices at each pole, like GeometryGenerator::CreateSphere
+    Mesh MakeSphere(int stacks, int slices, float radius, const glm::vec3& center) {
+        Mesh mesh;
+        for (int i = 0; i <= stacks; ++i) {
+            const float phi = 3.14159265f * i / stacks;
+            for (int j = 0; j <= slices; ++j) {
+                const float theta = 2.0f * 3.14159265f * j / slices;
+                const glm::vec3 n(std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta));
+                mesh.positions.push_back(center + n * radius);
+                mesh.normals.push_back(n);
+            }
+        }
+        for (int i = 0; i < stacks; ++i) {
+            for (int j = 0; j < slices; ++j) {
+                const uint32_t a = i * (slices + 1) + j, b = a + slices + 1;
+                mesh.indices.insert(mesh.indices.end(), { a, a + 1, b, b, a + 1, b + 1 });
+            }
+        }
+        return mesh;
+    }
+
+    void Build(XpbdBody& body, const Mesh& mesh, float mass, bool preserveVolume = false) {
+        body.Build(mesh.positions.data(), mesh.normals.data(), mesh.positions.size(), mesh.indices.data(), mesh.indices.size(), mass, preserveVolume);
+    }
+
+    void PinTopRow(XpbdBody& body, int side) {
+        for (int col = 0; col < side; ++col) body.Pin(body.ParticleOf(col));
+    }
+
+    template <typename ParallelFor>
+    void Simulate(XpbdBody& body, const ParticleColliders& colliders, int frames, ParallelFor&& parallelFor) {
+        for (int i = 0; i < frames; ++i) body.Step(1.0f / 60.0f, colliders, parallelFor);
+    }
+
+    bool AllFinite(const XpbdBody& body) {
+        for (size_t i = 0; i < body.ParticleCount(); ++i) {
+            const glm::vec3 p = body.Position(i);
+            const glm::vec3 v = body.Velocity(i);
+            if (!std::isfinite(p.x + p.y + p.z + v.x + v.y + v.z)) return false;
+        }
+        return true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// XPBD Body: Build
+// -----------------------------------------------------------------------------
+TEST(XpbdBody, SheetGetsStretchAndBendingConstraints) {
+    XpbdBody body;
+    Build(body, MakeSheet(4, 0.1f, 1.0f), 1.0f);
+
+    EXPECT_EQ(body.ParticleCount(), 16u);
+    EXPECT_EQ(body.TriangleCount(), 18u);
+    // 12 horizontal, 12 vertical and 9 diagonal edges; every interior edge joins two triangles
+    EXPECT_EQ(body.StretchCount(), 33u);
+    EXPECT_EQ(body.BendCount(), 33u - 12u);
+    EXPECT_GT(body.BatchCount(), 0u);
+}
+
+TEST(XpbdBody, DoubleSidedSheetSharesParticles) {
+    XpbdBody body;
+    Build(body, MakeSheet(5, 0.1f, 1.0f, true), 1.0f);
+
+    EXPECT_EQ(body.VertexCount(), 50u);
+    EXPECT_EQ(body.ParticleCount(), 25u);
+    EXPECT_EQ(body.TriangleCount(), 32u);
+    for (size_t v = 0; v < 25; ++v) {
+        EXPECT_EQ(body.ParticleOf(v), body.ParticleOf(v + 25));
+        EXPECT_NEAR(body.VertexNormal(v).z, 1.0f, 1e-5f);
+        EXPECT_NEAR(body.VertexNormal(v + 25).z, -1.0f, 1e-5f);
+    }
+}
+
+TEST(XpbdBody, SphereSeamsAndPolesWeldIntoAClosedSurface) {
+    XpbdBody body;
+    const Mesh sphere = MakeSphere(12, 24, 0.5f, glm::vec3(3.0f, 1.0f, -2.0f));
+    Build(body, sphere, 1.0f, true);
+
+    // Seam column and pole rings collapse: 11 rings of 24 plus the two poles
+    EXPECT_EQ(body.ParticleCount(), 11u * 24u + 2u);
+    EXPECT_NEAR(body.RestVolume(), 4.0f / 3.0f * 3.14159265f * 0.125f, 0.03f);
+    for (size_t v = 0; v < body.VertexCount(); ++v) {
+        EXPECT_GT(glm::dot(body.VertexNormal(v), sphere.normals[v]), 0.9f);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// XPBD Body: Dynamics
+// -----------------------------------------------------------------------------
+TEST(XpbdBody, PinnedBannerHangsWithoutStretching) {
+    constexpr int SIDE = 20;
+    constexpr float SPACING = 0.05f;
+    XpbdBody body;
+    Build(body, MakeSheet(SIDE, SPACING, 2.0f), 0.5f);
+    PinTopRow(body, SIDE);
+
+    // A wind-like pull out of the sheet's plane loads the columns at an angle; heavy damping settles the swing
+    XpbdSettings settings;
+    settings.gravity = glm::vec3(0.0f, -9.81f, 4.0f);
+    settings.damping = 3.0f;
+    body.Configure(settings);
+    Simulate(body, ParticleColliders{}, 180, Serial);
+    ASSERT_TRUE(AllFinite(body));
+
+    for (int col = 0; col < SIDE; ++col) EXPECT_EQ(body.Position(body.ParticleOf(col)).y, 2.0f);
+
+    // Column lengths stay within a couple of percent of the rest length
+    const float rest = SPACING * (SIDE - 1);
+    for (int col = 0; col < SIDE; ++col) {
+        float length = 0.0f;
+        for (int row = 0; row + 1 < SIDE; ++row) {
+            length += glm::length(body.Position(body.ParticleOf((row + 1) * SIDE + col)) - body.Position(body.ParticleOf(row * SIDE + col)));
+        }
+        EXPECT_LT(length, rest * 1.02f);
+    }
+
+    // The free edge hangs along the pull, about 22 degrees off vertical
+    const glm::vec3 bottom = body.Position(body.ParticleOf((SIDE - 1) * SIDE + SIDE / 2));
+    EXPECT_NEAR(bottom.z, rest * 0.38f, 0.1f);
+    EXPECT_LT(bottom.y, 2.0f - 0.8f * rest);
+
+    // Releasing the pins lets it fall
+    body.ReleaseAll();
+    const float before = body.Position(body.ParticleOf(0)).y;
+    Simulate(body, ParticleColliders{}, 10, Serial);
+    EXPECT_LT(body.Position(body.ParticleOf(0)).y, before);
+}
+
+TEST(XpbdBody, ClothDrapesOverASphereOntoTheFloor) {
+    constexpr int SIDE = 24;
+    XpbdBody body;
+    Mesh sheet = MakeSheet(SIDE, 0.1f, 0.0f);
+    for (glm::vec3& p : sheet.positions) p = glm::vec3(p.x, 1.5f, p.y + 1.15f); // Lay it flat above the ball
+    Build(body, sheet, 1.0f);
+
+    ParticleColliders colliders;
+    colliders.planes.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    colliders.spheres.push_back({ glm::vec3(0.0f, 0.6f, 0.0f), 0.6f, glm::vec3(0.0f) });
+    Simulate(body, colliders, 180, Serial);
+    ASSERT_TRUE(AllFinite(body));
+
+    const float thickness = body.Settings().thickness;
+    float top = 0.0f;
+    for (size_t i = 0; i < body.ParticleCount(); ++i) {
+        const glm::vec3 p = body.Position(i);
+        EXPECT_GE(p.y, thickness * 0.5f);
+        EXPECT_GE(glm::length(p - colliders.spheres[0].center), 0.6f + thickness * 0.5f);
+        top = std::max(top, p.y);
+    }
+    // Held up by the ball, not lying flat on the floor or floating where it started
+    EXPECT_GT(top, 1.1f);
+    EXPECT_LT(top, 1.3f);
+}
+
+TEST(XpbdBody, SoftBallKeepsItsVolumeOnTheFloor) {
+    XpbdBody body;
+    Build(body, MakeSphere(12, 24, 0.5f, glm::vec3(0.0f, 1.5f, 0.0f)), 1.0f, true);
+    XpbdSettings settings;
+    settings.bendCompliance = 1.0f;
+    body.Configure(settings);
+
+    ParticleColliders floor;
+    floor.planes.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Simulate(body, floor, 240, Serial);
+    ASSERT_TRUE(AllFinite(body));
+
+    EXPECT_NEAR(body.Volume(), body.RestVolume(), 0.05f * body.RestVolume());
+    glm::vec3 lo, hi;
+    body.Bounds(lo, hi);
+    EXPECT_GE(lo.y, 0.0f);
+    EXPECT_LT(lo.y, 0.05f); // Resting on the floor rather than bouncing
+    EXPECT_GT(hi.y, 0.7f);  // Still a ball, not a puddle
+
+    // Inflating raises the pressure towards the new target volume
+    settings.pressure = 1.3f;
+    body.Configure(settings);
+    Simulate(body, floor, 60, Serial);
+    EXPECT_NEAR(body.Volume(), 1.3f * body.RestVolume(), 0.05f * body.RestVolume());
+}
+
+TEST(XpbdBody, ParallelStepMatchesSerial) {
+    constexpr int SIDE = 64;
+    XpbdBody serial, parallel;
+    for (XpbdBody* body : { &serial, &parallel }) {
+        Build(*body, MakeSheet(SIDE, 0.05f, 3.0f, true), 1.0f);
+        PinTopRow(*body, SIDE);
+    }
+    ParticleColliders colliders;
+    colliders.spheres.push_back({ glm::vec3(0.3f, 2.0f, 0.1f), 0.5f, glm::vec3(0.0f) });
+
+    Simulate(serial, colliders, 20, Serial);
+    Simulate(parallel, colliders, 20, Parallel);
+    for (size_t i = 0; i < serial.ParticleCount(); ++i) {
+        ASSERT_EQ(serial.Position(i), parallel.Position(i));
+    }
+    for (size_t v = 0; v < serial.VertexCount(); ++v) {
+        ASSERT_EQ(serial.VertexNormal(v), parallel.VertexNormal(v));
+    }
+}
@@ -0,0 +1,190 @@
+#include "BenchmarkScene.h"
+#include "../src/core/Components.h"
+#include "../src/core/Config.h"
+#include "../src/geometry/GeometryGenerator.h"
+#include "../src/systems/PhysicsSystem.h"
+#include "../SimulationStaticLib/Heightfield.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    // Same as PhysicsSystem and Scene::AddTerrain
+    constexpr float GRAVITY = 9.81f;
+    constexpr int TERRAIN_HEIGHTFIELD_RESOLUTION = 512;
+
+    constexpr float SPHERE_RADIUS = 0.5f;
+    constexpr float LATTICE_SPACING = 1.5f; // Centre to centre, so a gas fills about 15% of its box
+}
+
+BenchmarkScene::BenchmarkScene() {
+    m_Registry.RegisterComponent<TransformComponent>();
+    m_Registry.RegisterComponent<PhysicsComponent>();
+    m_Registry.RegisterComponent<ColliderComponent>();
+}
+
+Entity BenchmarkScene::AddBody(const glm::vec3& position, bool isStatic, float mass, int colliderType, float radius) {
+    const Entity e = m_Registry.CreateEntity();
+
+    TransformComponent transform;
+    transform.position = position;
+    transform.UpdateMatrix();
+    m_Registry.AddComponent(e, transform);
+
+    PhysicsComponent physics;
+    physics.isStatic = isStatic;
+    physics.SetMass(isStatic ? 0.0f : mass);
+    m_Registry.AddComponent(e, physics);
+
+    ColliderComponent collider;
+    collider.type = colliderType;
+    collider.radius = radius;
+    m_Registry.AddComponent(e, collider);
+
+    ++(isStatic ? m_Info.staticBodies : m_Info.dynamicBodies);
+    return e;
+}
+
+void BenchmarkScene::AddWall(const glm::vec3& position, const glm::vec3& normal) {
+    const Entity e = AddBody(position, true, 0.0f, 1, 0.0f); // Radius 0 = infinite plane
+    m_Registry.GetComponent<ColliderComponent>(e).normal = normal;
+}
+
+bool BenchmarkScene::LoadWorld(const std::string& path) {
+    const AppConfig config = ConfigLoader::Load(path);
+    if (config.sceneObjects.empty()) return false;
+
+    // As Application::LoadScene: every object is a body, with the collider its config asks for
+    for (const SceneObjectConfig& object : config.sceneObjects) {
+        const Entity e = AddBody(object.position, object.isStatic, 1.0f, object.colliderType, object.colliderRadius);
+
+        auto& transform = m_Registry.GetComponent<TransformComponent>(e);
+        transform.rotation = object.rotation;
+        transform.scale = object.scale;
+        transform.UpdateMatrix();
+
+        auto& collider = m_Registry.GetComponent<ColliderComponent>(e);
+        collider.hasCollision = object.hasCollision;
+        collider.normal = glm::normalize(object.colliderNormal);
+
+        if (object.type == "Terrain") {
+            // Params: x=Radius, y=HeightScale, z=NoiseFreq, baked like Scene::AddTerrain
+            const float radius = object.params.x;
+            const float heightScale = object.params.y;
+            const float noiseFreq = object.params.z;
+            auto heightfield = std::make_shared<Heightfield>();
+            heightfield->Build(radius, TERRAIN_HEIGHTFIELD_RESOLUTION, [&](float x, float z) {
+                return GeometryGenerator::GetTerrainHeight(x, z, radius, heightScale, noiseFreq);
+            });
+            collider.type = 2;
+            collider.radius = radius - 1.0f;
+            collider.heightfield = heightfield;
+        }
+        else if (collider.type == 3) {
+            collider.hasCollision = false;
+            ++m_Info.skippedColliders;
+        }
+    }
+    return true;
+}
+
+void BenchmarkScene::AddSpheres(SyntheticLayout layout, size_t count, uint32_t seed) {
+    if (count == 0) return;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    if (layout == SyntheticLayout::Cluster) {
+        // As Scene::SpawnGravityCluster, with the disk grown so the surface density stays the same
+        const float bodyRadius = 0.2f;
+        const float bodyMass = 1.0f;
+        const float coreMass = 2.5f * static_cast<float>(count);
+        const float radius = 30.0f * std::sqrt(static_cast<float>(count) / 2000.0f);
+        AddBody(glm::vec3(0.0f), false, coreMass, 0, 1.5f);
+
+        std::vector<float> radii(count);
+        for (float& r : radii) r = radius * std::sqrt(0.0625f + 0.9375f * unit(rng));
+        std::sort(radii.begin(), radii.end());
+
+        for (size_t i = 0; i < count; ++i) {
+            const float angle = unit(rng) * glm::two_pi<float>();
+            const glm::vec3 radial(std::cos(angle), 0.0f, std::sin(angle));
+            const glm::vec3 offset = radial * radii[i] + glm::vec3(0.0f, (unit(rng) - 0.5f) * radius * 0.02f, 0.0f);
+            const float enclosed = coreMass + bodyMass * static_cast<float>(i);
+            const float speed = std::sqrt(PhysicsSystem::gravitySettings.G * enclosed / radii[i]);
+
+            const Entity e = AddBody(offset, false, bodyMass, 0, bodyRadius);
+            auto& physics = m_Registry.GetComponent<PhysicsComponent>(e);
+            physics.velocity = glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), radial) * speed;
+            physics.restitution = 0.3f;
+        }
+        return;
+    }
+
+    // A cube of lattice sites with a little jitter, so no column lines up exactly
+    const size_t side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(count))));
+    const float halfExtent = 0.5f * static_cast<float>(side) * LATTICE_SPACING + SPHERE_RADIUS;
+    const float jitter = 0.5f * (LATTICE_SPACING - 2.0f * SPHERE_RADIUS);
+    const float floorY = (layout == SyntheticLayout::Pile) ? 0.0f : -halfExtent;
+
+    for (size_t i = 0; i < count; ++i) {
+        const size_t x = i % side;
+        const size_t y = i / (side * side);
+        const size_t z = (i / side) % side;
+        const glm::vec3 site(
+            (static_cast<float>(x) + 0.5f) * LATTICE_SPACING - halfExtent + SPHERE_RADIUS,
+            floorY + (static_cast<float>(y) + 0.5f) * LATTICE_SPACING + SPHERE_RADIUS,
+            (static_cast<float>(z) + 0.5f) * LATTICE_SPACING - halfExtent + SPHERE_RADIUS);
+        const glm::vec3 offset = (glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f - 1.0f) * jitter;
+
+        const Entity e = AddBody(site + offset, false, 1.0f, 0, SPHERE_RADIUS);
+        auto& physics = m_Registry.GetComponent<PhysicsComponent>(e);
+        if (layout == SyntheticLayout::Gas) {
+            physics.velocity = (glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f - 1.0f) * 4.0f;
+            physics.restitution = 1.0f;
+        }
+        else {
+            physics.restitution = 0.5f;
+        }
+    }
+
+    // The box: a floor and four walls, plus a lid for the gas
+    const float top = floorY + 2.0f * halfExtent;
+    AddWall(glm::vec3(0.0f, floorY, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    AddWall(glm::vec3(-halfExtent, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    AddWall(glm::vec3(halfExtent, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f));
+    AddWall(glm::vec3(0.0f, 0.0f, -halfExtent), glm::vec3(0.0f, 0.0f, 1.0f));
+    AddWall(glm::vec3(0.0f, 0.0f, halfExtent), glm::vec3(0.0f, 0.0f, -1.0f));
+    if (layout == SyntheticLayout::Gas) AddWall(glm::vec3(0.0f, top, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+}
+
+double BenchmarkScene::TotalEnergy() {
+    std::vector<glm::vec3> positions;
+    std::vector<float> masses;
+    double kinetic = 0.0;
+    double potential = 0.0;
+    const bool uniformGravity = PhysicsSystem::applyGravity && !PhysicsSystem::mutualGravity;
+
+    m_Registry.Each<TransformComponent, PhysicsComponent>([&](Entity, TransformComponent& transform, PhysicsComponent& physics) {
+        if (physics.isStatic || physics.inverseMass <= 0.0f) return;
+        kinetic += 0.5 * physics.mass * glm::dot(physics.velocity, physics.velocity);
+        if (uniformGravity) potential += static_cast<double>(physics.mass) * GRAVITY * transform.position.y;
+        positions.push_back(transform.position);
+        masses.push_back(physics.mass);
+    });
+
+    if (PhysicsSystem::mutualGravity) {
+        // Softened like BarnesHutTree's pull: -G m1 m2 / sqrt(r^2 + softening^2)
+        if (positions.size() > MAX_PAIRWISE_ENERGY_BODIES) return std::numeric_limits<double>::quiet_NaN();
+        const GravitySettings& settings = PhysicsSystem::gravitySettings;
+        const double eps2 = static_cast<double>(settings.softening) * settings.softening;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            for (size_t j = i + 1; j < positions.size(); ++j) {
+                const glm::vec3 d = positions[j] - positions[i];
+                potential -= settings.G * static_cast<double>(masses[i]) * masses[j] / std::sqrt(glm::dot(d, d) + eps2);
+            }
+        }
+    }
+    return kinetic + potential;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../src/core/ECS.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Synthetic body sets, each centred on the origin:
+//   Pile    - spheres on a jittered lattice dropping into a walled box under gravity
+//   Gas     - spheres with random velocities bouncing elastically in a closed box, no gravity; energy should hold
+//   Cluster - a heavy core with small bodies on circular orbits in a disk, under mutual gravity
+enum class SyntheticLayout { Pile, Gas, Cluster };
+
+struct BenchmarkSceneInfo {
+    size_t dynamicBodies = 0;
+    size_t staticBodies = 0;
+    size_t skippedColliders = 0; // Mesh colliders in the world file; they need the render geometry's BVH
+};
+
+// The registry a headless benchmark steps: only the Transform, Physics and Collider components PhysicsSystem
+// reads, built from a .world file the way Application does and/or synthesised. No geometry is created, so
+// nothing here needs a Vulkan device.
+class BenchmarkScene {
+public:
+    BenchmarkScene();
+
+    // Adds every object of the world file as a physics body. False when the file holds no objects.
+    bool LoadWorld(const std::string& path);
+    void AddSpheres(SyntheticLayout layout, size_t count, uint32_t seed);
+
+    // Kinetic plus potential energy of the dynamic bodies, under the gravity PhysicsSystem is set to apply.
+    // NaN under mutual gravity above MAX_PAIRWISE_ENERGY_BODIES, where the direct pair sum is too slow.
+    static constexpr size_t MAX_PAIRWISE_ENERGY_BODIES = 8192;
+    double TotalEnergy();
+
+    Registry& GetRegistry() { return m_Registry; }
+    const BenchmarkSceneInfo& GetInfo() const { return m_Info; }
+
+private:
+    Entity AddBody(const glm::vec3& position, bool isStatic, float mass, int colliderType, float radius);
+    void AddWall(const glm::vec3& position, const glm::vec3& normal);
+
+    Registry m_Registry;
+    BenchmarkSceneInfo m_Info;
+};
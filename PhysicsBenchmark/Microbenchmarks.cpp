@@ -0,0 +1,189 @@
+#include "Microbenchmarks.h"
+#include "../src/core/ECS.h"
+#include "../src/core/JobSystem.h"
+#include "../SimulationStaticLib/BodySoA.h"
+#include "../SimulationStaticLib/SphFluid.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <typeindex>
+#include <unordered_map>
+
+namespace {
+    struct Position {
+        float x = 0.0f;
+    };
+
+    // Pools found through a type_index map and handed out as shared_ptr copies on every call
+    class MapLookupRegistry {
+    public:
+        template <typename T>
+        std::shared_ptr<ComponentArray<T>> GetComponentArray() {
+            auto type = std::type_index(typeid(T));
+            if (componentArrays.find(type) == componentArrays.end()) {
+                componentArrays[type] = std::make_shared<ComponentArray<T>>();
+            }
+            return std::static_pointer_cast<ComponentArray<T>>(componentArrays[type]);
+        }
+
+    private:
+        std::unordered_map<std::type_index, std::shared_ptr<IComponentArray>> componentArrays;
+    };
+
+    // Mirrors the hot and cold fields of TransformComponent + PhysicsComponent
+    struct AoSBody {
+        glm::mat4 matrix = glm::mat4(1.0f);
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 rotation = glm::vec3(0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+        glm::vec3 velocity = glm::vec3(0.0f);
+        glm::vec3 forceAccumulator = glm::vec3(0.0f);
+        float mass = 1.0f;
+        float inverseMass = 1.0f;
+        bool isStatic = false;
+        float friction = 0.98f;
+        float restitution = 1.0f;
+    };
+
+    // Same steps as PhysicsSystem::Integrate with semi-implicit Euler, minus the matrix rebuild
+    void IntegrateAoS(std::vector<AoSBody>& bodies, float dt, const glm::vec3& gravity, float damping) {
+        for (auto& body : bodies) {
+            if (body.isStatic || body.inverseMass <= 0.0f) continue;
+
+            body.forceAccumulator += gravity * body.mass;
+            body.velocity += body.forceAccumulator * body.inverseMass * dt;
+            body.position += body.velocity * dt;
+
+            body.forceAccumulator = glm::vec3(0.0f);
+            body.velocity *= damping;
+        }
+    }
+
+    template <typename Fn>
+    double Nanoseconds(Fn&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+}
+
+LookupTiming TimeComponentLookups(size_t entities, int rounds) {
+    MapLookupRegistry mapRegistry;
+    Registry registry;
+    registry.RegisterComponent<Position>();
+    for (Entity e = 0; e < entities; ++e) {
+        mapRegistry.GetComponentArray<Position>()->InsertData(e, Position{ static_cast<float>(e % 7) });
+        const Entity created = registry.CreateEntity();
+        registry.AddComponent(created, Position{ static_cast<float>(e % 7) });
+    }
+
+    // Summed so neither loop can be optimised away, and compared to show both found the same components
+    double mapSum = 0.0;
+    const double mapNs = Nanoseconds([&]() {
+        for (int r = 0; r < rounds; ++r)
+            for (Entity e = 0; e < entities; ++e)
+                if (mapRegistry.GetComponentArray<Position>()->HasData(e))
+                    mapSum += mapRegistry.GetComponentArray<Position>()->GetData(e).x;
+    });
+
+    double familySum = 0.0;
+    const double familyNs = Nanoseconds([&]() {
+        for (int r = 0; r < rounds; ++r)
+            for (Entity e = 0; e < entities; ++e)
+                if (registry.HasComponent<Position>(e))
+                    familySum += registry.GetComponent<Position>(e).x;
+    });
+
+    LookupTiming timing;
+    timing.entities = entities;
+    timing.lookups = entities * static_cast<size_t>(rounds) * 2;
+    const double lookups = static_cast<double>(std::max<size_t>(timing.lookups, 1));
+    timing.mapNsPerLookup = mapNs / lookups;
+    timing.familyNsPerLookup = familyNs / lookups;
+    timing.resultsMatch = (mapSum == familySum);
+    return timing;
+}
+
+IntegrationTiming TimeBodyIntegration(size_t bodies, int steps) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> range(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> massRange(0.5f, 5.0f);
+
+    std::vector<AoSBody> aos(bodies);
+    BodySoA soa;
+    soa.Reserve(bodies);
+    for (auto& body : aos) {
+        body.position = glm::vec3(range(gen), range(gen), range(gen));
+        body.velocity = glm::vec3(range(gen), range(gen), range(gen));
+        body.mass = massRange(gen);
+        body.inverseMass = 1.0f / body.mass;
+        soa.Add(body.position, body.velocity, glm::vec3(0.0f), body.inverseMass);
+    }
+
+    const float dt = 1.0f / 240.0f;
+    const glm::vec3 gravity(0.0f, -9.81f, 0.0f);
+    const float damping = std::pow(0.999f, dt * 60.0f);
+    const double aosNs = Nanoseconds([&]() {
+        for (int i = 0; i < steps; ++i) IntegrateAoS(aos, dt, gravity, damping);
+    });
+    const double soaNs = Nanoseconds([&]() {
+        for (int i = 0; i < steps; ++i) IntegrateBodies(soa, dt, gravity, IntegrationMethod::SemiImplicitEuler, damping);
+    });
+
+    IntegrationTiming timing;
+    timing.bodies = bodies;
+    timing.steps = steps;
+    const double updates = static_cast<double>(std::max<size_t>(bodies, 1)) * std::max(steps, 1);
+    timing.aosNsPerBody = aosNs / updates;
+    timing.soaNsPerBody = soaNs / updates;
+    for (size_t i = 0; i < bodies; ++i) {
+        const glm::vec3 d = glm::abs(soa.Position(i) - aos[i].position);
+        timing.maxPositionDifference = std::max<double>(timing.maxPositionDifference, std::max(d.x, std::max(d.y, d.z)));
+    }
+    return timing;
+}
+
+SphTiming TimeSphSteps(size_t particles, int steps) {
+    // Four walls and a floor, 8 m from the centre; the block starts on the floor and fills most of the tank
+    const float halfWidth = 8.0f;
+    ParticleColliders tank;
+    tank.planes.emplace_back(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    tank.planes.emplace_back(glm::vec3(-halfWidth, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    tank.planes.emplace_back(glm::vec3(halfWidth, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f));
+    tank.planes.emplace_back(glm::vec3(0.0f, 0.0f, -halfWidth), glm::vec3(0.0f, 0.0f, 1.0f));
+    tank.planes.emplace_back(glm::vec3(0.0f, 0.0f, halfWidth), glm::vec3(0.0f, 0.0f, -1.0f));
+
+    SphFluid fluid;
+    fluid.AddBlock(glm::vec3(0.0f, 4.8f, 0.0f), glm::vec3(4.75f), glm::vec3(0.0f), particles);
+    auto parallel = [](size_t count, size_t minBatch, auto&& fn) { JobSystem::Get().ParallelFor(count, minBatch, fn); };
+
+    // Warm-up: the neighbour grid and per-particle arrays grow to the fluid here
+    for (int i = 0; i < 2; ++i) fluid.Step(fluid.MaxTimeStep(), tank, parallel);
+
+    uint64_t neighbours = 0;
+    const double ns = Nanoseconds([&]() {
+        for (int i = 0; i < steps; ++i) {
+            fluid.Step(fluid.MaxTimeStep(), tank, parallel);
+            neighbours += fluid.LastNeighbourCount();
+        }
+    });
+
+    SphTiming timing;
+    timing.particles = fluid.Size();
+    timing.steps = steps;
+    const double seconds = ns * 1e-9;
+    timing.msPerStep = ns * 1e-6 / std::max(steps, 1);
+    timing.neighboursPerParticle = static_cast<double>(neighbours) / std::max<size_t>(fluid.Size(), 1) / std::max(steps, 1);
+    timing.neighboursPerSecond = seconds > 0.0 ? static_cast<double>(neighbours) / seconds : 0.0;
+    timing.allFinite = true;
+    for (size_t i = 0; i < fluid.Size(); ++i) {
+        const glm::vec3 p = fluid.Position(i);
+        const glm::vec3 v = fluid.Velocity(i);
+        if (!std::isfinite(p.x + p.y + p.z + v.x + v.y + v.z)) timing.allFinite = false;
+    }
+    return timing;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+// Timings of single techniques, kept beside the whole-scene run so both come from the same optimised build.
+// Where a technique replaced an older approach, both are timed and checked to agree.
+
+struct LookupTiming {
+    size_t entities = 0;
+    size_t lookups = 0;             // HasComponent and GetComponent calls, each way
+    double mapNsPerLookup = 0.0;    // type_index map + shared_ptr per call, as the registry found its pools before
+    double familyNsPerLookup = 0.0; // The registry's family-ID table
+    bool resultsMatch = false;
+};
+
+// HasComponent then GetComponent on every entity, rounds times over
+LookupTiming TimeComponentLookups(size_t entities, int rounds = 200);
+
+struct IntegrationTiming {
+    size_t bodies = 0;
+    int steps = 0;
+    double aosNsPerBody = 0.0; // One record per body with the Transform and Physics fields, as Integrate walks them
+    double soaNsPerBody = 0.0; // BodySoA columns through IntegrateBodies, as the SoA path steps them
+    double maxPositionDifference = 0.0;
+};
+
+// Semi-implicit Euler under gravity and drag at 240 Hz, the same random bodies in both layouts
+IntegrationTiming TimeBodyIntegration(size_t bodies, int steps = 20);
+
+struct SphTiming {
+    size_t particles = 0;
+    int steps = 0;
+    double msPerStep = 0.0;
+    double neighboursPerParticle = 0.0; // Per step
+    double neighboursPerSecond = 0.0;
+    bool allFinite = false;
+};
+
+// A block of fluid collapsing in an open 16 m tank, stepped at its largest stable time step across the job system
+SphTiming TimeSphSteps(size_t particles, int steps = 20);
@@ -0,0 +1,301 @@
+// Headless physics benchmark: steps PhysicsSystem over a .world file and/or a synthetic scene for a fixed
+// number of frames, with no window, swapchain or GPU, and reports the timings as JSON.
+//
+//   PhysicsBenchmark [--world path] [--spheres N] [--layout pile|gas|cluster] [--frames N] [--warmup N]
+//                    [--dt seconds] [--steps N] [--solver si|batches|serial] [--aos] [--no-sleep] [--no-ccd]
+//                    [--seed N] [--out path]
+//   PhysicsBenchmark --lookups N [--out path]
+//   PhysicsBenchmark --integrate N [--out path]
+//   PhysicsBenchmark --sph N [--out path]
+//
+// Defaults: 240 measured frames after 20 warm-up frames, each 1/60 s split into 4 steps (the 240 Hz the app runs
+// at), and the pile layout when --spheres is given. The gas layout turns gravity, drag and sleeping off, so its
+// energy drift is the solver's own error.
+//
+// --lookups times component lookups over N entities instead of stepping a scene: the registry's family-ID table
+// against the type_index map it replaced, in ns per HasComponent / GetComponent call. --integrate times 20 steps
+// of integrating N bodies stored as one record each (AoS) and as BodySoA columns, in ns per body per step.
+// --sph times 20 steps of an N-particle SPH fluid block settling in a tank, in ms per step and neighbours per second.
+
+#include "BenchmarkScene.h"
+#include "Microbenchmarks.h"
+#include "../src/core/Components.h"
+#include "../src/core/JobSystem.h"
+#include "../src/systems/PhysicsSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string world;
+        size_t spheres = 0;
+        size_t lookups = 0;
+        size_t integrate = 0;
+        size_t sph = 0;
+        SyntheticLayout layout = SyntheticLayout::Pile;
+        int frames = 240;
+        int warmup = 20;
+        float frameTime = 1.0f / 60.0f;
+        int steps = 4;
+        std::string solver = "si";
+        bool soa = true;
+        bool sleeping = true;
+        bool ccd = true;
+        uint32_t seed = 1;
+        std::string out;
+    };
+
+    const char* LayoutName(SyntheticLayout layout) {
+        switch (layout) {
+        case SyntheticLayout::Gas: return "gas";
+        case SyntheticLayout::Cluster: return "cluster";
+        default: return "pile";
+        }
+    }
+
+    Options ParseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Missing value for " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--world") options.world = value();
+            else if (arg == "--spheres") options.spheres = std::stoull(value());
+            else if (arg == "--lookups") options.lookups = std::max<size_t>(std::stoull(value()), 1);
+            else if (arg == "--integrate") options.integrate = std::max<size_t>(std::stoull(value()), 1);
+            else if (arg == "--sph") options.sph = std::max<size_t>(std::stoull(value()), 1);
+            else if (arg == "--frames") options.frames = std::max(std::stoi(value()), 1);
+            else if (arg == "--warmup") options.warmup = std::max(std::stoi(value()), 0);
+            else if (arg == "--dt") options.frameTime = std::stof(value());
+            else if (arg == "--steps") options.steps = std::max(std::stoi(value()), 1);
+            else if (arg == "--seed") options.seed = static_cast<uint32_t>(std::stoul(value()));
+            else if (arg == "--out") options.out = value();
+            else if (arg == "--aos") options.soa = false;
+            else if (arg == "--no-sleep") options.sleeping = false;
+            else if (arg == "--no-ccd") options.ccd = false;
+            else if (arg == "--layout") {
+                const std::string layout = value();
+                if (layout == "pile") options.layout = SyntheticLayout::Pile;
+                else if (layout == "gas") options.layout = SyntheticLayout::Gas;
+                else if (layout == "cluster") options.layout = SyntheticLayout::Cluster;
+                else throw std::runtime_error("Unknown layout: " + layout);
+            }
+            else if (arg == "--solver") {
+                options.solver = value();
+                if (options.solver != "si" && options.solver != "batches" && options.solver != "serial") {
+                    throw std::runtime_error("Unknown solver: " + options.solver);
+                }
+            }
+            else throw std::runtime_error("Unknown option: " + arg);
+        }
+        if (options.world.empty() && options.spheres == 0 && options.lookups == 0 && options.integrate == 0 && options.sph == 0) {
+            throw std::runtime_error("Nothing to simulate: give --world and/or --spheres, or --lookups, --integrate or --sph");
+        }
+        return options;
+    }
+
+    void ApplySettings(const Options& options) {
+        PhysicsSystem::useSequentialImpulse = (options.solver == "si");
+        PhysicsSystem::parallelContacts = (options.solver != "serial");
+        PhysicsSystem::useSoA = options.soa;
+        PhysicsSystem::allowSleeping = options.sleeping;
+        PhysicsSystem::continuousCollision = options.ccd;
+        PhysicsSystem::mutualGravity = false;
+        PhysicsSystem::applyGravity = true;
+
+        if (options.spheres == 0) return;
+        if (options.layout == SyntheticLayout::Gas) {
+            PhysicsSystem::applyGravity = false;
+            PhysicsSystem::airDamping = 1.0f;
+            PhysicsSystem::allowSleeping = false;
+        }
+        else if (options.layout == SyntheticLayout::Cluster) {
+            PhysicsSystem::mutualGravity = true;
+        }
+    }
+
+    std::string JsonString(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    // NaN and infinities have no JSON form
+    std::string JsonNumber(double value) {
+        if (!std::isfinite(value)) return "null";
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        return buffer;
+    }
+
+    double Percentile(std::vector<double> values, double p) {
+        std::sort(values.begin(), values.end());
+        const size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+        return values[index];
+    }
+
+    std::string LookupReport(const Options& options) {
+        const LookupTiming timing = TimeComponentLookups(options.lookups);
+        std::string json = "{\n";
+        json += "  \"benchmark\": \"lookups\",\n";
+        json += "  \"entities\": " + std::to_string(timing.entities) + ",\n";
+        json += "  \"lookups\": " + std::to_string(timing.lookups) + ",\n";
+        json += "  \"nsPerLookup\": { \"map\": " + JsonNumber(timing.mapNsPerLookup)
+            + ", \"familyTable\": " + JsonNumber(timing.familyNsPerLookup) + " },\n";
+        json += "  \"speedup\": " + JsonNumber(timing.mapNsPerLookup / timing.familyNsPerLookup) + ",\n";
+        json += "  \"resultsMatch\": " + std::string(timing.resultsMatch ? "true" : "false") + "\n";
+        json += "}\n";
+        return json;
+    }
+
+    std::string IntegrationReport(const Options& options) {
+        const IntegrationTiming timing = TimeBodyIntegration(options.integrate);
+        std::string json = "{\n";
+        json += "  \"benchmark\": \"integrate\",\n";
+        json += "  \"bodies\": " + std::to_string(timing.bodies) + ",\n";
+        json += "  \"steps\": " + std::to_string(timing.steps) + ",\n";
+        json += "  \"nsPerBody\": { \"aos\": " + JsonNumber(timing.aosNsPerBody)
+            + ", \"soa\": " + JsonNumber(timing.soaNsPerBody) + " },\n";
+        json += "  \"speedup\": " + JsonNumber(timing.aosNsPerBody / timing.soaNsPerBody) + ",\n";
+        json += "  \"maxPositionDifference\": " + JsonNumber(timing.maxPositionDifference) + "\n";
+        json += "}\n";
+        return json;
+    }
+
+    std::string SphReport(const Options& options) {
+        const SphTiming timing = TimeSphSteps(options.sph);
+        std::string json = "{\n";
+        json += "  \"benchmark\": \"sph\",\n";
+        json += "  \"particles\": " + std::to_string(timing.particles) + ",\n";
+        json += "  \"threads\": " + std::to_string(JobSystem::Get().GetThreadCount()) + ",\n";
+        json += "  \"steps\": " + std::to_string(timing.steps) + ",\n";
+        json += "  \"msPerStep\": " + JsonNumber(timing.msPerStep) + ",\n";
+        json += "  \"neighboursPerParticle\": " + JsonNumber(timing.neighboursPerParticle) + ",\n";
+        json += "  \"neighboursPerSecond\": " + JsonNumber(timing.neighboursPerSecond) + ",\n";
+        json += "  \"allFinite\": " + std::string(timing.allFinite ? "true" : "false") + "\n";
+        json += "}\n";
+        return json;
+    }
+
+    void WriteReport(const Options& options, const std::string& json) {
+        if (options.out.empty()) {
+            std::fputs(json.c_str(), stdout);
+            return;
+        }
+        FILE* file = std::fopen(options.out.c_str(), "w");
+        if (!file) throw std::runtime_error("Cannot write " + options.out);
+        std::fputs(json.c_str(), file);
+        std::fclose(file);
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        const Options options = ParseOptions(argc, argv);
+        // Microbenchmarks run on their own, without a scene
+        std::string report;
+        if (options.lookups) report = LookupReport(options);
+        else if (options.integrate) report = IntegrationReport(options);
+        else if (options.sph) report = SphReport(options);
+        if (!report.empty()) {
+            WriteReport(options, report);
+            return EXIT_SUCCESS;
+        }
+        ApplySettings(options);
+
+        // 1. Build the bodies
+        BenchmarkScene scene;
+        if (!options.world.empty() && !scene.LoadWorld(options.world)) {
+            throw std::runtime_error("No objects loaded from " + options.world);
+        }
+        scene.AddSpheres(options.layout, options.spheres, options.seed);
+        Registry& registry = scene.GetRegistry();
+
+        // 2. Warm up: the pools, grids and caches grow to the scene here rather than in the timed frames
+        PhysicsSystem physics;
+        const float dt = options.frameTime / static_cast<float>(options.steps);
+        for (int frame = 0; frame < options.warmup; ++frame) {
+            registry.AdvanceChangeTick();
+            physics.Simulate(registry, options.steps, dt, false);
+        }
+
+        // 3. Measured frames
+        const double energyStart = scene.TotalEnergy();
+        std::vector<double> stepNs;
+        stepNs.reserve(static_cast<size_t>(options.frames));
+        double pairsTested = 0.0;
+        double contacts = 0.0;
+        double gravityInteractions = 0.0;
+        for (int frame = 0; frame < options.frames; ++frame) {
+            registry.AdvanceChangeTick();
+            const auto start = std::chrono::steady_clock::now();
+            physics.Simulate(registry, options.steps, dt, false);
+            const auto end = std::chrono::steady_clock::now();
+            stepNs.push_back(std::chrono::duration<double, std::nano>(end - start).count() / options.steps);
+
+            const PhysicsStats& stats = physics.GetStats();
+            pairsTested += static_cast<double>(stats.pairsTested) / options.steps;
+            contacts += static_cast<double>(stats.contactsSolved) / options.steps;
+            gravityInteractions += static_cast<double>(stats.gravityInteractions);
+        }
+        const double energyEnd = scene.TotalEnergy();
+
+        double totalNs = 0.0;
+        for (double ns : stepNs) totalNs += ns;
+        const double frames = static_cast<double>(options.frames);
+        const PhysicsStats& stats = physics.GetStats();
+        const BenchmarkSceneInfo& info = scene.GetInfo();
+
+        // 4. Report
+        std::string json = "{\n";
+        json += "  \"world\": " + (options.world.empty() ? std::string("null") : JsonString(options.world)) + ",\n";
+        json += "  \"layout\": " + (options.spheres ? JsonString(LayoutName(options.layout)) : std::string("null")) + ",\n";
+        json += "  \"dynamicBodies\": " + std::to_string(info.dynamicBodies) + ",\n";
+        json += "  \"staticBodies\": " + std::to_string(info.staticBodies) + ",\n";
+        json += "  \"skippedColliders\": " + std::to_string(info.skippedColliders) + ",\n";
+        json += "  \"threads\": " + std::to_string(JobSystem::Get().GetThreadCount()) + ",\n";
+        json += "  \"settings\": { \"solver\": " + JsonString(options.solver)
+            + ", \"soa\": " + (options.soa ? "true" : "false")
+            + ", \"sleeping\": " + (PhysicsSystem::allowSleeping ? "true" : "false")
+            + ", \"ccd\": " + (options.ccd ? "true" : "false")
+            + ", \"mutualGravity\": " + (PhysicsSystem::mutualGravity ? "true" : "false") + " },\n";
+        json += "  \"frames\": " + std::to_string(options.frames) + ",\n";
+        json += "  \"stepsPerFrame\": " + std::to_string(options.steps) + ",\n";
+        json += "  \"stepSeconds\": " + JsonNumber(dt) + ",\n";
+        json += "  \"nsPerStep\": { \"mean\": " + JsonNumber(totalNs / frames)
+            + ", \"min\": " + JsonNumber(*std::min_element(stepNs.begin(), stepNs.end()))
+            + ", \"p50\": " + JsonNumber(Percentile(stepNs, 0.5))
+            + ", \"p95\": " + JsonNumber(Percentile(stepNs, 0.95))
+            + ", \"max\": " + JsonNumber(*std::max_element(stepNs.begin(), stepNs.end())) + " },\n";
+        json += "  \"pairsTestedPerStep\": " + JsonNumber(pairsTested / frames) + ",\n";
+        json += "  \"contactsPerStep\": " + JsonNumber(contacts / frames) + ",\n";
+        json += "  \"gravityInteractionsPerStep\": " + JsonNumber(gravityInteractions / frames) + ",\n";
+        json += "  \"awakeBodies\": " + std::to_string(stats.awakeBodies) + ",\n";
+        json += "  \"sleepingBodies\": " + std::to_string(stats.sleepingBodies) + ",\n";
+        json += "  \"energy\": { \"start\": " + JsonNumber(energyStart)
+            + ", \"end\": " + JsonNumber(energyEnd)
+            + ", \"drift\": " + JsonNumber((energyEnd - energyStart) / std::max(std::abs(energyStart), 1e-9)) + " }\n";
+        json += "}\n";
+        WriteReport(options, json);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
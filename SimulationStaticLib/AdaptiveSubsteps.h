@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// CFL-style substep count: enough substeps that the fastest body, relative to its size, moves at most
+// maxMotion of its radius per substep. ratio is max(|v| * frameTime / radius) over the awake bodies.
+struct SubstepSettings
+{
+	int minSteps = 1;
+	int maxSteps = 16;
+	float maxMotion = 0.5f; // Radius fraction a body may travel in one substep
+};
+
+inline int ChooseSubsteps(float ratio, const SubstepSettings& settings)
+{
+	const int lo = std::max(settings.minSteps, 1);
+	const int hi = std::max(settings.maxSteps, lo);
+	if (!(ratio > 0.0f) || !(settings.maxMotion > 0.0f)) return lo; // Also catches NaN
+
+	// Clamped as a float first, so a huge ratio cannot overflow the int
+	const float steps = std::min(std::ceil(ratio / settings.maxMotion), static_cast<float>(hi));
+	return std::max(static_cast<int>(steps), lo);
+}
+
+// Fixed-size ring of the most recent samples, laid out for ImGui::PlotLines (Data, Count, Offset)
+class SampleHistory
+{
+public:
+	explicit SampleHistory(size_t capacity = 120) : m_samples(std::max<size_t>(capacity, 1), 0.0f) {}
+
+	void Push(float value)
+	{
+		m_samples[m_next] = value;
+		m_next = (m_next + 1) % m_samples.size();
+		m_count = std::min(m_count + 1, m_samples.size());
+	}
+
+	// Oldest first: sample i is Data()[(Offset() + i) % Count()]. Until the ring wraps the samples sit
+	// at the front of the buffer in order.
+	const float* Data() const { return m_samples.data(); }
+	int Count() const { return static_cast<int>(m_count); }
+	int Offset() const { return (m_count < m_samples.size()) ? 0 : static_cast<int>(m_next); }
+
+	float Latest() const { return m_count ? m_samples[(m_next + m_samples.size() - 1) % m_samples.size()] : 0.0f; }
+	float Max() const { return m_count ? *std::max_element(m_samples.begin(), m_samples.begin() + m_count) : 0.0f; }
+	float Average() const
+	{
+		float sum = 0.0f;
+		for (size_t i = 0; i < m_count; ++i) sum += m_samples[i];
+		return m_count ? sum / static_cast<float>(m_count) : 0.0f;
+	}
+
+private:
+	std::vector<float> m_samples;
+	size_t m_next = 0;
+	size_t m_count = 0;
+};
@@ -0,0 +1,670 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BARNESHUT_USE_SSE 1
+#endif
+
+struct GravitySettings
+{
+	float G = 1.0f;          // In scene units; the real 6.67e-11 would not move bodies of a few kilograms
+	float theta = 0.5f;      // A cell is taken whole when its width over the distance to its centre of mass is below theta; 0 = exact
+	float softening = 0.05f; // Plummer length that caps the pull of close pairs
+};
+
+namespace BarnesHutDetail
+{
+	constexpr int MORTON_BITS = 21; // Per axis, 63 bits of key
+	constexpr int SPLIT_LEVEL = 2;  // Cells at this depth are the subtrees built in parallel (up to 64)
+	constexpr uint32_t LEAF_SIZE = 8;
+	constexpr uint32_t GROUP_SIZE = 64; // Bodies that share one walk in SelfAccelerations
+	constexpr int RADIX_BITS = 11;
+	constexpr uint32_t RADIX_BUCKETS = 1u << RADIX_BITS;
+
+	// Spreads the low 21 bits of v so two zero bits sit between each
+	inline uint64_t SpreadBits(uint64_t v)
+	{
+		v &= 0x1fffff;
+		v = (v | (v << 32)) & 0x1f00000000ffffull;
+		v = (v | (v << 16)) & 0x1f0000ff0000ffull;
+		v = (v | (v << 8)) & 0x100f00f00f00f00full;
+		v = (v | (v << 4)) & 0x10c30c30c30c30c3ull;
+		v = (v | (v << 2)) & 0x1249249249249249ull;
+		return v;
+	}
+
+	// Octant of the key at the given depth (1 = the root's children)
+	inline uint32_t Octant(uint64_t key, int level)
+	{
+		return static_cast<uint32_t>(key >> (3 * (MORTON_BITS - level))) & 7u;
+	}
+
+	struct Node
+	{
+		float x, y, z;       // Centre of mass
+		float mass;
+		float width;         // Edge of the cubic cell
+		uint32_t firstChild; // Children are contiguous
+		uint32_t childCount; // 0 for a leaf, which owns the sorted bodies [begin, end)
+		uint32_t begin, end;
+	};
+
+	// Adds the pull of a point mass at offset d. A zero offset (the body itself) adds nothing.
+	inline void AddPull(float& ax, float& ay, float& az, float dx, float dy, float dz, float mass, float eps2)
+	{
+		const float r2 = dx * dx + dy * dy + dz * dz;
+		const float inv = (r2 > 0.0f) ? 1.0f / std::sqrt(r2 + eps2) : 0.0f;
+		const float s = mass * inv * inv * inv;
+		ax += dx * s;
+		ay += dy * s;
+		az += dz * s;
+	}
+
+	// Point masses (accepted cells and the bodies of opened leaves) that pull on one group of bodies
+	struct InteractionList
+	{
+		std::vector<float> x, y, z, mass;
+
+		size_t Size() const { return mass.size(); }
+
+		void Clear()
+		{
+			x.clear(); y.clear(); z.clear(); mass.clear();
+		}
+
+		void Add(float px, float py, float pz, float m)
+		{
+			x.push_back(px); y.push_back(py); z.push_back(pz); mass.push_back(m);
+		}
+	};
+
+#ifdef BARNESHUT_USE_SSE
+	inline float HorizontalSum(__m128 v)
+	{
+		__m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_add_ps(v, shuffled);
+		shuffled = _mm_movehl_ps(shuffled, v);
+		return _mm_cvtss_f32(_mm_add_ss(v, shuffled));
+	}
+#endif
+
+	// Pull of the whole list at p, without G
+	inline glm::vec3 SumPull(const InteractionList& list, float px, float py, float pz, float eps2)
+	{
+		float ax = 0.0f, ay = 0.0f, az = 0.0f;
+		const size_t count = list.Size();
+		size_t j = 0;
+#ifdef BARNESHUT_USE_SSE
+		if (count >= 4)
+		{
+			const __m128 x = _mm_set1_ps(px), y = _mm_set1_ps(py), z = _mm_set1_ps(pz), eps = _mm_set1_ps(eps2);
+			const __m128 zero = _mm_setzero_ps(), half = _mm_set1_ps(0.5f), three = _mm_set1_ps(3.0f);
+			__m128 sx = zero, sy = zero, sz = zero;
+			for (; j + 4 <= count; j += 4)
+			{
+				const __m128 dx = _mm_sub_ps(_mm_loadu_ps(list.x.data() + j), x);
+				const __m128 dy = _mm_sub_ps(_mm_loadu_ps(list.y.data() + j), y);
+				const __m128 dz = _mm_sub_ps(_mm_loadu_ps(list.z.data() + j), z);
+				const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+				// Estimate plus one Newton step, good to about 1e-7. Lanes with a zero offset are masked to 0
+				// after the step, so a zero softened distance never reaches the sum.
+				const __m128 d2 = _mm_add_ps(r2, eps);
+				const __m128 estimate = _mm_rsqrt_ps(d2);
+				const __m128 refined = _mm_mul_ps(_mm_mul_ps(half, estimate), _mm_sub_ps(three, _mm_mul_ps(_mm_mul_ps(d2, estimate), estimate)));
+				const __m128 inv = _mm_and_ps(_mm_cmpgt_ps(r2, zero), refined);
+				const __m128 scale = _mm_mul_ps(_mm_loadu_ps(list.mass.data() + j), _mm_mul_ps(_mm_mul_ps(inv, inv), inv));
+				sx = _mm_add_ps(sx, _mm_mul_ps(dx, scale));
+				sy = _mm_add_ps(sy, _mm_mul_ps(dy, scale));
+				sz = _mm_add_ps(sz, _mm_mul_ps(dz, scale));
+			}
+			ax = HorizontalSum(sx);
+			ay = HorizontalSum(sy);
+			az = HorizontalSum(sz);
+		}
+#endif
+		for (; j < count; ++j)
+		{
+			AddPull(ax, ay, az, list.x[j] - px, list.y[j] - py, list.z[j] - pz, list.mass[j], eps2);
+		}
+		return glm::vec3(ax, ay, az);
+	}
+}
+
+// Reference O(n * m) sum of the pull of every source on every target, for checking the tree
+inline void BruteForceGravity(const float* x, const float* y, const float* z, const float* mass, size_t count,
+	const float* targetX, const float* targetY, const float* targetZ, size_t targetCount, const GravitySettings& settings,
+	float* ax, float* ay, float* az)
+{
+	const float eps2 = settings.softening * settings.softening;
+	for (size_t i = 0; i < targetCount; ++i)
+	{
+		float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+		for (size_t j = 0; j < count; ++j)
+		{
+			BarnesHutDetail::AddPull(sx, sy, sz, x[j] - targetX[i], y[j] - targetY[i], z[j] - targetZ[i], mass[j], eps2);
+		}
+		ax[i] = sx * settings.G;
+		ay[i] = sy * settings.G;
+		az[i] = sz * settings.G;
+	}
+}
+
+// Barnes-Hut octree over point masses, rebuilt from scratch every step. Bodies are sorted along a 63-bit
+// Morton curve with a parallel radix sort, so every cell is a contiguous range of the sorted bodies; the
+// cells at SPLIT_LEVEL are then built as independent subtrees and spliced under the top levels. Each node
+// keeps only its monopole (mass and centre of mass). Work is split through the caller's
+// parallelFor(count, minBatch, fn(begin, end)); each pass writes only its own range.
+class BarnesHutTree
+{
+public:
+	template <typename ParallelFor>
+	void Build(const float* x, const float* y, const float* z, const float* mass, size_t count, ParallelFor&& parallelFor)
+	{
+		m_nodes.clear();
+		m_groups.clear();
+		m_count = count;
+		if (count == 0) return;
+
+		ComputeBounds(x, y, z, count, parallelFor);
+		SortBodies(x, y, z, mass, count, parallelFor);
+		BuildNodes(parallelFor);
+
+		// Groups for SelfAccelerations: the largest cells of at most GROUP_SIZE bodies (or leaves), in key order
+		m_groups.clear();
+		std::vector<uint32_t> pending{ 0 };
+		while (!pending.empty())
+		{
+			const Node& node = m_nodes[pending.back()];
+			const uint32_t index = pending.back();
+			pending.pop_back();
+			if (node.childCount == 0 || node.end - node.begin <= BarnesHutDetail::GROUP_SIZE) m_groups.push_back(index);
+			else for (uint32_t c = 0; c < node.childCount; ++c) pending.push_back(node.firstChild + c);
+		}
+		std::sort(m_groups.begin(), m_groups.end(), [&](uint32_t a, uint32_t b) { return m_nodes[a].begin < m_nodes[b].begin; });
+	}
+
+	// Acceleration at every target. Targets may be the sources themselves: a body exerts no pull on itself.
+	template <typename ParallelFor>
+	void Accelerations(const float* x, const float* y, const float* z, size_t count, const GravitySettings& settings,
+		float* ax, float* ay, float* az, ParallelFor&& parallelFor) const
+	{
+		std::atomic<uint64_t> interactions{ 0 };
+		parallelFor(count, MIN_BATCH, [&](size_t begin, size_t end) {
+			uint64_t local = 0;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const glm::vec3 a = Walk(x[i], y[i], z[i], settings, local);
+				ax[i] = a.x;
+				ay[i] = a.y;
+				az[i] = a.z;
+			}
+			interactions.fetch_add(local, std::memory_order_relaxed);
+		});
+		m_interactions = interactions.load();
+	}
+
+	// Acceleration at every body the tree was built from, written in the caller's order. Bodies are handled a
+	// cell of up to GROUP_SIZE at a time: one walk opens cells against the group's bounding box, which is at
+	// least as strict as opening them against each body, and the resulting list is summed for every body in it.
+	template <typename ParallelFor>
+	void SelfAccelerations(const GravitySettings& settings, float* ax, float* ay, float* az, ParallelFor&& parallelFor) const
+	{
+		using namespace BarnesHutDetail;
+		const float eps2 = settings.softening * settings.softening;
+		std::atomic<uint64_t> interactions{ 0 };
+		parallelFor(m_groups.size(), MIN_GROUPS, [&](size_t begin, size_t end) {
+			InteractionList list;
+			uint64_t local = 0;
+			for (size_t k = begin; k < end; ++k)
+			{
+				const Node& group = m_nodes[m_groups[k]];
+				GatherGroup(group, settings, list);
+				for (uint32_t i = group.begin; i < group.end; ++i)
+				{
+					const glm::vec3 a = SumPull(list, m_x[i], m_y[i], m_z[i], eps2) * settings.G;
+					const uint32_t j = m_order[i];
+					ax[j] = a.x;
+					ay[j] = a.y;
+					az[j] = a.z;
+				}
+				local += static_cast<uint64_t>(list.Size()) * (group.end - group.begin);
+			}
+			interactions.fetch_add(local, std::memory_order_relaxed);
+		});
+		m_interactions = interactions.load();
+	}
+
+	glm::vec3 Acceleration(const glm::vec3& p, const GravitySettings& settings) const
+	{
+		uint64_t interactions = 0;
+		return Walk(p.x, p.y, p.z, settings, interactions);
+	}
+
+	size_t BodyCount() const { return m_count; }
+	size_t NodeCount() const { return m_nodes.size(); }
+	bool Empty() const { return m_nodes.empty(); }
+	float TotalMass() const { return m_nodes.empty() ? 0.0f : m_nodes[0].mass; }
+	glm::vec3 CenterOfMass() const { return m_nodes.empty() ? glm::vec3(0.0f) : glm::vec3(m_nodes[0].x, m_nodes[0].y, m_nodes[0].z); }
+
+	// Node and body pulls summed by the last Accelerations call
+	uint64_t LastInteractionCount() const { return m_interactions; }
+
+private:
+	using Node = BarnesHutDetail::Node;
+	static constexpr size_t MIN_BATCH = 64;
+	static constexpr size_t MIN_GROUPS = 16;
+	static constexpr size_t SORT_CHUNK = 16384;
+	static constexpr uint32_t SUBTREES = 1u << (3 * BarnesHutDetail::SPLIT_LEVEL);
+
+	// Cubic root cell around the bodies, reduced over fixed chunks so the result does not depend on threading
+	template <typename ParallelFor>
+	void ComputeBounds(const float* x, const float* y, const float* z, size_t count, ParallelFor& parallelFor)
+	{
+		const size_t chunks = (count + SORT_CHUNK - 1) / SORT_CHUNK;
+		m_chunkLo.assign(chunks, glm::vec3(std::numeric_limits<float>::max()));
+		m_chunkHi.assign(chunks, glm::vec3(-std::numeric_limits<float>::max()));
+		parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+			for (size_t c = begin; c < end; ++c)
+			{
+				glm::vec3 lo = m_chunkLo[c], hi = m_chunkHi[c];
+				for (size_t i = c * SORT_CHUNK; i < std::min(count, (c + 1) * SORT_CHUNK); ++i)
+				{
+					lo = glm::min(lo, glm::vec3(x[i], y[i], z[i]));
+					hi = glm::max(hi, glm::vec3(x[i], y[i], z[i]));
+				}
+				m_chunkLo[c] = lo;
+				m_chunkHi[c] = hi;
+			}
+		});
+
+		glm::vec3 lo = m_chunkLo[0], hi = m_chunkHi[0];
+		for (size_t c = 1; c < chunks; ++c)
+		{
+			lo = glm::min(lo, m_chunkLo[c]);
+			hi = glm::max(hi, m_chunkHi[c]);
+		}
+		const glm::vec3 extent = hi - lo;
+		// Slightly oversized, so the far corner still quantises inside the grid
+		m_width = std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-6f)) * 1.0001f;
+		m_origin = lo;
+	}
+
+	// Morton keys, an LSD radix sort of (key, body) pairs with per-chunk histograms, then the body columns
+	// gathered into key order
+	template <typename ParallelFor>
+	void SortBodies(const float* x, const float* y, const float* z, const float* mass, size_t count, ParallelFor& parallelFor)
+	{
+		using namespace BarnesHutDetail;
+		m_keys.resize(count);
+		m_order.resize(count);
+		const float scale = static_cast<float>(1u << MORTON_BITS) / m_width;
+		const float maxCell = static_cast<float>((1u << MORTON_BITS) - 1);
+		parallelFor(count, MIN_BATCH * 16, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const uint64_t cx = static_cast<uint64_t>(std::min((x[i] - m_origin.x) * scale, maxCell));
+				const uint64_t cy = static_cast<uint64_t>(std::min((y[i] - m_origin.y) * scale, maxCell));
+				const uint64_t cz = static_cast<uint64_t>(std::min((z[i] - m_origin.z) * scale, maxCell));
+				m_keys[i] = (SpreadBits(cx) << 2) | (SpreadBits(cy) << 1) | SpreadBits(cz);
+				m_order[i] = static_cast<uint32_t>(i);
+			}
+		});
+
+		const size_t chunks = (count + SORT_CHUNK - 1) / SORT_CHUNK;
+		m_keyScratch.resize(count);
+		m_orderScratch.resize(count);
+		m_histogram.resize(chunks * RADIX_BUCKETS);
+		for (int shift = 0; shift < 3 * MORTON_BITS; shift += RADIX_BITS)
+		{
+			std::fill(m_histogram.begin(), m_histogram.end(), 0u);
+			parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+				for (size_t c = begin; c < end; ++c)
+				{
+					uint32_t* counts = &m_histogram[c * RADIX_BUCKETS];
+					for (size_t i = c * SORT_CHUNK; i < std::min(count, (c + 1) * SORT_CHUNK); ++i)
+						counts[(m_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+				}
+			});
+
+			// Digit-major, chunk-minor prefix sum keeps the sort stable. A digit every key shares is skipped.
+			uint32_t running = 0;
+			bool allInOneBucket = false;
+			for (uint32_t digit = 0; digit < RADIX_BUCKETS; ++digit)
+			{
+				const uint32_t before = running;
+				for (size_t c = 0; c < chunks; ++c)
+				{
+					uint32_t& slot = m_histogram[c * RADIX_BUCKETS + digit];
+					const uint32_t n = slot;
+					slot = running;
+					running += n;
+				}
+				if (running - before == count) allInOneBucket = true;
+			}
+			if (allInOneBucket) continue;
+
+			parallelFor(chunks, 1, [&](size_t begin, size_t end) {
+				for (size_t c = begin; c < end; ++c)
+				{
+					uint32_t* cursor = &m_histogram[c * RADIX_BUCKETS];
+					for (size_t i = c * SORT_CHUNK; i < std::min(count, (c + 1) * SORT_CHUNK); ++i)
+					{
+						const uint32_t slot = cursor[(m_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+						m_keyScratch[slot] = m_keys[i];
+						m_orderScratch[slot] = m_order[i];
+					}
+				}
+			});
+			m_keys.swap(m_keyScratch);
+			m_order.swap(m_orderScratch);
+		}
+
+		m_x.resize(count); m_y.resize(count); m_z.resize(count); m_mass.resize(count);
+		parallelFor(count, MIN_BATCH * 16, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const uint32_t j = m_order[i];
+				m_x[i] = x[j]; m_y[i] = y[j]; m_z[i] = z[j]; m_mass[i] = mass[j];
+			}
+		});
+	}
+
+	// First sorted body in [begin, end) whose octant at the given level is at least octant
+	uint32_t OctantStart(uint32_t begin, uint32_t end, int level, uint32_t octant) const
+	{
+		return static_cast<uint32_t>(std::partition_point(m_keys.begin() + begin, m_keys.begin() + end,
+			[&](uint64_t key) { return BarnesHutDetail::Octant(key, level) < octant; }) - m_keys.begin());
+	}
+
+	void MakeLeaf(Node& node, uint32_t begin, uint32_t end) const
+	{
+		double mass = 0.0, x = 0.0, y = 0.0, z = 0.0;
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			mass += m_mass[i];
+			x += static_cast<double>(m_x[i]) * m_mass[i];
+			y += static_cast<double>(m_y[i]) * m_mass[i];
+			z += static_cast<double>(m_z[i]) * m_mass[i];
+		}
+		SetMoments(node, mass, x, y, z, begin);
+		node.firstChild = 0;
+		node.childCount = 0;
+		node.begin = begin;
+		node.end = end;
+	}
+
+	// Massless cells sit on their first body, so they still have a finite position
+	void SetMoments(Node& node, double mass, double x, double y, double z, uint32_t firstBody) const
+	{
+		node.mass = static_cast<float>(mass);
+		if (mass > 0.0)
+		{
+			node.x = static_cast<float>(x / mass);
+			node.y = static_cast<float>(y / mass);
+			node.z = static_cast<float>(z / mass);
+		}
+		else
+		{
+			node.x = m_x[firstBody];
+			node.y = m_y[firstBody];
+			node.z = m_z[firstBody];
+		}
+	}
+
+	void SumChildren(std::vector<Node>& nodes, uint32_t index) const
+	{
+		double mass = 0.0, x = 0.0, y = 0.0, z = 0.0;
+		const Node& node = nodes[index];
+		for (uint32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c)
+		{
+			const Node& child = nodes[c];
+			mass += child.mass;
+			x += static_cast<double>(child.x) * child.mass;
+			y += static_cast<double>(child.y) * child.mass;
+			z += static_cast<double>(child.z) * child.mass;
+		}
+		SetMoments(nodes[index], mass, x, y, z, node.begin);
+	}
+
+	// Fills nodes[index] with the cell holding the sorted bodies [begin, end) at the given depth. Its children
+	// are reserved side by side before any of them is filled, which keeps every sibling group contiguous.
+	void Fill(std::vector<Node>& nodes, uint32_t index, uint32_t begin, uint32_t end, int level) const
+	{
+		using namespace BarnesHutDetail;
+		nodes[index].width = m_width / static_cast<float>(1u << level);
+		if (end - begin <= LEAF_SIZE || level == MORTON_BITS)
+		{
+			MakeLeaf(nodes[index], begin, end);
+			return;
+		}
+
+		uint32_t starts[9];
+		uint32_t childCount = 0;
+		for (uint32_t octant = 0; octant < 8; ++octant) starts[octant] = OctantStart(begin, end, level + 1, octant);
+		starts[8] = end;
+		for (uint32_t octant = 0; octant < 8; ++octant) childCount += (starts[octant + 1] > starts[octant]) ? 1u : 0u;
+
+		const uint32_t first = static_cast<uint32_t>(nodes.size());
+		nodes.resize(nodes.size() + childCount);
+		nodes[index].firstChild = first;
+		nodes[index].childCount = childCount;
+		nodes[index].begin = begin;
+		nodes[index].end = end;
+
+		uint32_t slot = first;
+		for (uint32_t octant = 0; octant < 8; ++octant)
+		{
+			if (starts[octant + 1] > starts[octant]) Fill(nodes, slot++, starts[octant], starts[octant + 1], level + 1);
+		}
+		SumChildren(nodes, index);
+	}
+
+	// The root and the cells above SPLIT_LEVEL go first, forced open whatever their size, followed by the
+	// non-empty SPLIT_LEVEL cells. Each of those is built alone into its own array (its root in slot 0) and
+	// then copied after the top levels with its child indices shifted.
+	template <typename ParallelFor>
+	void BuildNodes(ParallelFor& parallelFor)
+	{
+		using namespace BarnesHutDetail;
+		const uint32_t count = static_cast<uint32_t>(m_count);
+		if (count <= LEAF_SIZE)
+		{
+			m_nodes.resize(1);
+			m_nodes[0].width = m_width;
+			MakeLeaf(m_nodes[0], 0, count);
+			return;
+		}
+
+		// Body range of every cell at SPLIT_LEVEL; the key's top bits are the cell's index at that depth
+		const int splitShift = 3 * (MORTON_BITS - SPLIT_LEVEL);
+		uint32_t cellStart[SUBTREES + 1];
+		for (uint32_t cell = 0; cell < SUBTREES; ++cell)
+		{
+			cellStart[cell] = static_cast<uint32_t>(std::partition_point(m_keys.begin(), m_keys.end(),
+				[&](uint64_t key) { return (key >> splitShift) < cell; }) - m_keys.begin());
+		}
+		cellStart[SUBTREES] = count;
+
+		m_subtrees.resize(SUBTREES);
+		parallelFor(SUBTREES, 1, [&](size_t begin, size_t end) {
+			for (size_t cell = begin; cell < end; ++cell)
+			{
+				std::vector<Node>& nodes = m_subtrees[cell];
+				nodes.clear();
+				if (cellStart[cell + 1] == cellStart[cell]) continue;
+				nodes.resize(1);
+				Fill(nodes, 0, cellStart[cell], cellStart[cell + 1], SPLIT_LEVEL);
+			}
+		});
+
+		// Top levels, breadth first: level by level, each cell's non-empty children side by side
+		m_nodes.clear();
+		m_nodes.push_back(Node{});
+		m_nodes[0].width = m_width;
+		m_nodes[0].begin = 0;
+		m_nodes[0].end = count;
+		std::vector<uint32_t> levelNodes{ 0 };
+		std::vector<uint32_t> levelCells{ 0 };
+		m_subtreeSlot.assign(SUBTREES, 0);
+		uint32_t firstSplitNode = 0;
+		for (int level = 1; level <= SPLIT_LEVEL; ++level)
+		{
+			firstSplitNode = static_cast<uint32_t>(m_nodes.size());
+			std::vector<uint32_t> nextNodes, nextCells;
+			for (size_t k = 0; k < levelNodes.size(); ++k)
+			{
+				const uint32_t parent = levelNodes[k];
+				m_nodes[parent].firstChild = static_cast<uint32_t>(m_nodes.size());
+				m_nodes[parent].childCount = 0;
+				for (uint32_t octant = 0; octant < 8; ++octant)
+				{
+					// Range of the child cell, from the SPLIT_LEVEL cells it covers
+					const uint32_t cell = levelCells[k] * 8 + octant;
+					const uint32_t span = 1u << (3 * (SPLIT_LEVEL - level));
+					const uint32_t begin = cellStart[cell * span], end = cellStart[(cell + 1) * span];
+					if (begin == end) continue;
+
+					Node child{};
+					child.width = m_width / static_cast<float>(1u << level);
+					child.begin = begin;
+					child.end = end;
+					if (level == SPLIT_LEVEL) m_subtreeSlot[cell] = static_cast<uint32_t>(m_nodes.size());
+					nextNodes.push_back(static_cast<uint32_t>(m_nodes.size()));
+					nextCells.push_back(cell);
+					m_nodes.push_back(child);
+					m_nodes[parent].childCount++;
+				}
+			}
+			levelNodes.swap(nextNodes);
+			levelCells.swap(nextCells);
+		}
+
+		// Splice: a subtree's root replaces its placeholder, the rest is appended in cell order
+		const uint32_t topCount = static_cast<uint32_t>(m_nodes.size());
+		uint32_t offsets[SUBTREES];
+		uint32_t total = topCount;
+		for (uint32_t cell = 0; cell < SUBTREES; ++cell)
+		{
+			offsets[cell] = total;
+			if (!m_subtrees[cell].empty()) total += static_cast<uint32_t>(m_subtrees[cell].size()) - 1;
+		}
+		m_nodes.resize(total);
+		parallelFor(SUBTREES, 1, [&](size_t begin, size_t end) {
+			for (size_t cell = begin; cell < end; ++cell)
+			{
+				const std::vector<Node>& nodes = m_subtrees[cell];
+				if (nodes.empty()) continue;
+				// Local index l >= 1 lands at offset + l - 1
+				const uint32_t shift = offsets[cell] - 1;
+				for (size_t l = 0; l < nodes.size(); ++l)
+				{
+					Node node = nodes[l];
+					if (node.childCount > 0) node.firstChild += shift;
+					m_nodes[l == 0 ? m_subtreeSlot[cell] : shift + l] = node;
+				}
+			}
+		});
+
+		// Moments of the levels above the subtrees, deepest first; breadth-first order puts children after parents
+		for (uint32_t i = firstSplitNode; i-- > 0;) SumChildren(m_nodes, i);
+	}
+
+	// Cells accepted for every body of the group, measured from the nearest point of the group's bounding box
+	void GatherGroup(const Node& group, const GravitySettings& settings, BarnesHutDetail::InteractionList& list) const
+	{
+		using namespace BarnesHutDetail;
+		glm::vec3 lo(m_x[group.begin], m_y[group.begin], m_z[group.begin]), hi = lo;
+		for (uint32_t i = group.begin + 1; i < group.end; ++i)
+		{
+			lo = glm::min(lo, glm::vec3(m_x[i], m_y[i], m_z[i]));
+			hi = glm::max(hi, glm::vec3(m_x[i], m_y[i], m_z[i]));
+		}
+
+		const float theta2 = settings.theta * settings.theta;
+		list.Clear();
+		uint32_t stack[8 * (MORTON_BITS + 1)];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const Node& node = m_nodes[stack[--top]];
+			const float dx = std::max(std::max(lo.x - node.x, node.x - hi.x), 0.0f);
+			const float dy = std::max(std::max(lo.y - node.y, node.y - hi.y), 0.0f);
+			const float dz = std::max(std::max(lo.z - node.z, node.z - hi.z), 0.0f);
+			if (node.width * node.width < theta2 * (dx * dx + dy * dy + dz * dz))
+			{
+				list.Add(node.x, node.y, node.z, node.mass);
+			}
+			else if (node.childCount == 0)
+			{
+				for (uint32_t j = node.begin; j < node.end; ++j) list.Add(m_x[j], m_y[j], m_z[j], m_mass[j]);
+			}
+			else
+			{
+				for (uint32_t c = 0; c < node.childCount; ++c) stack[top++] = node.firstChild + c;
+			}
+		}
+	}
+
+	glm::vec3 Walk(float px, float py, float pz, const GravitySettings& settings, uint64_t& interactions) const
+	{
+		using namespace BarnesHutDetail;
+		if (m_nodes.empty()) return glm::vec3(0.0f);
+
+		const float eps2 = settings.softening * settings.softening;
+		const float theta2 = settings.theta * settings.theta;
+		float ax = 0.0f, ay = 0.0f, az = 0.0f;
+
+		// Every level pushes at most 8 children after popping its parent
+		uint32_t stack[8 * (MORTON_BITS + 1)];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0)
+		{
+			const Node& node = m_nodes[stack[--top]];
+			const float dx = node.x - px, dy = node.y - py, dz = node.z - pz;
+			const float r2 = dx * dx + dy * dy + dz * dz;
+			if (node.width * node.width < theta2 * r2)
+			{
+				AddPull(ax, ay, az, dx, dy, dz, node.mass, eps2);
+				++interactions;
+			}
+			else if (node.childCount == 0)
+			{
+				for (uint32_t j = node.begin; j < node.end; ++j)
+				{
+					AddPull(ax, ay, az, m_x[j] - px, m_y[j] - py, m_z[j] - pz, m_mass[j], eps2);
+				}
+				interactions += node.end - node.begin;
+			}
+			else
+			{
+				for (uint32_t c = 0; c < node.childCount; ++c) stack[top++] = node.firstChild + c;
+			}
+		}
+		return glm::vec3(ax, ay, az) * settings.G;
+	}
+
+	std::vector<Node> m_nodes;
+	std::vector<uint32_t> m_groups; // Node indices
+	std::vector<std::vector<Node>> m_subtrees;
+	std::vector<uint32_t> m_subtreeSlot;
+	size_t m_count = 0;
+	glm::vec3 m_origin{ 0.0f };
+	float m_width = 0.0f;
+
+	// Bodies in key order
+	std::vector<float> m_x, m_y, m_z, m_mass;
+	std::vector<uint64_t> m_keys, m_keyScratch;
+	std::vector<uint32_t> m_order, m_orderScratch;
+	std::vector<uint32_t> m_histogram;
+	std::vector<glm::vec3> m_chunkLo, m_chunkHi;
+	mutable uint64_t m_interactions = 0;
+};
@@ -0,0 +1,142 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BODYSOA_USE_SSE 1
+#endif
+
+enum class IntegrationMethod {
+	ExplicitEuler,
+	SemiImplicitEuler,
+	RK4
+};
+
+// Hot integration state for a set of dynamic bodies, stored as one contiguous float array per component.
+// Only bodies that actually move are stored (static and zero inverse mass bodies are filtered out by the
+// caller), so the integrator runs without per-body branches. Everything else (rotation, scale, matrices,
+// material values) stays in the owning components.
+struct BodySoA
+{
+	std::vector<float> posX, posY, posZ;
+	std::vector<float> velX, velY, velZ;
+	std::vector<float> forceX, forceY, forceZ;
+	std::vector<float> inverseMass;
+
+	size_t Size() const { return inverseMass.size(); }
+
+	void Clear()
+	{
+		ForEachColumn([](std::vector<float>& column) { column.clear(); });
+	}
+
+	void Reserve(size_t count)
+	{
+		ForEachColumn([count](std::vector<float>& column) { column.reserve(count); });
+	}
+
+	size_t Add(const glm::vec3& position, const glm::vec3& velocity, const glm::vec3& force, float invMass)
+	{
+		posX.push_back(position.x); posY.push_back(position.y); posZ.push_back(position.z);
+		velX.push_back(velocity.x); velY.push_back(velocity.y); velZ.push_back(velocity.z);
+		forceX.push_back(force.x); forceY.push_back(force.y); forceZ.push_back(force.z);
+		inverseMass.push_back(invMass);
+		return Size() - 1;
+	}
+
+	glm::vec3 Position(size_t i) const { return glm::vec3(posX[i], posY[i], posZ[i]); }
+	glm::vec3 Velocity(size_t i) const { return glm::vec3(velX[i], velY[i], velZ[i]); }
+	glm::vec3 Force(size_t i) const { return glm::vec3(forceX[i], forceY[i], forceZ[i]); }
+
+	void SetPosition(size_t i, const glm::vec3& p) { posX[i] = p.x; posY[i] = p.y; posZ[i] = p.z; }
+	void SetVelocity(size_t i, const glm::vec3& v) { velX[i] = v.x; velY[i] = v.y; velZ[i] = v.z; }
+
+private:
+	template <typename Fn>
+	void ForEachColumn(Fn&& fn)
+	{
+		for (auto* column : { &posX, &posY, &posZ, &velX, &velY, &velZ, &forceX, &forceY, &forceZ, &inverseMass }) fn(*column);
+	}
+};
+
+namespace BodySoADetail
+{
+	// One axis of one body. a = F/m + g; RK4 under constant acceleration reduces to the exact
+	// x += v*dt + a*dt^2/2, which is what the four stages of the AoS integrator sum to.
+	inline void IntegrateAxis(float& x, float& v, float& f, float invMass, float g, float dt, float damping, IntegrationMethod method)
+	{
+		const float a = f * invMass + g;
+		if (method == IntegrationMethod::ExplicitEuler) {
+			x += v * dt;
+			v += a * dt;
+		}
+		else if (method == IntegrationMethod::SemiImplicitEuler) {
+			v += a * dt;
+			x += v * dt;
+		}
+		else {
+			x += v * dt + a * (0.5f * dt * dt);
+			v += a * dt;
+		}
+		f = 0.0f;
+		v *= damping;
+	}
+
+#ifdef BODYSOA_USE_SSE
+	inline void IntegrateAxis4(float* x, float* v, float* f, const float* invMass, float g, float dt, float damping, IntegrationMethod method)
+	{
+		const __m128 dtv = _mm_set1_ps(dt);
+		__m128 xs = _mm_loadu_ps(x);
+		__m128 vs = _mm_loadu_ps(v);
+		const __m128 as = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(f), _mm_loadu_ps(invMass)), _mm_set1_ps(g));
+
+		if (method == IntegrationMethod::ExplicitEuler) {
+			xs = _mm_add_ps(xs, _mm_mul_ps(vs, dtv));
+			vs = _mm_add_ps(vs, _mm_mul_ps(as, dtv));
+		}
+		else if (method == IntegrationMethod::SemiImplicitEuler) {
+			vs = _mm_add_ps(vs, _mm_mul_ps(as, dtv));
+			xs = _mm_add_ps(xs, _mm_mul_ps(vs, dtv));
+		}
+		else {
+			const __m128 halfDtSq = _mm_set1_ps(0.5f * dt * dt);
+			xs = _mm_add_ps(xs, _mm_add_ps(_mm_mul_ps(vs, dtv), _mm_mul_ps(as, halfDtSq)));
+			vs = _mm_add_ps(vs, _mm_mul_ps(as, dtv));
+		}
+
+		_mm_storeu_ps(x, xs);
+		_mm_storeu_ps(v, _mm_mul_ps(vs, _mm_set1_ps(damping)));
+		_mm_storeu_ps(f, _mm_setzero_ps());
+	}
+#endif
+
+	inline void IntegrateColumn(float* x, float* v, float* f, const float* invMass, size_t count, float g, float dt, float damping, IntegrationMethod method)
+	{
+		size_t i = 0;
+#ifdef BODYSOA_USE_SSE
+		for (; i + 4 <= count; i += 4) {
+			IntegrateAxis4(x + i, v + i, f + i, invMass + i, g, dt, damping, method);
+		}
+#endif
+		for (; i < count; ++i) {
+			IntegrateAxis(x[i], v[i], f[i], invMass[i], g, dt, damping, method);
+		}
+	}
+}
+
+// Advances every body by dt: applies accumulated force plus gravity, integrates with the chosen
+// method, clears the force accumulators and applies velocity damping. The three axes are independent,
+// so each is processed as its own 4-wide column pass.
+inline void IntegrateBodies(BodySoA& bodies, float dt, const glm::vec3& gravity, IntegrationMethod method, float damping)
+{
+	const size_t count = bodies.Size();
+	if (count == 0) return;
+
+	const float* invMass = bodies.inverseMass.data();
+	BodySoADetail::IntegrateColumn(bodies.posX.data(), bodies.velX.data(), bodies.forceX.data(), invMass, count, gravity.x, dt, damping, method);
+	BodySoADetail::IntegrateColumn(bodies.posY.data(), bodies.velY.data(), bodies.forceY.data(), invMass, count, gravity.y, dt, damping, method);
+	BodySoADetail::IntegrateColumn(bodies.posZ.data(), bodies.velZ.data(), bodies.forceZ.data(), invMass, count, gravity.z, dt, damping, method);
+}
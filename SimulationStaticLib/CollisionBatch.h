@@ -0,0 +1,305 @@
+#pragma once
+#include "PhysicsHelper.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define COLLISIONBATCH_USE_SSE 1
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COLLISIONBATCH_USE_AVX2 1
+#endif
+
+// Spheres stored as one float array per field, for the batch kernels below.
+// A pair batch is two SphereSoA of equal size: pair i is (a[i], b[i]).
+struct SphereSoA
+{
+	std::vector<float> posX, posY, posZ, radius;
+	std::vector<float> velX, velY, velZ, mass, restitution;
+
+	size_t Size() const { return radius.size(); }
+
+	void Clear()
+	{
+		ForEachColumn([](std::vector<float>& column) { column.clear(); });
+	}
+
+	void Reserve(size_t count)
+	{
+		ForEachColumn([count](std::vector<float>& column) { column.reserve(count); });
+	}
+
+	size_t Add(const MovingSphere& s)
+	{
+		const glm::vec3& p = s.sphere.Position();
+		posX.push_back(p.x); posY.push_back(p.y); posZ.push_back(p.z); radius.push_back(s.sphere.m_radius);
+		velX.push_back(s.velocity.x); velY.push_back(s.velocity.y); velZ.push_back(s.velocity.z);
+		mass.push_back(s.mass); restitution.push_back(s.restitution);
+		return Size() - 1;
+	}
+
+	glm::vec3 Position(size_t i) const { return glm::vec3(posX[i], posY[i], posZ[i]); }
+	glm::vec3 Velocity(size_t i) const { return glm::vec3(velX[i], velY[i], velZ[i]); }
+
+private:
+	template <typename Fn>
+	void ForEachColumn(Fn&& fn)
+	{
+		for (auto* column : { &posX, &posY, &posZ, &radius, &velX, &velY, &velZ, &mass, &restitution }) fn(*column);
+	}
+};
+
+// The kernels repeat the scalar functions' operations in the same order (dot products as (x + y) + z,
+// the elastic impulse in double), so each lane is bit-identical to Sphere::CollideWith,
+// Plane::GetSignedDistance / Intersects(Sphere) and ResolveElasticCollision unless the compiler fuses the
+// scalar multiply-adds (e.g. /fp:fast or -ffp-contract=fast with FMA), which can move a result by 1-2 ULP.
+// 8 lanes run per iteration with AVX2, 4 with SSE2, and the remainder goes through the scalar code.
+namespace CollisionBatchDetail
+{
+	constexpr float EPS = 1e-6f; // Same tolerance as Sphere and Plane
+
+	inline bool CollideScalar(const SphereSoA& a, const SphereSoA& b, size_t i)
+	{
+		const float dx = a.posX[i] - b.posX[i];
+		const float dy = a.posY[i] - b.posY[i];
+		const float dz = a.posZ[i] - b.posZ[i];
+		const float rSum = a.radius[i] + b.radius[i];
+		return (dx * dx + dy * dy) + dz * dz <= (rSum * rSum) + EPS;
+	}
+
+	inline float SignedDistanceScalar(const SphereSoA& s, const glm::vec3& n, float d, size_t i)
+	{
+		return ((n.x * s.posX[i] + n.y * s.posY[i]) + n.z * s.posZ[i]) + d;
+	}
+
+	inline void ResolveElasticScalar(SphereSoA& a, SphereSoA& b, size_t i)
+	{
+		MovingSphere sa(a.Position(i), a.radius[i], a.Velocity(i), a.mass[i], a.restitution[i]);
+		MovingSphere sb(b.Position(i), b.radius[i], b.Velocity(i), b.mass[i], b.restitution[i]);
+		ResolveElasticCollision(sa, sb);
+		a.velX[i] = sa.velocity.x; a.velY[i] = sa.velocity.y; a.velZ[i] = sa.velocity.z;
+		b.velX[i] = sb.velocity.x; b.velY[i] = sb.velocity.y; b.velZ[i] = sb.velocity.z;
+	}
+
+#ifdef COLLISIONBATCH_USE_SSE
+	inline __m128 Dot4(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+	{
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+	}
+
+	inline __m128 Select4(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+	}
+
+	// j = -((1 + e) * v) / ((1/ma + 1/mb) * distSq) for two lanes, in double like the scalar code
+	inline __m128d Impulse2(__m128d restA, __m128d restB, __m128d massA, __m128d massB, __m128d velAlongNormal, __m128d distSq)
+	{
+		const __m128d one = _mm_set1_pd(1.0);
+		const __m128d e = _mm_mul_pd(restA, restB);
+		const __m128d invMassSum = _mm_add_pd(_mm_div_pd(one, massA), _mm_div_pd(one, massB));
+		const __m128d j = _mm_xor_pd(_mm_mul_pd(_mm_add_pd(one, e), velAlongNormal), _mm_set1_pd(-0.0)); // Negate, as -(x)
+		return _mm_div_pd(j, _mm_mul_pd(invMassSum, distSq));
+	}
+
+	inline __m128d Low2(__m128 v) { return _mm_cvtps_pd(v); }
+	inline __m128d High2(__m128 v) { return _mm_cvtps_pd(_mm_movehl_ps(v, v)); }
+#endif
+
+#ifdef COLLISIONBATCH_USE_AVX2
+	inline __m256 Dot8(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz)
+	{
+		// Separate multiply and add (not FMA) so the rounding matches the scalar dot product
+		return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+	}
+
+	inline __m256d Impulse4(__m256d restA, __m256d restB, __m256d massA, __m256d massB, __m256d velAlongNormal, __m256d distSq)
+	{
+		const __m256d one = _mm256_set1_pd(1.0);
+		const __m256d e = _mm256_mul_pd(restA, restB);
+		const __m256d invMassSum = _mm256_add_pd(_mm256_div_pd(one, massA), _mm256_div_pd(one, massB));
+		const __m256d j = _mm256_xor_pd(_mm256_mul_pd(_mm256_add_pd(one, e), velAlongNormal), _mm256_set1_pd(-0.0));
+		return _mm256_div_pd(j, _mm256_mul_pd(invMassSum, distSq));
+	}
+
+	inline __m256d Low4(__m256 v) { return _mm256_cvtps_pd(_mm256_castps256_ps128(v)); }
+	inline __m256d High4(__m256 v) { return _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)); }
+#endif
+}
+
+// hits[i] = 1 when sphere a[i] overlaps sphere b[i] (Sphere::CollideWith), else 0
+inline void CollideSpheresBatch(const SphereSoA& a, const SphereSoA& b, uint8_t* hits)
+{
+	using namespace CollisionBatchDetail;
+	const size_t count = a.Size();
+	size_t i = 0;
+
+#ifdef COLLISIONBATCH_USE_AVX2
+	const __m256 eps8 = _mm256_set1_ps(EPS);
+	for (; i + 8 <= count; i += 8) {
+		const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&a.posX[i]), _mm256_loadu_ps(&b.posX[i]));
+		const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&a.posY[i]), _mm256_loadu_ps(&b.posY[i]));
+		const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(&a.posZ[i]), _mm256_loadu_ps(&b.posZ[i]));
+		const __m256 rSum = _mm256_add_ps(_mm256_loadu_ps(&a.radius[i]), _mm256_loadu_ps(&b.radius[i]));
+		const __m256 limit = _mm256_add_ps(_mm256_mul_ps(rSum, rSum), eps8);
+		const int mask = _mm256_movemask_ps(_mm256_cmp_ps(Dot8(dx, dy, dz, dx, dy, dz), limit, _CMP_LE_OQ));
+		for (int lane = 0; lane < 8; ++lane) hits[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+	}
+#endif
+#ifdef COLLISIONBATCH_USE_SSE
+	const __m128 eps4 = _mm_set1_ps(EPS);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&a.posX[i]), _mm_loadu_ps(&b.posX[i]));
+		const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&a.posY[i]), _mm_loadu_ps(&b.posY[i]));
+		const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&a.posZ[i]), _mm_loadu_ps(&b.posZ[i]));
+		const __m128 rSum = _mm_add_ps(_mm_loadu_ps(&a.radius[i]), _mm_loadu_ps(&b.radius[i]));
+		const __m128 limit = _mm_add_ps(_mm_mul_ps(rSum, rSum), eps4);
+		const int mask = _mm_movemask_ps(_mm_cmple_ps(Dot4(dx, dy, dz, dx, dy, dz), limit));
+		for (int lane = 0; lane < 4; ++lane) hits[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+	}
+#endif
+	for (; i < count; ++i) {
+		hits[i] = CollideScalar(a, b, i) ? 1 : 0;
+	}
+}
+
+// distances[i] = Plane::GetSignedDistance(center of sphere i); positive on the normal's side
+inline void SpherePlaneDistancesBatch(const SphereSoA& spheres, const Plane& plane, float* distances)
+{
+	using namespace CollisionBatchDetail;
+	const size_t count = spheres.Size();
+	const glm::vec3 n = plane.GetNormal();
+	const float d = plane.GetOffset();
+	size_t i = 0;
+
+#ifdef COLLISIONBATCH_USE_AVX2
+	const __m256 nx8 = _mm256_set1_ps(n.x), ny8 = _mm256_set1_ps(n.y), nz8 = _mm256_set1_ps(n.z), d8 = _mm256_set1_ps(d);
+	for (; i + 8 <= count; i += 8) {
+		const __m256 dot = Dot8(nx8, ny8, nz8, _mm256_loadu_ps(&spheres.posX[i]), _mm256_loadu_ps(&spheres.posY[i]), _mm256_loadu_ps(&spheres.posZ[i]));
+		_mm256_storeu_ps(distances + i, _mm256_add_ps(dot, d8));
+	}
+#endif
+#ifdef COLLISIONBATCH_USE_SSE
+	const __m128 nx4 = _mm_set1_ps(n.x), ny4 = _mm_set1_ps(n.y), nz4 = _mm_set1_ps(n.z), d4 = _mm_set1_ps(d);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 dot = Dot4(nx4, ny4, nz4, _mm_loadu_ps(&spheres.posX[i]), _mm_loadu_ps(&spheres.posY[i]), _mm_loadu_ps(&spheres.posZ[i]));
+		_mm_storeu_ps(distances + i, _mm_add_ps(dot, d4));
+	}
+#endif
+	for (; i < count; ++i) {
+		distances[i] = SignedDistanceScalar(spheres, n, d, i);
+	}
+}
+
+// hits[i] = Plane::Intersects(sphere i): within radius of the plane and, for a finite plane, of its extent.
+// distances must come from SpherePlaneDistancesBatch for the same spheres and plane.
+inline void SpheresTouchPlaneBatch(const SphereSoA& spheres, const Plane& plane, const float* distances, uint8_t* hits)
+{
+	using namespace CollisionBatchDetail;
+	const size_t count = spheres.Size();
+	const glm::vec3 n = plane.GetNormal();
+	const glm::vec3 origin = plane.Position();
+	const float size = plane.GetSize();
+
+	for (size_t i = 0; i < count; ++i) {
+		bool hit = std::abs(distances[i]) <= spheres.radius[i] + EPS;
+		if (hit && size > 0.0f) {
+			// Rare (only spheres already within reach of the plane), so kept scalar
+			const glm::vec3 toSphere = spheres.Position(i) - origin;
+			const glm::vec3 pointOnPlane = toSphere - (n * glm::dot(toSphere, n));
+			hit = glm::length(pointOnPlane) <= size + spheres.radius[i] + EPS;
+		}
+		hits[i] = hit ? 1 : 0;
+	}
+}
+
+// Applies ResolveElasticCollision to every pair (a[i], b[i]), updating both velocities.
+// No sphere may appear in two pairs of one batch (see ConstraintColoring).
+inline void ResolveElasticBatch(SphereSoA& a, SphereSoA& b)
+{
+	using namespace CollisionBatchDetail;
+	const size_t count = a.Size();
+	size_t i = 0;
+
+#ifdef COLLISIONBATCH_USE_AVX2
+	const __m256 zero8 = _mm256_setzero_ps();
+	const __m256 one8 = _mm256_set1_ps(1.0f);
+	for (; i + 8 <= count; i += 8) {
+		const __m256 nx = _mm256_sub_ps(_mm256_loadu_ps(&b.posX[i]), _mm256_loadu_ps(&a.posX[i]));
+		const __m256 ny = _mm256_sub_ps(_mm256_loadu_ps(&b.posY[i]), _mm256_loadu_ps(&a.posY[i]));
+		const __m256 nz = _mm256_sub_ps(_mm256_loadu_ps(&b.posZ[i]), _mm256_loadu_ps(&a.posZ[i]));
+		const __m256 distSq = Dot8(nx, ny, nz, nx, ny, nz);
+
+		const __m256 avx = _mm256_loadu_ps(&a.velX[i]), avy = _mm256_loadu_ps(&a.velY[i]), avz = _mm256_loadu_ps(&a.velZ[i]);
+		const __m256 bvx = _mm256_loadu_ps(&b.velX[i]), bvy = _mm256_loadu_ps(&b.velY[i]), bvz = _mm256_loadu_ps(&b.velZ[i]);
+		const __m256 velAlongNormal = Dot8(_mm256_sub_ps(avx, bvx), _mm256_sub_ps(avy, bvy), _mm256_sub_ps(avz, bvz), nx, ny, nz);
+
+		// Lanes the scalar code would return early from keep their velocities
+		const __m256 active = _mm256_and_ps(_mm256_cmp_ps(distSq, zero8, _CMP_NEQ_UQ), _mm256_cmp_ps(velAlongNormal, zero8, _CMP_NLT_UQ));
+		if (_mm256_movemask_ps(active) == 0) continue;
+
+		const __m256 restA = _mm256_loadu_ps(&a.restitution[i]), restB = _mm256_loadu_ps(&b.restitution[i]);
+		const __m256 massA = _mm256_loadu_ps(&a.mass[i]), massB = _mm256_loadu_ps(&b.mass[i]);
+		const __m128 jLow = _mm256_cvtpd_ps(Impulse4(Low4(restA), Low4(restB), Low4(massA), Low4(massB), Low4(velAlongNormal), Low4(distSq)));
+		const __m128 jHigh = _mm256_cvtpd_ps(Impulse4(High4(restA), High4(restB), High4(massA), High4(massB), High4(velAlongNormal), High4(distSq)));
+		const __m256 j = _mm256_insertf128_ps(_mm256_castps128_ps256(jLow), jHigh, 1);
+
+		const __m256 invA = _mm256_div_ps(one8, massA);
+		const __m256 invB = _mm256_div_ps(one8, massB);
+		const __m256 ix = _mm256_mul_ps(nx, j), iy = _mm256_mul_ps(ny, j), iz = _mm256_mul_ps(nz, j);
+
+		_mm256_storeu_ps(&a.velX[i], _mm256_blendv_ps(avx, _mm256_add_ps(avx, _mm256_mul_ps(ix, invA)), active));
+		_mm256_storeu_ps(&a.velY[i], _mm256_blendv_ps(avy, _mm256_add_ps(avy, _mm256_mul_ps(iy, invA)), active));
+		_mm256_storeu_ps(&a.velZ[i], _mm256_blendv_ps(avz, _mm256_add_ps(avz, _mm256_mul_ps(iz, invA)), active));
+		_mm256_storeu_ps(&b.velX[i], _mm256_blendv_ps(bvx, _mm256_sub_ps(bvx, _mm256_mul_ps(ix, invB)), active));
+		_mm256_storeu_ps(&b.velY[i], _mm256_blendv_ps(bvy, _mm256_sub_ps(bvy, _mm256_mul_ps(iy, invB)), active));
+		_mm256_storeu_ps(&b.velZ[i], _mm256_blendv_ps(bvz, _mm256_sub_ps(bvz, _mm256_mul_ps(iz, invB)), active));
+	}
+#endif
+#ifdef COLLISIONBATCH_USE_SSE
+	const __m128 zero4 = _mm_setzero_ps();
+	const __m128 one4 = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4) {
+		const __m128 nx = _mm_sub_ps(_mm_loadu_ps(&b.posX[i]), _mm_loadu_ps(&a.posX[i]));
+		const __m128 ny = _mm_sub_ps(_mm_loadu_ps(&b.posY[i]), _mm_loadu_ps(&a.posY[i]));
+		const __m128 nz = _mm_sub_ps(_mm_loadu_ps(&b.posZ[i]), _mm_loadu_ps(&a.posZ[i]));
+		const __m128 distSq = Dot4(nx, ny, nz, nx, ny, nz);
+
+		const __m128 avx = _mm_loadu_ps(&a.velX[i]), avy = _mm_loadu_ps(&a.velY[i]), avz = _mm_loadu_ps(&a.velZ[i]);
+		const __m128 bvx = _mm_loadu_ps(&b.velX[i]), bvy = _mm_loadu_ps(&b.velY[i]), bvz = _mm_loadu_ps(&b.velZ[i]);
+		const __m128 velAlongNormal = Dot4(_mm_sub_ps(avx, bvx), _mm_sub_ps(avy, bvy), _mm_sub_ps(avz, bvz), nx, ny, nz);
+
+		const __m128 active = _mm_and_ps(_mm_cmpneq_ps(distSq, zero4), _mm_cmpnlt_ps(velAlongNormal, zero4));
+		if (_mm_movemask_ps(active) == 0) continue;
+
+		const __m128 restA = _mm_loadu_ps(&a.restitution[i]), restB = _mm_loadu_ps(&b.restitution[i]);
+		const __m128 massA = _mm_loadu_ps(&a.mass[i]), massB = _mm_loadu_ps(&b.mass[i]);
+		const __m128 jLow = _mm_cvtpd_ps(Impulse2(Low2(restA), Low2(restB), Low2(massA), Low2(massB), Low2(velAlongNormal), Low2(distSq)));
+		const __m128 jHigh = _mm_cvtpd_ps(Impulse2(High2(restA), High2(restB), High2(massA), High2(massB), High2(velAlongNormal), High2(distSq)));
+		const __m128 j = _mm_movelh_ps(jLow, jHigh);
+
+		const __m128 invA = _mm_div_ps(one4, massA);
+		const __m128 invB = _mm_div_ps(one4, massB);
+		const __m128 ix = _mm_mul_ps(nx, j), iy = _mm_mul_ps(ny, j), iz = _mm_mul_ps(nz, j);
+
+		_mm_storeu_ps(&a.velX[i], Select4(active, _mm_add_ps(avx, _mm_mul_ps(ix, invA)), avx));
+		_mm_storeu_ps(&a.velY[i], Select4(active, _mm_add_ps(avy, _mm_mul_ps(iy, invA)), avy));
+		_mm_storeu_ps(&a.velZ[i], Select4(active, _mm_add_ps(avz, _mm_mul_ps(iz, invA)), avz));
+		_mm_storeu_ps(&b.velX[i], Select4(active, _mm_sub_ps(bvx, _mm_mul_ps(ix, invB)), bvx));
+		_mm_storeu_ps(&b.velY[i], Select4(active, _mm_sub_ps(bvy, _mm_mul_ps(iy, invB)), bvy));
+		_mm_storeu_ps(&b.velZ[i], Select4(active, _mm_sub_ps(bvz, _mm_mul_ps(iz, invB)), bvz));
+	}
+#endif
+	for (; i < count; ++i) {
+		ResolveElasticScalar(a, b, i);
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Splits constraints into batches in which no two constraints touch the same dynamic body, so the
+// constraints of one batch can be solved in parallel without locks. Greedy colouring: each constraint
+// takes the lowest colour none of its bodies has used yet. A body touching more than MAX_COLORS
+// constraints sends the extra ones to a final overflow batch that must be solved serially.
+class ConstraintColoring
+{
+public:
+	static constexpr uint32_t NO_BODY = UINT32_MAX; // Second body of a constraint against a static object
+	static constexpr uint32_t MAX_COLORS = 64;
+
+	struct Batch
+	{
+		uint32_t begin;
+		uint32_t end;
+		bool serial; // Overflow batch: its constraints may share bodies
+	};
+
+	// bodyA / bodyB hold the dynamic body indices (< bodyCount) of each constraint
+	void Build(const std::vector<uint32_t>& bodyA, const std::vector<uint32_t>& bodyB, size_t bodyCount)
+	{
+		const size_t count = bodyA.size();
+		m_usedColors.assign(bodyCount, 0);
+		m_colorOf.resize(count);
+		m_colorCount.assign(MAX_COLORS + 1, 0);
+
+		// 1. Colour each constraint in order
+		for (size_t i = 0; i < count; ++i) {
+			const uint32_t a = bodyA[i];
+			const uint32_t b = bodyB[i];
+			const uint64_t used = m_usedColors[a] | (b != NO_BODY ? m_usedColors[b] : 0);
+
+			uint32_t color = MAX_COLORS;
+			if (used != ~uint64_t(0)) {
+				color = LowestBit(~used);
+				m_usedColors[a] |= uint64_t(1) << color;
+				if (b != NO_BODY) m_usedColors[b] |= uint64_t(1) << color;
+			}
+			m_colorOf[i] = color;
+			m_colorCount[color]++;
+		}
+
+		// 2. Counting sort by colour, keeping the original order inside each batch
+		m_batches.clear();
+		std::vector<uint32_t>& start = m_colorCount;
+		uint32_t offset = 0;
+		for (uint32_t color = 0; color <= MAX_COLORS; ++color) {
+			const uint32_t n = start[color];
+			if (n > 0) m_batches.push_back({ offset, offset + n, color == MAX_COLORS });
+			start[color] = offset;
+			offset += n;
+		}
+
+		m_order.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			m_order[start[m_colorOf[i]]++] = static_cast<uint32_t>(i);
+		}
+	}
+
+	const std::vector<Batch>& Batches() const { return m_batches; }
+
+	// Constraint indices grouped by batch: Batch::begin..end index into this
+	const std::vector<uint32_t>& Order() const { return m_order; }
+
+private:
+	static uint32_t LowestBit(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanForward64(&bit, value);
+		return static_cast<uint32_t>(bit);
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+	}
+
+	std::vector<uint64_t> m_usedColors; // Per body: colours already taken by its constraints
+	std::vector<uint32_t> m_colorOf;
+	std::vector<uint32_t> m_colorCount;
+	std::vector<uint32_t> m_order;
+	std::vector<Batch> m_batches;
+};
@@ -0,0 +1,155 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+enum class ContactPhase : uint8_t
+{
+	Begin,   // Touching in this step but not in the one before
+	Persist, // Touching in both
+	End      // Touching in the step before only
+};
+
+struct ContactEvent
+{
+	uint32_t a, b;      // Body ids, a < b
+	ContactPhase phase;
+	glm::vec3 point;    // Where the bodies touch; the last one seen for End
+	glm::vec3 normal;   // From a towards b
+	float impulse;      // Normal impulse summed over the step, 0 for End
+};
+
+// Contacts of one simulation step (any number of substeps), classified against the step before.
+// Contacts are recorded as they are solved, several times per pair if several substeps see it. EndStep
+// sorts the records by pair, merges each pair into one event and walks them against the previous step's
+// pairs, which are kept sorted too. Every list is cleared rather than freed, so once the vectors have
+// grown to the scene's contact count a step allocates nothing.
+// A pair the step did not see can be kept touching without an event, for bodies that stopped being tested
+// rather than came apart (two bodies asleep against each other, say).
+class ContactEventBuffer
+{
+public:
+	// Starts a step: the last step's events are dropped, the pairs it left touching are kept for comparison
+	void BeginStep()
+	{
+		m_samples.clear();
+		m_events.clear();
+	}
+
+	void Record(uint32_t a, uint32_t b, const glm::vec3& point, const glm::vec3& normal, float impulse)
+	{
+		m_samples.push_back({ Key(a, b), static_cast<uint32_t>(m_samples.size()), point, a > b ? -normal : normal, impulse });
+	}
+
+	void EndStep()
+	{
+		EndStep([](uint32_t, uint32_t) { return false; });
+	}
+
+	// keep(a, b) is asked about each pair that touched last step but was not recorded in this one
+	template <typename Keep>
+	void EndStep(Keep&& keep)
+	{
+		// 1. One touch per pair: impulses add up, the latest point and normal win
+		std::sort(m_samples.begin(), m_samples.end(), [](const Sample& x, const Sample& y) {
+			return x.key != y.key ? x.key < y.key : x.order < y.order;
+		});
+		m_current.clear();
+		for (const Sample& sample : m_samples)
+		{
+			if (!m_current.empty() && m_current.back().key == sample.key)
+			{
+				Touch& touch = m_current.back();
+				touch.point = sample.point;
+				touch.normal = sample.normal;
+				touch.impulse += sample.impulse;
+			}
+			else
+			{
+				m_current.push_back({ sample.key, sample.point, sample.normal, sample.impulse });
+			}
+		}
+
+		// 2. Merge walk over both sorted pair lists, into the pairs left touching
+		m_next.clear();
+		size_t i = 0, j = 0;
+		while (i < m_current.size() || j < m_previous.size())
+		{
+			if (j == m_previous.size() || (i < m_current.size() && m_current[i].key < m_previous[j].key))
+			{
+				Emit(m_current[i], ContactPhase::Begin);
+				m_next.push_back(m_current[i++]);
+			}
+			else if (i == m_current.size() || m_previous[j].key < m_current[i].key)
+			{
+				Touch ended = m_previous[j++];
+				ended.impulse = 0.0f;
+				if (keep(static_cast<uint32_t>(ended.key >> 32), static_cast<uint32_t>(ended.key))) m_next.push_back(ended);
+				else Emit(ended, ContactPhase::End);
+			}
+			else
+			{
+				Emit(m_current[i], ContactPhase::Persist);
+				m_next.push_back(m_current[i++]);
+				++j;
+			}
+		}
+		m_previous.swap(m_next);
+	}
+
+	// Forgets the touching pairs too, so the next step starts every contact afresh
+	void Clear()
+	{
+		BeginStep();
+		m_current.clear();
+		m_next.clear();
+		m_previous.clear();
+	}
+
+	// Sorted by pair
+	const std::vector<ContactEvent>& Events() const { return m_events; }
+
+	size_t Count(ContactPhase phase) const
+	{
+		return static_cast<size_t>(std::count_if(m_events.begin(), m_events.end(), [phase](const ContactEvent& e) { return e.phase == phase; }));
+	}
+
+	// Pairs touching at the end of the last step
+	size_t TouchingCount() const { return m_previous.size(); }
+
+private:
+	struct Sample
+	{
+		uint64_t key;
+		uint32_t order; // Recording order, so the sort keeps the latest touch last
+		glm::vec3 point;
+		glm::vec3 normal;
+		float impulse;
+	};
+
+	struct Touch
+	{
+		uint64_t key;
+		glm::vec3 point;
+		glm::vec3 normal;
+		float impulse;
+	};
+
+	static uint64_t Key(uint32_t a, uint32_t b)
+	{
+		if (a > b) std::swap(a, b);
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+
+	void Emit(const Touch& touch, ContactPhase phase)
+	{
+		m_events.push_back({ static_cast<uint32_t>(touch.key >> 32), static_cast<uint32_t>(touch.key), phase, touch.point, touch.normal, touch.impulse });
+	}
+
+	std::vector<Sample> m_samples;
+	std::vector<Touch> m_current;
+	std::vector<Touch> m_previous;
+	std::vector<Touch> m_next;
+	std::vector<ContactEvent> m_events;
+};
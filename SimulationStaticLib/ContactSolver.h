@@ -0,0 +1,116 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct ContactSolverSettings
+{
+	int iterations = 8;
+	bool warmStarting = true;
+	float restitutionThreshold = 1.0f; // m/s; slower impacts do not bounce, so resting contacts stay quiet
+};
+
+// Velocity state of one dynamic body for the duration of a solve
+struct SolverBody
+{
+	glm::vec3 velocity;
+	float inverseMass;
+};
+
+// One non-penetration constraint between a dynamic body and either another dynamic body or a static one
+struct SolverContact
+{
+	static constexpr uint32_t NO_BODY = UINT32_MAX;
+
+	uint32_t a = 0;
+	uint32_t b = NO_BODY;
+	glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f); // From a towards b
+	float normalMass = 0.0f;                        // 1 / (invMassA + invMassB)
+	float velocityBias = 0.0f;                      // Separation speed the restitution asks for
+	float impulse = 0.0f;                           // Accumulated normal impulse, never negative
+	uint64_t key = 0;                               // ContactCache key of the body pair
+};
+
+// Accumulated impulses keyed by body pair, kept from one step to the next while the pair stays in
+// contact. Pairs that were not stored during a step are forgotten when it ends.
+class ContactCache
+{
+public:
+	static uint64_t Key(uint32_t idA, uint32_t idB)
+	{
+		if (idA > idB) std::swap(idA, idB);
+		return (static_cast<uint64_t>(idA) << 32) | idB;
+	}
+
+	float Find(uint64_t key) const
+	{
+		const auto it = m_current.find(key);
+		return (it != m_current.end()) ? it->second : 0.0f;
+	}
+
+	void Store(uint64_t key, float impulse) { m_next[key] = impulse; }
+
+	void EndStep()
+	{
+		m_current.swap(m_next);
+		m_next.clear();
+	}
+
+	void Clear()
+	{
+		m_current.clear();
+		m_next.clear();
+	}
+
+	size_t Size() const { return m_current.size(); }
+
+private:
+	std::unordered_map<uint64_t, float> m_current;
+	std::unordered_map<uint64_t, float> m_next;
+};
+
+namespace ContactSolverDetail
+{
+	inline glm::vec3 VelocityOf(const std::vector<SolverBody>& bodies, uint32_t index)
+	{
+		return (index == SolverContact::NO_BODY) ? glm::vec3(0.0f) : bodies[index].velocity;
+	}
+
+	inline void ApplyImpulse(SolverContact& c, std::vector<SolverBody>& bodies, float lambda)
+	{
+		const glm::vec3 p = c.normal * lambda;
+		bodies[c.a].velocity -= p * bodies[c.a].inverseMass;
+		if (c.b != SolverContact::NO_BODY) bodies[c.b].velocity += p * bodies[c.b].inverseMass;
+	}
+}
+
+// Fills in the effective mass and restitution target from the velocities before any impulse is applied
+inline void PrepareContact(SolverContact& c, const std::vector<SolverBody>& bodies, float restitution, const ContactSolverSettings& settings)
+{
+	const float invMassSum = bodies[c.a].inverseMass + (c.b != SolverContact::NO_BODY ? bodies[c.b].inverseMass : 0.0f);
+	c.normalMass = (invMassSum > 0.0f) ? 1.0f / invMassSum : 0.0f;
+
+	const float vn = glm::dot(ContactSolverDetail::VelocityOf(bodies, c.b) - bodies[c.a].velocity, c.normal);
+	c.velocityBias = (vn < -settings.restitutionThreshold) ? -restitution * vn : 0.0f;
+}
+
+// Re-applies last step's impulse, so a resting stack starts the iterations already close to balanced
+inline void WarmStartContact(SolverContact& c, std::vector<SolverBody>& bodies, float cachedImpulse)
+{
+	c.impulse = std::max(cachedImpulse, 0.0f);
+	if (c.impulse > 0.0f) ContactSolverDetail::ApplyImpulse(c, bodies, c.impulse);
+}
+
+// One sequential-impulse iteration of one contact. The accumulated impulse is clamped rather than each
+// correction, so later iterations may take back part of an earlier push without ever pulling.
+inline void SolveContact(SolverContact& c, std::vector<SolverBody>& bodies)
+{
+	const float vn = glm::dot(ContactSolverDetail::VelocityOf(bodies, c.b) - bodies[c.a].velocity, c.normal);
+	const float lambda = -c.normalMass * (vn - c.velocityBias);
+
+	const float previous = c.impulse;
+	c.impulse = std::max(previous + lambda, 0.0f);
+	ContactSolverDetail::ApplyImpulse(c, bodies, c.impulse - previous);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+
+// Accumulator for running a simulation at a fixed rate under a variable frame rate.
+// Frame time is banked and spent in whole steps, so the result depends only on the step length.
+// Leftover time carries into the next frame and is reported as an interpolation fraction.
+struct FixedTimestep
+{
+	float accumulator = 0.0f;
+
+	// Returns how many steps of stepTime to run this frame. When more than maxSteps are owed the
+	// backlog is dropped instead of carried, so one slow frame cannot snowball into slower ones.
+	int Advance(float frameTime, float stepTime, int maxSteps)
+	{
+		accumulator += std::max(frameTime, 0.0f);
+		int steps = static_cast<int>(accumulator / stepTime);
+		if (steps > maxSteps) {
+			steps = std::max(maxSteps, 0);
+			accumulator = 0.0f;
+		}
+		else {
+			accumulator -= static_cast<float>(steps) * stepTime;
+		}
+		return steps;
+	}
+
+	// How far the current state is past the last step, in [0, 1): the blend from previous to current pose
+	float Alpha(float stepTime) const
+	{
+		return std::clamp(accumulator / stepTime, 0.0f, 1.0f);
+	}
+
+	void Reset() { accumulator = 0.0f; }
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include "Plane.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Square raster of heights baked once from a height function and sampled bilinearly, so a query costs
+// four loads instead of re-evaluating the function. Covers [-halfExtent, halfExtent] on local X and Z
+// with resolution x resolution cells; queries outside are clamped to the border.
+class Heightfield
+{
+public:
+	template <typename Fn>
+	void Build(float halfExtent, int resolution, Fn&& heightAt)
+	{
+		m_resolution = std::max(resolution, 1);
+		m_halfExtent = std::max(halfExtent, 1e-3f);
+		m_cellSize = 2.0f * m_halfExtent / static_cast<float>(m_resolution);
+		m_invCellSize = 1.0f / m_cellSize;
+
+		const int n = m_resolution + 1;
+		m_heights.resize(static_cast<size_t>(n) * n);
+		for (int z = 0; z < n; ++z) {
+			const float pz = -m_halfExtent + static_cast<float>(z) * m_cellSize;
+			for (int x = 0; x < n; ++x) {
+				m_heights[static_cast<size_t>(z) * n + x] = heightAt(-m_halfExtent + static_cast<float>(x) * m_cellSize, pz);
+			}
+		}
+	}
+
+	bool Empty() const { return m_heights.empty(); }
+	int Resolution() const { return m_resolution; }
+	float CellSize() const { return m_cellSize; }
+	float HalfExtent() const { return m_halfExtent; }
+
+	bool Contains(float x, float z) const
+	{
+		return !Empty() && std::abs(x) <= m_halfExtent && std::abs(z) <= m_halfExtent;
+	}
+
+	float Height(float x, float z) const
+	{
+		if (Empty()) return 0.0f;
+		const Cell c = Locate(x, z);
+		const float h0 = c.h00 + (c.h10 - c.h00) * c.fx;
+		const float h1 = c.h01 + (c.h11 - c.h01) * c.fx;
+		return h0 + (h1 - h0) * c.fz;
+	}
+
+	// Normal of the bilinear surface, from its exact partial derivatives within the cell
+	glm::vec3 Normal(float x, float z) const
+	{
+		float height;
+		glm::vec3 normal;
+		Sample(x, z, height, normal);
+		return normal;
+	}
+
+	void Sample(float x, float z, float& height, glm::vec3& normal) const
+	{
+		if (Empty()) {
+			height = 0.0f;
+			normal = glm::vec3(0.0f, 1.0f, 0.0f);
+			return;
+		}
+		const Cell c = Locate(x, z);
+		const float h0 = c.h00 + (c.h10 - c.h00) * c.fx;
+		const float h1 = c.h01 + (c.h11 - c.h01) * c.fx;
+		height = h0 + (h1 - h0) * c.fz;
+
+		const float dx = ((c.h10 - c.h00) + ((c.h11 - c.h01) - (c.h10 - c.h00)) * c.fz) * m_invCellSize;
+		const float dz = (h1 - h0) * m_invCellSize;
+		normal = glm::normalize(glm::vec3(-dx, 1.0f, -dz));
+	}
+
+	// Tangent plane of the surface under (x, z), in the field's local space
+	Plane TangentPlane(float x, float z) const
+	{
+		float height;
+		glm::vec3 normal;
+		Sample(x, z, height, normal);
+		return Plane(glm::vec3(x, height, z), normal);
+	}
+
+	// Batch queries over (x, z) points in local space
+	void Heights(const glm::vec2* points, size_t count, float* heights) const
+	{
+		for (size_t i = 0; i < count; ++i) heights[i] = Height(points[i].x, points[i].y);
+	}
+
+	void Samples(const glm::vec2* points, size_t count, float* heights, glm::vec3* normals) const
+	{
+		for (size_t i = 0; i < count; ++i) Sample(points[i].x, points[i].y, heights[i], normals[i]);
+	}
+
+private:
+	struct Cell
+	{
+		float h00, h10, h01, h11; // Corner heights: (x, z), (x + 1, z), (x, z + 1), (x + 1, z + 1)
+		float fx, fz;             // Position inside the cell, in [0, 1]
+	};
+
+	Cell Locate(float x, float z) const
+	{
+		const float gx = std::clamp((x + m_halfExtent) * m_invCellSize, 0.0f, static_cast<float>(m_resolution));
+		const float gz = std::clamp((z + m_halfExtent) * m_invCellSize, 0.0f, static_cast<float>(m_resolution));
+		const int cx = std::min(static_cast<int>(gx), m_resolution - 1);
+		const int cz = std::min(static_cast<int>(gz), m_resolution - 1);
+
+		const size_t n = static_cast<size_t>(m_resolution) + 1;
+		const size_t i = static_cast<size_t>(cz) * n + cx;
+		return { m_heights[i], m_heights[i + 1], m_heights[i + n], m_heights[i + n + 1],
+			gx - static_cast<float>(cx), gz - static_cast<float>(cz) };
+	}
+
+	std::vector<float> m_heights; // (resolution + 1)^2 samples, row-major in Z
+	int m_resolution = 0;
+	float m_halfExtent = 0.0f;
+	float m_cellSize = 1.0f;
+	float m_invCellSize = 1.0f;
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include "Heightfield.h"
+#include "Plane.h"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <vector>
+
+// Colliders that particle solvers (SPH fluid, XPBD cloth) push their particles out of for one step.
+// The particles do not push back: the bodies behind the colliders never see the contact.
+struct ParticleColliders
+{
+	struct Ball
+	{
+		glm::vec3 center;
+		float radius;
+		glm::vec3 velocity;
+	};
+
+	// Footprint radius 0 = the whole raster; the field follows the origin's translation only
+	struct Ground
+	{
+		const Heightfield* field;
+		glm::vec3 origin;
+		float footprintRadius;
+	};
+
+	std::vector<Plane> planes;
+	std::vector<Ball> spheres;
+	std::vector<Ground> heightfields;
+
+	void Clear()
+	{
+		planes.clear();
+		spheres.clear();
+		heightfields.clear();
+	}
+
+	bool Empty() const { return planes.empty() && spheres.empty() && heightfields.empty(); }
+
+	size_t Count() const { return planes.size() + spheres.size() + heightfields.size(); }
+
+	// Calls respond(normal, depth, colliderVelocity) for every collider the particle of the given radius at p
+	// overlaps. respond is expected to move p out along the normal before the next collider is tested;
+	// previous is where the particle started the step.
+	template <typename Respond>
+	void ForEachContact(const glm::vec3& previous, const glm::vec3& p, float radius, Respond&& respond) const
+	{
+		// Planes are two-sided: the particle stays on the side it started the step on
+		for (const Plane& plane : planes)
+		{
+			const float before = plane.GetSignedDistance(previous);
+			const float side = (before >= 0.0f) ? 1.0f : -1.0f;
+			const float dist = plane.GetSignedDistance(p) * side;
+			if (dist >= radius) continue;
+			if (plane.GetSize() > 0.0f)
+			{
+				const glm::vec3 along = p - plane.Position() - plane.GetNormal() * plane.GetSignedDistance(p);
+				if (glm::dot(along, along) > plane.GetSize() * plane.GetSize()) continue;
+			}
+			respond(plane.GetNormal() * side, radius - dist, glm::vec3(0.0f));
+		}
+
+		for (const Ball& ball : spheres)
+		{
+			const glm::vec3 delta = p - ball.center;
+			const float reach = ball.radius + radius;
+			const float d2 = glm::dot(delta, delta);
+			if (d2 >= reach * reach) continue;
+			const float d = std::sqrt(d2);
+			const glm::vec3 normal = (d > 1e-6f) ? delta / d : glm::vec3(0.0f, 1.0f, 0.0f);
+			respond(normal, reach - d, ball.velocity);
+		}
+
+		// Terrain is solid underneath, so anything below the surface is pushed back on top
+		for (const Ground& ground : heightfields)
+		{
+			const glm::vec3 local = p - ground.origin;
+			if (!ground.field->Contains(local.x, local.z)) continue;
+			if (ground.footprintRadius > 0.0f && local.x * local.x + local.z * local.z > ground.footprintRadius * ground.footprintRadius) continue;
+
+			float height;
+			glm::vec3 normal;
+			ground.field->Sample(local.x, local.z, height, normal);
+			const float dist = (local.y - height) * normal.y;
+			if (dist < radius) respond(normal, radius - dist, glm::vec3(0.0f));
+		}
+	}
+};
@@ -58,6 +58,8 @@ public:
 
 	glm::vec3 GetNormal() const { return m_normal; }
 	float GetSignedDistance(const glm::vec3& p) const { return glm::dot(m_normal, p) + m_d; }
+	float GetOffset() const { return m_d; } // d in dot(normal, p) + d = 0
+	float GetSize() const { return m_size; }
 
 private:
 	glm::vec3 m_normal;
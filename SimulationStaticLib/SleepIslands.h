@@ -0,0 +1,76 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Rest thresholds. A body counts as resting for a frame when both its speed and its kinetic energy are
+// below the limits; it may sleep once it has rested for framesToSleep consecutive frames.
+struct SleepSettings
+{
+	float linearVelocity = 0.15f; // m/s
+	float kineticEnergy = 0.05f;  // J
+	int framesToSleep = 30;
+};
+
+inline bool IsAtRest(const glm::vec3& velocity, float mass, const SleepSettings& settings)
+{
+	const float speedSq = glm::dot(velocity, velocity);
+	return speedSq < settings.linearVelocity * settings.linearVelocity
+		&& 0.5f * mass * speedSq < settings.kineticEnergy;
+}
+
+// Groups bodies into contact islands with a union-find over body indices.
+// Bodies linked by any chain of contacts end up in the same island, so an island can only
+// go to sleep (or wake up) as a whole.
+class IslandBuilder
+{
+public:
+	void Reset(size_t bodyCount)
+	{
+		m_parent.resize(bodyCount);
+		for (size_t i = 0; i < bodyCount; ++i) m_parent[i] = static_cast<uint32_t>(i);
+		m_size.assign(bodyCount, 1);
+	}
+
+	void Union(uint32_t a, uint32_t b)
+	{
+		a = Find(a);
+		b = Find(b);
+		if (a == b) return;
+
+		// Union by size keeps the trees shallow
+		if (m_size[a] < m_size[b]) std::swap(a, b);
+		m_parent[b] = a;
+		m_size[a] += m_size[b];
+	}
+
+	uint32_t Find(uint32_t a)
+	{
+		while (m_parent[a] != a) {
+			m_parent[a] = m_parent[m_parent[a]]; // Path halving
+			a = m_parent[a];
+		}
+		return a;
+	}
+
+	// Writes a dense island index (0..count-1) for every body and returns the island count
+	size_t Label(std::vector<uint32_t>& islandOf)
+	{
+		const size_t count = m_parent.size();
+		islandOf.assign(count, UINT32_MAX);
+		std::vector<uint32_t> labelOfRoot(count, UINT32_MAX);
+
+		uint32_t islands = 0;
+		for (size_t i = 0; i < count; ++i) {
+			const uint32_t root = Find(static_cast<uint32_t>(i));
+			if (labelOfRoot[root] == UINT32_MAX) labelOfRoot[root] = islands++;
+			islandOf[i] = labelOfRoot[root];
+		}
+		return islands;
+	}
+
+private:
+	std::vector<uint32_t> m_parent;
+	std::vector<uint32_t> m_size;
+};
@@ -0,0 +1,182 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+// Uniform spatial hash used as a collision broadphase.
+// Entries are bucketed by hashed cell coordinate and packed with a counting sort,
+// so a rebuild is linear in the number of entries and queries touch only nearby buckets.
+// Different cells can share a bucket, so callers must still run their own overlap test.
+class SpatialHash
+{
+public:
+	void Reset(float cellSize, size_t expectedEntries)
+	{
+		m_cellSize = (cellSize > EPS) ? cellSize : 1.0f;
+		m_invCellSize = 1.0f / m_cellSize;
+
+		size_t tableSize = 64;
+		while (tableSize < expectedEntries * 2) tableSize <<= 1;
+		m_mask = static_cast<uint32_t>(tableSize - 1);
+
+		m_entryBuckets.clear();
+		m_entryIds.clear();
+		m_entryBuckets.reserve(expectedEntries);
+		m_entryIds.reserve(expectedEntries);
+		m_cellStart.assign(tableSize + 1, 0);
+		m_sortedIds.clear();
+		m_oversized.clear();
+	}
+
+	// Point insertion: the caller guarantees cellSize >= the largest entry diameter,
+	// so a 3x3x3 neighbourhood query is enough to find every overlap.
+	void InsertPoint(uint32_t id, const glm::vec3& p)
+	{
+		m_entryBuckets.push_back(BucketOf(CellOf(p)));
+		m_entryIds.push_back(id);
+	}
+
+	// Bounds insertion: the entry is written into every cell its AABB touches.
+	// Such ids may be reported more than once by a query.
+	// Bounds more than MAX_BOUNDS_SPAN cells across are kept whole instead, on a list every query tests
+	// directly, so one large body among small ones does not fill the table with copies of itself.
+	void InsertBounds(uint32_t id, const glm::vec3& min, const glm::vec3& max)
+	{
+		const glm::ivec3 lo = CellOf(min);
+		const glm::ivec3 hi = CellOf(max);
+		const glm::ivec3 span = hi - lo;
+		if (span.x >= MAX_BOUNDS_SPAN || span.y >= MAX_BOUNDS_SPAN || span.z >= MAX_BOUNDS_SPAN)
+		{
+			m_oversized.push_back({ id, lo, hi });
+			return;
+		}
+
+		for (int x = lo.x; x <= hi.x; ++x)
+			for (int y = lo.y; y <= hi.y; ++y)
+				for (int z = lo.z; z <= hi.z; ++z)
+				{
+					m_entryBuckets.push_back(BucketOf(glm::ivec3(x, y, z)));
+					m_entryIds.push_back(id);
+				}
+	}
+
+	// Counting sort of the inserted entries by bucket.
+	void Build()
+	{
+		for (uint32_t bucket : m_entryBuckets) m_cellStart[bucket + 1]++;
+		for (size_t i = 1; i < m_cellStart.size(); ++i) m_cellStart[i] += m_cellStart[i - 1];
+
+		m_sortedIds.resize(m_entryIds.size());
+		m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+		for (size_t i = 0; i < m_entryIds.size(); ++i)
+		{
+			m_sortedIds[m_cursor[m_entryBuckets[i]]++] = m_entryIds[i];
+		}
+	}
+
+	// Visits every id stored in the 27 cells surrounding p. Each bucket is visited once.
+	template <typename Fn>
+	void QueryNeighbours(const glm::vec3& p, Fn&& fn) const
+	{
+		const glm::ivec3 c = CellOf(p);
+		QueryCells(c - glm::ivec3(1), c + glm::ivec3(1), fn);
+	}
+
+	// Visits every id stored in the cells overlapped by [min, max].
+	template <typename Fn>
+	void QueryBounds(const glm::vec3& min, const glm::vec3& max, Fn&& fn) const
+	{
+		QueryCells(CellOf(min), CellOf(max), fn);
+	}
+
+	bool Empty() const { return m_sortedIds.empty() && m_oversized.empty(); }
+	size_t EntryCount() const { return m_sortedIds.size() + m_oversized.size(); }
+	size_t OversizedCount() const { return m_oversized.size(); }
+	float CellSize() const { return m_cellSize; }
+
+	glm::ivec3 CellOf(const glm::vec3& p) const
+	{
+		return glm::ivec3(
+			static_cast<int>(std::floor(p.x * m_invCellSize)),
+			static_cast<int>(std::floor(p.y * m_invCellSize)),
+			static_cast<int>(std::floor(p.z * m_invCellSize)));
+	}
+
+private:
+	static constexpr float EPS = 1e-6f;
+	static constexpr int MAX_QUERY_BUCKETS = 64;
+	static constexpr int MAX_BOUNDS_SPAN = 4; // Cells per axis; larger bounds go on the oversized list
+
+	struct Oversized
+	{
+		uint32_t id;
+		glm::ivec3 lo, hi; // Cell range
+	};
+
+	uint32_t BucketOf(const glm::ivec3& c) const
+	{
+		const uint32_t h = (static_cast<uint32_t>(c.x) * 73856093u)
+			^ (static_cast<uint32_t>(c.y) * 19349663u)
+			^ (static_cast<uint32_t>(c.z) * 83492791u);
+		return h & m_mask;
+	}
+
+	template <typename Fn>
+	void QueryCells(const glm::ivec3& lo, const glm::ivec3& hi, Fn& fn) const
+	{
+		for (const Oversized& entry : m_oversized)
+		{
+			if (glm::all(glm::lessThanEqual(entry.lo, hi)) && glm::all(glm::lessThanEqual(lo, entry.hi))) fn(entry.id);
+		}
+		if (m_sortedIds.empty()) return;
+
+		// A range with more cells than the table has buckets (a very fast body's sweep, say) would walk
+		// them all many times over. Every stored id is fewer visits then, and each bucket comes up once.
+		const double cellCount = static_cast<double>(hi.x - lo.x + 1) * static_cast<double>(hi.y - lo.y + 1) * static_cast<double>(hi.z - lo.z + 1);
+		if (cellCount > static_cast<double>(m_cellStart.size() - 1))
+		{
+			for (uint32_t id : m_sortedIds) fn(id);
+			return;
+		}
+
+		// Small ranges dedupe their buckets so a hash collision never reports an id twice.
+		// Larger ones visit buckets as they come.
+		uint32_t visited[MAX_QUERY_BUCKETS];
+		int visitedCount = 0;
+		const bool dedupe = cellCount <= MAX_QUERY_BUCKETS;
+
+		for (int x = lo.x; x <= hi.x; ++x)
+			for (int y = lo.y; y <= hi.y; ++y)
+				for (int z = lo.z; z <= hi.z; ++z)
+				{
+					const uint32_t bucket = BucketOf(glm::ivec3(x, y, z));
+					if (dedupe)
+					{
+						bool seen = false;
+						for (int k = 0; k < visitedCount; ++k)
+						{
+							if (visited[k] == bucket) { seen = true; break; }
+						}
+						if (seen) continue;
+						visited[visitedCount++] = bucket;
+					}
+
+					for (uint32_t i = m_cellStart[bucket]; i < m_cellStart[bucket + 1]; ++i)
+					{
+						fn(m_sortedIds[i]);
+					}
+				}
+	}
+
+	float m_cellSize{ 1.0f };
+	float m_invCellSize{ 1.0f };
+	uint32_t m_mask{ 63 };
+
+	std::vector<uint32_t> m_entryBuckets;
+	std::vector<uint32_t> m_entryIds;
+	std::vector<uint32_t> m_cellStart;
+	std::vector<uint32_t> m_cursor;
+	std::vector<uint32_t> m_sortedIds;
+	std::vector<Oversized> m_oversized;
+};
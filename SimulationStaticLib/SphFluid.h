@@ -0,0 +1,528 @@
+#pragma once
+#include "ParticleColliders.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SPHFLUID_USE_SSE 1
+#endif
+
+struct SphSettings
+{
+	float particleSpacing = 0.2f;   // Rest distance between particles; fixes particle mass and radius
+	float smoothingScale = 2.0f;    // Kernel radius h as a multiple of the spacing
+	float restDensity = 1000.0f;
+	float soundSpeed = 30.0f;       // Stiffness of the equation of state p = c^2 (rho - rho0); bounds the time step
+	float viscosity = 0.05f;        // Kinematic, m^2/s
+	float maxSpeed = 40.0f;         // Clamp that keeps one bad step from launching particles
+	float restitution = 0.1f;       // Normal velocity kept when bouncing off a collider
+	float friction = 0.1f;          // Tangential velocity removed on contact
+	glm::vec3 gravity{ 0.0f, -9.81f, 0.0f };
+
+	float SmoothingRadius() const { return particleSpacing * smoothingScale; }
+	float ParticleRadius() const { return particleSpacing * 0.5f; }
+};
+
+namespace SphFluidDetail
+{
+	struct DensitySum
+	{
+		float x, y, z;
+		float h2;
+		float weight = 0.0f;     // Sum of (h^2 - r^2)^3
+		uint32_t neighbours = 0; // Including the particle itself
+	};
+
+	struct Columns
+	{
+		const float* posX; const float* posY; const float* posZ;
+		const float* velX; const float* velY; const float* velZ;
+		const float* pressureTerm;
+		const float* invDensity;
+	};
+
+	struct ForceSum
+	{
+		float x, y, z;
+		float vx, vy, vz;
+		float pressureTerm;
+		float h, spikyGrad, viscosity;
+		float ax, ay, az;
+	};
+
+	// Out-of-range candidates are clamped to a zero weight instead of skipped, so the loops have no branch.
+	// The particle itself contributes nothing to the force: its offset and velocity difference are zero.
+	inline void DensityTerm(DensitySum& s, float px, float py, float pz)
+	{
+		const float dx = s.x - px, dy = s.y - py, dz = s.z - pz;
+		const float r2 = dx * dx + dy * dy + dz * dz;
+		const float d = std::max(s.h2 - r2, 0.0f);
+		s.weight += d * d * d;
+		s.neighbours += (r2 < s.h2) ? 1u : 0u;
+	}
+
+	inline void ForceTerm(ForceSum& s, const Columns& c, uint32_t j)
+	{
+		const float dx = s.x - c.posX[j], dy = s.y - c.posY[j], dz = s.z - c.posZ[j];
+		const float r = std::sqrt(std::max(dx * dx + dy * dy + dz * dz, 1e-12f));
+		const float q = std::max(s.h - r, 0.0f);
+		const float push = (s.pressureTerm + c.pressureTerm[j]) * s.spikyGrad * q * q / r;
+		const float blend = s.viscosity * q * c.invDensity[j];
+		s.ax += push * dx + blend * (c.velX[j] - s.vx);
+		s.ay += push * dy + blend * (c.velY[j] - s.vy);
+		s.az += push * dz + blend * (c.velZ[j] - s.vz);
+	}
+
+#ifdef SPHFLUID_USE_SSE
+	inline float HorizontalSum(__m128 v)
+	{
+		__m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+		v = _mm_add_ps(v, shuffled);
+		shuffled = _mm_movehl_ps(shuffled, v);
+		return _mm_cvtss_f32(_mm_add_ss(v, shuffled));
+	}
+#endif
+
+	inline void AccumulateDensity(DensitySum& s, const float* posX, const float* posY, const float* posZ, uint32_t first, uint32_t last)
+	{
+		uint32_t j = first;
+#ifdef SPHFLUID_USE_SSE
+		if (last - first >= 4)
+		{
+			const __m128 x = _mm_set1_ps(s.x), y = _mm_set1_ps(s.y), z = _mm_set1_ps(s.z), h2 = _mm_set1_ps(s.h2);
+			__m128 weight = _mm_setzero_ps();
+			__m128i count = _mm_setzero_si128();
+			for (; j + 4 <= last; j += 4)
+			{
+				const __m128 dx = _mm_sub_ps(x, _mm_loadu_ps(posX + j));
+				const __m128 dy = _mm_sub_ps(y, _mm_loadu_ps(posY + j));
+				const __m128 dz = _mm_sub_ps(z, _mm_loadu_ps(posZ + j));
+				const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+				const __m128 d = _mm_max_ps(_mm_sub_ps(h2, r2), _mm_setzero_ps());
+				weight = _mm_add_ps(weight, _mm_mul_ps(_mm_mul_ps(d, d), d));
+				count = _mm_sub_epi32(count, _mm_castps_si128(_mm_cmplt_ps(r2, h2))); // Lanes in range are -1
+			}
+			s.weight += HorizontalSum(weight);
+			alignas(16) uint32_t lanes[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), count);
+			s.neighbours += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+		}
+#endif
+		for (; j < last; ++j) DensityTerm(s, posX[j], posY[j], posZ[j]);
+	}
+
+	inline void AccumulateForce(ForceSum& s, const Columns& c, uint32_t first, uint32_t last)
+	{
+		uint32_t j = first;
+#ifdef SPHFLUID_USE_SSE
+		if (last - first >= 4)
+		{
+			const __m128 x = _mm_set1_ps(s.x), y = _mm_set1_ps(s.y), z = _mm_set1_ps(s.z);
+			const __m128 vx = _mm_set1_ps(s.vx), vy = _mm_set1_ps(s.vy), vz = _mm_set1_ps(s.vz);
+			const __m128 h = _mm_set1_ps(s.h), pressureTerm = _mm_set1_ps(s.pressureTerm);
+			const __m128 spikyGrad = _mm_set1_ps(s.spikyGrad), viscosity = _mm_set1_ps(s.viscosity);
+			const __m128 minR2 = _mm_set1_ps(1e-12f), zero = _mm_setzero_ps();
+			__m128 ax = zero, ay = zero, az = zero;
+			for (; j + 4 <= last; j += 4)
+			{
+				const __m128 dx = _mm_sub_ps(x, _mm_loadu_ps(c.posX + j));
+				const __m128 dy = _mm_sub_ps(y, _mm_loadu_ps(c.posY + j));
+				const __m128 dz = _mm_sub_ps(z, _mm_loadu_ps(c.posZ + j));
+				const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+				const __m128 r = _mm_sqrt_ps(_mm_max_ps(r2, minR2));
+				const __m128 q = _mm_max_ps(_mm_sub_ps(h, r), zero);
+
+				const __m128 pressures = _mm_add_ps(pressureTerm, _mm_loadu_ps(c.pressureTerm + j));
+				const __m128 push = _mm_div_ps(_mm_mul_ps(_mm_mul_ps(pressures, spikyGrad), _mm_mul_ps(q, q)), r);
+				const __m128 blend = _mm_mul_ps(_mm_mul_ps(viscosity, q), _mm_loadu_ps(c.invDensity + j));
+
+				ax = _mm_add_ps(ax, _mm_add_ps(_mm_mul_ps(push, dx), _mm_mul_ps(blend, _mm_sub_ps(_mm_loadu_ps(c.velX + j), vx))));
+				ay = _mm_add_ps(ay, _mm_add_ps(_mm_mul_ps(push, dy), _mm_mul_ps(blend, _mm_sub_ps(_mm_loadu_ps(c.velY + j), vy))));
+				az = _mm_add_ps(az, _mm_add_ps(_mm_mul_ps(push, dz), _mm_mul_ps(blend, _mm_sub_ps(_mm_loadu_ps(c.velZ + j), vz))));
+			}
+			s.ax += HorizontalSum(ax);
+			s.ay += HorizontalSum(ay);
+			s.az += HorizontalSum(az);
+		}
+#endif
+		for (; j < last; ++j) ForceTerm(s, c, j);
+	}
+}
+
+// Weakly compressible smoothed-particle hydrodynamics. Particles live in one float array per component
+// and are re-sorted by grid cell every step with a counting sort, so the particles of a cell are contiguous
+// and a row of three neighbouring cells is a single index range. The passes are split across threads
+// through the caller's parallelFor(count, minBatch, fn(begin, end)); each pass writes only its own range.
+class SphFluid
+{
+public:
+	std::vector<float> posX, posY, posZ;
+	std::vector<float> velX, velY, velZ;
+	std::vector<float> density, pressure;
+
+	SphFluid() { Configure(SphSettings{}); }
+
+	void Configure(const SphSettings& settings)
+	{
+		m_settings = settings;
+		m_settings.particleSpacing = std::max(m_settings.particleSpacing, 1e-3f);
+		m_settings.smoothingScale = std::max(m_settings.smoothingScale, 1.0f);
+
+		m_h = m_settings.SmoothingRadius();
+		m_h2 = m_h * m_h;
+		const float pi = 3.14159265358979f;
+		m_poly6 = 315.0f / (64.0f * pi * std::pow(m_h, 9.0f));
+		m_spikyGrad = 45.0f / (pi * std::pow(m_h, 6.0f));
+		m_viscLaplacian = m_spikyGrad;
+
+		// Mass such that a particle inside a full rest lattice sits exactly at the rest density,
+		// so a freshly spawned block starts without pressure
+		const float s = m_settings.particleSpacing;
+		const int reach = static_cast<int>(std::ceil(m_h / s));
+		float lattice = 0.0f;
+		for (int x = -reach; x <= reach; ++x)
+			for (int y = -reach; y <= reach; ++y)
+				for (int z = -reach; z <= reach; ++z)
+				{
+					const float r2 = s * s * static_cast<float>(x * x + y * y + z * z);
+					if (r2 < m_h2) lattice += Poly6(r2);
+				}
+		m_mass = m_settings.restDensity / lattice;
+	}
+
+	const SphSettings& Settings() const { return m_settings; }
+	float SmoothingRadius() const { return m_h; }
+	float ParticleMass() const { return m_mass; }
+
+	size_t Size() const { return posX.size(); }
+	bool Empty() const { return posX.empty(); }
+
+	void Clear()
+	{
+		ForEachColumn([](std::vector<float>& column) { column.clear(); });
+	}
+
+	void Reserve(size_t count)
+	{
+		ForEachColumn([count](std::vector<float>& column) { column.reserve(count); });
+	}
+
+	size_t AddParticle(const glm::vec3& position, const glm::vec3& velocity)
+	{
+		posX.push_back(position.x); posY.push_back(position.y); posZ.push_back(position.z);
+		velX.push_back(velocity.x); velY.push_back(velocity.y); velZ.push_back(velocity.z);
+		density.push_back(m_settings.restDensity);
+		pressure.push_back(0.0f);
+		return Size() - 1;
+	}
+
+	// Fills the box with particles on the rest lattice, up to maxCount in total. Returns how many were added.
+	size_t AddBlock(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& velocity, size_t maxCount)
+	{
+		const float s = m_settings.particleSpacing;
+		const glm::ivec3 n = glm::max(glm::ivec3(glm::floor(halfExtents * 2.0f / s)), glm::ivec3(1));
+		const glm::vec3 start = center - glm::vec3(n - glm::ivec3(1)) * (0.5f * s);
+
+		const size_t before = Size();
+		Reserve(std::min(before + static_cast<size_t>(n.x) * n.y * n.z, maxCount));
+		for (int y = 0; y < n.y; ++y)
+			for (int z = 0; z < n.z; ++z)
+				for (int x = 0; x < n.x; ++x)
+				{
+					if (Size() >= maxCount) return Size() - before;
+					AddParticle(start + glm::vec3(x, y, z) * s, velocity);
+				}
+		return Size() - before;
+	}
+
+	// Box around every particle centre; inverted (lo > hi) when there are none
+	void Bounds(glm::vec3& lo, glm::vec3& hi) const
+	{
+		lo = glm::vec3(std::numeric_limits<float>::max());
+		hi = glm::vec3(-std::numeric_limits<float>::max());
+		for (size_t i = 0; i < Size(); ++i)
+		{
+			lo = glm::min(lo, glm::vec3(posX[i], posY[i], posZ[i]));
+			hi = glm::max(hi, glm::vec3(posX[i], posY[i], posZ[i]));
+		}
+	}
+
+	// The particles alone, with the settings they were stepped under. Density, pressure, the grid and the
+	// per-step columns are derived from these and rebuilt by the next step, so they are not kept.
+	struct State
+	{
+		SphSettings settings;
+		std::vector<float> posX, posY, posZ;
+		std::vector<float> velX, velY, velZ;
+	};
+
+	State SaveState() const
+	{
+		return State{ m_settings, posX, posY, posZ, velX, velY, velZ };
+	}
+
+	void RestoreState(const State& state)
+	{
+		Configure(state.settings);
+		posX = state.posX; posY = state.posY; posZ = state.posZ;
+		velX = state.velX; velY = state.velY; velZ = state.velZ;
+		density.assign(Size(), m_settings.restDensity);
+		pressure.assign(Size(), 0.0f);
+	}
+
+	glm::vec3 Position(size_t i) const { return glm::vec3(posX[i], posY[i], posZ[i]); }
+	glm::vec3 Velocity(size_t i) const { return glm::vec3(velX[i], velY[i], velZ[i]); }
+
+	// Particle pairs closer than h found by the last step's density pass (each pair counted from both sides)
+	uint64_t LastNeighbourCount() const { return m_neighbourCount; }
+	size_t LastCellCount() const { return m_cellStart.empty() ? 0 : m_cellStart.size() - 1; }
+
+	// CFL bound: the step a pressure wave needs to cross a fraction of the kernel radius
+	float MaxTimeStep() const
+	{
+		return 0.4f * m_h / std::max(m_settings.soundSpeed, 1e-3f);
+	}
+
+	// One explicit step: sort, density and pressure, forces, then integration with collider response
+	template <typename ParallelFor>
+	void Step(float dt, const ParticleColliders& colliders, ParallelFor&& parallelFor)
+	{
+		const size_t count = Size();
+		if (count == 0 || !(dt > 0.0f)) return;
+
+		BuildGrid(parallelFor);
+		ComputeDensity(parallelFor);
+		ComputeAccelerations(parallelFor);
+		Integrate(dt, colliders, parallelFor);
+	}
+
+	template <typename ParallelFor>
+	void Step(float dt, ParallelFor&& parallelFor)
+	{
+		Step(dt, ParticleColliders{}, parallelFor);
+	}
+
+private:
+	static constexpr size_t MIN_BATCH = 256;
+	static constexpr uint32_t MAX_CELLS_PER_PARTICLE = 8;
+
+	float Poly6(float r2) const
+	{
+		const float d = m_h2 - r2;
+		return m_poly6 * d * d * d;
+	}
+
+	template <typename Fn>
+	void ForEachColumn(Fn&& fn)
+	{
+		for (std::vector<float>* column : { &posX, &posY, &posZ, &velX, &velY, &velZ, &density, &pressure }) fn(*column);
+	}
+
+	glm::ivec3 CellOf(float x, float y, float z) const
+	{
+		return glm::clamp(glm::ivec3(
+			static_cast<int>((x - m_gridOrigin.x) * m_invCellSize),
+			static_cast<int>((y - m_gridOrigin.y) * m_invCellSize),
+			static_cast<int>((z - m_gridOrigin.z) * m_invCellSize)), glm::ivec3(0), m_gridDims - glm::ivec3(1));
+	}
+
+	// Visits every particle in the 3x3x3 block of cells around i's cell, as nine contiguous rows along X
+	template <typename Fn>
+	void ForEachNeighbourRange(size_t i, Fn&& fn) const
+	{
+		const glm::ivec3 c = CellOf(posX[i], posY[i], posZ[i]);
+		const int x0 = std::max(c.x - 1, 0);
+		const int x1 = std::min(c.x + 1, m_gridDims.x - 1);
+		for (int z = std::max(c.z - 1, 0); z <= std::min(c.z + 1, m_gridDims.z - 1); ++z)
+			for (int y = std::max(c.y - 1, 0); y <= std::min(c.y + 1, m_gridDims.y - 1); ++y)
+			{
+				const size_t row = (static_cast<size_t>(z) * m_gridDims.y + y) * m_gridDims.x;
+				fn(m_cellStart[row + x0], m_cellStart[row + x1 + 1]);
+			}
+	}
+
+	// Dense grid over the particles' bounds with cells no smaller than h. Cells grow when the fluid is
+	// spread so thin that the grid would outnumber the particles by MAX_CELLS_PER_PARTICLE.
+	template <typename ParallelFor>
+	void BuildGrid(ParallelFor& parallelFor)
+	{
+		const size_t count = Size();
+		glm::vec3 lo, hi;
+		Bounds(lo, hi);
+
+		float cellSize = m_h;
+		const glm::vec3 extent = hi - lo;
+		const double maxCells = static_cast<double>(std::max<size_t>(count * MAX_CELLS_PER_PARTICLE, 4096));
+		double cells = 1.0;
+		for (int axis = 0; axis < 3; ++axis) cells *= std::floor(extent[axis] / cellSize) + 1.0;
+		if (cells > maxCells) cellSize *= static_cast<float>(std::cbrt(cells / maxCells)) * 1.01f;
+
+		m_gridOrigin = lo;
+		m_invCellSize = 1.0f / cellSize;
+		m_gridDims = glm::ivec3(glm::floor(extent * m_invCellSize)) + glm::ivec3(1);
+		const size_t cellCount = static_cast<size_t>(m_gridDims.x) * m_gridDims.y * m_gridDims.z;
+
+		m_cellOf.resize(count);
+		parallelFor(count, MIN_BATCH * 4, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				const glm::ivec3 c = CellOf(posX[i], posY[i], posZ[i]);
+				m_cellOf[i] = static_cast<uint32_t>((static_cast<size_t>(c.z) * m_gridDims.y + c.y) * m_gridDims.x + c.x);
+			}
+		});
+
+		// Counting sort: histogram, exclusive prefix sum, stable scatter of the particle order
+		m_cellStart.assign(cellCount + 1, 0);
+		for (size_t i = 0; i < count; ++i) m_cellStart[m_cellOf[i] + 1]++;
+		for (size_t c = 1; c <= cellCount; ++c) m_cellStart[c] += m_cellStart[c - 1];
+
+		m_order.resize(count);
+		m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+		for (size_t i = 0; i < count; ++i) m_order[m_cursor[m_cellOf[i]]++] = static_cast<uint32_t>(i);
+
+		// Gather every column into sorted order so neighbours are contiguous in memory
+		m_scratch.resize(count);
+		ForEachColumn([&](std::vector<float>& column) {
+			parallelFor(count, MIN_BATCH * 4, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) m_scratch[i] = column[m_order[i]];
+			});
+			column.swap(m_scratch);
+		});
+	}
+
+	template <typename ParallelFor>
+	void ComputeDensity(ParallelFor& parallelFor)
+	{
+		const size_t count = Size();
+		m_pressureTerm.resize(count);
+		m_invDensity.resize(count);
+		const float stiffness = m_settings.soundSpeed * m_settings.soundSpeed;
+		const float rest = m_settings.restDensity;
+		std::atomic<uint64_t> neighbours{ 0 };
+
+		parallelFor(count, MIN_BATCH, [&](size_t begin, size_t end) {
+			uint64_t found = 0;
+			for (size_t i = begin; i < end; ++i)
+			{
+				SphFluidDetail::DensitySum sum{ posX[i], posY[i], posZ[i], m_h2 };
+				ForEachNeighbourRange(i, [&](uint32_t first, uint32_t last) {
+					SphFluidDetail::AccumulateDensity(sum, posX.data(), posY.data(), posZ.data(), first, last);
+				});
+
+				const float rho = m_mass * m_poly6 * sum.weight;
+				density[i] = rho;
+				// Tension is dropped: a free surface would otherwise pull itself into clumps
+				pressure[i] = std::max(stiffness * (rho - rest), 0.0f);
+				m_pressureTerm[i] = pressure[i] / (rho * rho);
+				m_invDensity[i] = 1.0f / rho;
+				found += sum.neighbours - 1; // Not itself
+			}
+			neighbours.fetch_add(found, std::memory_order_relaxed);
+		});
+		m_neighbourCount = neighbours.load();
+	}
+
+	// Symmetric pressure gradient with the spiky kernel and Mueller's viscosity Laplacian. Accelerations go to
+	// their own columns, so every particle reads the same velocity field before the integrator changes it.
+	template <typename ParallelFor>
+	void ComputeAccelerations(ParallelFor& parallelFor)
+	{
+		const size_t count = Size();
+		m_accX.resize(count);
+		m_accY.resize(count);
+		m_accZ.resize(count);
+		const glm::vec3 g = m_settings.gravity;
+		const SphFluidDetail::Columns columns{ posX.data(), posY.data(), posZ.data(), velX.data(), velY.data(), velZ.data(),
+			m_pressureTerm.data(), m_invDensity.data() };
+
+		parallelFor(count, MIN_BATCH, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				SphFluidDetail::ForceSum sum{};
+				sum.x = posX[i]; sum.y = posY[i]; sum.z = posZ[i];
+				sum.vx = velX[i]; sum.vy = velY[i]; sum.vz = velZ[i];
+				sum.pressureTerm = m_pressureTerm[i];
+				sum.h = m_h;
+				sum.spikyGrad = m_spikyGrad;
+				sum.viscosity = m_settings.viscosity * m_viscLaplacian;
+				ForEachNeighbourRange(i, [&](uint32_t first, uint32_t last) {
+					SphFluidDetail::AccumulateForce(sum, columns, first, last);
+				});
+
+				m_accX[i] = g.x + m_mass * sum.ax;
+				m_accY[i] = g.y + m_mass * sum.ay;
+				m_accZ[i] = g.z + m_mass * sum.az;
+			}
+		});
+	}
+
+	template <typename ParallelFor>
+	void Integrate(float dt, const ParticleColliders& colliders, ParallelFor& parallelFor)
+	{
+		const float maxSpeed2 = m_settings.maxSpeed * m_settings.maxSpeed;
+		const float radius = m_settings.ParticleRadius();
+
+		parallelFor(Size(), MIN_BATCH * 4, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				glm::vec3 v(velX[i] + m_accX[i] * dt, velY[i] + m_accY[i] * dt, velZ[i] + m_accZ[i] * dt);
+				const float speed2 = glm::dot(v, v);
+				if (speed2 > maxSpeed2) v *= m_settings.maxSpeed / std::sqrt(speed2);
+
+				const glm::vec3 previous(posX[i], posY[i], posZ[i]);
+				glm::vec3 p = previous + v * dt;
+				if (!colliders.Empty()) Collide(previous, p, v, radius, colliders);
+
+				posX[i] = p.x; posY[i] = p.y; posZ[i] = p.z;
+				velX[i] = v.x; velY[i] = v.y; velZ[i] = v.z;
+			}
+		});
+	}
+
+	// Pushes the particle out along the contact normal and reflects the approaching part of its velocity
+	// relative to the collider, keeping restitution of it and losing friction of the sliding part
+	void Respond(glm::vec3& p, glm::vec3& v, const glm::vec3& normal, float depth, const glm::vec3& colliderVelocity) const
+	{
+		p += normal * depth;
+		const glm::vec3 relative = v - colliderVelocity;
+		const float vn = glm::dot(relative, normal);
+		if (vn >= 0.0f) return;
+		const glm::vec3 tangent = relative - normal * vn;
+		v = colliderVelocity + tangent * (1.0f - m_settings.friction) - normal * (vn * m_settings.restitution);
+	}
+
+	void Collide(const glm::vec3& previous, glm::vec3& p, glm::vec3& v, float radius, const ParticleColliders& colliders) const
+	{
+		colliders.ForEachContact(previous, p, radius, [&](const glm::vec3& normal, float depth, const glm::vec3& colliderVelocity) {
+			Respond(p, v, normal, depth, colliderVelocity);
+		});
+	}
+
+	SphSettings m_settings;
+	float m_h = 0.4f;
+	float m_h2 = 0.16f;
+	float m_poly6 = 0.0f;
+	float m_spikyGrad = 0.0f;
+	float m_viscLaplacian = 0.0f;
+	float m_mass = 1.0f;
+
+	glm::vec3 m_gridOrigin{ 0.0f };
+	glm::ivec3 m_gridDims{ 1 };
+	float m_invCellSize = 1.0f;
+	uint64_t m_neighbourCount = 0;
+
+	std::vector<uint32_t> m_cellOf;
+	std::vector<uint32_t> m_cellStart;
+	std::vector<uint32_t> m_cursor;
+	std::vector<uint32_t> m_order;
+	std::vector<float> m_scratch;
+	std::vector<float> m_pressureTerm; // p / rho^2
+	std::vector<float> m_invDensity;
+	std::vector<float> m_accX, m_accY, m_accZ;
+};
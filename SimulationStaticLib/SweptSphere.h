@@ -0,0 +1,58 @@
+#pragma once
+#include "Collider.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include <glm/glm.hpp>
+#include <cmath>
+
+// Swept-sphere time of impact. A sphere moving by `displacement` over one step is tested against a plane
+// or another moving sphere; on a hit, toi in [0, 1] is the fraction of the step at which they first touch.
+// Pairs that already overlap at the start report no hit, since the discrete contact pass handles them.
+
+// Only bodies that move further than this fraction of their radius in one step can skip past a contact
+inline bool NeedsSweep(const glm::vec3& displacement, float radius, float motionFraction)
+{
+	const float limit = radius * motionFraction;
+	return glm::dot(displacement, displacement) > limit * limit;
+}
+
+inline bool SweepSpherePlane(const Sphere& sphere, const glm::vec3& displacement, const Plane& plane, float& toi)
+{
+	// Planes are two-sided, so the sphere is stopped on whichever side it starts
+	const float start = plane.GetSignedDistance(sphere.Position());
+	const float side = (start >= 0.0f) ? 1.0f : -1.0f;
+	const float s0 = start * side;
+	const float s1 = s0 + glm::dot(displacement, plane.GetNormal()) * side;
+	const float r = sphere.m_radius;
+
+	if (s0 <= r || s1 > r) return false;
+
+	const float t = (s0 - r) / (s0 - s1);
+	if (plane.GetSize() > 0.0f && !plane.Intersects(Sphere(sphere.Position() + displacement * t, r))) return false;
+
+	toi = t;
+	return true;
+}
+
+inline bool SweepSphereSphere(const Sphere& a, const glm::vec3& displacementA, const Sphere& b, const glm::vec3& displacementB, float& toi)
+{
+	// In b's frame, a moves along a segment; a hit means that segment passes within rSum of b's centre
+	const glm::vec3 p = a.Position() - b.Position();
+	const glm::vec3 v = displacementA - displacementB;
+	const float rSum = a.m_radius + b.m_radius;
+
+	const float c = glm::dot(p, p) - rSum * rSum;
+	const float halfB = glm::dot(p, v);
+	if (c <= 0.0f || halfB >= 0.0f) return false; // Already touching, or not closing
+	if (!Sphere(glm::vec3(0.0f), rSum).Intersects(Line{ p, p + v })) return false;
+
+	const float vv = glm::dot(v, v);
+	const float disc = halfB * halfB - vv * c;
+	if (disc < 0.0f) return false;
+
+	const float t = (-halfB - std::sqrt(disc)) / vv;
+	if (t < 0.0f || t > 1.0f) return false;
+
+	toi = t;
+	return true;
+}
@@ -0,0 +1,400 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Closest point to p on triangle abc (Ericson, Real-Time Collision Detection 5.1.5)
+inline glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	const glm::vec3 ab = b - a;
+	const glm::vec3 ac = c - a;
+	const glm::vec3 ap = p - a;
+	const float d1 = glm::dot(ab, ap);
+	const float d2 = glm::dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+	const glm::vec3 bp = p - b;
+	const float d3 = glm::dot(ab, bp);
+	const float d4 = glm::dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3) return b;
+
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+	const glm::vec3 cp = p - c;
+	const float d5 = glm::dot(ab, cp);
+	const float d6 = glm::dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6) return c;
+
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	const float denom = 1.0f / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+// Bounding volume hierarchy over a triangle mesh, queried in the mesh's own space. Built top-down with
+// binned SAH and flattened: a node's two children sit side by side, and a leaf owns a contiguous run of
+// the reordered triangles, so every query walks two flat arrays.
+class TriangleBVH
+{
+public:
+	struct RayHit
+	{
+		float t;           // In units of the ray direction as given
+		glm::vec3 normal;  // Unit face normal, by winding
+		uint32_t triangle; // Position of the triangle in the source index buffer, divided by 3
+	};
+
+	struct SurfacePoint
+	{
+		glm::vec3 point;   // Closest point on the mesh
+		glm::vec3 normal;  // Unit face normal of the triangle it lies on
+		float distance;
+		uint32_t triangle;
+	};
+
+	// Without indices every three positions form a triangle. Triangles with an index out of range are dropped.
+	void Build(const glm::vec3* positions, size_t positionCount, const uint32_t* indices, size_t indexCount)
+	{
+		m_nodes.clear();
+		m_triangles.clear();
+		m_depth = 0;
+
+		const size_t triangleCount = indices ? indexCount / 3 : positionCount / 3;
+		m_triangles.reserve(triangleCount);
+		for (size_t t = 0; t < triangleCount; ++t) {
+			const size_t i0 = indices ? indices[3 * t] : 3 * t;
+			const size_t i1 = indices ? indices[3 * t + 1] : 3 * t + 1;
+			const size_t i2 = indices ? indices[3 * t + 2] : 3 * t + 2;
+			if (i0 >= positionCount || i1 >= positionCount || i2 >= positionCount) continue;
+			m_triangles.push_back({ positions[i0], positions[i1], positions[i2], static_cast<uint32_t>(t) });
+		}
+		if (m_triangles.empty()) return;
+
+		const uint32_t count = static_cast<uint32_t>(m_triangles.size());
+		std::vector<glm::vec3> centroids(count);
+		std::vector<uint32_t> order(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			centroids[i] = (m_triangles[i].a + m_triangles[i].b + m_triangles[i].c) * (1.0f / 3.0f);
+			order[i] = i;
+		}
+
+		m_nodes.reserve(2 * static_cast<size_t>(count));
+		m_nodes.push_back({});
+
+		struct Pending { uint32_t node, first, count; int depth; };
+		std::vector<Pending> pending{ { 0, 0, count, 1 } };
+		while (!pending.empty()) {
+			const Pending job = pending.back();
+			pending.pop_back();
+			m_depth = std::max(m_depth, job.depth);
+
+			const uint32_t split = Subdivide(job.node, job.first, job.count, job.depth, centroids, order);
+			if (split == 0) continue;
+
+			const uint32_t left = static_cast<uint32_t>(m_nodes.size());
+			m_nodes.push_back({});
+			m_nodes.push_back({});
+			m_nodes[job.node].first = left;
+			m_nodes[job.node].count = 0;
+			pending.push_back({ left + 1, job.first + split, job.count - split, job.depth + 1 });
+			pending.push_back({ left, job.first, split, job.depth + 1 });
+		}
+
+		std::vector<Triangle> sorted(count);
+		for (uint32_t i = 0; i < count; ++i) sorted[i] = m_triangles[order[i]];
+		m_triangles.swap(sorted);
+	}
+
+	bool Empty() const { return m_nodes.empty(); }
+	size_t TriangleCount() const { return m_triangles.size(); }
+	size_t NodeCount() const { return m_nodes.size(); }
+	int Depth() const { return m_depth; }
+	glm::vec3 BoundsMin() const { return m_nodes.empty() ? glm::vec3(0.0f) : m_nodes[0].min; }
+	glm::vec3 BoundsMax() const { return m_nodes.empty() ? glm::vec3(0.0f) : m_nodes[0].max; }
+
+	// Nearest hit with 0 < t <= maxT. Triangles are hit from either side unless frontOnly, which skips
+	// those the ray meets from behind their winding.
+	bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, RayHit& hit, bool frontOnly = false) const
+	{
+		if (m_nodes.empty()) return false;
+
+		// A zero direction component would give 0 * inf in the slab test; a huge slope stands in for it
+		glm::vec3 invDir;
+		for (int k = 0; k < 3; ++k) {
+			invDir[k] = (std::abs(direction[k]) > 1e-20f) ? 1.0f / direction[k] : std::copysign(1e30f, direction[k]);
+		}
+
+		float best = maxT;
+		bool found = false;
+		uint32_t stack[MAX_DEPTH + 2];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			const Node& node = m_nodes[stack[--top]];
+			if (RayEntry(origin, invDir, node, best) == NO_HIT) continue;
+
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+					const Triangle& tri = m_triangles[i];
+					float t;
+					if (RayTriangle(origin, direction, tri, frontOnly, t) && t <= best) {
+						best = t;
+						hit = { t, FaceNormal(tri), tri.index };
+						found = true;
+					}
+				}
+				continue;
+			}
+
+			// The nearer child goes on top, so it is searched first and shortens the ray for the other
+			const float tLeft = RayEntry(origin, invDir, m_nodes[node.first], best);
+			const float tRight = RayEntry(origin, invDir, m_nodes[node.first + 1], best);
+			const bool leftFirst = tLeft <= tRight;
+			const float tFar = leftFirst ? tRight : tLeft;
+			if (tFar != NO_HIT) stack[top++] = leftFirst ? node.first + 1 : node.first;
+			if (std::min(tLeft, tRight) != NO_HIT) stack[top++] = leftFirst ? node.first : node.first + 1;
+		}
+		return found;
+	}
+
+	// Closest point on the mesh to p, if one lies within maxDistance
+	bool ClosestPoint(const glm::vec3& p, float maxDistance, SurfacePoint& out) const
+	{
+		if (m_nodes.empty()) return false;
+
+		float bestSq = (maxDistance < std::numeric_limits<float>::max()) ? maxDistance * maxDistance : std::numeric_limits<float>::max();
+		bool found = false;
+		uint32_t stack[MAX_DEPTH + 2];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			const Node& node = m_nodes[stack[--top]];
+			if (BoxDistanceSq(p, node) > bestSq) continue;
+
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+					const Triangle& tri = m_triangles[i];
+					const glm::vec3 q = ClosestPointOnTriangle(p, tri.a, tri.b, tri.c);
+					const float dSq = glm::dot(p - q, p - q);
+					if (dSq <= bestSq) {
+						bestSq = dSq;
+						out = { q, FaceNormal(tri), 0.0f, tri.index };
+						found = true;
+					}
+				}
+				continue;
+			}
+
+			const float dLeft = BoxDistanceSq(p, m_nodes[node.first]);
+			const float dRight = BoxDistanceSq(p, m_nodes[node.first + 1]);
+			const bool leftFirst = dLeft <= dRight;
+			if (std::max(dLeft, dRight) <= bestSq) stack[top++] = leftFirst ? node.first + 1 : node.first;
+			if (std::min(dLeft, dRight) <= bestSq) stack[top++] = leftFirst ? node.first : node.first + 1;
+		}
+		if (found) out.distance = std::sqrt(bestSq);
+		return found;
+	}
+
+	// Calls fn(const SurfacePoint&) for every triangle within radius of center, with its closest point
+	template <typename Fn>
+	void QuerySphere(const glm::vec3& center, float radius, Fn&& fn) const
+	{
+		if (m_nodes.empty()) return;
+
+		const float radiusSq = radius * radius;
+		uint32_t stack[MAX_DEPTH + 2];
+		int top = 0;
+		stack[top++] = 0;
+		while (top > 0) {
+			const Node& node = m_nodes[stack[--top]];
+			if (BoxDistanceSq(center, node) > radiusSq) continue;
+
+			if (node.count > 0) {
+				for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+					const Triangle& tri = m_triangles[i];
+					const glm::vec3 q = ClosestPointOnTriangle(center, tri.a, tri.b, tri.c);
+					const float dSq = glm::dot(center - q, center - q);
+					if (dSq <= radiusSq) fn(SurfacePoint{ q, FaceNormal(tri), std::sqrt(dSq), tri.index });
+				}
+				continue;
+			}
+			stack[top++] = node.first + 1;
+			stack[top++] = node.first;
+		}
+	}
+
+private:
+	struct Node
+	{
+		glm::vec3 min;
+		uint32_t first; // Leaf: first triangle. Interior: left child, with the right child after it.
+		glm::vec3 max;
+		uint32_t count; // Triangles in a leaf, 0 for an interior node
+	};
+
+	struct Triangle
+	{
+		glm::vec3 a, b, c;
+		uint32_t index;
+	};
+
+	static constexpr uint32_t MAX_LEAF = 4;
+	static constexpr int MAX_DEPTH = 60; // Traversal stacks hold at most one entry per level, plus the root
+	static constexpr int BINS = 16;
+	static constexpr float TRAVERSAL_COST = 1.0f; // Relative to one triangle test
+	static constexpr float NO_HIT = std::numeric_limits<float>::infinity();
+
+	static float HalfArea(const glm::vec3& min, const glm::vec3& max)
+	{
+		const glm::vec3 e = max - min;
+		return e.x * e.y + e.y * e.z + e.z * e.x;
+	}
+
+	static glm::vec3 FaceNormal(const Triangle& tri)
+	{
+		const glm::vec3 n = glm::cross(tri.b - tri.a, tri.c - tri.a);
+		const float len = glm::length(n);
+		return (len > 0.0f) ? n / len : glm::vec3(0.0f, 1.0f, 0.0f);
+	}
+
+	static float BoxDistanceSq(const glm::vec3& p, const Node& node)
+	{
+		const glm::vec3 d = glm::max(glm::max(node.min - p, p - node.max), glm::vec3(0.0f));
+		return glm::dot(d, d);
+	}
+
+	// Entry distance of the ray into the node's box, or NO_HIT if it misses within (0, maxT]
+	static float RayEntry(const glm::vec3& origin, const glm::vec3& invDir, const Node& node, float maxT)
+	{
+		const glm::vec3 t0 = (node.min - origin) * invDir;
+		const glm::vec3 t1 = (node.max - origin) * invDir;
+		const glm::vec3 tNear = glm::min(t0, t1);
+		const glm::vec3 tFar = glm::max(t0, t1);
+		const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+		return (enter <= exit) ? enter : NO_HIT;
+	}
+
+	// Moller-Trumbore. det is -dot(direction, face normal), so a front-face hit has det > 0.
+	static bool RayTriangle(const glm::vec3& origin, const glm::vec3& direction, const Triangle& tri, bool frontOnly, float& t)
+	{
+		constexpr float EPS = 1e-9f;
+		const glm::vec3 e1 = tri.b - tri.a;
+		const glm::vec3 e2 = tri.c - tri.a;
+		const glm::vec3 p = glm::cross(direction, e2);
+		const float det = glm::dot(e1, p);
+		if (frontOnly ? det < EPS : std::abs(det) < EPS) return false;
+
+		const float invDet = 1.0f / det;
+		const glm::vec3 s = origin - tri.a;
+		const float u = glm::dot(s, p) * invDet;
+		if (u < 0.0f || u > 1.0f) return false;
+		const glm::vec3 q = glm::cross(s, e1);
+		const float v = glm::dot(direction, q) * invDet;
+		if (v < 0.0f || u + v > 1.0f) return false;
+
+		t = glm::dot(e2, q) * invDet;
+		return t > 0.0f;
+	}
+
+	// Fits the node to its triangles and either leaves it a leaf (returns 0) or partitions order[first, first + count)
+	// by the cheapest SAH split and returns the size of the left half
+	uint32_t Subdivide(uint32_t nodeIndex, uint32_t first, uint32_t count, int depth,
+		const std::vector<glm::vec3>& centroids, std::vector<uint32_t>& order)
+	{
+		glm::vec3 min(std::numeric_limits<float>::max());
+		glm::vec3 max(-std::numeric_limits<float>::max());
+		glm::vec3 cMin = min;
+		glm::vec3 cMax = max;
+		for (uint32_t i = first; i < first + count; ++i) {
+			const Triangle& tri = m_triangles[order[i]];
+			min = glm::min(min, glm::min(tri.a, glm::min(tri.b, tri.c)));
+			max = glm::max(max, glm::max(tri.a, glm::max(tri.b, tri.c)));
+			cMin = glm::min(cMin, centroids[order[i]]);
+			cMax = glm::max(cMax, centroids[order[i]]);
+		}
+		Node& node = m_nodes[nodeIndex];
+		node.min = min;
+		node.max = max;
+		node.first = first;
+		node.count = count;
+		if (count <= MAX_LEAF || depth >= MAX_DEPTH) return 0;
+
+		// 1. Bin the centroids along each axis and cost every split between bins
+		struct Bin { glm::vec3 min, max; uint32_t count; };
+		float bestCost = std::numeric_limits<float>::max();
+		int bestAxis = -1;
+		int bestSplit = 0;
+		for (int axis = 0; axis < 3; ++axis) {
+			const float extent = cMax[axis] - cMin[axis];
+			if (!(extent > 0.0f)) continue;
+
+			Bin bins[BINS];
+			for (Bin& bin : bins) bin = { glm::vec3(std::numeric_limits<float>::max()), glm::vec3(-std::numeric_limits<float>::max()), 0 };
+			const float scale = BINS / extent;
+			for (uint32_t i = first; i < first + count; ++i) {
+				const Triangle& tri = m_triangles[order[i]];
+				const int b = std::min(static_cast<int>((centroids[order[i]][axis] - cMin[axis]) * scale), BINS - 1);
+				bins[b].min = glm::min(bins[b].min, glm::min(tri.a, glm::min(tri.b, tri.c)));
+				bins[b].max = glm::max(bins[b].max, glm::max(tri.a, glm::max(tri.b, tri.c)));
+				bins[b].count++;
+			}
+
+			// Sweep from the right for the right-hand areas, then from the left to cost each split
+			float rightArea[BINS];
+			uint32_t rightCount[BINS];
+			glm::vec3 rMin(std::numeric_limits<float>::max());
+			glm::vec3 rMax(-std::numeric_limits<float>::max());
+			uint32_t rCount = 0;
+			for (int b = BINS - 1; b > 0; --b) {
+				rMin = glm::min(rMin, bins[b].min);
+				rMax = glm::max(rMax, bins[b].max);
+				rCount += bins[b].count;
+				rightArea[b] = rCount ? HalfArea(rMin, rMax) : 0.0f;
+				rightCount[b] = rCount;
+			}
+
+			glm::vec3 lMin(std::numeric_limits<float>::max());
+			glm::vec3 lMax(-std::numeric_limits<float>::max());
+			uint32_t lCount = 0;
+			for (int b = 0; b < BINS - 1; ++b) {
+				lMin = glm::min(lMin, bins[b].min);
+				lMax = glm::max(lMax, bins[b].max);
+				lCount += bins[b].count;
+				if (lCount == 0 || rightCount[b + 1] == 0) continue;
+				const float cost = HalfArea(lMin, lMax) * lCount + rightArea[b + 1] * rightCount[b + 1];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b + 1;
+				}
+			}
+		}
+
+		// 2. Every centroid in one place: nothing to split on
+		if (bestAxis < 0) return 0;
+
+		// Small nodes stay leaves when splitting would not pay for the extra traversal step
+		const float area = HalfArea(min, max);
+		if (count <= 4 * MAX_LEAF && area > 0.0f && TRAVERSAL_COST + bestCost / area >= static_cast<float>(count)) return 0;
+
+		// 3. Partition by bin
+		const float scale = BINS / (cMax[bestAxis] - cMin[bestAxis]);
+		const auto mid = std::partition(order.begin() + first, order.begin() + first + count, [&](uint32_t t) {
+			return std::min(static_cast<int>((centroids[t][bestAxis] - cMin[bestAxis]) * scale), BINS - 1) < bestSplit;
+		});
+		return static_cast<uint32_t>(mid - (order.begin() + first));
+	}
+
+	std::vector<Node> m_nodes;
+	std::vector<Triangle> m_triangles;
+	int m_depth = 0;
+};
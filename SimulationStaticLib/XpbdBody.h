@@ -0,0 +1,444 @@
+#pragma once
+#include "ConstraintColoring.h"
+#include "ParticleColliders.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct XpbdSettings
+{
+	int substeps = 10;               // Each substep runs one pass over every constraint (small steps beat more iterations)
+	float stretchCompliance = 0.0f;  // Inverse stiffness of the mesh edges in m/N; 0 = inextensible
+	float bendCompliance = 0.05f;    // Of the distance across each pair of adjacent triangles
+	float volumeCompliance = 0.0f;   // Of the enclosed volume; closed bodies only
+	float pressure = 1.0f;           // Target volume as a multiple of the rest volume; closed bodies only
+	float thickness = 0.02f;         // Collision radius of each particle
+	float friction = 0.4f;           // Sliding along a collider is cut by this share of the penetration depth
+	float damping = 0.1f;            // Share of the velocity lost per second
+	float maxSpeed = 50.0f;          // Clamp that keeps one bad step from launching particles
+	glm::vec3 gravity{ 0.0f, -9.81f, 0.0f };
+};
+
+namespace XpbdBodyDetail
+{
+	struct Distance
+	{
+		uint32_t a;
+		uint32_t b;
+		float rest;
+	};
+
+	// Distance constraints reordered so that each batch is a run of constraints sharing no particle
+	struct DistanceSet
+	{
+		std::vector<Distance> constraints;
+		std::vector<ConstraintColoring::Batch> batches;
+
+		void Build(std::vector<Distance>& unordered, size_t particleCount, ConstraintColoring& coloring)
+		{
+			std::vector<uint32_t> a(unordered.size()), b(unordered.size());
+			for (size_t i = 0; i < unordered.size(); ++i) {
+				a[i] = unordered[i].a;
+				b[i] = unordered[i].b;
+			}
+			coloring.Build(a, b, particleCount);
+
+			constraints.resize(unordered.size());
+			const std::vector<uint32_t>& order = coloring.Order();
+			for (size_t i = 0; i < order.size(); ++i) constraints[i] = unordered[order[i]];
+			batches = coloring.Batches();
+		}
+	};
+
+	struct TriangleHash
+	{
+		size_t operator()(const std::array<uint32_t, 3>& t) const
+		{
+			return std::hash<uint64_t>()((uint64_t(t[0]) << 32 | t[1]) * 0x9E3779B97F4A7C15ull ^ t[2]);
+		}
+	};
+}
+
+// Cloth or soft body simulated with extended position-based dynamics (XPBD) in world space. The render mesh's
+// vertices are welded into particles (seams and double-sided copies share one particle); each unique edge
+// becomes a stretch constraint and each pair of triangles sharing an edge a bending constraint between their
+// far corners. Both sets are graph-coloured once at build, so every batch is solved in parallel without locks.
+// Closed meshes can also keep their enclosed volume, which makes them soft balls rather than limp bags.
+class XpbdBody
+{
+public:
+	// normals may be null; when given, a vertex whose normal faces away from the surface its particle belongs
+	// to (the back copy of a double-sided sheet) gets a flipped normal back. Mass is spread by triangle area.
+	void Build(const glm::vec3* positions, const glm::vec3* normals, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+		float totalMass, bool preserveVolume)
+	{
+		Weld(positions, vertexCount);
+		const size_t count = m_pos.size();
+
+		// 1. Triangles over particles; degenerate and repeated ones (the back faces of a double-sided sheet) go
+		std::unordered_set<std::array<uint32_t, 3>, XpbdBodyDetail::TriangleHash> seen;
+		m_triangles.clear();
+		for (size_t t = 0; t + 2 < indexCount; t += 3) {
+			if (indices[t] >= vertexCount || indices[t + 1] >= vertexCount || indices[t + 2] >= vertexCount) continue;
+			const uint32_t i0 = m_vertexParticle[indices[t]];
+			const uint32_t i1 = m_vertexParticle[indices[t + 1]];
+			const uint32_t i2 = m_vertexParticle[indices[t + 2]];
+			if (i0 == i1 || i1 == i2 || i0 == i2) continue;
+
+			std::array<uint32_t, 3> key = { i0, i1, i2 };
+			std::sort(key.begin(), key.end());
+			if (!seen.insert(key).second) continue;
+			m_triangles.insert(m_triangles.end(), { i0, i1, i2 });
+		}
+
+		// 2. Mass: a third of each triangle's area goes to each corner
+		std::vector<float> mass(count, 0.0f);
+		float area = 0.0f;
+		for (size_t t = 0; t < m_triangles.size(); t += 3) {
+			const float a = 0.5f * glm::length(glm::cross(m_pos[m_triangles[t + 1]] - m_pos[m_triangles[t]], m_pos[m_triangles[t + 2]] - m_pos[m_triangles[t]]));
+			for (int k = 0; k < 3; ++k) mass[m_triangles[t + k]] += a / 3.0f;
+			area += a;
+		}
+		m_invMass.resize(count);
+		m_restInvMass.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			const float m = (area > 0.0f) ? mass[i] * totalMass / area : totalMass / static_cast<float>(count);
+			m_restInvMass[i] = m_invMass[i] = (m > 0.0f) ? 1.0f / m : 0.0f;
+		}
+
+		// 3. Stretch on every unique edge, bending across every edge two triangles share
+		struct EdgeInfo { uint32_t opposite; bool shared; };
+		std::unordered_map<uint64_t, EdgeInfo> edges;
+		edges.reserve(m_triangles.size());
+		std::vector<XpbdBodyDetail::Distance> stretch, bend;
+		for (size_t t = 0; t < m_triangles.size(); t += 3) {
+			for (int k = 0; k < 3; ++k) {
+				const uint32_t a = m_triangles[t + k];
+				const uint32_t b = m_triangles[t + (k + 1) % 3];
+				const uint32_t opposite = m_triangles[t + (k + 2) % 3];
+				const uint64_t key = (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+
+				auto [it, inserted] = edges.try_emplace(key, EdgeInfo{ opposite, false });
+				if (inserted) {
+					stretch.push_back({ a, b, glm::length(m_pos[b] - m_pos[a]) });
+				}
+				else if (!it->second.shared && it->second.opposite != opposite) {
+					it->second.shared = true; // A third triangle on the edge (non-manifold) adds no more bending
+					bend.push_back({ it->second.opposite, opposite, glm::length(m_pos[opposite] - m_pos[it->second.opposite]) });
+				}
+			}
+		}
+
+		ConstraintColoring coloring;
+		m_stretch.Build(stretch, count, coloring);
+		m_bend.Build(bend, count, coloring);
+
+		// 4. Particle -> triangle adjacency for the normals and the volume gradient
+		m_triangleStart.assign(count + 1, 0);
+		for (uint32_t i : m_triangles) m_triangleStart[i + 1]++;
+		for (size_t i = 0; i < count; ++i) m_triangleStart[i + 1] += m_triangleStart[i];
+		m_triangleOf.resize(m_triangles.size());
+		std::vector<uint32_t> cursor(m_triangleStart.begin(), m_triangleStart.end() - 1);
+		for (size_t c = 0; c < m_triangles.size(); ++c) m_triangleOf[cursor[m_triangles[c]]++] = static_cast<uint32_t>(c);
+
+		m_preserveVolume = preserveVolume;
+		m_restVolume = Volume();
+
+		m_faceNormal.resize(m_triangles.size() / 3);
+		m_normal.resize(count);
+		auto serial = [](size_t n, size_t, auto&& fn) { fn(size_t(0), n); };
+		UpdateNormals(serial);
+
+		m_vertexSign.assign(vertexCount, 1.0f);
+		if (normals) {
+			for (size_t v = 0; v < vertexCount; ++v) {
+				if (glm::dot(normals[v], m_normal[m_vertexParticle[v]]) < 0.0f) m_vertexSign[v] = -1.0f;
+			}
+		}
+	}
+
+	void Configure(const XpbdSettings& settings) { m_settings = settings; }
+	const XpbdSettings& Settings() const { return m_settings; }
+
+	// A pinned particle has infinite mass: constraints and gravity leave it where it is
+	void Pin(uint32_t particle) { m_invMass[particle] = 0.0f; m_vel[particle] = glm::vec3(0.0f); }
+	void Release(uint32_t particle) { m_invMass[particle] = m_restInvMass[particle]; }
+	bool IsPinned(uint32_t particle) const { return m_invMass[particle] == 0.0f; }
+	void ReleaseAll() { m_invMass = m_restInvMass; }
+
+	size_t ParticleCount() const { return m_pos.size(); }
+	size_t VertexCount() const { return m_vertexParticle.size(); }
+	size_t TriangleCount() const { return m_triangles.size() / 3; }
+	size_t StretchCount() const { return m_stretch.constraints.size(); }
+	size_t BendCount() const { return m_bend.constraints.size(); }
+	size_t BatchCount() const { return m_stretch.batches.size() + m_bend.batches.size(); }
+	bool Empty() const { return m_pos.empty(); }
+
+	uint32_t ParticleOf(size_t vertex) const { return m_vertexParticle[vertex]; }
+	const glm::vec3& Position(size_t particle) const { return m_pos[particle]; }
+	const glm::vec3& Velocity(size_t particle) const { return m_vel[particle]; }
+
+	// The render mesh as of the last step: its vertices follow their particles, normals are area-weighted
+	const glm::vec3& VertexPosition(size_t vertex) const { return m_pos[m_vertexParticle[vertex]]; }
+	glm::vec3 VertexNormal(size_t vertex) const { return m_normal[m_vertexParticle[vertex]] * m_vertexSign[vertex]; }
+
+	void Bounds(glm::vec3& lo, glm::vec3& hi) const
+	{
+		lo = glm::vec3(std::numeric_limits<float>::max());
+		hi = glm::vec3(-std::numeric_limits<float>::max());
+		for (const glm::vec3& p : m_pos) {
+			lo = glm::min(lo, p);
+			hi = glm::max(hi, p);
+		}
+	}
+
+	// Signed volume enclosed by the triangles; positive for a closed mesh wound counter-clockwise from outside
+	float Volume() const
+	{
+		double volume = 0.0;
+		for (size_t t = 0; t < m_triangles.size(); t += 3) {
+			volume += glm::dot(m_pos[m_triangles[t]], glm::cross(m_pos[m_triangles[t + 1]], m_pos[m_triangles[t + 2]]));
+		}
+		return static_cast<float>(volume / 6.0);
+	}
+
+	float RestVolume() const { return m_restVolume; }
+	bool PreservesVolume() const { return m_preserveVolume; }
+
+	// Advances dt in Settings().substeps substeps, then refreshes the normals
+	template <typename ParallelFor>
+	void Step(float dt, const ParticleColliders& colliders, ParallelFor&& parallelFor)
+	{
+		if (m_pos.empty() || !(dt > 0.0f)) return;
+
+		const int substeps = std::max(m_settings.substeps, 1);
+		const float h = dt / static_cast<float>(substeps);
+		for (int s = 0; s < substeps; ++s) {
+			Predict(h, parallelFor);
+			SolveDistances(m_stretch, m_settings.stretchCompliance, h, parallelFor);
+			SolveDistances(m_bend, m_settings.bendCompliance, h, parallelFor);
+			if (m_preserveVolume) SolveVolume(h);
+			Finish(h, colliders, parallelFor);
+		}
+		UpdateNormals(parallelFor);
+	}
+
+	template <typename ParallelFor>
+	void Step(float dt, ParallelFor&& parallelFor)
+	{
+		Step(dt, ParticleColliders{}, parallelFor);
+	}
+
+private:
+	static constexpr size_t MIN_BATCH = 512;
+
+	// Vertices closer than a ten-thousandth of the mesh's extent become one particle
+	void Weld(const glm::vec3* positions, size_t vertexCount)
+	{
+		m_pos.clear();
+		m_vertexParticle.resize(vertexCount);
+
+		glm::vec3 lo(std::numeric_limits<float>::max()), hi(-std::numeric_limits<float>::max());
+		for (size_t v = 0; v < vertexCount; ++v) {
+			lo = glm::min(lo, positions[v]);
+			hi = glm::max(hi, positions[v]);
+		}
+		const glm::vec3 extent = hi - lo;
+		const float tolerance = std::max(1e-4f * std::max({ extent.x, extent.y, extent.z }), 1e-7f);
+		const float invCell = 1.0f / tolerance;
+
+		// Hash grid of tolerance-sized cells: a match lies in the vertex's cell or one of its 26 neighbours
+		std::unordered_map<uint64_t, uint32_t> head;
+		std::vector<uint32_t> next;
+		head.reserve(vertexCount);
+		auto key = [](int64_t x, int64_t y, int64_t z) {
+			return (uint64_t(x & 0x1FFFFF) << 42) | (uint64_t(y & 0x1FFFFF) << 21) | uint64_t(z & 0x1FFFFF);
+		};
+
+		for (size_t v = 0; v < vertexCount; ++v) {
+			const glm::vec3 p = positions[v];
+			const int64_t cx = static_cast<int64_t>((p.x - lo.x) * invCell);
+			const int64_t cy = static_cast<int64_t>((p.y - lo.y) * invCell);
+			const int64_t cz = static_cast<int64_t>((p.z - lo.z) * invCell);
+
+			uint32_t match = UINT32_MAX;
+			for (int64_t dz = -1; dz <= 1 && match == UINT32_MAX; ++dz)
+				for (int64_t dy = -1; dy <= 1 && match == UINT32_MAX; ++dy)
+					for (int64_t dx = -1; dx <= 1 && match == UINT32_MAX; ++dx) {
+						const auto it = head.find(key(cx + dx, cy + dy, cz + dz));
+						for (uint32_t i = (it != head.end()) ? it->second : UINT32_MAX; i != UINT32_MAX; i = next[i]) {
+							const glm::vec3 d = m_pos[i] - p;
+							if (glm::dot(d, d) <= tolerance * tolerance) { match = i; break; }
+						}
+					}
+
+			if (match == UINT32_MAX) {
+				match = static_cast<uint32_t>(m_pos.size());
+				m_pos.push_back(p);
+				auto [it, inserted] = head.try_emplace(key(cx, cy, cz), match);
+				next.push_back(inserted ? UINT32_MAX : it->second);
+				it->second = match;
+			}
+			m_vertexParticle[v] = match;
+		}
+
+		m_prev = m_pos;
+		m_vel.assign(m_pos.size(), glm::vec3(0.0f));
+	}
+
+	template <typename ParallelFor>
+	void Predict(float h, ParallelFor& parallelFor)
+	{
+		const glm::vec3 g = m_settings.gravity * h;
+		const float maxSpeed2 = m_settings.maxSpeed * m_settings.maxSpeed;
+		parallelFor(m_pos.size(), MIN_BATCH * 4, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				m_prev[i] = m_pos[i];
+				if (m_invMass[i] == 0.0f) continue;
+
+				glm::vec3 v = m_vel[i] + g;
+				const float speed2 = glm::dot(v, v);
+				if (speed2 > maxSpeed2) v *= m_settings.maxSpeed / std::sqrt(speed2);
+				m_vel[i] = v;
+				m_pos[i] += v * h;
+			}
+		});
+	}
+
+	// One Gauss-Seidel pass per batch. The Lagrange multiplier starts from zero every substep, so with a
+	// single pass its accumulated value is never needed and is not stored.
+	template <typename ParallelFor>
+	void SolveDistances(const XpbdBodyDetail::DistanceSet& set, float compliance, float h, ParallelFor& parallelFor)
+	{
+		const float alpha = compliance / (h * h);
+		auto solve = [&](size_t begin, size_t end) {
+			for (size_t c = begin; c < end; ++c) {
+				const XpbdBodyDetail::Distance& d = set.constraints[c];
+				const float wa = m_invMass[d.a];
+				const float wb = m_invMass[d.b];
+				const float w = wa + wb;
+				if (w == 0.0f) continue;
+
+				const glm::vec3 delta = m_pos[d.b] - m_pos[d.a];
+				const float length = std::sqrt(glm::dot(delta, delta));
+				if (length < 1e-9f) continue;
+				const float lambda = -(length - d.rest) / (w + alpha);
+				const glm::vec3 correction = delta * (lambda / length);
+				m_pos[d.a] -= correction * wa;
+				m_pos[d.b] += correction * wb;
+			}
+		};
+
+		for (const ConstraintColoring::Batch& batch : set.batches) {
+			if (batch.serial) {
+				solve(batch.begin, batch.end);
+				continue;
+			}
+			parallelFor(batch.end - batch.begin, MIN_BATCH, [&](size_t begin, size_t end) {
+				solve(batch.begin + begin, batch.begin + end);
+			});
+		}
+	}
+
+	// The whole surface is one constraint, so it is solved serially: C = V - pressure * V0,
+	// with gradient (1/6) sum of p_j x p_k over the triangles (i, j, k) around each particle
+	void SolveVolume(float h)
+	{
+		const float alpha = m_settings.volumeCompliance / (h * h);
+		const float error = Volume() - m_settings.pressure * m_restVolume;
+
+		m_gradient.assign(m_pos.size(), glm::vec3(0.0f));
+		for (size_t t = 0; t < m_triangles.size(); t += 3) {
+			const uint32_t i0 = m_triangles[t], i1 = m_triangles[t + 1], i2 = m_triangles[t + 2];
+			m_gradient[i0] += glm::cross(m_pos[i1], m_pos[i2]) / 6.0f;
+			m_gradient[i1] += glm::cross(m_pos[i2], m_pos[i0]) / 6.0f;
+			m_gradient[i2] += glm::cross(m_pos[i0], m_pos[i1]) / 6.0f;
+		}
+
+		float w = 0.0f;
+		for (size_t i = 0; i < m_pos.size(); ++i) w += m_invMass[i] * glm::dot(m_gradient[i], m_gradient[i]);
+		if (w < 1e-12f) return;
+
+		const float lambda = -error / (w + alpha);
+		for (size_t i = 0; i < m_pos.size(); ++i) m_pos[i] += m_gradient[i] * (m_invMass[i] * lambda);
+	}
+
+	// Pushes particles out of the colliders, with position-based friction against the collider's own motion,
+	// then derives the velocity from how far each particle moved this substep
+	template <typename ParallelFor>
+	void Finish(float h, const ParticleColliders& colliders, ParallelFor& parallelFor)
+	{
+		const float radius = m_settings.thickness;
+		const float friction = m_settings.friction;
+		const float keep = std::max(1.0f - m_settings.damping * h, 0.0f) / h;
+		const bool collide = !colliders.Empty();
+
+		parallelFor(m_pos.size(), MIN_BATCH * 4, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				if (m_invMass[i] == 0.0f) continue;
+				glm::vec3& p = m_pos[i];
+				const glm::vec3 previous = m_prev[i];
+
+				if (collide) {
+					colliders.ForEachContact(previous, p, radius, [&](const glm::vec3& normal, float depth, const glm::vec3& colliderVelocity) {
+						p += normal * depth;
+						const glm::vec3 moved = (p - previous) - colliderVelocity * h;
+						const glm::vec3 slide = moved - normal * glm::dot(moved, normal);
+						const float slide2 = glm::dot(slide, slide);
+						if (slide2 > 0.0f) p -= slide * std::min(friction * depth / std::sqrt(slide2), 1.0f);
+					});
+				}
+				m_vel[i] = (p - previous) * keep;
+			}
+		});
+	}
+
+	template <typename ParallelFor>
+	void UpdateNormals(ParallelFor& parallelFor)
+	{
+		parallelFor(m_faceNormal.size(), MIN_BATCH * 4, [&](size_t begin, size_t end) {
+			for (size_t t = begin; t < end; ++t) {
+				const glm::vec3& a = m_pos[m_triangles[3 * t]];
+				m_faceNormal[t] = glm::cross(m_pos[m_triangles[3 * t + 1]] - a, m_pos[m_triangles[3 * t + 2]] - a);
+			}
+		});
+		parallelFor(m_pos.size(), MIN_BATCH * 4, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				glm::vec3 n(0.0f);
+				for (uint32_t k = m_triangleStart[i]; k < m_triangleStart[i + 1]; ++k) n += m_faceNormal[m_triangleOf[k] / 3];
+				const float length2 = glm::dot(n, n);
+				m_normal[i] = (length2 > 0.0f) ? n / std::sqrt(length2) : glm::vec3(0.0f, 1.0f, 0.0f);
+			}
+		});
+	}
+
+	XpbdSettings m_settings;
+
+	std::vector<glm::vec3> m_pos;
+	std::vector<glm::vec3> m_prev;
+	std::vector<glm::vec3> m_vel;
+	std::vector<float> m_invMass;
+	std::vector<float> m_restInvMass; // What Release gives back to a pinned particle
+
+	std::vector<uint32_t> m_triangles;     // Three particle indices each
+	std::vector<uint32_t> m_triangleStart; // CSR: corners of particle i are m_triangleOf[start[i] .. start[i + 1])
+	std::vector<uint32_t> m_triangleOf;    // Corner positions in m_triangles
+	std::vector<glm::vec3> m_faceNormal;   // Area-weighted
+	std::vector<glm::vec3> m_normal;
+	std::vector<glm::vec3> m_gradient;
+
+	std::vector<uint32_t> m_vertexParticle;
+	std::vector<float> m_vertexSign;
+
+	XpbdBodyDetail::DistanceSet m_stretch;
+	XpbdBodyDetail::DistanceSet m_bend;
+
+	bool m_preserveVolume = false;
+	float m_restVolume = 0.0f;
+};
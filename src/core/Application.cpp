@@ -289,7 +289,10 @@ void Application::SetupScene() {
         scene->SetObjectLayerMask(objCfg.name, objCfg.layerMask);
         scene->SetObjectCollision(objCfg.name, objCfg.hasCollision);
         scene->SetObjectPhysics(objCfg.name, objCfg.isStatic, 1.0f);
-        scene->SetObjectCollider(objCfg.name, objCfg.colliderType, objCfg.colliderRadius, objCfg.colliderNormal);
+        if (objCfg.type != "Terrain") {
+            // Terrain keeps the heightfield collider AddTerrain baked for it
+            scene->SetObjectCollider(objCfg.name, objCfg.colliderType, objCfg.colliderRadius, objCfg.colliderNormal);
+        }
         // --- Apply Light ---
         if (objCfg.isLight) {
             scene->AddLight(objCfg.name, objCfg.position, objCfg.lightColor, objCfg.lightIntensity, objCfg.lightType);
@@ -385,6 +388,11 @@ void Application::MainLoop() {
             *scene,
             cameraController->GetOrbitTarget());
 
+        // Click-to-select: a left click the UI did not take picks the object under the cursor
+        if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && !ImGui::GetIO().WantCaptureMouse) {
+            PickObjectAtCursor();
+        }
+
         const float* uiColor = editorUI->GetClearColor();
         renderer->SetClearColor(glm::vec4(uiColor[0], uiColor[1], uiColor[2], uiColor[3]));
 
@@ -400,6 +408,14 @@ void Application::MainLoop() {
             scene->ResetEnvironment();
         }
 
+        // 2. Handle Snapshots
+        if (editorUI->ConsumeSnapshotSaveRequest()) {
+            scene->SaveSnapshot();
+        }
+        if (editorUI->ConsumeSnapshotRestoreRequest()) {
+            scene->RestoreSnapshot();
+        }
+
         std::string selectedCam = editorUI->ConsumeCameraSwitchRequest();
         if (!selectedCam.empty()) {
             cameraController->SwitchCamera(selectedCam, *scene);
@@ -467,6 +483,7 @@ void Application::MainLoop() {
                     // Default to a small terrain patch
                     render.geometry = GeometryGenerator::CreateTerrain(vulkanDevice->GetDevice(), vulkanDevice->GetPhysicalDevice(), 10.0f, 64, 64, 1.5f, 0.1f);
                 }
+                registry.MarkChanged<RenderComponent>(req.entity);
             }
         }
         // --------------------------------
@@ -488,11 +505,9 @@ void Application::MainLoop() {
         const VkExtent2D extent = vulkanSwapChain->GetExtent();
         const float aspectRatio = (extent.height > 0) ? (extent.width / static_cast<float>(extent.height)) : 1.0f;
 
-        for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-            if (registry.HasComponent<CameraComponent>(e)) {
-                registry.GetComponent<CameraComponent>(e).aspectRatio = aspectRatio;
-            }
-        }
+        registry.Each<CameraComponent>([aspectRatio](Entity, CameraComponent& cam) {
+            cam.aspectRatio = aspectRatio;
+        });
 
         // 4. Update the scene with the calculated delta
         scene->Update(stepDelta);
@@ -531,6 +546,26 @@ void Application::MainLoop() {
     renderer->WaitIdle();
 }
 
+void Application::PickObjectAtCursor() {
+    Registry& registry = scene->GetRegistry();
+    const Entity camEntity = cameraController->GetActiveCameraEntity();
+    if (camEntity == MAX_ENTITIES || !registry.HasComponent<CameraComponent>(camEntity)) return;
+    const auto& cam = registry.GetComponent<CameraComponent>(camEntity);
+
+    const ImGuiIO& io = ImGui::GetIO();
+    if (io.DisplaySize.x <= 0.0f || io.DisplaySize.y <= 0.0f) return;
+
+    // Vulkan NDC has +Y down like the window, and the projection already carries the flip.
+    // Depth 1 is the far plane under either depth convention.
+    const glm::vec2 ndc(2.0f * io.MousePos.x / io.DisplaySize.x - 1.0f, 2.0f * io.MousePos.y / io.DisplaySize.y - 1.0f);
+    const glm::vec4 farPoint = glm::inverse(cam.projectionMatrix * cam.viewMatrix) * glm::vec4(ndc, 1.0f, 1.0f);
+    const glm::vec3 origin = glm::vec3(glm::inverse(cam.viewMatrix)[3]);
+    const glm::vec3 ray = glm::vec3(farPoint) / farPoint.w - origin;
+
+    const Entity hit = scene->Raycast(origin, ray, glm::length(ray));
+    if (hit != MAX_ENTITIES) editorUI->SelectEntity(hit);
+}
+
 void Application::ProcessInput() {
     // --- Application / System ---
     if (inputManager->IsActionJustPressed(InputAction::Exit)) {
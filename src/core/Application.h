@@ -37,6 +37,7 @@ private:
 
     // Input handling
     void ProcessInput();
+    void PickObjectAtCursor();
     static void KeyCallback(GLFWwindow* glfwWindow, int key, int scancode, int action, int mods);
     static void FramebufferResizeCallback(GLFWwindow* glfwWindow, int width, int height);
 
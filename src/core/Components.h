@@ -4,18 +4,29 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
 #include <memory>
+#include <type_traits>
 #include "../geometry/Geometry.h"
 #include "ECS.h"
+#include "SymbolTable.h"
+#include "TransformHierarchy.h"
 #include "CoreTypes.h"
 #include "../core/Config.h"
 #include "../rendering/ParticleSystem.h"
 
+class Heightfield; // SimulationStaticLib/Heightfield.h
+class TriangleBVH; // SimulationStaticLib/TriangleBVH.h
+class XpbdBody; // SimulationStaticLib/XpbdBody.h
 
 // 1. Identification
 struct NameComponent {
     std::string name;
+    Symbol symbol = INVALID_SYMBOL; // Interned form used for lookups; the string is for display
 };
 
+// Tags for well-known entities, so they can be found without a name lookup
+struct SunTag {};
+struct FireLightTag {};
+
 // 2. Spatial Data
 struct TransformComponent {
     glm::mat4 matrix = glm::mat4(1.0f);
@@ -25,14 +36,20 @@ struct TransformComponent {
     glm::vec3 rotation = glm::vec3(0.0f); // Stored in Degrees
     glm::vec3 scale = glm::vec3(1.0f);
 
-    // Call this whenever pos/rot/scale are changed
-    void UpdateMatrix() {
+    // pos/rot/scale as a matrix (relative to the parent for entities with a HierarchyComponent)
+    glm::mat4 LocalMatrix() const {
         glm::mat4 m = glm::translate(glm::mat4(1.0f), position);
         m = glm::rotate(m, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
         m = glm::rotate(m, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
         m = glm::rotate(m, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
         m = glm::scale(m, scale);
-        matrix = m;
+        return m;
+    }
+
+    // Call this whenever pos/rot/scale are changed
+    // Children get their world matrix from the hierarchy pass at the end of Scene::Update
+    void UpdateMatrix() {
+        matrix = LocalMatrix();
     }
 };
 
@@ -104,6 +121,18 @@ struct PhysicsComponent {
     float friction = 0.98f;
     float restitution = 1.0f;
 
+    // Sleeping bodies are left out of integration and pair generation until an impact or an edit wakes
+    // their island. sleepPosition is where the body fell asleep, so outside moves can be detected.
+    bool isSleeping = false;
+    int restFrames = 0;
+    uint32_t islandId = 0;
+    glm::vec3 sleepPosition = glm::vec3(0.0f);
+
+    // Position before the last fixed step; the rendered matrix blends from here to position
+    // (not until the body has been stepped once)
+    glm::vec3 previousPosition = glm::vec3(0.0f);
+    bool hasPreviousPosition = false;
+
     // Helper to safely set mass and update inverse mass
     void SetMass(float newMass) {
         if (newMass <= 0.0f) {
@@ -120,10 +149,26 @@ struct PhysicsComponent {
 
 struct ColliderComponent {
     bool hasCollision = true;
-    int type = 0; // 0 = Sphere, 1 = Plane
-    float radius = 2.0f; // Used if type == 0
+    int type = 0; // 0 = Sphere, 1 = Plane, 2 = Heightfield, 3 = Mesh
+    float radius = 2.0f; // Used if type == 0; for a heightfield, the disc around its origin that collides (0 = whole raster)
     glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f); // Used if type == 1
     float height = 5.0f;
+    std::shared_ptr<const Heightfield> heightfield; // Used if type == 2; shared with the scene's TerrainConfig
+    std::shared_ptr<const TriangleBVH> mesh; // Used if type == 3; the render geometry's BVH, in its local space
+};
+
+// The shared shape pointers keep the collider pool off the snapshot's memcpy path (RegistrySnapshot): colliders are
+// copied one by one, each heightfield or mesh costing a reference count. They are few beside the transform and
+// physics pools, which are on every body and must stay on the fast path.
+static_assert(std::is_trivially_copyable_v<TransformComponent> && std::is_trivially_copyable_v<PhysicsComponent>,
+    "Body state is snapshotted with memcpy");
+
+// Cloth or soft body: the render geometry is dynamic and rewritten from the solver every frame. The body
+// simulates in world space, so the entity's transform stays at identity. Snapshots share the solver rather
+// than copying it, so a restore leaves deformables where they are.
+struct SoftBodyComponent {
+    std::shared_ptr<XpbdBody> body;
+    float stepTimeMs = 0.0f; // Solver wall time last frame
 };
 
 // 7. Light
@@ -52,7 +52,7 @@ struct SceneObjectConfig {
     bool isStatic = true;
     bool isFlammable = false;
 
-    int colliderType = 0; // 0 = Sphere, 1 = Plane
+    int colliderType = 0; // 0 = Sphere, 1 = Plane, 3 = Mesh (terrain always gets its baked heightfield)
     float colliderRadius = 2.0f;
     glm::vec3 colliderNormal = glm::vec3(0.0f, 1.0f, 0.0f);
 
@@ -1,70 +1,324 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
 #include <queue>
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
+#include <new>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 using Entity = uint32_t;
-const Entity MAX_ENTITIES = 5000;
+
+// Upper bound of the entity ID space. Pools grow on demand, so this is not a preallocation size;
+// the value itself is never handed out and doubles as the "no entity" sentinel.
+const Entity MAX_ENTITIES = std::numeric_limits<Entity>::max();
+
+// Sequential per-type IDs used to index the Registry's pool table.
+// Each component type draws the next ID the first time it is used, and keeps it for the rest of the run.
+class ComponentFamily {
+public:
+    template <typename T>
+    static size_t Id() {
+        static const size_t id = counter++;
+        return id;
+    }
+
+private:
+    static inline std::atomic<size_t> counter{ 0 };
+};
+
+// Binary image of a Registry produced by Registry::SaveSnapshot.
+// Pools of trivially copyable components are stored as raw bytes in `data` and restored with one
+// memcpy per storage segment. Pools that own resources (shared geometry, strings) keep copies in a
+// side table instead, so shared resources are referenced rather than duplicated.
+struct RegistrySnapshot {
+    struct Pool {
+        size_t family = 0;
+        size_t count = 0;
+        size_t entityOffset = 0;                 // Packed entity list in data
+        size_t componentOffset = 0;              // Raw components in data (trivially copyable pools only)
+        std::shared_ptr<const void> sideTable;   // std::vector<T> of copies for every other pool
+    };
+
+    std::vector<unsigned char> data;
+    std::vector<Pool> pools;
+    Entity nextEntityId = 0;
+    std::vector<Entity> availableEntities;
+
+    size_t ByteSize() const { return data.size(); }
+
+    size_t Append(const void* bytes, size_t size) {
+        const size_t offset = data.size();
+        data.resize(offset + size);
+        if (size > 0) std::memcpy(data.data() + offset, bytes, size);
+        return offset;
+    }
+};
 
 class IComponentArray {
 public:
     virtual ~IComponentArray() = default;
     virtual void EntityDestroyed(Entity entity) = 0;
+
+    // Packed (dense) view of the entities that own this component, used to drive joins
+    virtual size_t Size() const = 0;
+    virtual Entity EntityAt(size_t index) const = 0;
+
+    virtual void SaveSnapshot(RegistrySnapshot& snapshot, size_t family) const = 0;
+    // Replaces the pool contents with the snapshot's (pool == nullptr empties it).
+    // Every restored component is marked changed at changeTick.
+    virtual void RestoreSnapshot(const RegistrySnapshot& snapshot, const RegistrySnapshot::Pool* pool, uint32_t changeTick) = 0;
 };
 
+// Dense component storage split into segments that double in size (64, 64, 128, 256, ...).
+// Capacity grows geometrically like a vector, but existing elements never move, so references
+// handed out by GetComponent stay valid while other entities gain components.
+template <typename T>
+class SegmentedStorage {
+public:
+    SegmentedStorage() = default;
+    SegmentedStorage(const SegmentedStorage&) = delete;
+    SegmentedStorage& operator=(const SegmentedStorage&) = delete;
+
+    ~SegmentedStorage() {
+        while (count > 0) PopBack();
+        std::allocator<T> allocator;
+        for (size_t s = 0; s < segments.size(); ++s) {
+            allocator.deallocate(segments[s], SegmentCapacity(s));
+        }
+    }
+
+    T& operator[](size_t index) { return *Locate(index); }
+    const T& operator[](size_t index) const { return *Locate(index); }
+
+    void PushBack(T&& value) {
+        size_t segment, offset;
+        SplitIndex(count, segment, offset);
+        if (segment == segments.size()) {
+            segments.push_back(std::allocator<T>().allocate(SegmentCapacity(segment)));
+        }
+        new (segments[segment] + offset) T(std::move(value));
+        count++;
+    }
+
+    void PopBack() {
+        Locate(count - 1)->~T();
+        count--;
+    }
+
+    size_t Size() const { return count; }
+
+    void Clear() {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            count = 0;
+        }
+        else {
+            while (count > 0) PopBack();
+        }
+    }
+
+    // Calls fn(elements, n) for each contiguous run, in index order
+    template <typename Fn>
+    void ForEachChunk(Fn&& fn) const {
+        size_t remaining = count;
+        for (size_t s = 0; s < segments.size() && remaining > 0; ++s) {
+            const size_t n = std::min(remaining, SegmentCapacity(s));
+            fn(static_cast<const T*>(segments[s]), n);
+            remaining -= n;
+        }
+    }
+
+    // Bulk append for trivially copyable types: one memcpy per segment touched
+    void AppendBytes(const unsigned char* bytes, size_t n) {
+        static_assert(std::is_trivially_copyable_v<T>, "AppendBytes requires a trivially copyable type");
+        while (n > 0) {
+            size_t segment, offset;
+            SplitIndex(count, segment, offset);
+            if (segment == segments.size()) {
+                segments.push_back(std::allocator<T>().allocate(SegmentCapacity(segment)));
+            }
+            const size_t chunk = std::min(n, SegmentCapacity(segment) - offset);
+            std::memcpy(static_cast<void*>(segments[segment] + offset), bytes, chunk * sizeof(T));
+            bytes += chunk * sizeof(T);
+            count += chunk;
+            n -= chunk;
+        }
+    }
+
+private:
+    static constexpr size_t FIRST_SEGMENT_BITS = 6;
+
+    static size_t SegmentCapacity(size_t segment) {
+        return size_t(1) << (segment == 0 ? FIRST_SEGMENT_BITS : FIRST_SEGMENT_BITS + segment - 1);
+    }
+
+    static size_t HighestBit(size_t value) {
+#if defined(_MSC_VER)
+        unsigned long bit;
+        _BitScanReverse64(&bit, static_cast<unsigned long long>(value));
+        return bit;
+#else
+        return 63 - static_cast<size_t>(__builtin_clzll(static_cast<unsigned long long>(value)));
+#endif
+    }
+
+    static void SplitIndex(size_t index, size_t& segment, size_t& offset) {
+        if (index < (size_t(1) << FIRST_SEGMENT_BITS)) {
+            segment = 0;
+            offset = index;
+            return;
+        }
+        const size_t highBit = HighestBit(index);
+        segment = highBit - FIRST_SEGMENT_BITS + 1;
+        offset = index - (size_t(1) << highBit);
+    }
+
+    T* Locate(size_t index) const {
+        size_t segment, offset;
+        SplitIndex(index, segment, offset);
+        return segments[segment] + offset;
+    }
+
+    std::vector<T*> segments;
+    size_t count = 0;
+};
+
+// Sparse set: entity -> dense index through a paged lookup table, dense index -> component.
+// Sparse pages are only allocated for entity ranges that actually own this component,
+// so memory follows the live entity count rather than a fixed cap.
 template <typename T>
 class ComponentArray : public IComponentArray {
 private:
-    std::vector<T> componentData;
-    std::vector<size_t> entityToIndex;
+    static constexpr size_t PAGE_BITS = 12;
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS;
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    SegmentedStorage<T> componentData;
+    std::vector<std::unique_ptr<uint32_t[]>> sparsePages;
     std::vector<Entity> indexToEntity;
-    size_t validSize = 0;
 
-public:
-    ComponentArray() {
-        componentData.resize(MAX_ENTITIES);
-        entityToIndex.resize(MAX_ENTITIES, -1);
-        indexToEntity.resize(MAX_ENTITIES, -1);
+    // Change tracking: the tick each component was last marked changed (parallel to the dense arrays),
+    // plus a log of (entity, tick) in tick order so "changed since" queries skip untouched components
+    std::vector<uint32_t> changeTicks;
+    std::vector<std::pair<Entity, uint32_t>> changeLog;
+    uint64_t structureVersion = 0;
+
+    uint32_t IndexOf(Entity entity) const {
+        const size_t page = entity >> PAGE_BITS;
+        if (page >= sparsePages.size() || !sparsePages[page]) return INVALID_INDEX;
+        return sparsePages[page][entity & (PAGE_SIZE - 1)];
+    }
+
+    uint32_t& SparseSlot(Entity entity) {
+        const size_t page = entity >> PAGE_BITS;
+        if (page >= sparsePages.size()) {
+            sparsePages.resize(page + 1);
+        }
+        if (!sparsePages[page]) {
+            sparsePages[page].reset(new uint32_t[PAGE_SIZE]);
+            std::fill(sparsePages[page].get(), sparsePages[page].get() + PAGE_SIZE, INVALID_INDEX);
+        }
+        return sparsePages[page][entity & (PAGE_SIZE - 1)];
     }
 
-    void InsertData(Entity entity, T component) {
-        if (entityToIndex[entity] != static_cast<size_t>(-1)) {
-            componentData[entityToIndex[entity]] = component;
+public:
+    void InsertData(Entity entity, T component, uint32_t changeTick = 0) {
+        uint32_t& slot = SparseSlot(entity);
+        if (slot != INVALID_INDEX) {
+            componentData[slot] = std::move(component);
+            MarkChanged(entity, changeTick);
             return;
         }
-        size_t newIndex = validSize;
-        entityToIndex[entity] = newIndex;
-        indexToEntity[newIndex] = entity;
-        componentData[newIndex] = component;
-        validSize++;
+        slot = static_cast<uint32_t>(componentData.Size());
+        indexToEntity.push_back(entity);
+        changeTicks.push_back(UINT32_MAX);
+        componentData.PushBack(std::move(component));
+        structureVersion++;
+        MarkChanged(entity, changeTick);
+    }
+
+    void MarkChanged(Entity entity, uint32_t changeTick) {
+        const uint32_t index = IndexOf(entity);
+        if (index == INVALID_INDEX || changeTicks[index] == changeTick) return;
+
+        changeTicks[index] = changeTick;
+        changeLog.emplace_back(entity, changeTick);
+
+        // Keep the log bounded: drop entries superseded by a later change of the same entity
+        if (changeLog.size() > 2 * componentData.Size() + 1024) {
+            CompactChangeLog();
+        }
+    }
+
+    // Calls fn(entity) once for every entity whose component was marked at or after sinceTick
+    template <typename Fn>
+    void ForEachChangedSince(uint32_t sinceTick, Fn&& fn) const {
+        auto it = std::lower_bound(changeLog.begin(), changeLog.end(), sinceTick,
+            [](const std::pair<Entity, uint32_t>& entry, uint32_t tick) { return entry.second < tick; });
+        for (; it != changeLog.end(); ++it) {
+            const uint32_t index = IndexOf(it->first);
+            // Skip removed components and entries superseded by a later change
+            if (index != INVALID_INDEX && changeTicks[index] == it->second) {
+                fn(it->first);
+            }
+        }
+    }
+
+    bool ChangedSince(Entity entity, uint32_t sinceTick) const {
+        const uint32_t index = IndexOf(entity);
+        return index != INVALID_INDEX && changeTicks[index] != UINT32_MAX && changeTicks[index] >= sinceTick;
+    }
+
+    // Bumped whenever a component is added or removed (dense indices and membership changed)
+    uint64_t GetStructureVersion() const { return structureVersion; }
+
+    void CompactChangeLog() {
+        size_t write = 0;
+        for (size_t read = 0; read < changeLog.size(); ++read) {
+            const uint32_t index = IndexOf(changeLog[read].first);
+            if (index != INVALID_INDEX && changeTicks[index] == changeLog[read].second) {
+                changeLog[write++] = changeLog[read];
+            }
+        }
+        changeLog.resize(write);
     }
 
     void RemoveData(Entity entity) {
-        if (entityToIndex[entity] == static_cast<size_t>(-1)) return;
+        const uint32_t indexOfRemovedEntity = IndexOf(entity);
+        if (indexOfRemovedEntity == INVALID_INDEX) return;
 
-        size_t indexOfRemovedEntity = entityToIndex[entity];
-        size_t indexOfLastElement = validSize - 1;
+        const uint32_t indexOfLastElement = static_cast<uint32_t>(componentData.Size() - 1);
 
         if (indexOfRemovedEntity != indexOfLastElement) {
-            componentData[indexOfRemovedEntity] = componentData[indexOfLastElement];
+            componentData[indexOfRemovedEntity] = std::move(componentData[indexOfLastElement]);
+            changeTicks[indexOfRemovedEntity] = changeTicks[indexOfLastElement];
             Entity entityOfLastElement = indexToEntity[indexOfLastElement];
-            entityToIndex[entityOfLastElement] = indexOfRemovedEntity;
+            SparseSlot(entityOfLastElement) = indexOfRemovedEntity;
             indexToEntity[indexOfRemovedEntity] = entityOfLastElement;
         }
 
-        entityToIndex[entity] = -1;
-        indexToEntity[indexOfLastElement] = -1;
-        validSize--;
+        SparseSlot(entity) = INVALID_INDEX;
+        indexToEntity.pop_back();
+        changeTicks.pop_back();
+        componentData.PopBack();
+        structureVersion++;
     }
 
     T& GetData(Entity entity) {
-        size_t index = entityToIndex[entity];
-        if (index == static_cast<size_t>(-1)) {
+        const uint32_t index = IndexOf(entity);
+        if (index == INVALID_INDEX) {
             throw std::runtime_error("Retrieving non-existent component.");
         }
         return componentData[index];
@@ -72,16 +326,26 @@ public:
 
     // --- ADD CONST OVERLOAD ---
     const T& GetData(Entity entity) const {
-        size_t index = entityToIndex[entity];
-        if (index == static_cast<size_t>(-1)) {
+        const uint32_t index = IndexOf(entity);
+        if (index == INVALID_INDEX) {
             throw std::runtime_error("Retrieving non-existent component.");
         }
         return componentData[index];
     }
 
     bool HasData(Entity entity) const {
-        if (entity >= entityToIndex.size()) return false;
-        return entityToIndex[entity] != static_cast<size_t>(-1);
+        return IndexOf(entity) != INVALID_INDEX;
+    }
+
+    // Single sparse lookup for joins: nullptr if the entity has no component
+    T* TryGetData(Entity entity) {
+        const uint32_t index = IndexOf(entity);
+        return (index == INVALID_INDEX) ? nullptr : &componentData[index];
+    }
+
+    const T* TryGetData(Entity entity) const {
+        const uint32_t index = IndexOf(entity);
+        return (index == INVALID_INDEX) ? nullptr : &componentData[index];
     }
 
     void EntityDestroyed(Entity entity) override {
@@ -89,33 +353,164 @@ public:
             RemoveData(entity);
         }
     }
+
+    size_t Size() const override { return componentData.Size(); }
+    Entity EntityAt(size_t index) const override { return indexToEntity[index]; }
+
+    void SaveSnapshot(RegistrySnapshot& snapshot, size_t family) const override {
+        RegistrySnapshot::Pool pool;
+        pool.family = family;
+        pool.count = componentData.Size();
+        pool.entityOffset = snapshot.Append(indexToEntity.data(), indexToEntity.size() * sizeof(Entity));
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            pool.componentOffset = snapshot.data.size();
+            componentData.ForEachChunk([&](const T* chunk, size_t n) { snapshot.Append(chunk, n * sizeof(T)); });
+        }
+        else if constexpr (std::is_copy_constructible_v<T>) {
+            auto copies = std::make_shared<std::vector<T>>();
+            copies->reserve(pool.count);
+            for (size_t i = 0; i < pool.count; ++i) copies->push_back(componentData[i]);
+            pool.sideTable = std::move(copies);
+        }
+        else {
+            throw std::runtime_error("Component type cannot be captured in a snapshot.");
+        }
+
+        snapshot.pools.push_back(std::move(pool));
+    }
+
+    void RestoreSnapshot(const RegistrySnapshot& snapshot, const RegistrySnapshot::Pool* pool, uint32_t changeTick) override {
+        // Reset only the sparse slots in use, so pages that are already allocated are reused
+        for (Entity entity : indexToEntity) SparseSlot(entity) = INVALID_INDEX;
+        indexToEntity.clear();
+        changeTicks.clear();
+        changeLog.clear();
+        componentData.Clear();
+        structureVersion++;
+
+        if (!pool || pool->count == 0) return;
+        const size_t count = pool->count;
+
+        indexToEntity.resize(count);
+        std::memcpy(indexToEntity.data(), snapshot.data.data() + pool->entityOffset, count * sizeof(Entity));
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            componentData.AppendBytes(snapshot.data.data() + pool->componentOffset, count);
+        }
+        else if constexpr (std::is_copy_constructible_v<T>) {
+            const auto& copies = *static_cast<const std::vector<T>*>(pool->sideTable.get());
+            for (const T& component : copies) componentData.PushBack(T(component));
+        }
+
+        changeTicks.assign(count, changeTick);
+        changeLog.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            SparseSlot(indexToEntity[i]) = i;
+            changeLog.emplace_back(indexToEntity[i], changeTick);
+        }
+    }
+};
+
+// Lazy join over several component pools.
+// Iteration walks the packed entities of the smallest pool (back to front, so the current
+// entity may safely remove its own components) and probes the other pools by entity index.
+template <typename... Ts>
+class ComponentView {
+public:
+    explicit ComponentView(ComponentArray<Ts>*... arrays) : pools(arrays...) {
+        const IComponentArray* candidates[] = { arrays... };
+        for (const IComponentArray* pool : candidates) {
+            if (!pool) { driver = nullptr; return; }
+            if (!driver || pool->Size() < driver->Size()) driver = pool;
+        }
+    }
+
+    class Iterator {
+    public:
+        Iterator(const ComponentView* viewArg, size_t indexArg) : view(viewArg), index(indexArg) { SkipMisses(); }
+
+        Entity operator*() const { return view->driver->EntityAt(index - 1); }
+        Iterator& operator++() { --index; SkipMisses(); return *this; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+    private:
+        void SkipMisses() {
+            if (!view->driver) return;
+            if (index > view->driver->Size()) index = view->driver->Size(); // Entries were removed mid-iteration
+            while (index > 0 && !view->Contains(view->driver->EntityAt(index - 1))) --index;
+        }
+
+        const ComponentView* view;
+        size_t index;
+    };
+
+    Iterator begin() const { return Iterator(this, driver ? driver->Size() : 0); }
+    Iterator end() const { return Iterator(this, 0); }
+
+    bool Contains(Entity entity) const {
+        return (std::get<ComponentArray<Ts>*>(pools)->HasData(entity) && ...);
+    }
+
+    template <typename T>
+    T& Get(Entity entity) const {
+        return *std::get<ComponentArray<T>*>(pools)->TryGetData(entity);
+    }
+
+    // Calls fn(entity, components...) for every entity owning all Ts
+    template <typename Fn>
+    void Each(Fn&& fn) const {
+        if (!driver) return;
+        for (size_t i = driver->Size(); i-- > 0;) {
+            if (i >= driver->Size()) continue; // The callback removed entries further down the pool
+            const Entity entity = driver->EntityAt(i);
+            std::tuple<Ts*...> components(std::get<ComponentArray<Ts>*>(pools)->TryGetData(entity)...);
+            if (((std::get<Ts*>(components) != nullptr) && ...)) {
+                fn(entity, *std::get<Ts*>(components)...);
+            }
+        }
+    }
+
+private:
+    std::tuple<ComponentArray<Ts>*...> pools;
+    const IComponentArray* driver = nullptr;
 };
 
 class Registry {
 private:
     Entity nextEntityId = 0;
+    uint32_t changeTick = 1;
     std::queue<Entity> availableEntities;
-    std::unordered_map<std::type_index, std::shared_ptr<IComponentArray>> componentArrays;
+    std::vector<std::unique_ptr<IComponentArray>> componentArrays; // Indexed by ComponentFamily::Id<T>()
 
     template<typename T>
-    std::shared_ptr<ComponentArray<T>> GetComponentArray() {
-        auto type = std::type_index(typeid(T));
-        if (componentArrays.find(type) == componentArrays.end()) {
-            componentArrays[type] = std::make_shared<ComponentArray<T>>();
+    ComponentArray<T>* GetComponentArray() {
+        const size_t id = ComponentFamily::Id<T>();
+        if (id >= componentArrays.size()) {
+            componentArrays.resize(id + 1);
         }
-        return std::static_pointer_cast<ComponentArray<T>>(componentArrays[type]);
+        auto& pool = componentArrays[id];
+        if (!pool) {
+            pool = std::make_unique<ComponentArray<T>>();
+        }
+        return static_cast<ComponentArray<T>*>(pool.get());
     }
 
     // --- ADD CONST VERSION (No lazy creation) ---
     template<typename T>
-    std::shared_ptr<const ComponentArray<T>> GetComponentArray() const {
-        auto type = std::type_index(typeid(T));
-        auto it = componentArrays.find(type);
-        if (it == componentArrays.end()) return nullptr;
-        return std::static_pointer_cast<const ComponentArray<T>>(it->second);
+    const ComponentArray<T>* GetComponentArray() const {
+        const size_t id = ComponentFamily::Id<T>();
+        if (id >= componentArrays.size()) return nullptr;
+        return static_cast<const ComponentArray<T>*>(componentArrays[id].get());
     }
 
 public:
+    // Creates the pool for T if it does not exist yet
+    template <typename T>
+    void RegisterComponent() {
+        GetComponentArray<T>();
+    }
+
     Entity CreateEntity() {
         if (!availableEntities.empty()) {
             Entity id = availableEntities.front();
@@ -129,15 +524,15 @@ public:
     }
 
     void DestroyEntity(Entity entity) {
-        for (auto const& pair : componentArrays) {
-            pair.second->EntityDestroyed(entity);
+        for (auto const& pool : componentArrays) {
+            if (pool) pool->EntityDestroyed(entity);
         }
         availableEntities.push(entity);
     }
 
     template <typename T>
     void AddComponent(Entity entity, T component) {
-        GetComponentArray<T>()->InsertData(entity, component);
+        GetComponentArray<T>()->InsertData(entity, component, changeTick);
     }
 
     template <typename T>
@@ -170,7 +565,96 @@ public:
         return array && array->HasData(entity);
     }
 
+    // Returns nullptr instead of throwing when the component is missing
+    template <typename T>
+    T* TryGetComponent(Entity entity) {
+        return GetComponentArray<T>()->TryGetData(entity);
+    }
+
+    template <typename T>
+    const T* TryGetComponent(Entity entity) const {
+        auto array = GetComponentArray<T>();
+        return array ? array->TryGetData(entity) : nullptr;
+    }
+
+    // Join over every entity that owns all of Ts. See ComponentView.
+    template <typename... Ts>
+    ComponentView<Ts...> View() {
+        return ComponentView<Ts...>(GetComponentArray<Ts>()...);
+    }
+
+    template <typename... Ts, typename Fn>
+    void Each(Fn&& fn) {
+        View<Ts...>().Each(std::forward<Fn>(fn));
+    }
+
+    // --- Change tracking ---
+    // Writers call MarkChanged after modifying a component in place; AddComponent marks automatically.
+    // Consumers remember GetChangeTick() when they process, then ask for everything changed since.
+    uint32_t GetChangeTick() const { return changeTick; }
+    uint32_t AdvanceChangeTick() { return ++changeTick; }
+
+    template <typename T>
+    void MarkChanged(Entity entity) {
+        GetComponentArray<T>()->MarkChanged(entity, changeTick);
+    }
+
+    template <typename T>
+    bool ChangedSince(Entity entity, uint32_t sinceTick) const {
+        auto array = GetComponentArray<T>();
+        return array && array->ChangedSince(entity, sinceTick);
+    }
+
+    template <typename T, typename Fn>
+    void ForEachChangedSince(uint32_t sinceTick, Fn&& fn) const {
+        auto array = GetComponentArray<T>();
+        if (array) array->ForEachChangedSince(sinceTick, std::forward<Fn>(fn));
+    }
+
+    template <typename T>
+    uint64_t GetStructureVersion() const {
+        auto array = GetComponentArray<T>();
+        return array ? array->GetStructureVersion() : 0;
+    }
+
     Entity GetEntityCount() const {
         return nextEntityId;
     }
+
+    // --- Snapshots ---
+    // Captures every pool plus the entity allocator. Restoring brings back exactly that state:
+    // pools created after the snapshot are emptied and entity IDs are handed out in the same order.
+    RegistrySnapshot SaveSnapshot() const {
+        RegistrySnapshot snapshot;
+        snapshot.nextEntityId = nextEntityId;
+
+        std::queue<Entity> available = availableEntities;
+        snapshot.availableEntities.reserve(available.size());
+        while (!available.empty()) {
+            snapshot.availableEntities.push_back(available.front());
+            available.pop();
+        }
+
+        for (size_t family = 0; family < componentArrays.size(); ++family) {
+            if (componentArrays[family]) componentArrays[family]->SaveSnapshot(snapshot, family);
+        }
+        return snapshot;
+    }
+
+    void RestoreSnapshot(const RegistrySnapshot& snapshot) {
+        std::vector<const RegistrySnapshot::Pool*> byFamily(componentArrays.size(), nullptr);
+        for (const auto& pool : snapshot.pools) {
+            if (pool.family >= componentArrays.size() || !componentArrays[pool.family]) {
+                throw std::runtime_error("Snapshot contains a component pool this registry does not have.");
+            }
+            byFamily[pool.family] = &pool;
+        }
+
+        for (size_t family = 0; family < componentArrays.size(); ++family) {
+            if (componentArrays[family]) componentArrays[family]->RestoreSnapshot(snapshot, byFamily[family], changeTick);
+        }
+
+        nextEntityId = snapshot.nextEntityId;
+        availableEntities = std::queue<Entity>(std::deque<Entity>(snapshot.availableEntities.begin(), snapshot.availableEntities.end()));
+    }
 };
\ No newline at end of file
@@ -2,7 +2,14 @@
 #include "imgui.h"
 #include "../rendering/ParticleLibrary.h"
 #include "../systems/PhysicsSystem.h"
+#include "../systems/FluidSystem.h"
+#include "../systems/ClothSystem.h"
+#include "../systems/ThermodynamicsSystem.h"
+#include "../../SimulationStaticLib/Heightfield.h"
+#include "../../SimulationStaticLib/TriangleBVH.h"
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <iostream>
 
@@ -384,6 +391,7 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                             // 4. Material
                             if (registry.HasComponent<RenderComponent>(e)) {
                                 auto& render = registry.GetComponent<RenderComponent>(e);
+                                registry.MarkChanged<RenderComponent>(e); // Edited live through ImGui while the menu is open
                                 ImGui::Separator();
                                 ImGui::TextDisabled("Material");
 
@@ -734,7 +742,8 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
 
                     auto& light = registry.GetComponent<LightComponent>(e);
                     std::string lightName = registry.HasComponent<NameComponent>(e) ?
-                        registry.GetComponent<NameComponent>(e).name : "Unnamed Light";
+                        registry.GetComponent<NameComponent>(e).name :
+                        (registry.HasComponent<FireLightTag>(e) ? "Fire Light " + std::to_string(e) : "Unnamed Light");
 
                     // --- NEW: Inactive Logic ---
                     bool isInactive = (light.intensity <= 0.001f);
@@ -832,6 +841,19 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                     m_RestartRequested = true;
                 }
 
+                // Snapshots capture the whole simulation state, so physics can be rewound or re-run with other settings
+                if (ImGui::Selectable("Save Snapshot", false, ImGuiSelectableFlags_DontClosePopups)) {
+                    m_SnapshotSaveRequested = true;
+                }
+                if (scene.HasSnapshot()) {
+                    if (ImGui::Selectable("Restore Snapshot", false, ImGuiSelectableFlags_DontClosePopups)) {
+                        m_SnapshotRestoreRequested = true;
+                    }
+                }
+                else {
+                    ImGui::TextDisabled("Restore Snapshot (Save first)");
+                }
+
                 ImGui::Separator();
 
                 ImGui::Text("Simulation Speed (CTRL + CLICK to Type)");
@@ -840,8 +862,47 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                 if (ImGui::CollapsingHeader("Physics Engine", ImGuiTreeNodeFlags_DefaultOpen)) {
 
                     ImGui::Text("Time Step & Substepping");
-                    // Slider to control how many times the physics loop runs per frame
-                    ImGui::SliderInt("Substeps per Frame", &PhysicsSystem::subSteps, 1, 16);
+                    // Threaded: physics steps at its own fixed rate and the scene picks up the latest results
+                    ImGui::Checkbox("Run on Physics Thread", &PhysicsSystem::runOnThread);
+                    if (!PhysicsSystem::runOnThread) {
+                        // Fixed rate: frame time is spent in whole steps and the rendered poses are interpolated
+                        ImGui::Checkbox("Fixed Timestep", &PhysicsSystem::useFixedTimestep);
+                    }
+
+                    if (PhysicsSystem::runOnThread) {
+                        ImGui::SliderFloat("Physics Rate (Hz)", &PhysicsSystem::fixedRate, 30.0f, 480.0f, "%.0f");
+                        ImGui::SliderInt("Max Steps per Batch", &PhysicsSystem::maxStepsPerFrame, 1, 32);
+                        ImGui::Text("Steps: %d  Step Time: %.2f ms", PhysicsSystem::lastStats.stepsThisFrame, PhysicsSystem::lastStats.stepTimeMs);
+                    }
+                    else {
+                        if (PhysicsSystem::useFixedTimestep) {
+                            ImGui::SliderFloat("Physics Rate (Hz)", &PhysicsSystem::fixedRate, 30.0f, 480.0f, "%.0f");
+                            ImGui::SliderInt("Max Steps per Frame", &PhysicsSystem::maxStepsPerFrame, 1, 32);
+                            ImGui::Text("Steps: %d  Alpha: %.2f", PhysicsSystem::lastStats.stepsThisFrame, PhysicsSystem::lastStats.interpolationAlpha);
+                        }
+
+                        // Adaptive: the frame, or each fixed step, takes as many substeps as the fastest awake body needs
+                        ImGui::Checkbox("Adaptive Substeps", &PhysicsSystem::adaptiveSubsteps);
+                        if (PhysicsSystem::adaptiveSubsteps) {
+                            SubstepSettings& settings = PhysicsSystem::substepSettings;
+                            ImGui::SliderInt("Min Substeps", &settings.minSteps, 1, 16);
+                            ImGui::SliderInt("Max Substeps", &settings.maxSteps, 1, 64);
+                            ImGui::SliderFloat("Max Motion (x Radius)", &settings.maxMotion, 0.05f, 2.0f, "%.2f");
+                            ImGui::Text("Substeps: %d  Peak Motion: %.2f x Radius", PhysicsSystem::lastStats.stepsThisFrame, PhysicsSystem::lastStats.maxMotionRatio);
+                        }
+                        else if (!PhysicsSystem::useFixedTimestep) {
+                            // Slider to control how many times the physics loop runs per frame
+                            ImGui::SliderInt("Substeps per Frame", &PhysicsSystem::subSteps, 1, 16);
+                        }
+                    }
+
+                    if (!PhysicsSystem::runOnThread) {
+                        // Steps taken over the last couple of seconds of frames
+                        const SampleHistory& history = PhysicsSystem::stepHistory;
+                        char overlay[48];
+                        snprintf(overlay, sizeof(overlay), "avg %.1f  max %.0f", history.Average(), history.Max());
+                        ImGui::PlotLines("Step History", history.Data(), history.Count(), history.Offset(), overlay, 0.0f, std::max(history.Max(), 1.0f) * 1.2f, ImVec2(0, 50));
+                    }
 
                     ImGui::Spacing();
                     ImGui::Text("Integration Method");
@@ -856,6 +917,168 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                     ImGui::Spacing();
                     // Checkbox to disable gravity to prove the zero-acceleration lab requirement
                     ImGui::Checkbox("Apply Gravity", &PhysicsSystem::applyGravity);
+
+                    // Every dynamic body pulls every other (Barnes-Hut); replaces the uniform field and sleeping
+                    ImGui::Checkbox("Mutual Gravity", &PhysicsSystem::mutualGravity);
+                    if (PhysicsSystem::mutualGravity) {
+                        GravitySettings& gravity = PhysicsSystem::gravitySettings;
+                        ImGui::DragFloat("G", &gravity.G, 0.01f, 0.0f, 100.0f, "%.3f");
+                        ImGui::SliderFloat("Opening Angle", &gravity.theta, 0.0f, 1.5f, "%.2f");
+                        ImGui::SliderFloat("Softening", &gravity.softening, 0.0f, 2.0f, "%.3f");
+                        ImGui::SliderInt("Cluster Bodies", &m_ClusterBodies, 100, 10000, "%d", ImGuiSliderFlags_Logarithmic);
+                        if (ImGui::Button("Spawn Gravity Cluster")) {
+                            scene.SpawnGravityCluster(glm::vec3(0.0f, 40.0f, 0.0f), m_ClusterBodies, 30.0f, 5000.0f);
+                        }
+                        ImGui::Text("Octree Cells: %zu  Interactions: %.2f M", PhysicsSystem::lastStats.gravityNodes,
+                            static_cast<double>(PhysicsSystem::lastStats.gravityInteractions) / 1e6);
+                    }
+
+                    // Toggle between the SIMD structure-of-arrays integrator and the per-component loop
+                    ImGui::Checkbox("SoA Integrator", &PhysicsSystem::useSoA);
+
+                    // Colour contacts into batches with no shared body and solve each batch across the workers
+                    ImGui::Checkbox("Parallel Contact Solver", &PhysicsSystem::parallelContacts);
+                    if (PhysicsSystem::parallelContacts) {
+                        ImGui::Text("Contacts: %zu  Batches: %zu", PhysicsSystem::lastStats.contacts, PhysicsSystem::lastStats.contactBatches);
+                    }
+
+                    // Iterate clamped impulses per contact, starting from what each body pair needed last substep
+                    ImGui::Checkbox("Sequential Impulse Solver", &PhysicsSystem::useSequentialImpulse);
+                    if (PhysicsSystem::useSequentialImpulse) {
+                        ImGui::SliderInt("Solver Iterations", &PhysicsSystem::solverSettings.iterations, 1, 32);
+                        ImGui::Checkbox("Warm Starting", &PhysicsSystem::solverSettings.warmStarting);
+                        ImGui::DragFloat("Bounce Threshold", &PhysicsSystem::solverSettings.restitutionThreshold, 0.05f, 0.0f, 10.0f);
+                        ImGui::Text("Cached Contacts: %zu", PhysicsSystem::lastStats.cachedContacts);
+                    }
+
+                    // Bodies moving more than this share of their radius per step are swept to their first impact
+                    ImGui::Checkbox("Continuous Collision", &PhysicsSystem::continuousCollision);
+                    if (PhysicsSystem::continuousCollision) {
+                        ImGui::SliderFloat("Sweep Above (x Radius)", &PhysicsSystem::ccdMotionFraction, 0.05f, 2.0f, "%.2f");
+                        ImGui::Text("Swept: %zu  Impacts: %zu", PhysicsSystem::lastStats.sweptBodies, PhysicsSystem::lastStats.sweptHits);
+                    }
+
+                    // Touching pairs published to the scene each frame; hard hits heat flammable bodies
+                    ImGui::Checkbox("Contact Events", &PhysicsSystem::recordContactEvents);
+                    if (PhysicsSystem::recordContactEvents) {
+                        ImGui::DragFloat("Impact Heat", &ThermodynamicsSystem::impactHeat, 0.1f, 0.0f, 100.0f);
+                        ImGui::DragFloat("Min Impact Impulse", &ThermodynamicsSystem::minImpactImpulse, 0.1f, 0.0f, 100.0f);
+
+                        const auto& events = scene.GetContactEvents();
+                        size_t phaseCounts[3] = {};
+                        const ContactEvent* hardest = nullptr;
+                        for (const ContactEvent& contact : events) {
+                            ++phaseCounts[static_cast<size_t>(contact.phase)];
+                            if (contact.phase == ContactPhase::Begin && (!hardest || contact.impulse > hardest->impulse)) hardest = &contact;
+                        }
+                        ImGui::Text("Begin: %zu  Persist: %zu  End: %zu", phaseCounts[0], phaseCounts[1], phaseCounts[2]);
+                        if (hardest) {
+                            auto nameOf = [&](Entity e) {
+                                const auto* name = scene.GetRegistry().TryGetComponent<NameComponent>(e);
+                                return (name && !name->name.empty()) ? name->name : "Entity " + std::to_string(e);
+                            };
+                            ImGui::Text("Hardest Hit: %s / %s (%.2f)", nameOf(hardest->a).c_str(), nameOf(hardest->b).c_str(), hardest->impulse);
+                        }
+                    }
+
+                    ImGui::Spacing();
+                    ImGui::Text("Sleeping");
+                    // Bodies that stay under both thresholds for the frame count are frozen in contact islands
+                    ImGui::Checkbox("Allow Sleeping", &PhysicsSystem::allowSleeping);
+                    ImGui::DragFloat("Sleep Velocity", &PhysicsSystem::sleepSettings.linearVelocity, 0.01f, 0.0f, 5.0f);
+                    ImGui::DragFloat("Sleep Energy", &PhysicsSystem::sleepSettings.kineticEnergy, 0.01f, 0.0f, 10.0f);
+                    ImGui::SliderInt("Frames to Sleep", &PhysicsSystem::sleepSettings.framesToSleep, 1, 240);
+
+                    const PhysicsStats& stats = PhysicsSystem::lastStats;
+                    ImGui::Text("Awake: %zu  Sleeping: %zu", stats.awakeBodies, stats.sleepingBodies);
+                }
+
+                if (ImGui::CollapsingHeader("Fluid (SPH)")) {
+                    SphFluid& fluid = scene.GetFluid();
+                    ImGui::Checkbox("Simulate Fluid", &FluidSystem::enabled);
+
+                    // Blocks are cubes of the requested particle count, dropped above the middle of the scene
+                    ImGui::SliderInt("Block Particles", &m_FluidBlockParticles, 1000, static_cast<int>(Scene::MAX_FLUID_PARTICLES), "%d", ImGuiSliderFlags_Logarithmic);
+                    if (ImGui::Button("Spawn Fluid Block")) {
+                        const float side = std::cbrt(static_cast<float>(m_FluidBlockParticles)) * FluidSystem::settings.particleSpacing;
+                        const glm::vec3 halfExtents(side * 0.5f);
+                        const TerrainConfig& terrain = scene.GetTerrainConfig();
+                        const float groundY = terrain.exists ? terrain.HeightAt(0.0f, 0.0f) : 0.0f;
+                        scene.SpawnFluidBlock(glm::vec3(0.0f, groundY + halfExtents.y + 2.0f, 0.0f), halfExtents);
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Clear Fluid")) {
+                        scene.ClearFluid();
+                    }
+
+                    SphSettings& settings = FluidSystem::settings;
+                    ImGui::SliderFloat("Sound Speed", &settings.soundSpeed, 5.0f, 100.0f, "%.0f m/s");
+                    ImGui::SliderFloat("Viscosity", &settings.viscosity, 0.0f, 1.0f, "%.3f", ImGuiSliderFlags_Logarithmic);
+                    ImGui::SliderFloat("Wall Restitution", &settings.restitution, 0.0f, 1.0f);
+                    ImGui::SliderFloat("Wall Friction", &settings.friction, 0.0f, 1.0f);
+                    ImGui::SliderInt("Max Fluid Substeps", &FluidSystem::maxSubsteps, 1, 32);
+                    // Spacing sets the particle mass, so it only applies to blocks spawned after the change
+                    ImGui::SliderFloat("Particle Spacing", &settings.particleSpacing, 0.05f, 0.5f, "%.2f m");
+                    if (!fluid.Empty() && std::abs(settings.particleSpacing - fluid.Settings().particleSpacing) > 1e-6f) {
+                        ImGui::TextDisabled("Spacing of the current fluid: %.2f m", fluid.Settings().particleSpacing);
+                    }
+
+                    const FluidStats& stats = FluidSystem::lastStats;
+                    ImGui::Text("Particles: %zu / %u  Colliders: %zu", stats.particles, Scene::MAX_FLUID_PARTICLES, stats.colliders);
+                    ImGui::Text("Substeps: %d  Step Time: %.2f ms", stats.substeps, stats.stepTimeMs);
+                    ImGui::Text("Neighbours: %.1f each, %.1f M/s", stats.neighboursPerParticle, stats.neighboursPerSecond / 1e6);
+                }
+
+                if (ImGui::CollapsingHeader("Cloth & Soft Bodies")) {
+                    ImGui::Checkbox("Simulate Deformables", &ClothSystem::enabled);
+
+                    // Both drop in above the middle of the scene, the banner pinned along its top edge
+                    const TerrainConfig& terrain = scene.GetTerrainConfig();
+                    const float groundY = terrain.exists ? terrain.HeightAt(0.0f, 0.0f) : 0.0f;
+                    ImGui::SliderInt("Cloth Resolution", &m_ClothResolution, 8, 256);
+                    if (ImGui::Button("Spawn Banner")) {
+                        scene.AddCloth("Banner_" + std::to_string(m_DeformableCount++), glm::vec3(0.0f, groundY + 8.0f, 0.0f),
+                            4.0f, 6.0f, m_ClothResolution, m_ClothResolution);
+                    }
+                    ImGui::SameLine();
+                    if (ImGui::Button("Spawn Soft Ball")) {
+                        scene.AddSoftBall("SoftBall_" + std::to_string(m_DeformableCount++), glm::vec3(0.0f, groundY + 5.0f, 2.0f), 1.0f);
+                    }
+
+                    Registry& registry = scene.GetRegistry();
+                    auto softBodies = registry.View<SoftBodyComponent>();
+                    if (ImGui::Button("Release Pins")) {
+                        for (Entity e : softBodies) {
+                            if (const auto& body = softBodies.Get<SoftBodyComponent>(e).body) body->ReleaseAll();
+                        }
+                    }
+                    if (ImGui::SliderFloat("Soft Ball Pressure", &m_SoftBallPressure, 0.5f, 2.0f)) {
+                        for (Entity e : softBodies) {
+                            const auto& body = softBodies.Get<SoftBodyComponent>(e).body;
+                            if (!body || !body->PreservesVolume()) continue;
+                            XpbdSettings settings = body->Settings();
+                            settings.pressure = m_SoftBallPressure;
+                            body->Configure(settings);
+                        }
+                    }
+
+                    const ClothStats& stats = ClothSystem::lastStats;
+                    ImGui::Text("Bodies: %zu  Particles: %zu  Colliders: %zu", stats.bodies, stats.particles, stats.colliders);
+                    ImGui::Text("Constraints: %zu in %zu batches", stats.constraints, stats.batches);
+                    ImGui::Text("Step Time: %.2f ms", stats.stepTimeMs);
+                }
+
+                if (ImGui::CollapsingHeader("System Timings")) {
+                    const SystemScheduler& scheduler = scene.GetScheduler();
+                    ImGui::Checkbox("Run Systems in Parallel", &SystemScheduler::runParallel);
+                    ImGui::Text("Update: %.3f ms  (critical path %.3f ms)", scheduler.GetFrameTimeMs(), scheduler.GetCriticalPathMs());
+                    ImGui::Separator();
+
+                    // Systems on the critical path are highlighted; "T" is the thread that ran it (0 = main)
+                    for (const auto& timing : scheduler.GetTimings()) {
+                        const ImVec4 colour = timing.onCriticalPath ? ImVec4(1.0f, 0.75f, 0.3f, 1.0f) : ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
+                        ImGui::TextColored(colour, "%-16s %7.3f ms  @%6.3f  T%u", timing.name, timing.durationMs, timing.startMs, timing.thread);
+                    }
                 }
 
                 ImGui::EndMenu();
@@ -1043,7 +1266,14 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                     }
 
                     ImGui::PushID(e);
-                    if (ImGui::CollapsingHeader(entityName.c_str())) {
+                    const bool revealSelection = m_RevealSelection && e == m_SelectedEntity;
+                    if (revealSelection) ImGui::SetNextItemOpen(true);
+                    const bool headerOpen = ImGui::CollapsingHeader(entityName.c_str());
+                    if (revealSelection) {
+                        ImGui::SetScrollHereY(0.0f);
+                        m_RevealSelection = false;
+                    }
+                    if (headerOpen) {
                         ImGui::Indent();
 
                         ImGui::Spacing();
@@ -1104,6 +1334,7 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                                 // Rebuild the matrix if anything moved
                                 if (modified) {
                                     comp.UpdateMatrix();
+                                    registry.MarkChanged<TransformComponent>(e);
                                 }
 
                                 ImGui::TreePop();
@@ -1118,6 +1349,7 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
 
                             if (open && registry.HasComponent<RenderComponent>(e)) {
                                 auto& comp = registry.GetComponent<RenderComponent>(e);
+                                registry.MarkChanged<RenderComponent>(e); // Edited live through ImGui while the panel is open
                                 ImGui::Checkbox("Visible", &comp.visible);
                                 ImGui::Checkbox("Casts Shadow", &comp.castsShadow);
                                 ImGui::Checkbox("Receives Shadows", &comp.receiveShadows);
@@ -1418,13 +1650,13 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
 
                             if (open && registry.HasComponent<ColliderComponent>(e)) {
                                 auto& comp = registry.GetComponent<ColliderComponent>(e);
-                                ImGui::Checkbox("Has Collision", &comp.hasCollision);
+                                bool changed = ImGui::Checkbox("Has Collision", &comp.hasCollision);
 
-                                const char* shapeTypes[] = { "Sphere", "Plane" };
-                                ImGui::Combo("Shape Type", &comp.type, shapeTypes, IM_ARRAYSIZE(shapeTypes));
+                                const char* shapeTypes[] = { "Sphere", "Plane", "Heightfield", "Mesh" };
+                                changed |= ImGui::Combo("Shape Type", &comp.type, shapeTypes, IM_ARRAYSIZE(shapeTypes));
 
                                 if (comp.type == 0) { // Sphere
-                                    ImGui::DragFloat("Radius", &comp.radius, 0.1f, 0.0f, 100.0f);
+                                    changed |= ImGui::DragFloat("Radius", &comp.radius, 0.1f, 0.0f, 100.0f);
                                 }
                                 else if (comp.type == 1) { // Plane
                                     if (ImGui::DragFloat3("Normal", &comp.normal.x, 0.05f)) {
@@ -1432,10 +1664,38 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                                         if (glm::length(comp.normal) > 0.001f) {
                                             comp.normal = glm::normalize(comp.normal);
                                         }
+                                        changed = true;
+                                    }
+                                }
+                                else if (comp.type == 2) { // Heightfield
+                                    if (comp.heightfield && !comp.heightfield->Empty()) {
+                                        ImGui::Text("Raster: %d x %d cells, %.2f m each", comp.heightfield->Resolution(),
+                                            comp.heightfield->Resolution(), comp.heightfield->CellSize());
+                                    }
+                                    else {
+                                        ImGui::TextDisabled("(none baked)");
+                                    }
+                                    changed |= ImGui::DragFloat("Footprint Radius", &comp.radius, 0.5f, 0.0f, 1000.0f);
+                                }
+                                else if (comp.type == 3) { // Mesh
+                                    if (comp.mesh && !comp.mesh->Empty()) {
+                                        ImGui::Text("BVH: %zu triangles, %zu nodes, depth %d", comp.mesh->TriangleCount(),
+                                            comp.mesh->NodeCount(), comp.mesh->Depth());
+                                    }
+                                    else {
+                                        ImGui::TextDisabled("(no mesh)");
+                                    }
+                                    if (registry.HasComponent<RenderComponent>(e) && ImGui::Button("Use Render Mesh")) {
+                                        const auto& render = registry.GetComponent<RenderComponent>(e);
+                                        comp.mesh = render.geometry ? render.geometry->GetBVH() : nullptr;
+                                        changed = true;
                                     }
                                 }
 
-                                ImGui::DragFloat("Height", &comp.height, 0.1f, 0.0f, 100.0f);
+                                changed |= ImGui::DragFloat("Height", &comp.height, 0.1f, 0.0f, 100.0f);
+
+                                // The physics thread only hears of edits marked as changes
+                                if (changed) registry.MarkChanged<ColliderComponent>(e);
                                 ImGui::TreePop();
                             }
                         }
@@ -1449,16 +1709,42 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                             if (open && registry.HasComponent<PhysicsComponent>(e)) {
                                 auto& comp = registry.GetComponent<PhysicsComponent>(e);
 
-                                ImGui::Checkbox("Is Static", &comp.isStatic);
-                                ImGui::DragFloat("Mass", &comp.mass, 0.1f, 0.1f, 1000.0f);
-                                ImGui::DragFloat("Restitution (Bounciness)", &comp.restitution, 0.05f, 0.0f, 2.0f);
-                                ImGui::DragFloat("Friction", &comp.friction, 0.01f, 0.0f, 1.0f);
-                                ImGui::DragFloat3("Velocity", &comp.velocity.x, 0.1f);
+                                bool changed = ImGui::Checkbox("Is Static", &comp.isStatic);
+                                if (comp.isSleeping) ImGui::TextDisabled("Sleeping (island %u)", comp.islandId);
+                                changed |= ImGui::DragFloat("Mass", &comp.mass, 0.1f, 0.1f, 1000.0f);
+                                changed |= ImGui::DragFloat("Restitution (Bounciness)", &comp.restitution, 0.05f, 0.0f, 2.0f);
+                                changed |= ImGui::DragFloat("Friction", &comp.friction, 0.01f, 0.0f, 1.0f);
+                                changed |= ImGui::DragFloat3("Velocity", &comp.velocity.x, 0.1f);
+
+                                // Without the mark the physics thread keeps its own copy, and its next result overwrites the edit
+                                if (changed) registry.MarkChanged<PhysicsComponent>(e);
 
                                 ImGui::TreePop();
                             }
                         }
 
+                        // --- 10. Hierarchy Component ---
+                        if (registry.HasComponent<HierarchyComponent>(e)) {
+                            bool open = ImGui::TreeNodeEx("HierarchyComponent", ImGuiTreeNodeFlags_DefaultOpen);
+                            ImGui::SameLine(ImGui::GetWindowWidth() - 90.0f);
+                            if (ImGui::Button("Remove##Hierarchy")) scene.SetParent(e, MAX_ENTITIES);
+
+                            if (open && registry.HasComponent<HierarchyComponent>(e)) {
+                                const Entity parent = registry.GetComponent<HierarchyComponent>(e).parent;
+                                int parentId = (parent == MAX_ENTITIES) ? -1 : static_cast<int>(parent);
+
+                                // SetParent rejects missing entities and cycles, so the field just snaps back
+                                if (ImGui::InputInt("Parent Entity", &parentId)) {
+                                    scene.SetParent(e, (parentId < 0) ? MAX_ENTITIES : static_cast<Entity>(parentId));
+                                }
+                                if (parent != MAX_ENTITIES && registry.HasComponent<NameComponent>(parent)) {
+                                    ImGui::TextDisabled("Parent: %s", registry.GetComponent<NameComponent>(parent).name.c_str());
+                                }
+                                ImGui::TextDisabled("Transform values are relative to the parent");
+                                ImGui::TreePop();
+                            }
+                        }
+
                         ImGui::Spacing();
 
                         // 2. Dropdown to Add New Components
@@ -1475,6 +1761,7 @@ std::string EditorUI::Draw(float deltaTime, float currentTemp, const std::string
                             addMenuItem((AttachedEmitterComponent*)nullptr, "AttachedEmitterComponent", e);
                             addMenuItem((EnvironmentComponent*)nullptr, "EnvironmentComponent", e);
                             addMenuItem((DustCloudComponent*)nullptr, "DustCloudComponent", e);
+                            addMenuItem((HierarchyComponent*)nullptr, "HierarchyComponent", e);
 
                             ImGui::EndMenu();
                         }
@@ -21,6 +21,13 @@ public:
 
     const float* GetClearColor() const { return m_ClearColor; }
 
+    // Opens the entity's properties and scrolls them into view, e.g. after clicking it in the viewport
+    void SelectEntity(Entity e) {
+        m_SelectedEntity = e;
+        m_RevealSelection = true;
+        m_ShowEntityPropertiesWindow = true;
+    }
+
     Entity ConsumeViewRequest() {
         Entity req = m_ViewRequested;
         m_ViewRequested = MAX_ENTITIES;
@@ -68,12 +75,16 @@ public:
 
     bool ConsumeStepRequest() { bool req = m_StepRequested; m_StepRequested = false; return req; }
     bool ConsumeRestartRequest() { bool req = m_RestartRequested; m_RestartRequested = false; return req; }
+    bool ConsumeSnapshotSaveRequest() { bool req = m_SnapshotSaveRequested; m_SnapshotSaveRequested = false; return req; }
+    bool ConsumeSnapshotRestoreRequest() { bool req = m_SnapshotRestoreRequested; m_SnapshotRestoreRequested = false; return req; }
 
     void SetAvailableCameras(const std::vector<std::string>& cameras);
     std::string ConsumeCameraSwitchRequest();
 
 private:
     Entity m_ViewRequested = MAX_ENTITIES;
+    Entity m_SelectedEntity = MAX_ENTITIES;
+    bool m_RevealSelection = false;
 
     std::vector<std::string> availableCameras;
     std::string requestedCamera = "";
@@ -103,4 +114,11 @@ private:
     float m_StepSize = 0.0166f; // Default to ~60fps (16.6ms)
     bool m_StepRequested = false;
     bool m_RestartRequested = false;
+    bool m_SnapshotSaveRequested = false;
+    bool m_SnapshotRestoreRequested = false;
+    int m_ClusterBodies = 2000;
+    int m_FluidBlockParticles = 20000;
+    int m_ClothResolution = 64;
+    float m_SoftBallPressure = 1.0f;
+    int m_DeformableCount = 0; // Numbers the names of spawned banners and soft balls
 };
\ No newline at end of file
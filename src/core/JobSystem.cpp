@@ -0,0 +1,100 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+    thread_local unsigned int t_ThreadIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    if (workerCount == 0) {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = (hardware > 1) ? hardware - 1 : 0;
+    }
+
+    m_Workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_WorkAvailable.notify_all();
+
+    for (auto& worker : m_Workers) {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::Get() {
+    static JobSystem instance;
+    return instance;
+}
+
+unsigned int JobSystem::CurrentThreadIndex() {
+    return t_ThreadIndex;
+}
+
+void JobSystem::Submit(JobGroup& group, std::function<void()> job) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    // No workers: run immediately so single-core machines still make progress
+    if (m_Workers.empty()) {
+        QueuedJob queued{ std::move(job), &group };
+        Run(queued);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push_back({ std::move(job), &group });
+    }
+    m_WorkAvailable.notify_one();
+}
+
+void JobSystem::Wait(JobGroup& group) {
+    while (!group.IsDone()) {
+        // Help with the group's queued work instead of blocking, then back off once all of it has started
+        if (!TryRunOne(group)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::TryRunOne(const JobGroup& group) {
+    QueuedJob queued;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = std::find_if(m_Queue.begin(), m_Queue.end(), [&](const QueuedJob& q) { return q.group == &group; });
+        if (it == m_Queue.end()) return false;
+        queued = std::move(*it);
+        m_Queue.erase(it);
+    }
+    Run(queued);
+    return true;
+}
+
+void JobSystem::Run(QueuedJob& queued) {
+    queued.job();
+    queued.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::WorkerLoop(unsigned int index) {
+    t_ThreadIndex = index;
+
+    while (true) {
+        QueuedJob queued;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WorkAvailable.wait(lock, [this]() { return m_Stopping || !m_Queue.empty(); });
+            if (m_Stopping && m_Queue.empty()) return;
+
+            queued = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        Run(queued);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tracks a batch of jobs so the submitter can wait for all of them
+class JobGroup {
+public:
+    bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{ 0 };
+};
+
+// Shared worker pool used by the system scheduler and the parallel simulation passes.
+// Wait() runs the group's own queued jobs on the calling thread, so jobs may themselves submit and wait
+// (e.g. a system running on a worker that splits its own loop with ParallelFor). It never picks up another
+// group's jobs: a thread outside the scheduler, such as the physics thread, would otherwise end up running
+// scene systems, including the one that owns it.
+class JobSystem {
+public:
+    explicit JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Process-wide pool, sized to the hardware on first use
+    static JobSystem& Get();
+
+    void Submit(JobGroup& group, std::function<void()> job);
+    void Wait(JobGroup& group);
+
+    // Splits [0, count) into chunks of at least minBatch items and calls fn(begin, end) for each.
+    // Runs inline when the range is too small to be worth distributing.
+    template <typename Fn>
+    void ParallelFor(size_t count, size_t minBatch, Fn&& fn) {
+        if (count == 0) return;
+        const size_t threads = GetThreadCount();
+        if (minBatch == 0) minBatch = 1;
+        if (threads <= 1 || count <= minBatch) {
+            fn(size_t(0), count);
+            return;
+        }
+
+        const size_t batches = std::min(threads * 4, (count + minBatch - 1) / minBatch);
+        const size_t batchSize = (count + batches - 1) / batches;
+
+        JobGroup group;
+        for (size_t begin = batchSize; begin < count; begin += batchSize) {
+            const size_t end = std::min(begin + batchSize, count);
+            Submit(group, [&fn, begin, end]() { fn(begin, end); });
+        }
+        fn(size_t(0), std::min(batchSize, count));
+        Wait(group);
+    }
+
+    // Worker threads plus the calling thread
+    size_t GetThreadCount() const { return m_Workers.size() + 1; }
+
+    // 0 for the main thread, 1..N for workers
+    static unsigned int CurrentThreadIndex();
+
+private:
+    struct QueuedJob {
+        std::function<void()> job;
+        JobGroup* group;
+    };
+
+    void WorkerLoop(unsigned int index);
+    bool TryRunOne(const JobGroup& group);
+    static void Run(QueuedJob& queued);
+
+    std::vector<std::thread> m_Workers;
+    std::deque<QueuedJob> m_Queue;
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkAvailable;
+    bool m_Stopping = false;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Dense 32-bit ID for an interned string
+using Symbol = uint32_t;
+const Symbol INVALID_SYMBOL = UINT32_MAX;
+
+// Interns strings into dense IDs, handed out in order from 0.
+// A string is hashed once when it is interned or looked up; after that, comparisons and
+// table lookups work on the integer alone. Entries are never removed, so IDs stay valid
+// for the lifetime of the table (including inside snapshots).
+class SymbolTable {
+public:
+    Symbol Intern(const std::string& text) {
+        const auto it = m_Ids.find(text);
+        if (it != m_Ids.end()) return it->second;
+
+        const Symbol id = static_cast<Symbol>(m_Names.size());
+        m_Names.push_back(text);
+        m_Ids.emplace(text, id);
+        return id;
+    }
+
+    // INVALID_SYMBOL if the string was never interned
+    Symbol Find(const std::string& text) const {
+        const auto it = m_Ids.find(text);
+        return (it != m_Ids.end()) ? it->second : INVALID_SYMBOL;
+    }
+
+    const std::string& Name(Symbol symbol) const {
+        static const std::string empty;
+        return (symbol < m_Names.size()) ? m_Names[symbol] : empty;
+    }
+
+    size_t Size() const { return m_Names.size(); }
+
+private:
+    std::unordered_map<std::string, Symbol> m_Ids;
+    std::vector<std::string> m_Names;
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "ECS.h"
+#include "JobSystem.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Attaches an entity to a parent. The child's Transform position/rotation/scale are then local to the
+// parent, and its matrix holds the world matrix written by TransformHierarchy::Propagate.
+struct HierarchyComponent {
+    Entity parent = MAX_ENTITIES;
+};
+
+// Flat, depth-sorted view of every parented entity, grouped into one contiguous run per root.
+// Within a run every parent precedes its children, so world matrices propagate in a single linear
+// pass, and runs share no data so they can be processed on different workers.
+class TransformHierarchy {
+public:
+    static constexpr uint32_t ROOT_PARENT = UINT32_MAX;
+
+    struct Node {
+        Entity entity = MAX_ENTITIES;
+        Entity parent = MAX_ENTITIES;
+        uint32_t parentIndex = ROOT_PARENT; // Index into the node array, ROOT_PARENT when the parent is the root
+        uint32_t depth = 0;                 // 1 for direct children of the root
+    };
+
+    struct Subtree {
+        Entity root = MAX_ENTITIES;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    inline static bool runParallel = true;
+
+    // Forces a rebuild on the next Propagate (after the registry was cleared or restored wholesale)
+    void Invalidate() { m_NeedsRebuild = true; }
+
+    // Recomputes world matrices for every parented entity whose own Transform or any ancestor's
+    // Transform changed since the previous call; untouched subtrees cost one tick compare per node.
+    // Recomputed children are marked changed, then the registry tick is advanced so that those marks
+    // are not mistaken for new edits next time, while edits made after this call still are.
+    template <typename TransformT>
+    void Propagate(Registry& registry) {
+        if (m_NeedsRebuild
+            || registry.GetStructureVersion<HierarchyComponent>() != m_StructureVersion
+            || AnyParentChanged(registry)) {
+            Rebuild(registry);
+        }
+
+        const uint32_t sinceTick = m_LastTick;
+        const bool recomputeAll = m_RecomputeAll;
+        m_RecomputeAll = false;
+        m_Recomputed.assign(m_Nodes.size(), 0);
+
+        auto propagateSubtrees = [&](size_t first, size_t last) {
+            for (size_t s = first; s < last; ++s) {
+                const Subtree& subtree = m_Subtrees[s];
+                for (size_t i = subtree.begin; i < subtree.end; ++i) {
+                    const Node& node = m_Nodes[i];
+                    const bool parentMoved = (node.parentIndex == ROOT_PARENT)
+                        ? registry.ChangedSince<TransformT>(node.parent, sinceTick)
+                        : m_Recomputed[node.parentIndex] != 0;
+
+                    if (!recomputeAll && !parentMoved && !registry.ChangedSince<TransformT>(node.entity, sinceTick)) continue;
+
+                    const TransformT* parent = registry.TryGetComponent<TransformT>(node.parent);
+                    TransformT* transform = registry.TryGetComponent<TransformT>(node.entity);
+                    if (!parent || !transform) continue;
+
+                    transform->matrix = parent->matrix * transform->LocalMatrix();
+                    m_Recomputed[i] = 1;
+                }
+            }
+        };
+
+        if (runParallel) {
+            JobSystem::Get().ParallelFor(m_Subtrees.size(), 4, propagateSubtrees);
+        }
+        else {
+            propagateSubtrees(0, m_Subtrees.size());
+        }
+
+        // Change logs are not thread safe, so marks are applied after the parallel pass
+        m_LastRecomputed = 0;
+        for (size_t i = 0; i < m_Nodes.size(); ++i) {
+            if (!m_Recomputed[i]) continue;
+            registry.MarkChanged<TransformT>(m_Nodes[i].entity);
+            ++m_LastRecomputed;
+        }
+
+        m_LastTick = registry.AdvanceChangeTick();
+    }
+
+    const std::vector<Node>& GetNodes() const { return m_Nodes; }
+    const std::vector<Subtree>& GetSubtrees() const { return m_Subtrees; }
+
+    // Nodes whose world matrix was rewritten by the last Propagate
+    size_t GetLastRecomputedCount() const { return m_LastRecomputed; }
+
+private:
+    bool AnyParentChanged(const Registry& registry) const {
+        bool changed = false;
+        registry.ForEachChangedSince<HierarchyComponent>(m_LastTick, [&](Entity) { changed = true; });
+        return changed;
+    }
+
+    void Rebuild(Registry& registry) {
+        m_Nodes.clear();
+        m_Subtrees.clear();
+
+        // 1. Resolve every parented entity to its root and depth. Chains that loop, or that lead to a
+        // destroyed entity, are left out rather than trusted.
+        struct Pending {
+            Node node;
+            Entity root;
+        };
+        std::vector<std::pair<Entity, Entity>> links;
+        registry.Each<HierarchyComponent>([&](Entity e, const HierarchyComponent& link) {
+            if (link.parent != MAX_ENTITIES && link.parent != e) links.emplace_back(e, link.parent);
+        });
+
+        std::vector<Pending> pending;
+        pending.reserve(links.size());
+        const size_t maxDepth = links.size();
+
+        for (const auto& [e, parent] : links) {
+            Entity root = parent;
+            uint32_t depth = 1;
+            bool valid = true;
+            while (const HierarchyComponent* link = registry.TryGetComponent<HierarchyComponent>(root)) {
+                if (link->parent == MAX_ENTITIES) break;
+                root = link->parent;
+                if (root == e || ++depth > maxDepth) {
+                    valid = false;
+                    break;
+                }
+            }
+            if (!valid) continue;
+
+            pending.push_back({ Node{ e, parent, ROOT_PARENT, depth }, root });
+        }
+
+        // 2. Group by root, parents before children
+        std::sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+            if (a.root != b.root) return a.root < b.root;
+            if (a.node.depth != b.node.depth) return a.node.depth < b.node.depth;
+            return a.node.entity < b.node.entity;
+        });
+
+        std::unordered_map<Entity, uint32_t> indexOf;
+        indexOf.reserve(pending.size());
+        m_Nodes.reserve(pending.size());
+
+        for (const Pending& p : pending) {
+            if (m_Subtrees.empty() || m_Subtrees.back().root != p.root) {
+                m_Subtrees.push_back({ p.root, m_Nodes.size(), m_Nodes.size() });
+            }
+
+            Node node = p.node;
+            if (node.depth > 1) {
+                const auto it = indexOf.find(node.parent);
+                node.parentIndex = (it != indexOf.end()) ? it->second : ROOT_PARENT;
+            }
+            indexOf.emplace(node.entity, static_cast<uint32_t>(m_Nodes.size()));
+            m_Nodes.push_back(node);
+            m_Subtrees.back().end = m_Nodes.size();
+        }
+
+        m_StructureVersion = registry.GetStructureVersion<HierarchyComponent>();
+        m_NeedsRebuild = false;
+
+        // Any node may have a new parent now, so every world matrix is recomputed once
+        m_RecomputeAll = true;
+    }
+
+    std::vector<Node> m_Nodes;
+    std::vector<Subtree> m_Subtrees;
+    std::vector<uint8_t> m_Recomputed;
+    uint64_t m_StructureVersion = 0;
+    uint32_t m_LastTick = 0;
+    size_t m_LastRecomputed = 0;
+    bool m_NeedsRebuild = true;
+    bool m_RecomputeAll = true;
+};
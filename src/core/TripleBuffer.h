@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer / single-consumer hand-off of the latest value.
+// The producer fills WriteBuffer() and calls Publish(); the consumer calls Consume() and reads
+// ReadBuffer(). Neither side ever waits: the producer always has a free slot to write into, and the
+// consumer always sees the newest complete value (intermediate ones are simply overwritten).
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& WriteBuffer() { return m_Buffers[m_Write]; }
+
+    void Publish() {
+        // Hand the written slot over and take back whichever slot was waiting in the middle
+        const uint8_t previous = m_Middle.exchange(static_cast<uint8_t>(m_Write | FRESH), std::memory_order_acq_rel);
+        m_Write = previous & INDEX_MASK;
+    }
+
+    // Consumer side. Returns false (and keeps the current ReadBuffer) when nothing new was published.
+    bool Consume() {
+        if ((m_Middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        const uint8_t previous = m_Middle.exchange(m_Read, std::memory_order_acq_rel);
+        m_Read = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& ReadBuffer() const { return m_Buffers[m_Read]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    T m_Buffers[3];
+    uint8_t m_Write = 0;                // Owned by the producer
+    uint8_t m_Read = 2;                 // Owned by the consumer
+    std::atomic<uint8_t> m_Middle{ 1 }; // Slot index, plus FRESH when it holds an unread value
+};
@@ -1,4 +1,5 @@
 #include "Geometry.h"
+#include "../../SimulationStaticLib/TriangleBVH.h"
 #include <stdexcept>
 
 Geometry::Geometry(VkDevice deviceArg, VkPhysicalDevice physicalDeviceArg)
@@ -37,8 +38,41 @@ void Geometry::CreateBuffers() {
     }
 }
 
+void Geometry::MakeDynamic(uint32_t framesInFlight) {
+    if (vertices.empty()) {
+        throw std::runtime_error("No vertices to create buffer from!");
+    }
+
+    const VkDeviceSize vertexBufferSize = sizeof(vertices[0]) * vertices.size();
+    for (auto& buffer : dynamicVertexBuffers) buffer->Cleanup();
+    dynamicVertexBuffers.resize(static_cast<size_t>(framesInFlight) + 1);
+    for (auto& buffer : dynamicVertexBuffers) {
+        buffer = std::make_unique<VulkanBuffer>(device, physicalDevice);
+        buffer->CreateBuffer(
+            vertexBufferSize,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        );
+    }
+    dynamicVertexCount = vertices.size();
+    activeVertexBuffer = 0;
+    dynamicVertexBuffers[0]->CopyData(vertices.data(), vertexBufferSize);
+}
+
+void Geometry::UploadVertices() {
+    if (!IsDynamic()) {
+        throw std::runtime_error("UploadVertices needs MakeDynamic first!");
+    }
+    if (vertices.size() != dynamicVertexCount) {
+        throw std::runtime_error("Dynamic geometry cannot change its vertex count!");
+    }
+
+    activeVertexBuffer = (activeVertexBuffer + 1) % dynamicVertexBuffers.size();
+    dynamicVertexBuffers[activeVertexBuffer]->CopyData(vertices.data(), sizeof(vertices[0]) * vertices.size());
+}
+
 void Geometry::Bind(VkCommandBuffer commandBuffer) const {
-    const VkBuffer vb = vertexBuffer->GetBuffer();
+    const VkBuffer vb = IsDynamic() ? dynamicVertexBuffers[activeVertexBuffer]->GetBuffer() : vertexBuffer->GetBuffer();
     const VkDeviceSize offset = 0;
     vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vb, &offset);
 
@@ -63,4 +97,20 @@ void Geometry::Cleanup() {
     if (indexBuffer) {
         indexBuffer->Cleanup();
     }
+    for (auto& buffer : dynamicVertexBuffers) {
+        buffer->Cleanup();
+    }
+}
+
+std::shared_ptr<const TriangleBVH> Geometry::GetBVH() const {
+    if (!bvh && !vertices.empty()) {
+        std::vector<glm::vec3> positions;
+        positions.reserve(vertices.size());
+        for (const Vertex& v : vertices) positions.push_back(v.pos);
+
+        auto built = std::make_shared<TriangleBVH>();
+        built->Build(positions.data(), positions.size(), HasIndices() ? indices.data() : nullptr, indices.size());
+        bvh = std::move(built);
+    }
+    return bvh;
 }
\ No newline at end of file
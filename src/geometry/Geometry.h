@@ -7,6 +7,8 @@
 #include <cstddef>
 #include <utility>
 
+class TriangleBVH; // SimulationStaticLib/TriangleBVH.h
+
 class Geometry final {
 public:
     Geometry(VkDevice deviceArg, VkPhysicalDevice physicalDeviceArg);
@@ -25,6 +27,13 @@ public:
     void Draw(VkCommandBuffer commandBuffer) const;
     void Cleanup();
 
+    // Dynamic geometry: vertices edited in place through GetVertex are re-sent with UploadVertices. The
+    // buffers are allocated once, a ring of framesInFlight + 1, so an upload never writes into a buffer that
+    // a frame still in flight is drawing from. The vertex count is fixed from MakeDynamic on.
+    void MakeDynamic(uint32_t framesInFlight);
+    void UploadVertices();
+    bool IsDynamic() const { return !dynamicVertexBuffers.empty(); }
+
     // Read-only accessors (safe)
     const std::vector<Vertex>& GetVertices() const { return vertices; }
     const std::vector<uint32_t>& GetIndices() const { return indices; }
@@ -32,14 +41,14 @@ public:
     bool HasIndices() const { return !indices.empty(); }
 
     // Controlled mutation API (replaces returning non-const references)
-    void AddVertex(const Vertex& v) { vertices.push_back(v); }
-    void AddVertex(Vertex&& v) { vertices.push_back(std::move(v)); }
-    void AddIndex(uint32_t idx) { indices.push_back(idx); }
+    void AddVertex(const Vertex& v) { vertices.push_back(v); bvh.reset(); }
+    void AddVertex(Vertex&& v) { vertices.push_back(std::move(v)); bvh.reset(); }
+    void AddIndex(uint32_t idx) { indices.push_back(idx); bvh.reset(); }
 
     void ReserveVertices(size_t n) { vertices.reserve(n); }
     void ReserveIndices(size_t n) { indices.reserve(n); }
 
-    void SetIndices(const std::vector<uint32_t>& newIndices) { indices = newIndices; }
+    void SetIndices(const std::vector<uint32_t>& newIndices) { indices = newIndices; bvh.reset(); }
 
     // Random access when needed (safe single-element access)
     size_t VertexCount() const { return vertices.size(); }
@@ -50,6 +59,11 @@ public:
 
     uint32_t GetIndex(size_t idx) const { return indices[idx]; }
 
+    // Triangle BVH over the vertex positions, built on first request and shared by every instance of this
+    // geometry (collider and picking alike). Main thread only; edits through GetVertex need InvalidateBVH.
+    std::shared_ptr<const TriangleBVH> GetBVH() const;
+    void InvalidateBVH() { bvh.reset(); }
+
 private:
     // Keep container data first for predictable layout
     std::vector<Vertex> vertices;
@@ -61,4 +75,9 @@ private:
     // Vulkan buffer members (vertex first for locality)
     std::unique_ptr<VulkanBuffer> vertexBuffer;
     std::unique_ptr<VulkanBuffer> indexBuffer;
+    std::vector<std::unique_ptr<VulkanBuffer>> dynamicVertexBuffers;
+    size_t activeVertexBuffer = 0;
+    size_t dynamicVertexCount = 0;
+
+    mutable std::shared_ptr<const TriangleBVH> bvh;
 };
\ No newline at end of file
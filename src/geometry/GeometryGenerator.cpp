@@ -71,32 +71,6 @@ void GeometryGenerator::GenerateGridIndices(Geometry* geometry, int slices, int
     }
 }
 
-float GeometryGenerator::GetTerrainHeight(float x, float z, float radius, float heightScale, float noiseFreq) {
-    const float dist = glm::length(glm::vec2(x, z));
-
-    // 1. Noise Generation
-    float y = 0.0f;
-    // Base layer
-    y += glm::perlin(glm::vec2(x, z) * noiseFreq);
-    // Detail layer
-    y += glm::perlin(glm::vec2(x, z) * noiseFreq * 2.0f) * 0.25f;
-
-    y *= heightScale;
-
-    // 2. Circular Clamping (Masking)
-    const float edgeFactor = dist / radius;
-    if (edgeFactor > 0.95f) {
-        y *= 0.0f; // Force flat/down at edges
-    }
-    else {
-        if (edgeFactor > 0.9f) {
-            y *= 1.0f - ((edgeFactor - 0.9f) * 10.0f);
-        }
-    }
-
-    return y;
-}
-
 std::unique_ptr<Geometry> GeometryGenerator::CreateDisk(VkDevice device, VkPhysicalDevice physicalDevice, float radius, int slices) {
     auto geometry = std::make_unique<Geometry>(device, physicalDevice);
     geometry->ReserveVertices(slices + 2);
@@ -371,6 +345,59 @@ std::unique_ptr<Geometry> GeometryGenerator::CreateGrid(VkDevice device, VkPhysi
     return geometry;
 }
 
+std::unique_ptr<Geometry> GeometryGenerator::CreateCloth(VkDevice device, VkPhysicalDevice physicalDevice, int columns, int rows, float width, float height) {
+    if (columns < 2) columns = 2;
+    if (rows < 2) rows = 2;
+    auto geometry = std::make_unique<Geometry>(device, physicalDevice);
+    const uint32_t sideCount = static_cast<uint32_t>(columns * rows);
+
+    geometry->ReserveVertices(2 * sideCount);
+    geometry->ReserveIndices(2 * (columns - 1) * (rows - 1) * 6);
+
+    for (int side = 0; side < 2; ++side) {
+        const glm::vec3 normal(0.0f, 0.0f, side == 0 ? 1.0f : -1.0f);
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < columns; ++col) {
+                const float u = static_cast<float>(col) / (columns - 1);
+                const float v = static_cast<float>(row) / (rows - 1);
+                const glm::vec3 pos((u - 0.5f) * width, -v * height, 0.0f);
+                glm::vec3 color = GenerateColor(row * columns + col, static_cast<int>(sideCount));
+                geometry->AddVertex({ pos, color, glm::vec2(u, v), normal });
+            }
+        }
+    }
+
+    for (uint32_t side = 0; side < 2; ++side) {
+        const uint32_t base = side * sideCount;
+        for (int row = 0; row + 1 < rows; ++row) {
+            for (int col = 0; col + 1 < columns; ++col) {
+                const uint32_t topLeft = base + row * columns + col;
+                const uint32_t topRight = topLeft + 1;
+                const uint32_t bottomLeft = topLeft + columns;
+                const uint32_t bottomRight = bottomLeft + 1;
+                if (side == 0) {
+                    geometry->AddIndex(topLeft);
+                    geometry->AddIndex(bottomLeft);
+                    geometry->AddIndex(topRight);
+                    geometry->AddIndex(topRight);
+                    geometry->AddIndex(bottomLeft);
+                    geometry->AddIndex(bottomRight);
+                }
+                else {
+                    geometry->AddIndex(topLeft);
+                    geometry->AddIndex(topRight);
+                    geometry->AddIndex(bottomLeft);
+                    geometry->AddIndex(topRight);
+                    geometry->AddIndex(bottomRight);
+                    geometry->AddIndex(bottomLeft);
+                }
+            }
+        }
+    }
+    geometry->CreateBuffers();
+    return geometry;
+}
+
 std::unique_ptr<Geometry> GeometryGenerator::CreateSphere(VkDevice device, VkPhysicalDevice physicalDevice, int stacks, int slices, float radius) {
     if (stacks < 2) stacks = 2;
     if (slices < 3) slices = 3;
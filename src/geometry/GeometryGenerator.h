@@ -2,6 +2,7 @@
 
 #include "Geometry.h"
 #include <glm/glm.hpp>
+#include <glm/gtc/noise.hpp>
 #include <memory>
 
 class GeometryGenerator final {
@@ -23,6 +24,7 @@ public:
 
     static std::unique_ptr<Geometry> CreateTerrain(VkDevice device, VkPhysicalDevice physicalDevice,
         float radius, int rings, int segments, float heightScale, float noiseFreq);
+    // Defined below, so tools without a Vulkan device can bake the same terrain
     static float GetTerrainHeight(float x, float z, float radius, float heightScale, float noiseFreq);
 
     static std::unique_ptr<Geometry> CreateBowl(VkDevice device, VkPhysicalDevice physicalDevice,
@@ -33,7 +35,39 @@ public:
 
     static std::unique_ptr<Geometry> CreateDisk(VkDevice device, VkPhysicalDevice physicalDevice, float radius, int slices);
 
+    // Vertical sheet of columns x rows vertices hanging down from y = 0, centred on x = 0 and facing +Z. The
+    // first row is the top edge. Double-sided: the back face is a second copy of every vertex with the normal
+    // flipped and the winding reversed, since the scene pipeline culls back faces.
+    static std::unique_ptr<Geometry> CreateCloth(VkDevice device, VkPhysicalDevice physicalDevice,
+        int columns, int rows, float width, float height);
+
 private:
     static glm::vec3 GenerateColor(int index, int total);
     static void GenerateGridIndices(Geometry* geometry, int slices, int stacks);
-};
\ No newline at end of file
+};
+
+inline float GeometryGenerator::GetTerrainHeight(float x, float z, float radius, float heightScale, float noiseFreq) {
+    const float dist = glm::length(glm::vec2(x, z));
+
+    // 1. Noise Generation
+    float y = 0.0f;
+    // Base layer
+    y += glm::perlin(glm::vec2(x, z) * noiseFreq);
+    // Detail layer
+    y += glm::perlin(glm::vec2(x, z) * noiseFreq * 2.0f) * 0.25f;
+
+    y *= heightScale;
+
+    // 2. Circular Clamping (Masking)
+    const float edgeFactor = dist / radius;
+    if (edgeFactor > 0.95f) {
+        y *= 0.0f; // Force flat/down at edges
+    }
+    else {
+        if (edgeFactor > 0.9f) {
+            y *= 1.0f - ((edgeFactor - 0.9f) * 10.0f);
+        }
+    }
+
+    return y;
+}
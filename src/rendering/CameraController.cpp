@@ -196,6 +196,7 @@ void CameraController::UpdateFreeRoam(float deltaTime, Scene& scene, const Input
     m = glm::rotate(m, glm::radians(cam.yaw), { 0, 1, 0 });
     m = glm::rotate(m, glm::radians(cam.pitch), { 1, 0, 0 });
     transform.matrix = m;
+    registry.MarkChanged<TransformComponent>(activeCameraEntity);
 }
 
 void CameraController::UpdateOrbitInput(float deltaTime, Scene& scene, const InputManager& input) {
@@ -245,14 +246,7 @@ void CameraController::ClampCameraPosition(glm::vec3& pos, Scene& scene, const g
         const float distFromCenter = glm::length(glm::vec2(localX, localZ));
 
         if (distFromCenter < terrain.radius) {
-            const float rawNoiseHeight = GeometryGenerator::GetTerrainHeight(
-                localX, localZ,
-                terrain.radius,
-                terrain.heightScale,
-                terrain.noiseFreq
-            );
-
-            const float worldFloorY = rawNoiseHeight + terrain.position.y;
+            const float worldFloorY = terrain.HeightAt(localX, localZ) + terrain.position.y;
             const float clampHeight = worldFloorY + COLLISION_BUFFER;
 
             if (pos.y < clampHeight) {
@@ -268,7 +262,8 @@ void CameraController::ClampCameraPosition(glm::vec3& pos, Scene& scene, const g
         auto& collider = registry.GetComponent<ColliderComponent>(e);
         auto& transform = registry.GetComponent<TransformComponent>(e);
 
-        if (!collider.hasCollision) continue;
+        // The terrain heightfield was handled above; it is not a cylinder
+        if (!collider.hasCollision || collider.type == 2) continue;
 
         const glm::vec3 objPos = glm::vec3(transform.matrix[3]);
         const float objTop = objPos.y + collider.height;
@@ -134,6 +134,22 @@ namespace ParticleLibrary {
         return props;
     }
 
+    const ParticleProps& GetFluidProps() {
+        static const ParticleProps props = CreateProps(
+            glm::vec3(0.0f),                    // Velocity (simulated by FluidSystem)
+            glm::vec3(0.0f),                    // Velocity Variation
+            glm::vec4(0.1f, 0.35f, 0.8f, 0.85f), // Color Begin (Still water)
+            glm::vec4(0.85f, 0.93f, 1.0f, 0.9f), // Color End   (Fast water / foam)
+            0.35f,                              // Size Begin
+            0.35f,                              // Size End
+            0.0f,                               // Size Variation
+            1.0f,                               // Lifetime
+            "textures/kenney_particle-pack/transparent/circle_01.png",
+            false                               // Is Additive? No (Alpha blend so water reads as a body)
+        );
+        return props;
+    }
+
     std::vector<std::pair<std::string, ParticleProps>> GetAllPresets() {
         return {
             {"Fire", GetFireProps()},
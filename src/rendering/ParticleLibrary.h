@@ -13,6 +13,9 @@ namespace ParticleLibrary {
     const ParticleProps& GetDustProps();
     const ParticleProps& GetDustStormProps();
 
+    // Texture and blending for the SPH fluid; its instances come from FluidSystem, not from emitters
+    const ParticleProps& GetFluidProps();
+
     // New function to return all presets dynamically
     std::vector<std::pair<std::string, ParticleProps>> GetAllPresets();
 }
\ No newline at end of file
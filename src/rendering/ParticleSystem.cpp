@@ -14,11 +14,12 @@ static float RandomFloat(float min, float max) {
     return dist(mt);
 }
 
-ParticleSystem::ParticleSystem(VkDevice deviceArg, VkPhysicalDevice physicalDeviceArg, VkCommandPool commandPool, VkQueue graphicsQueue, uint32_t maxParticlesArg, uint32_t framesInFlightArg)
+ParticleSystem::ParticleSystem(VkDevice deviceArg, VkPhysicalDevice physicalDeviceArg, VkCommandPool commandPool, VkQueue graphicsQueue, uint32_t maxParticlesArg, uint32_t framesInFlightArg, uint32_t externalCapacityArg)
     : device(deviceArg),
     physicalDevice(physicalDeviceArg),
     maxParticles(maxParticlesArg),
     framesInFlight(framesInFlightArg),
+    externalCapacity(externalCapacityArg),
     poolIndex(maxParticlesArg > 0 ? maxParticlesArg - 1 : 0),
     particles(maxParticlesArg),
     texture(std::make_unique<Texture>(deviceArg, physicalDeviceArg, commandPool, graphicsQueue)) {
@@ -205,11 +206,16 @@ void ParticleSystem::UpdateInstanceBuffer(uint32_t currentFrame) {
         instanceData.push_back(data);
     }
 
-    if (!instanceData.empty()) {
-        const VkDeviceSize size = static_cast<VkDeviceSize>(instanceData.size() * sizeof(InstanceData));
+    // Submitted instances go straight behind the pooled ones without another staging copy
+    const size_t externalCount = std::min<size_t>(externalInstances.size(), externalCapacity);
+    if (!instanceData.empty() || externalCount > 0) {
+        const size_t pooledBytes = instanceData.size() * sizeof(InstanceData);
+        const size_t externalBytes = externalCount * sizeof(InstanceData);
+        const VkDeviceSize size = static_cast<VkDeviceSize>(pooledBytes + externalBytes);
         void* dataPtr = nullptr;
         vkMapMemory(device, instanceBuffers[currentFrame]->GetBufferMemory(), 0, size, 0, &dataPtr);
-        std::memcpy(dataPtr, instanceData.data(), static_cast<size_t>(size));
+        if (pooledBytes > 0) std::memcpy(dataPtr, instanceData.data(), pooledBytes);
+        if (externalBytes > 0) std::memcpy(static_cast<char*>(dataPtr) + pooledBytes, externalInstances.data(), externalBytes);
         vkUnmapMemory(device, instanceBuffers[currentFrame]->GetBufferMemory());
     }
 }
@@ -220,6 +226,7 @@ void ParticleSystem::Draw(VkCommandBuffer cmd, VkDescriptorSet globalDescriptorS
 
     uint32_t activeCount = 0;
     for (const auto& p : particles) if (p.active) activeCount++;
+    activeCount += static_cast<uint32_t>(std::min<size_t>(externalInstances.size(), externalCapacity));
 
     if (activeCount == 0 || !pipeline) return;
 
@@ -258,7 +265,7 @@ void ParticleSystem::SetupBuffers() {
     instanceBuffers.resize(framesInFlight);
     for (uint32_t i = 0; i < framesInFlight; ++i) {
         instanceBuffers[i] = std::make_unique<VulkanBuffer>(device, physicalDevice);
-        instanceBuffers[i]->CreateBuffer(maxParticles * sizeof(InstanceData),
+        instanceBuffers[i]->CreateBuffer((static_cast<VkDeviceSize>(maxParticles) + externalCapacity) * sizeof(InstanceData),
             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
     }
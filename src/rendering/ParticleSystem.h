@@ -34,7 +34,8 @@ public:
 
     const std::vector<ParticleEmitter>& GetEmitters() const { return emitters; }
 
-    ParticleSystem(VkDevice deviceArg, VkPhysicalDevice physicalDeviceArg, VkCommandPool commandPool, VkQueue graphicsQueue, uint32_t maxParticlesArg, uint32_t framesInFlightArg);
+    // externalCapacityArg reserves instance buffer room for SubmitInstances on top of the emitter pool
+    ParticleSystem(VkDevice deviceArg, VkPhysicalDevice physicalDeviceArg, VkCommandPool commandPool, VkQueue graphicsQueue, uint32_t maxParticlesArg, uint32_t framesInFlightArg, uint32_t externalCapacityArg = 0);
     ~ParticleSystem();
 
     // Non-copyable
@@ -71,6 +72,10 @@ public:
         glm::vec4 size;     // x = size, yzw = padding   (Offset 32)
     };
 
+    // Instances simulated elsewhere (the SPH fluid) and drawn after the pooled particles, up to the external
+    // capacity. Swaps with the caller's vector, so both sides keep their allocations from frame to frame.
+    void SubmitInstances(std::vector<InstanceData>& instances) { externalInstances.swap(instances); }
+
     // Static helpers to describe vertex input for the shared pipeline
     static std::array<VkVertexInputBindingDescription, 2> GetBindingDescriptions();
     static std::array<VkVertexInputAttributeDescription, 5> GetAttributeDescriptions();
@@ -98,6 +103,7 @@ private:
     // Small PODs next
     uint32_t maxParticles;
     uint32_t framesInFlight;
+    uint32_t externalCapacity;
     uint32_t poolIndex = 9999;
 
     // Simulation state
@@ -112,6 +118,7 @@ private:
     // Dynamic collections and heap resources
     std::vector<Particle> particles;
     std::vector<ParticleEmitter> emitters;
+    std::vector<InstanceData> externalInstances;
     std::vector<std::unique_ptr<VulkanBuffer>> instanceBuffers;
     std::unique_ptr<Texture> texture;
     std::unique_ptr<VulkanBuffer> vertexBuffer;
@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <iostream>
 #include <array>
+#include <algorithm>
+#include <iterator>
 
 #include "imgui.h"
 #include "backends/imgui_impl_vulkan.h"
@@ -641,19 +643,15 @@ void Renderer::RenderRefractionPass(VkCommandBuffer cmd, uint32_t currentFrame,
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->GetPipeline());
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->GetLayout(), 0, 1, &descriptorSet->GetDescriptorSets()[currentFrame], 0, nullptr);
 
-    Registry& reg = scene.GetRegistry();
-    for (Entity e : scene.GetRenderableEntities()) {
-        if (!reg.HasComponent<RenderComponent>(e) || !reg.HasComponent<TransformComponent>(e)) continue;
-
-        auto& renderComp = reg.GetComponent<RenderComponent>(e);
-        auto& transformComp = reg.GetComponent<TransformComponent>(e);
+    for (const DrawItem& item : m_DrawList) {
+        const RenderComponent& renderComp = *item.render;
 
         if (!renderComp.visible || !renderComp.geometry) continue;
         if (renderComp.shadingMode == 3 || renderComp.shadingMode == 2 || renderComp.shadingMode == 4) continue;
         if ((renderComp.layerMask & layerMask) == 0) continue;
 
         PushConstantObject pco{};
-        pco.model = transformComp.matrix;
+        pco.model = item.transform->matrix;
         pco.shadingMode = renderComp.shadingMode;
         pco.receiveShadows = renderComp.receiveShadows ? 1 : 0;
         pco.layerMask = renderComp.layerMask;
@@ -662,8 +660,7 @@ void Renderer::RenderRefractionPass(VkCommandBuffer cmd, uint32_t currentFrame,
         vkCmdPushConstants(cmd, graphicsPipeline->GetLayout(), VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstantObject), &pco);
 
         // Bind Texture
-        const VkDescriptorSet textureSet = GetTextureDescriptorSet(renderComp.texturePath);
-        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->GetLayout(), 1, 1, &textureSet, 0, nullptr);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->GetLayout(), 1, 1, &item.textureSet, 0, nullptr);
 
         renderComp.geometry->Bind(cmd);
         renderComp.geometry->Draw(cmd);
@@ -716,38 +713,71 @@ void Renderer::CreateSyncObjects() {
     syncObjects->CreateSyncObjects(imageCount);
 }
 
-void Renderer::DrawSceneObjects(VkCommandBuffer cmd, Scene& scene, VkPipelineLayout layout, bool bindTextures, bool skipIfNotCastingShadow, int layerMask) {
+void Renderer::RefreshDrawList(Scene& scene) {
     Registry& reg = scene.GetRegistry();
-    for (Entity e : scene.GetRenderableEntities()) {
-        if (!reg.HasComponent<RenderComponent>(e) || !reg.HasComponent<TransformComponent>(e)) continue;
+    const auto& renderables = scene.GetRenderableEntities();
+    const uint64_t versions[3] = {
+        reg.GetStructureVersion<RenderComponent>(),
+        reg.GetStructureVersion<TransformComponent>(),
+        reg.GetStructureVersion<ThermoComponent>()
+    };
+
+    const bool rebuild = m_DrawListRegistry != &reg
+        || m_DrawListRenderables != renderables.size()
+        || !std::equal(std::begin(versions), std::end(versions), std::begin(m_DrawListVersions));
+
+    if (rebuild) {
+        m_DrawList.clear();
+        m_DrawListIndex.clear();
+        m_DrawList.reserve(renderables.size());
+
+        for (Entity e : renderables) {
+            auto* render = reg.TryGetComponent<RenderComponent>(e);
+            auto* transform = reg.TryGetComponent<TransformComponent>(e);
+            if (!render || !transform) continue;
+
+            m_DrawListIndex[e] = m_DrawList.size();
+            m_DrawList.push_back({ e, render, transform, reg.TryGetComponent<ThermoComponent>(e), GetTextureDescriptorSet(render->texturePath) });
+        }
 
-        auto& renderComp = reg.GetComponent<RenderComponent>(e);
-        auto& transformComp = reg.GetComponent<TransformComponent>(e);
+        m_DrawListRegistry = &reg;
+        m_DrawListRenderables = renderables.size();
+        std::copy(std::begin(versions), std::end(versions), std::begin(m_DrawListVersions));
+    }
+    else {
+        // Only entities whose RenderComponent changed can have a different texture
+        reg.ForEachChangedSince<RenderComponent>(m_DrawListTick, [&](Entity e) {
+            const auto it = m_DrawListIndex.find(e);
+            if (it == m_DrawListIndex.end()) return;
+            DrawItem& item = m_DrawList[it->second];
+            item.textureSet = GetTextureDescriptorSet(item.render->texturePath);
+        });
+    }
+
+    m_DrawListTick = reg.GetChangeTick();
+}
+
+void Renderer::DrawSceneObjects(VkCommandBuffer cmd, Scene& scene, VkPipelineLayout layout, bool bindTextures, bool skipIfNotCastingShadow, int layerMask) {
+    for (const DrawItem& item : m_DrawList) {
+        const RenderComponent& renderComp = *item.render;
 
         if (!renderComp.visible || !renderComp.geometry) continue;
         if ((renderComp.layerMask & layerMask) == 0) continue;
         if (skipIfNotCastingShadow && !renderComp.castsShadow) continue;
 
-        // Fetch thermodynamics state if the entity is flammable
-        float burnFactor = 0.0f;
-        if (reg.HasComponent<ThermoComponent>(e)) {
-            burnFactor = reg.GetComponent<ThermoComponent>(e).burnFactor;
-        }
-
         PushConstantObject pco{};
-        pco.model = transformComp.matrix;
+        pco.model = item.transform->matrix;
         pco.shadingMode = renderComp.shadingMode;
         pco.receiveShadows = renderComp.receiveShadows ? 1 : 0;
         pco.layerMask = renderComp.layerMask;
-        pco.burnFactor = burnFactor;
+        pco.burnFactor = item.thermo ? item.thermo->burnFactor : 0.0f;
 
         // Push constants
         vkCmdPushConstants(cmd, layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushConstantObject), &pco);
 
         // Bind Texture
         if (bindTextures) {
-            const VkDescriptorSet textureSet = GetTextureDescriptorSet(renderComp.texturePath);
-            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 1, 1, &textureSet, 0, nullptr);
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 1, 1, &item.textureSet, 0, nullptr);
         }
 
         // Draw Geometry
@@ -877,6 +907,9 @@ void Renderer::RecordCommandBuffer(VkCommandBuffer cmd, uint32_t imageIndex,
 
     UpdateUniformBuffer(currentFrame, ubo);
 
+    // Resolve draw data once for all three passes
+    RefreshDrawList(scene);
+
     // --- 1. Render Shadow Pass ---
     RenderShadowMap(cmd, currentFrame, scene, SceneLayers::ALL);
 
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <functional>
 #include "../vulkan/VulkanContext.h"
 #include "Camera.h"
@@ -116,6 +117,23 @@ private:
     std::map<std::string, TextureResource> textureCache;
     TextureResource defaultTextureResource;
 
+    // Per-entity draw data resolved once and reused by every pass. Component storage never moves,
+    // so the pointers stay valid until a pool's structure changes; fields are still read live at draw time.
+    struct DrawItem {
+        Entity entity = MAX_ENTITIES;
+        RenderComponent* render = nullptr;
+        TransformComponent* transform = nullptr;
+        const ThermoComponent* thermo = nullptr;
+        VkDescriptorSet textureSet = VK_NULL_HANDLE;
+    };
+
+    std::vector<DrawItem> m_DrawList;
+    std::unordered_map<Entity, size_t> m_DrawListIndex;
+    const Registry* m_DrawListRegistry = nullptr;
+    size_t m_DrawListRenderables = 0;
+    uint64_t m_DrawListVersions[3] = { 0, 0, 0 };
+    uint32_t m_DrawListTick = 0;
+
     // --- 4. Primitives ---
     static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
     bool framebufferResized = false;
@@ -141,6 +159,7 @@ private:
     void BeginRenderPass(VkCommandBuffer cmd, VkRenderPass pass, VkFramebuffer fb, const std::vector<VkClearValue>& clearValues) const;
 
     void RenderShadowMap(VkCommandBuffer cmd, uint32_t currentFrame, Scene& scene, int layerMask = SceneLayers::ALL);
+    void RefreshDrawList(Scene& scene);
     void DrawSceneObjects(VkCommandBuffer cmd, Scene& scene, VkPipelineLayout layout, bool bindTextures, bool skipIfNotCastingShadow, int layerMask);
     void RenderScene(VkCommandBuffer cmd, uint32_t currentFrame, Scene& scene, int layerMask);
     void RenderRefractionPass(VkCommandBuffer cmd, uint32_t currentFrame, Scene& scene, int layerMask);
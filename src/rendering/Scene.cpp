@@ -19,15 +19,27 @@
 #include "../systems/ParticleUpdateSystem.h"
 #include "../systems/CameraSystem.h"
 #include "../systems/PhysicsSystem.h"
+#include "../systems/PhysicsEdits.h"
+#include "../systems/FluidSystem.h"
+#include "../systems/ClothSystem.h"
+#include "../../SimulationStaticLib/Heightfield.h"
+#include "../../SimulationStaticLib/TriangleBVH.h"
+
+namespace {
+    // Raster cells across the terrain's diameter. Noise features are tens of metres wide, so a cell of a
+    // metre or so loses nothing a sphere could feel.
+    constexpr int TERRAIN_HEIGHTFIELD_RESOLUTION = 512;
+}
+
+float TerrainConfig::HeightAt(float x, float z) const {
+    if (heightfield) return heightfield->Height(x, z);
+    return GeometryGenerator::GetTerrainHeight(x, z, radius, heightScale, noiseFreq);
+}
 
 // 3. Add the helper implementations anywhere in Scene.cpp
 void Scene::SetObjectPhysics(const std::string& name, bool isStatic, float mass) {
     Entity e = GetEntityByName(name);
-    if (e != MAX_ENTITIES && m_Registry.HasComponent<PhysicsComponent>(e)) {
-        auto& phys = m_Registry.GetComponent<PhysicsComponent>(e);
-        phys.isStatic = isStatic;
-        phys.mass = mass;
-    }
+    if (e != MAX_ENTITIES) SetBodyPhysics(m_Registry, e, isStatic, mass);
 }
 
 void Scene::SpawnPhysicsBall(const glm::vec3& pos, const glm::vec3& velocity) {
@@ -52,12 +64,64 @@ void Scene::SpawnPhysicsBall(const glm::vec3& pos, const glm::vec3& velocity) {
     col.hasCollision = true;
 }
 
+void Scene::SpawnGravityCluster(const glm::vec3& center, int count, float radius, float coreMass) {
+    static int clusterCount = 0;
+    const std::string prefix = "Cluster" + std::to_string(clusterCount++) + "_";
+    const float bodyRadius = 0.2f;
+    const float bodyMass = 1.0f;
+
+    Entity core = AddObjectInternal(prefix + "Core", GeometryGenerator::CreateSphere(device, physicalDevice, 16, 32, 1.5f), center, "textures/default.jpg", false);
+    m_Registry.GetComponent<PhysicsComponent>(core).isStatic = false;
+    m_Registry.GetComponent<PhysicsComponent>(core).SetMass(coreMass);
+    m_Registry.GetComponent<ColliderComponent>(core).radius = 1.5f;
+
+    // Radii uniform over the disk's area, sorted so the mass inside each one is a running count
+    std::mt19937 rng(1234u + clusterCount);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> radii(static_cast<size_t>(std::max(count, 0)));
+    for (float& r : radii) r = radius * std::sqrt(0.0625f + 0.9375f * unit(rng));
+    std::sort(radii.begin(), radii.end());
+
+    std::shared_ptr<Geometry> ball = GeometryGenerator::CreateSphere(device, physicalDevice, 6, 10, bodyRadius);
+    for (size_t i = 0; i < radii.size(); ++i) {
+        const float angle = unit(rng) * glm::two_pi<float>();
+        const glm::vec3 radial(std::cos(angle), 0.0f, std::sin(angle));
+        const glm::vec3 offset = radial * radii[i] + glm::vec3(0.0f, (unit(rng) - 0.5f) * radius * 0.02f, 0.0f);
+        const float enclosed = coreMass + bodyMass * static_cast<float>(i);
+        const float speed = std::sqrt(PhysicsSystem::gravitySettings.G * enclosed / radii[i]);
+
+        Entity e = AddObjectInternal(prefix + std::to_string(i), ball, center + offset, "textures/default.jpg", false);
+        auto& phys = m_Registry.GetComponent<PhysicsComponent>(e);
+        phys.isStatic = false;
+        phys.SetMass(bodyMass);
+        phys.velocity = glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), radial) * speed;
+        phys.restitution = 0.3f;
+        m_Registry.GetComponent<ColliderComponent>(e).radius = bodyRadius;
+    }
+}
+
 Entity Scene::GetEntityByName(const std::string& name) const {
-    auto it = m_EntityMap.find(name);
-    if (it != m_EntityMap.end()) {
-        return it->second;
+    return GetEntityBySymbol(m_Symbols.Find(name));
+}
+
+Entity Scene::GetEntityBySymbol(Symbol symbol) const {
+    return (symbol < m_EntityBySymbol.size()) ? m_EntityBySymbol[symbol] : MAX_ENTITIES;
+}
+
+void Scene::RegisterEntityName(Entity entity, const std::string& name) {
+    const Symbol symbol = m_Symbols.Intern(name);
+    if (symbol >= m_EntityBySymbol.size()) {
+        m_EntityBySymbol.resize(symbol + 1, MAX_ENTITIES);
+    }
+    m_EntityBySymbol[symbol] = entity;
+
+    m_Registry.AddComponent<NameComponent>(entity, { name, symbol });
+
+    // Well-known singletons are resolved here once, so per-frame code never looks them up by name
+    if (name == "Sun") {
+        m_SunEntity = entity;
+        m_Registry.AddComponent<SunTag>(entity, SunTag{});
     }
-    return MAX_ENTITIES;
 }
 
 void Scene::ToggleGlobalShadingMode() {
@@ -68,6 +132,7 @@ void Scene::ToggleGlobalShadingMode() {
             auto& renderComp = m_Registry.GetComponent<RenderComponent>(e);
             if (renderComp.shadingMode == 0 || renderComp.shadingMode == 1) {
                 renderComp.shadingMode = globalShadingMode;
+                m_Registry.MarkChanged<RenderComponent>(e);
             }
         }
     }
@@ -76,9 +141,7 @@ void Scene::ToggleGlobalShadingMode() {
 
 Entity Scene::AddObjectInternal(const std::string& name, std::shared_ptr<Geometry> geometry, const glm::vec3& position, const std::string& texturePath, bool isFlammable) {
     Entity entity = m_Registry.CreateEntity();
-    m_EntityMap[name] = entity;
-
-    m_Registry.AddComponent<NameComponent>(entity, { name });
+    RegisterEntityName(entity, name);
 
     TransformComponent transform;
     transform.position = position;
@@ -133,13 +196,13 @@ void Scene::Initialize() {
 
     // 1. Create Global Environment Entity
     m_EnvironmentEntity = m_Registry.CreateEntity();
-    m_Registry.AddComponent<NameComponent>(m_EnvironmentEntity, { "GlobalEnvironment" });
+    RegisterEntityName(m_EnvironmentEntity, "GlobalEnvironment");
     m_Registry.AddComponent<EnvironmentComponent>(m_EnvironmentEntity, EnvironmentComponent{});
 
     // 2. Create Global Dust Cloud Entity
-    Entity dustEntity = m_Registry.CreateEntity();
-    m_Registry.AddComponent<NameComponent>(dustEntity, { "GlobalDustCloud" });
-    m_Registry.AddComponent<DustCloudComponent>(dustEntity, DustCloudComponent{});
+    m_DustCloudEntity = m_Registry.CreateEntity();
+    RegisterEntityName(m_DustCloudEntity, "GlobalDustCloud");
+    m_Registry.AddComponent<DustCloudComponent>(m_DustCloudEntity, DustCloudComponent{});
 
     // 3. Register ECS Systems
     m_Systems.push_back(std::make_unique<CameraSystem>());
@@ -150,6 +213,8 @@ void Scene::Initialize() {
     m_Systems.push_back(std::make_unique<SimpleShadowSystem>());
     m_Systems.push_back(std::make_unique<ThermodynamicsSystem>());
     m_Systems.push_back(std::make_unique<PhysicsSystem>());
+    m_Systems.push_back(std::make_unique<FluidSystem>());
+    m_Systems.push_back(std::make_unique<ClothSystem>());
 }
 
 void Scene::RegisterProceduralObject(const std::string& modelPath, const std::string& texturePath, float frequency, const glm::vec3& minScale, const glm::vec3& maxScale, const glm::vec3& baseRotation, bool isFlammable) {
@@ -185,7 +250,10 @@ void Scene::GenerateProceduralObjects(int count, float terrainRadius, float delt
         const float x = r * cos(theta);
         const float z = r * sin(theta);
 
-        const float yOffset = GeometryGenerator::GetTerrainHeight(x, z, terrainRadius, heightScale, noiseFreq);
+        // Placement stays inside 0.9 of the radius, where the baked terrain and the raw noise agree
+        const float yOffset = m_TerrainConfig.heightfield
+            ? m_TerrainConfig.heightfield->Height(x, z)
+            : GeometryGenerator::GetTerrainHeight(x, z, terrainRadius, heightScale, noiseFreq);
         const float y = deltaY + yOffset;
 
         const float pick = distFreq(gen);
@@ -225,6 +293,7 @@ void Scene::GenerateProceduralObjects(int count, float terrainRadius, float delt
                 transform.rotation = config.baseRotation + glm::vec3(0.0f, randomYaw, 0.0f);
                 transform.scale = scale;
                 transform.UpdateMatrix();
+                m_Registry.MarkChanged<TransformComponent>(mainObj);
             }
         }
     }
@@ -234,18 +303,31 @@ void Scene::AddTerrain(const std::string& name, float radius, int rings, int seg
     auto geo = GeometryGenerator::CreateTerrain(device, physicalDevice, radius - 1, rings, segments, heightScale, noiseFreq);
     Entity entity = AddObjectInternal(name, std::move(geo), position, texturePath, false);
 
-    auto& collider = m_Registry.GetComponent<ColliderComponent>(entity);
-    collider.hasCollision = false;
-
     m_TerrainConfig.exists = true;
     m_TerrainConfig.radius = radius;
     m_TerrainConfig.heightScale = heightScale;
     m_TerrainConfig.noiseFreq = noiseFreq;
     m_TerrainConfig.position = position;
+
+    // Bake the noise once; camera clamping, object placement and physics all sample this raster
+    auto heightfield = std::make_shared<Heightfield>();
+    heightfield->Build(radius, TERRAIN_HEIGHTFIELD_RESOLUTION, [&](float x, float z) {
+        return GeometryGenerator::GetTerrainHeight(x, z, radius, heightScale, noiseFreq);
+    });
+    m_TerrainConfig.heightfield = heightfield;
+
+    // Bodies roll on the baked surface inside the disc the mesh covers
+    auto& collider = m_Registry.GetComponent<ColliderComponent>(entity);
+    collider.hasCollision = true;
+    collider.type = 2;
+    collider.radius = radius - 1.0f;
+    collider.heightfield = heightfield;
 }
 
 void Scene::AddBowl(const std::string& name, float radius, int slices, int stacks, const glm::vec3& position, const std::string& texturePath) {
-    AddObjectInternal(name, GeometryGenerator::CreateBowl(device, physicalDevice, radius, slices, stacks), position, texturePath, false);
+    std::shared_ptr<Geometry> geometry = GeometryGenerator::CreateBowl(device, physicalDevice, radius, slices, stacks);
+    geometry->GetBVH(); // Ready for a mesh collider
+    AddObjectInternal(name, geometry, position, texturePath, false);
 }
 
 void Scene::AddPedestal(const std::string& name, float topRadius, float baseWidth, float height, const glm::vec3& position, const std::string& texturePath) {
@@ -265,6 +347,7 @@ void Scene::AddCube(const std::string& name, const glm::vec3& position, const gl
     auto& transform = m_Registry.GetComponent<TransformComponent>(entity);
     transform.scale = scale;
     transform.UpdateMatrix();
+    m_Registry.MarkChanged<TransformComponent>(entity);
 }
 
 void Scene::AddGrid(const std::string& name, int rows, int cols, float cellSize, const glm::vec3& position, const std::string& texturePath) {
@@ -281,13 +364,16 @@ void Scene::AddGeometry(const std::string& name, std::unique_ptr<Geometry> geome
 
 void Scene::AddModel(const std::string& name, const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale, const std::string& modelPath, const std::string& texturePath, bool isFlammable) {
     try {
-        std::shared_ptr<Geometry> geometry;
-        std::string ext = modelPath.substr(modelPath.find_last_of(".") + 1);
-        if (ext == "sjg") {
-            geometry = SJGLoader::Load(device, physicalDevice, modelPath);
-        }
-        else {
-            geometry = OBJLoader::Load(device, physicalDevice, modelPath);
+        std::shared_ptr<Geometry>& geometry = m_ModelCache[modelPath];
+        if (!geometry) {
+            std::string ext = modelPath.substr(modelPath.find_last_of(".") + 1);
+            if (ext == "sjg") {
+                geometry = SJGLoader::Load(device, physicalDevice, modelPath);
+            }
+            else {
+                geometry = OBJLoader::Load(device, physicalDevice, modelPath);
+            }
+            geometry->GetBVH(); // Built once at load, for mesh colliders and picking
         }
 
         Entity entity = AddObjectInternal(name, geometry, position, texturePath, isFlammable);
@@ -297,6 +383,7 @@ void Scene::AddModel(const std::string& name, const glm::vec3& position, const g
         transform.rotation = rotation;
         transform.scale = scale;
         transform.UpdateMatrix();
+        m_Registry.MarkChanged<TransformComponent>(entity);
     }
     catch (const std::exception& e) {
         std::cerr << "Failed to add model '" << modelPath << "': " << e.what() << std::endl;
@@ -325,6 +412,7 @@ void Scene::CreateSimpleShadowEntity(Entity targetEntity) {
     shadowRender.shadingMode = 0;
     // Match the parent object's visibility
     shadowRender.visible = m_Registry.GetComponent<RenderComponent>(targetEntity).visible;
+    m_Registry.MarkChanged<RenderComponent>(shadowEntity);
 
     auto& shadowThermo = m_Registry.GetComponent<ThermoComponent>(shadowEntity);
     shadowThermo.burnFactor = 1.0f; // Force black color
@@ -370,6 +458,7 @@ void Scene::ToggleSimpleShadows() {
         if (!m_Registry.HasComponent<RenderComponent>(e)) continue;
 
         auto& render = m_Registry.GetComponent<RenderComponent>(e);
+        m_Registry.MarkChanged<RenderComponent>(e);
 
         if (env.useSimpleShadows) {
             // Turn ON Simple Shadows
@@ -396,7 +485,8 @@ void Scene::ToggleSimpleShadows() {
 
                 // 2. Remove from Maps & Lists
                 if (m_Registry.HasComponent<NameComponent>(shadowEnt)) {
-                    m_EntityMap.erase(m_Registry.GetComponent<NameComponent>(shadowEnt).name);
+                    const Symbol symbol = m_Registry.GetComponent<NameComponent>(shadowEnt).symbol;
+                    if (symbol < m_EntityBySymbol.size()) m_EntityBySymbol[symbol] = MAX_ENTITIES;
                 }
                 auto it = std::find(m_RenderableEntities.begin(), m_RenderableEntities.end(), shadowEnt);
                 if (it != m_RenderableEntities.end()) m_RenderableEntities.erase(it);
@@ -404,8 +494,8 @@ void Scene::ToggleSimpleShadows() {
                 // 3. Destroy in ECS
                 m_Registry.DestroyEntity(shadowEnt);
 
-                // 4. Sever the link
-                render.simpleShadowEntity = MAX_ENTITIES;
+                // 4. Sever the link (re-fetch: the destroy may have moved this entity's RenderComponent)
+                m_Registry.GetComponent<RenderComponent>(e).simpleShadowEntity = MAX_ENTITIES;
             }
         }
     }
@@ -422,9 +512,7 @@ Entity Scene::AddLight(const std::string& name, const glm::vec3& position, const
 
     if (entity == MAX_ENTITIES) {
         entity = m_Registry.CreateEntity();
-        m_EntityMap[name] = entity;
-
-        m_Registry.AddComponent<NameComponent>(entity, { name });
+        if (!name.empty()) RegisterEntityName(entity, name);
 
         TransformComponent transform;
         transform.position = position;
@@ -446,28 +534,52 @@ Entity Scene::AddLight(const std::string& name, const glm::vec3& position, const
 
 void Scene::SetObjectCollision(const std::string& name, bool enabled) {
     Entity e = GetEntityByName(name);
-    if (e != MAX_ENTITIES && m_Registry.HasComponent<ColliderComponent>(e)) {
-        m_Registry.GetComponent<ColliderComponent>(e).hasCollision = enabled;
-    }
+    if (e != MAX_ENTITIES) SetBodyCollision(m_Registry, e, enabled);
 }
 
 void Scene::SetObjectCollider(const std::string& name, int type, float radius, const glm::vec3& normal) {
     Entity e = GetEntityByName(name);
     if (e != MAX_ENTITIES && m_Registry.HasComponent<ColliderComponent>(e)) {
+        SetBodyCollider(m_Registry, e, type, radius, normal);
         auto& col = m_Registry.GetComponent<ColliderComponent>(e);
-        col.type = type;
-        col.radius = radius;
-        col.normal = glm::normalize(normal);
+
+        // A mesh collider uses the BVH of whatever the object renders
+        if (type == 3 && m_Registry.HasComponent<RenderComponent>(e)) {
+            const auto& render = m_Registry.GetComponent<RenderComponent>(e);
+            col.mesh = render.geometry ? render.geometry->GetBVH() : nullptr;
+        }
+    }
+}
+
+Entity Scene::Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float* hitDistance) const {
+    const glm::vec3 dir = glm::normalize(direction);
+    Entity best = MAX_ENTITIES;
+    float bestT = maxDistance;
+
+    for (Entity e : m_RenderableEntities) {
+        if (!m_Registry.HasComponent<RenderComponent>(e) || !m_Registry.HasComponent<TransformComponent>(e)) continue;
+        const auto& render = m_Registry.GetComponent<RenderComponent>(e);
+        if (!render.visible || !render.geometry) continue;
+        const std::shared_ptr<const TriangleBVH> bvh = render.geometry->GetBVH();
+        if (!bvh || bvh->Empty()) continue;
+
+        // An affine inverse keeps the ray parameter, so t stays a world distance along dir. Front faces only,
+        // so shells around the camera (sky domes, the snow globe) do not swallow every click.
+        const glm::mat4 toLocal = glm::inverse(m_Registry.GetComponent<TransformComponent>(e).matrix);
+        TriangleBVH::RayHit hit;
+        if (bvh->Raycast(glm::vec3(toLocal * glm::vec4(origin, 1.0f)), glm::vec3(toLocal * glm::vec4(dir, 0.0f)), bestT, hit, true)) {
+            bestT = hit.t;
+            best = e;
+        }
     }
+
+    if (hitDistance && best != MAX_ENTITIES) *hitDistance = bestT;
+    return best;
 }
 
 void Scene::SetObjectCollisionSize(const std::string& name, float radius, float height) {
     Entity e = GetEntityByName(name);
-    if (e != MAX_ENTITIES && m_Registry.HasComponent<ColliderComponent>(e)) {
-        auto& collider = m_Registry.GetComponent<ColliderComponent>(e);
-        collider.radius = radius;
-        collider.height = height;
-    }
+    if (e != MAX_ENTITIES) SetBodyCollisionSize(m_Registry, e, radius, height);
 }
 
 void Scene::SetObjectTexture(const std::string& name, const std::string& texturePath) {
@@ -476,6 +588,7 @@ void Scene::SetObjectTexture(const std::string& name, const std::string& texture
         auto& renderComp = m_Registry.GetComponent<RenderComponent>(e);
         renderComp.texturePath = texturePath;
         renderComp.originalTexturePath = texturePath;
+        m_Registry.MarkChanged<RenderComponent>(e);
     }
 }
 
@@ -499,14 +612,14 @@ void Scene::SetupParticleSystem(VkCommandPool commandPoolArg, VkQueue graphicsQu
     }
 }
 
-ParticleSystem* Scene::GetOrCreateSystem(const ParticleProps& props) {
+ParticleSystem* Scene::GetOrCreateSystem(const ParticleProps& props, uint32_t externalCapacity) {
     for (const auto& sys : particleSystems) {
         if (sys->GetTexturePath() == props.texturePath) {
             return sys.get();
         }
     }
 
-    auto newSys = std::make_unique<ParticleSystem>(device, physicalDevice, commandPool, graphicsQueue, 10000, framesInFlight);
+    auto newSys = std::make_unique<ParticleSystem>(device, physicalDevice, commandPool, graphicsQueue, 10000, framesInFlight, externalCapacity);
     GraphicsPipeline* const pipeline = props.isAdditive ? particlePipelineAdditive : particlePipelineAlpha;
     newSys->Initialize(particleDescriptorLayout, pipeline, props.texturePath, props.isAdditive);
 
@@ -515,6 +628,79 @@ ParticleSystem* Scene::GetOrCreateSystem(const ParticleProps& props) {
     return ptr;
 }
 
+size_t Scene::SpawnFluidBlock(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& velocity) {
+    // The block is laid out on the lattice of the current settings
+    m_Fluid.Configure(FluidSystem::settings);
+    const size_t added = m_Fluid.AddBlock(center, halfExtents, velocity, MAX_FLUID_PARTICLES);
+
+    if (added > 0 && !m_FluidParticles) {
+        m_FluidParticles = GetOrCreateSystem(ParticleLibrary::GetFluidProps(), MAX_FLUID_PARTICLES);
+    }
+    return added;
+}
+
+void Scene::ClearFluid() {
+    m_Fluid.Clear();
+    if (m_FluidParticles) {
+        std::vector<ParticleSystem::InstanceData> none;
+        m_FluidParticles->SubmitInstances(none);
+    }
+}
+
+namespace {
+    // Areal density of the cloth and mass of a soft ball per cubic metre; only their ratio to gravity matters
+    constexpr float CLOTH_DENSITY = 0.3f;
+    constexpr float SOFT_BALL_DENSITY = 100.0f;
+
+    std::shared_ptr<XpbdBody> BuildSoftBody(const Geometry& geometry, float mass, bool preserveVolume) {
+        std::vector<glm::vec3> positions, normals;
+        positions.reserve(geometry.VertexCount());
+        normals.reserve(geometry.VertexCount());
+        for (const Vertex& v : geometry.GetVertices()) {
+            positions.push_back(v.pos);
+            normals.push_back(v.normal);
+        }
+
+        auto body = std::make_shared<XpbdBody>();
+        body->Build(positions.data(), normals.data(), positions.size(), geometry.GetIndices().data(), geometry.IndexCount(), mass, preserveVolume);
+        return body;
+    }
+}
+
+Entity Scene::AddCloth(const std::string& name, const glm::vec3& topCenter, float width, float height, int columns, int rows, bool pinTopEdge, const std::string& texturePath) {
+    std::shared_ptr<Geometry> geometry = GeometryGenerator::CreateCloth(device, physicalDevice, columns, rows, width, height);
+    for (size_t i = 0; i < geometry->VertexCount(); ++i) geometry->GetVertex(i).pos += topCenter;
+
+    std::shared_ptr<XpbdBody> body = BuildSoftBody(*geometry, CLOTH_DENSITY * width * height, false);
+    if (pinTopEdge) {
+        // The generator lays the top edge out first
+        for (int col = 0; col < std::max(columns, 2); ++col) body->Pin(body->ParticleOf(col));
+    }
+    return AddSoftBodyInternal(name, std::move(geometry), std::move(body), texturePath);
+}
+
+Entity Scene::AddSoftBall(const std::string& name, const glm::vec3& center, float radius, int stacks, int slices, const std::string& texturePath) {
+    std::shared_ptr<Geometry> geometry = GeometryGenerator::CreateSphere(device, physicalDevice, stacks, slices, radius);
+    for (size_t i = 0; i < geometry->VertexCount(); ++i) geometry->GetVertex(i).pos += center;
+
+    const float volume = 4.0f / 3.0f * glm::pi<float>() * radius * radius * radius;
+    std::shared_ptr<XpbdBody> body = BuildSoftBody(*geometry, SOFT_BALL_DENSITY * volume, true);
+    XpbdSettings settings;
+    settings.bendCompliance = 1.0f; // The volume holds the shape; stiff bending would make it a hard shell
+    body->Configure(settings);
+    return AddSoftBodyInternal(name, std::move(geometry), std::move(body), texturePath);
+}
+
+Entity Scene::AddSoftBodyInternal(const std::string& name, std::shared_ptr<Geometry> geometry, std::shared_ptr<XpbdBody> body, const std::string& texturePath) {
+    geometry->MakeDynamic(framesInFlight);
+    Entity entity = AddObjectInternal(name, geometry, glm::vec3(0.0f), texturePath, false);
+
+    // The body collides through its particles; its default sphere collider would only get in the way
+    m_Registry.GetComponent<ColliderComponent>(entity).hasCollision = false;
+    m_Registry.AddComponent<SoftBodyComponent>(entity, SoftBodyComponent{ std::move(body) });
+    return entity;
+}
+
 void Scene::AddCampfire(const std::string& name, const glm::vec3& position, float scale) {
     AddFire(position, scale);
     glm::vec3 smokePos = position;
@@ -630,10 +816,9 @@ void Scene::AddDust() {
 }
 
 void Scene::SpawnDustCloud() {
-    Entity dustEnt = GetEntityByName("GlobalDustCloud");
-    if (dustEnt == MAX_ENTITIES) return;
+    if (m_DustCloudEntity == MAX_ENTITIES) return;
 
-    auto& dust = m_Registry.GetComponent<DustCloudComponent>(dustEnt);
+    auto& dust = m_Registry.GetComponent<DustCloudComponent>(m_DustCloudEntity);
     if (dust.isActive) return;
 
     std::cout << "Spawning Dust Cloud!" << std::endl;
@@ -657,10 +842,9 @@ void Scene::SpawnDustCloud() {
 }
 
 void Scene::StopDust() {
-    Entity dustEnt = GetEntityByName("GlobalDustCloud");
-    if (dustEnt == MAX_ENTITIES) return;
+    if (m_DustCloudEntity == MAX_ENTITIES) return;
 
-    auto& dust = m_Registry.GetComponent<DustCloudComponent>(dustEnt);
+    auto& dust = m_Registry.GetComponent<DustCloudComponent>(m_DustCloudEntity);
 
     if (dust.isActive && dust.emitterId != -1) {
         GetOrCreateSystem(ParticleLibrary::GetDustStormProps())->StopEmitter(dust.emitterId);
@@ -692,6 +876,7 @@ void Scene::SetObjectOrbit(const std::string& name, const glm::vec3& center, flo
         const glm::quat rotation = glm::angleAxis(orbit.initialAngle, orbit.axis);
         transform.position = orbit.center + (rotation * orbit.startVector);
         transform.UpdateMatrix();
+        m_Registry.MarkChanged<TransformComponent>(e);
     }
 }
 
@@ -699,6 +884,39 @@ void Scene::SetLightOrbit(const std::string& name, const glm::vec3& center, floa
     SetObjectOrbit(name, center, radius, speedRadPerSec, axis, startVector, initialAngleRad);
 }
 
+bool Scene::SetParent(Entity child, Entity parent) {
+    if (child == MAX_ENTITIES || !m_Registry.HasComponent<TransformComponent>(child)) return false;
+
+    if (parent == MAX_ENTITIES) {
+        if (m_Registry.HasComponent<HierarchyComponent>(child)) {
+            m_Registry.RemoveComponent<HierarchyComponent>(child);
+            // The stored pos/rot/scale were local, so the matrix falls back to them
+            m_Registry.GetComponent<TransformComponent>(child).UpdateMatrix();
+            m_Registry.MarkChanged<TransformComponent>(child);
+        }
+        return true;
+    }
+
+    if (!m_Registry.HasComponent<TransformComponent>(parent)) return false;
+
+    // Walk up from the new parent; reaching the child means the link would close a loop
+    for (Entity e = parent; e != MAX_ENTITIES; e = GetParent(e)) {
+        if (e == child) {
+            std::cerr << "Warning: SetParent would create a cycle, ignored." << std::endl;
+            return false;
+        }
+    }
+
+    m_Registry.AddComponent<HierarchyComponent>(child, HierarchyComponent{ parent });
+    m_Registry.MarkChanged<TransformComponent>(child);
+    return true;
+}
+
+Entity Scene::GetParent(Entity child) const {
+    const auto* link = m_Registry.TryGetComponent<HierarchyComponent>(child);
+    return link ? link->parent : MAX_ENTITIES;
+}
+
 void Scene::SetOrbitSpeed(const std::string& name, float speedRadPerSec) {
     Entity e = GetEntityByName(name);
     if (e != MAX_ENTITIES && m_Registry.HasComponent<OrbitComponent>(e)) {
@@ -751,9 +969,12 @@ void Scene::ClearProceduralRegistry() {
 }
 
 void Scene::Update(float deltaTime) {
-    for (auto& sys : m_Systems) {
-        sys->Update(*this, deltaTime);
-    }
+    // Everything written during this update is stamped with a fresh change tick
+    m_Registry.AdvanceChangeTick();
+    m_Scheduler.Run(*this, deltaTime, m_Systems);
+
+    // Children follow whatever the systems did to their parents this frame
+    m_Hierarchy.Propagate<TransformComponent>(m_Registry);
 }
 
 std::vector<Light> Scene::GetLights() const {
@@ -797,22 +1018,27 @@ void Scene::Clear() {
         m_Registry.DestroyEntity(i);
     }
 
-    m_EntityMap.clear();
+    m_EntityBySymbol.clear();
+    m_SunEntity = MAX_ENTITIES;
     m_RenderableEntities.clear();
     m_LightEntities.clear();
     particleSystems.clear();
+    m_FluidParticles = nullptr;
+    m_Fluid.Clear();
+    m_ContactEvents.clear();
+    m_ModelCache.clear();
+    m_Snapshot.reset();
+    m_Hierarchy.Invalidate();
 
     // 1. Recreate Environment Entity
     m_EnvironmentEntity = m_Registry.CreateEntity();
-    m_Registry.AddComponent<NameComponent>(m_EnvironmentEntity, { "GlobalEnvironment" });
+    RegisterEntityName(m_EnvironmentEntity, "GlobalEnvironment");
     m_Registry.AddComponent<EnvironmentComponent>(m_EnvironmentEntity, EnvironmentComponent{});
-    m_EntityMap["GlobalEnvironment"] = m_EnvironmentEntity;
 
     // 2. Recreate Dust Cloud Entity
-    Entity dustEntity = m_Registry.CreateEntity();
-    m_Registry.AddComponent<NameComponent>(dustEntity, { "GlobalDustCloud" });
-    m_Registry.AddComponent<DustCloudComponent>(dustEntity, DustCloudComponent{});
-    m_EntityMap["GlobalDustCloud"] = dustEntity;
+    m_DustCloudEntity = m_Registry.CreateEntity();
+    RegisterEntityName(m_DustCloudEntity, "GlobalDustCloud");
+    m_Registry.AddComponent<DustCloudComponent>(m_DustCloudEntity, DustCloudComponent{});
 }
 
 void Scene::SetObjectTransform(const std::string& name, const glm::vec3& pos, const glm::vec3& rot, const glm::vec3& scale) {
@@ -823,6 +1049,7 @@ void Scene::SetObjectTransform(const std::string& name, const glm::vec3& pos, co
         comp.rotation = rot;
         comp.scale = scale;
         comp.UpdateMatrix();
+        m_Registry.MarkChanged<TransformComponent>(e);
     }
 }
 
@@ -830,6 +1057,7 @@ void Scene::SetObjectLayerMask(const std::string& name, int mask) {
     Entity e = GetEntityByName(name);
     if (e != MAX_ENTITIES && m_Registry.HasComponent<RenderComponent>(e)) {
         m_Registry.GetComponent<RenderComponent>(e).layerMask = mask;
+        m_Registry.MarkChanged<RenderComponent>(e);
     }
 }
 
@@ -844,6 +1072,7 @@ void Scene::SetObjectVisible(const std::string& name, bool visible) {
     Entity e = GetEntityByName(name);
     if (e != MAX_ENTITIES && m_Registry.HasComponent<RenderComponent>(e)) {
         m_Registry.GetComponent<RenderComponent>(e).visible = visible;
+        m_Registry.MarkChanged<RenderComponent>(e);
     }
 }
 
@@ -853,6 +1082,7 @@ void Scene::SetObjectCastsShadow(const std::string& name, bool casts) {
         auto& render = m_Registry.GetComponent<RenderComponent>(e);
         render.castsShadow = casts;
         render.originalCastsShadow = casts;
+        m_Registry.MarkChanged<RenderComponent>(e);
     }
 }
 
@@ -860,6 +1090,7 @@ void Scene::SetObjectReceivesShadows(const std::string& name, bool receives) {
     Entity e = GetEntityByName(name);
     if (e != MAX_ENTITIES && m_Registry.HasComponent<RenderComponent>(e)) {
         m_Registry.GetComponent<RenderComponent>(e).receiveShadows = receives;
+        m_Registry.MarkChanged<RenderComponent>(e);
     }
 }
 
@@ -867,6 +1098,7 @@ void Scene::SetObjectShadingMode(const std::string& name, int mode) {
     Entity e = GetEntityByName(name);
     if (e != MAX_ENTITIES && m_Registry.HasComponent<RenderComponent>(e)) {
         m_Registry.GetComponent<RenderComponent>(e).shadingMode = mode;
+        m_Registry.MarkChanged<RenderComponent>(e);
     }
 }
 
@@ -934,9 +1166,8 @@ const TimeConfig& Scene::GetTimeConfig() const {
 }
 
 bool Scene::IsDustActive() const {
-    Entity e = GetEntityByName("GlobalDustCloud");
-    if (e != MAX_ENTITIES)
-        return m_Registry.GetComponent<DustCloudComponent>(e).isActive;
+    if (m_DustCloudEntity != MAX_ENTITIES)
+        return m_Registry.GetComponent<DustCloudComponent>(m_DustCloudEntity).isActive;
     return false;
 }
 
@@ -952,6 +1183,7 @@ void Scene::ResetEnvironment() {
                 const glm::vec3 offset = rotation * orbit.startVector;
                 transform.position = orbit.center + offset;
                 transform.UpdateMatrix();
+                m_Registry.MarkChanged<TransformComponent>(e);
             }
         }
 
@@ -981,6 +1213,10 @@ void Scene::ResetEnvironment() {
                 thermo.burnTimer = 0.0f;
                 thermo.regrowTimer = 0.0f;
                 thermo.burnFactor = 0.0f;
+
+                m_Registry.MarkChanged<TransformComponent>(e);
+                m_Registry.MarkChanged<RenderComponent>(e);
+                m_Registry.MarkChanged<ThermoComponent>(e);
             }
         }
     }
@@ -996,11 +1232,70 @@ void Scene::ResetEnvironment() {
     }
 }
 
+void Scene::SaveSnapshot() {
+    auto snapshot = std::make_unique<SceneSnapshot>();
+    snapshot->registry = m_Registry.SaveSnapshot();
+    snapshot->fluid = m_Fluid.SaveState();
+    snapshot->entityBySymbol = m_EntityBySymbol;
+    snapshot->renderableEntities = m_RenderableEntities;
+    snapshot->lightEntities = m_LightEntities;
+    snapshot->environmentEntity = m_EnvironmentEntity;
+    snapshot->sunEntity = m_SunEntity;
+    snapshot->dustCloudEntity = m_DustCloudEntity;
+    m_Snapshot = std::move(snapshot);
+}
+
+bool Scene::RestoreSnapshot() {
+    if (!m_Snapshot) return false;
+
+    // 1. Emitter IDs in the live thermo state are about to be overwritten, so stop those fires first
+    auto liveThermo = m_Registry.View<ThermoComponent>();
+    for (Entity e : liveThermo) {
+        StopObjectFire(e);
+    }
+
+    // 2. Cameras are the user's view rather than simulation state, so they keep their current pose
+    std::vector<std::tuple<Entity, TransformComponent, CameraComponent>> cameras;
+    auto cameraView = m_Registry.View<CameraComponent, TransformComponent>();
+    for (Entity e : cameraView) {
+        cameras.emplace_back(e, cameraView.Get<TransformComponent>(e), cameraView.Get<CameraComponent>(e));
+    }
+
+    // 3. Swap the simulation state back in
+    m_Registry.RestoreSnapshot(m_Snapshot->registry);
+    m_EntityBySymbol = m_Snapshot->entityBySymbol;
+    m_RenderableEntities = m_Snapshot->renderableEntities;
+    m_LightEntities = m_Snapshot->lightEntities;
+    m_EnvironmentEntity = m_Snapshot->environmentEntity;
+    m_SunEntity = m_Snapshot->sunEntity;
+    m_DustCloudEntity = m_Snapshot->dustCloudEntity;
+    m_Hierarchy.Invalidate();
+
+    // Fluid particles live outside the registry. An empty one is cleared so its last frame is not left drawn.
+    if (m_Snapshot->fluid.posX.empty()) ClearFluid();
+    else m_Fluid.RestoreState(m_Snapshot->fluid);
+
+    for (const auto& [e, transform, camera] : cameras) {
+        if (!m_Registry.HasComponent<CameraComponent>(e) || !m_Registry.HasComponent<TransformComponent>(e)) continue;
+        m_Registry.GetComponent<TransformComponent>(e) = transform;
+        m_Registry.GetComponent<CameraComponent>(e) = camera;
+    }
+
+    // 4. Relight anything that was burning when the snapshot was taken
+    auto view = m_Registry.View<ThermoComponent, TransformComponent>();
+    for (Entity e : view) {
+        auto& thermo = view.Get<ThermoComponent>(e);
+        const glm::vec3 pos = glm::vec3(view.Get<TransformComponent>(e).matrix[3]);
+        if (thermo.fireEmitterId != -1) thermo.fireEmitterId = AddFire(pos, 0.1f);
+        if (thermo.smokeEmitterId != -1) thermo.smokeEmitterId = AddSmoke(pos, 0.1f);
+    }
+
+    return true;
+}
+
 Entity Scene::CreateCameraEntity(const std::string& name, const glm::vec3& pos, const std::string& type) {
     Entity entity = m_Registry.CreateEntity();
-    m_EntityMap[name] = entity;
-
-    m_Registry.AddComponent<NameComponent>(entity, { name });
+    RegisterEntityName(entity, name);
 
     TransformComponent transform;
     transform.position = pos;
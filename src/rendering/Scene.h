@@ -15,9 +15,14 @@
 // ECS Includes
 #include "../core/CoreTypes.h"
 #include "../core/ECS.h"
+#include "../core/SymbolTable.h"
 #include "../core/Components.h"
+#include "../core/TransformHierarchy.h"
 #include <unordered_map>
 #include "../systems/ISystem.h"
+#include "../systems/SystemScheduler.h"
+#include "../../SimulationStaticLib/SphFluid.h"
+#include "../../SimulationStaticLib/ContactEvents.h"
 
 struct TerrainConfig {
     bool exists = false;
@@ -25,6 +30,10 @@ struct TerrainConfig {
     float heightScale = 1.0f;
     float noiseFreq = 0.01f;
     glm::vec3 position = glm::vec3(0.0f);
+    std::shared_ptr<const Heightfield> heightfield; // Baked once by AddTerrain, also the terrain's collider
+
+    // Terrain height at local (x, z): bilinear from the heightfield when baked, the noise function otherwise
+    float HeightAt(float x, float z) const;
 };
 
 struct ProceduralObjectConfig {
@@ -45,7 +54,12 @@ public:
     Scene(const Scene&) = delete;
     Scene& operator=(const Scene&) = delete;
 
+    // Name lookups hash the string once to find its symbol; callers that look an entity up
+    // repeatedly should keep the symbol (InternName) or the entity handle instead
     Entity GetEntityByName(const std::string& name) const;
+    Entity GetEntityBySymbol(Symbol symbol) const;
+    Symbol InternName(const std::string& name) { return m_Symbols.Intern(name); }
+    const std::string& GetSymbolName(Symbol symbol) const { return m_Symbols.Name(symbol); }
 
     void Initialize();
 
@@ -66,6 +80,11 @@ public:
     void SetObjectOrbit(const std::string& name, const glm::vec3& center, float radius, float speedRadPerSec, const glm::vec3& axis, const glm::vec3& startVector, float initialAngleRad = 0.0f);
     void SetLightOrbit(const std::string& name, const glm::vec3& center, float radius, float speedRadPerSec, const glm::vec3& axis, const glm::vec3& startVector, float initialAngleRad = 0.0f);
 
+    // Parents an entity: its Transform position/rotation/scale become local to the parent and its world
+    // matrix follows the parent after every Update. MAX_ENTITIES detaches. Refuses to create a cycle.
+    bool SetParent(Entity child, Entity parent);
+    Entity GetParent(Entity child) const;
+
     void AddBowl(const std::string& name, float radius, int slices, int stacks, const glm::vec3& position, const std::string& texturePath);
     void AddPedestal(const std::string& name, float topRadius, float baseWidth, float height, const glm::vec3& position, const std::string& texturePath);
 
@@ -102,6 +121,15 @@ public:
     void Update(float deltaTime);
     void ResetEnvironment();
 
+    // Single-slot snapshot of the simulation state (registry, SPH fluid and entity bookkeeping) for rewind
+    // and A/B runs. Particle systems are not captured; fires are relit from the restored thermo state.
+    // Neither are PhysicsSystem's caches: the warm-start impulses and touching pairs carry over from the
+    // live run, so the first step after a restore may warm-start a pair from a stale impulse (which its
+    // iterations correct) and report begin / end events against the pairs touching before it.
+    void SaveSnapshot();
+    bool RestoreSnapshot();
+    bool HasSnapshot() const { return m_Snapshot != nullptr; }
+
     void ToggleGlobalShadingMode();
 
     void AddSimpleShadow(const std::string& objectName, float radius);
@@ -120,11 +148,16 @@ public:
     // --- ECS Data Accessors ---
     const Registry& GetRegistry() const { return m_Registry; }
     Registry& GetRegistry() { return m_Registry; }
+    const SystemScheduler& GetScheduler() const { return m_Scheduler; }
+    const TransformHierarchy& GetHierarchy() const { return m_Hierarchy; }
     const std::vector<Entity>& GetRenderableEntities() const { return m_RenderableEntities; }
 
+    // Singleton handles, resolved when the entities are created
     Entity GetEnvironmentEntity() const { return m_EnvironmentEntity; }
+    Entity GetSunEntity() const { return m_SunEntity; }
+    Entity GetDustCloudEntity() const { return m_DustCloudEntity; }
 
-    ParticleSystem* GetOrCreateSystem(const ParticleProps& props);
+    ParticleSystem* GetOrCreateSystem(const ParticleProps& props, uint32_t externalCapacity = 0);
 
     std::shared_ptr<Geometry> dustGeometryPrototype;
     std::string sootTexturePath = "textures/soot.jpg";
@@ -166,20 +199,70 @@ public:
 
     void SetObjectPhysics(const std::string& name, bool isStatic, float mass);
     void SpawnPhysicsBall(const glm::vec3& pos, const glm::vec3& velocity);
+    // A heavy core with count small balls on circular orbits in a disk around it, for mutual gravity. Orbit
+    // speeds are set from the mass inside each ball's radius, so the disk starts close to equilibrium.
+    void SpawnGravityCluster(const glm::vec3& center, int count, float radius, float coreMass);
 
 	void SetObjectCollider(const std::string& name, int type, float radius, const glm::vec3& normal);
 
+    // SPH fluid: particles live in the solver's arrays rather than the registry, are stepped by FluidSystem
+    // and drawn as instances of one particle system. Not part of snapshots, like the other particles.
+    static constexpr uint32_t MAX_FLUID_PARTICLES = 131072;
+    size_t SpawnFluidBlock(const glm::vec3& center, const glm::vec3& halfExtents, const glm::vec3& velocity = glm::vec3(0.0f));
+    void ClearFluid();
+    SphFluid& GetFluid() { return m_Fluid; }
+    const SphFluid& GetFluid() const { return m_Fluid; }
+    ParticleSystem* GetFluidParticleSystem() const { return m_FluidParticles; }
+
+    // Deformables stepped by ClothSystem. They simulate in world space, so the entity keeps an identity transform
+    // and the geometry is rewritten every frame. A cloth of columns x rows vertices hangs down from topCenter,
+    // optionally pinned along its top edge; a soft ball keeps its volume and can be inflated through its settings.
+    Entity AddCloth(const std::string& name, const glm::vec3& topCenter, float width, float height, int columns, int rows,
+        bool pinTopEdge = true, const std::string& texturePath = "");
+    Entity AddSoftBall(const std::string& name, const glm::vec3& center, float radius, int stacks = 16, int slices = 32,
+        const std::string& texturePath = "");
+
+    // Collisions of the last physics frame, one event per touching body pair: Begin on the frame two bodies first
+    // touch, Persist while they stay in contact, End on the first frame they are apart. Sorted by pair.
+    // Published by PhysicsSystem, so systems that run after it see this frame's contacts and the rest the last one's.
+    const std::vector<ContactEvent>& GetContactEvents() const { return m_ContactEvents; }
+    void PublishContactEvents(const std::vector<ContactEvent>& events) { m_ContactEvents.assign(events.begin(), events.end()); }
+
+    // Nearest visible object whose mesh the ray hits from the front, tested against each geometry's BVH in
+    // its local space. MAX_ENTITIES when nothing is hit within maxDistance.
+    Entity Raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, float* hitDistance = nullptr) const;
+
 private:
     Registry m_Registry;
     std::vector<std::unique_ptr<ISystem>> m_Systems;
-    std::unordered_map<std::string, Entity> m_EntityMap;
+    SystemScheduler m_Scheduler;
+    TransformHierarchy m_Hierarchy;
+    SymbolTable m_Symbols;
+    std::vector<Entity> m_EntityBySymbol; // Indexed by name symbol; MAX_ENTITIES where unused
     std::vector<Entity> m_RenderableEntities;
     std::vector<Entity> m_LightEntities;
 
     // The singleton entity tracking global environment configurations
     Entity m_EnvironmentEntity = MAX_ENTITIES;
-
+    Entity m_SunEntity = MAX_ENTITIES;
+    Entity m_DustCloudEntity = MAX_ENTITIES;
+
+    struct SceneSnapshot {
+        RegistrySnapshot registry;
+        SphFluid::State fluid;
+        std::vector<Entity> entityBySymbol;
+        std::vector<Entity> renderableEntities;
+        std::vector<Entity> lightEntities;
+        Entity environmentEntity = MAX_ENTITIES;
+        Entity sunEntity = MAX_ENTITIES;
+        Entity dustCloudEntity = MAX_ENTITIES;
+    };
+    std::unique_ptr<SceneSnapshot> m_Snapshot;
+
+    // Interns the name, maps it to the entity and adds the NameComponent (plus tags for well-known singletons)
+    void RegisterEntityName(Entity entity, const std::string& name);
     Entity AddObjectInternal(const std::string& name, std::shared_ptr<Geometry> geometry, const glm::vec3& position, const std::string& texturePath, bool isFlammable);
+    Entity AddSoftBodyInternal(const std::string& name, std::shared_ptr<Geometry> geometry, std::shared_ptr<XpbdBody> body, const std::string& texturePath);
     void CreateSimpleShadowEntity(Entity targetEntity);
 
 
@@ -192,6 +275,9 @@ private:
     TerrainConfig m_TerrainConfig;
     std::vector<ProceduralObjectConfig> proceduralRegistry;
 
+    // Loaded models by path, so every instance shares one geometry and its BVH
+    std::unordered_map<std::string, std::shared_ptr<Geometry>> m_ModelCache;
+
     VkDevice device;
     VkPhysicalDevice physicalDevice;
 
@@ -203,4 +289,9 @@ private:
     uint32_t framesInFlight = 2;
 
     std::vector<std::unique_ptr<ParticleSystem>> particleSystems;
+
+    SphFluid m_Fluid;
+    ParticleSystem* m_FluidParticles = nullptr; // Owned by particleSystems
+
+    std::vector<ContactEvent> m_ContactEvents;
 };
\ No newline at end of file
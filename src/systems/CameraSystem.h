@@ -4,4 +4,6 @@
 class CameraSystem : public ISystem {
 public:
     void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Camera"; }
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "ClothSystem.h"
+#include "ParticleColliderGather.h"
+#include "../core/Components.h"
+#include "../core/JobSystem.h"
+#include "../rendering/Scene.h"
+#include <algorithm>
+#include <chrono>
+
+// Default settings
+bool ClothSystem::enabled = true;
+float ClothSystem::maxFrameTime = 1.0f / 30.0f;
+ClothStats ClothSystem::lastStats;
+
+void ClothSystem::DeclareAccess(SystemAccess& access) const {
+    // The geometry behind the RenderComponent is rewritten, so it counts as a write
+    access.Reads<TransformComponent, ColliderComponent, PhysicsComponent>()
+        .Writes<SoftBodyComponent, RenderComponent>();
+}
+
+void ClothSystem::Update(Scene& scene, float deltaTime) {
+    Registry& registry = scene.GetRegistry();
+    const float dt = std::min(deltaTime, maxFrameTime);
+    auto parallelFor = [](size_t count, size_t minBatch, auto&& fn) { JobSystem::Get().ParallelFor(count, minBatch, fn); };
+
+    ClothStats stats;
+    auto view = registry.View<SoftBodyComponent, RenderComponent>();
+    for (Entity e : view) {
+        auto& softBody = view.Get<SoftBodyComponent>(e);
+        const std::shared_ptr<Geometry>& geometry = view.Get<RenderComponent>(e).geometry;
+        if (!softBody.body || softBody.body->Empty() || !geometry || !geometry->IsDynamic()) continue;
+        XpbdBody& body = *softBody.body;
+
+        stats.bodies++;
+        stats.particles += body.ParticleCount();
+        stats.constraints += body.StretchCount() + body.BendCount();
+        stats.batches += body.BatchCount();
+        if (!enabled || !(dt > 0.0f)) continue;
+
+        // Only colliders a particle can reach this frame are tested
+        glm::vec3 lo, hi;
+        body.Bounds(lo, hi);
+        const glm::vec3 margin(body.Settings().maxSpeed * dt + body.Settings().thickness);
+        GatherParticleColliders(registry, lo - margin, hi + margin, m_Colliders);
+        stats.colliders += m_Colliders.Count();
+
+        const auto start = std::chrono::steady_clock::now();
+        body.Step(dt, m_Colliders, parallelFor);
+        softBody.stepTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        stats.stepTimeMs += softBody.stepTimeMs;
+
+        WriteVertices(body, *geometry);
+        geometry->UploadVertices();
+        geometry->InvalidateBVH(); // Picking rebuilds it on demand from the moved vertices
+    }
+    lastStats = stats;
+}
+
+void ClothSystem::WriteVertices(const XpbdBody& body, Geometry& geometry) {
+    const size_t count = std::min(body.VertexCount(), geometry.VertexCount());
+    JobSystem::Get().ParallelFor(count, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Vertex& vertex = geometry.GetVertex(i);
+            vertex.pos = body.VertexPosition(i);
+            vertex.normal = body.VertexNormal(i);
+        }
+    });
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "ISystem.h"
+#include "../../SimulationStaticLib/XpbdBody.h"
+
+class Geometry;
+
+struct ClothStats {
+    size_t bodies = 0;
+    size_t particles = 0;
+    size_t constraints = 0; // Stretch and bending
+    size_t batches = 0;     // Colour batches over all bodies, each solved in parallel
+    float stepTimeMs = 0.0f;
+    size_t colliders = 0;   // Collider tests summed over bodies
+};
+
+// Steps every SoftBodyComponent's XPBD body against the sphere, plane and heightfield colliders around it,
+// then writes the particles back into the entity's dynamic geometry. Deformables do not push on the
+// colliders, nor on each other.
+class ClothSystem : public ISystem {
+public:
+    static bool enabled;
+    static float maxFrameTime; // Longer frames are simulated as this, so a hitch slows the cloth instead of blowing it up
+    static ClothStats lastStats;
+
+    void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Cloth"; }
+
+private:
+    static void WriteVertices(const XpbdBody& body, Geometry& geometry);
+
+    ParticleColliders m_Colliders;
+};
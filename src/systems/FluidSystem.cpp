@@ -0,0 +1,99 @@
+#include "FluidSystem.h"
+#include "ParticleColliderGather.h"
+#include "../core/Components.h"
+#include "../core/JobSystem.h"
+#include "../rendering/Scene.h"
+#include "../rendering/ParticleLibrary.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// Default settings
+bool FluidSystem::enabled = true;
+SphSettings FluidSystem::settings;
+int FluidSystem::maxSubsteps = 8;
+FluidStats FluidSystem::lastStats;
+
+namespace {
+    // Speed at which a particle is drawn fully in the props' end (foam) colour
+    constexpr float FOAM_SPEED = 6.0f;
+
+    struct JobParallelFor {
+        template <typename Fn>
+        void operator()(size_t count, size_t minBatch, Fn&& fn) const {
+            JobSystem::Get().ParallelFor(count, minBatch, fn);
+        }
+    };
+}
+
+void FluidSystem::DeclareAccess(SystemAccess& access) const {
+    // The particles and their particle system are Scene state; colliders are only read
+    access.Reads<TransformComponent, ColliderComponent, PhysicsComponent>()
+        .WritesScene();
+}
+
+void FluidSystem::Update(Scene& scene, float deltaTime) {
+    SphFluid& fluid = scene.GetFluid();
+    lastStats.particles = fluid.Size();
+    if (fluid.Empty()) {
+        lastStats.substeps = 0;
+        return;
+    }
+
+    if (enabled && deltaTime > 0.0f) {
+        // Settings are edited live from the UI; reconfiguring only recomputes the kernel constants
+        fluid.Configure(settings);
+
+        const float maxStep = fluid.MaxTimeStep();
+        const int steps = std::clamp(static_cast<int>(std::ceil(deltaTime / maxStep)), 1, std::max(maxSubsteps, 1));
+        const float dt = std::min(deltaTime / static_cast<float>(steps), maxStep);
+
+        // Only colliders the fluid can reach before the frame ends are tested
+        glm::vec3 lo, hi;
+        fluid.Bounds(lo, hi);
+        const glm::vec3 margin(settings.maxSpeed * dt * static_cast<float>(steps) + fluid.SmoothingRadius());
+        GatherParticleColliders(scene.GetRegistry(), lo - margin, hi + margin, m_Colliders);
+
+        uint64_t neighbours = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < steps; ++i) {
+            fluid.Step(dt, m_Colliders, JobParallelFor{});
+            neighbours += fluid.LastNeighbourCount();
+        }
+        const float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+        lastStats.substeps = steps;
+        lastStats.stepTimeMs = seconds * 1000.0f;
+        lastStats.neighboursPerParticle = static_cast<float>(neighbours) / static_cast<float>(fluid.Size() * steps);
+        lastStats.neighboursPerSecond = (seconds > 0.0f) ? static_cast<double>(neighbours) / seconds : 0.0;
+        lastStats.colliders = m_Colliders.Count();
+    }
+    else {
+        lastStats.substeps = 0;
+    }
+
+    if (ParticleSystem* particles = scene.GetFluidParticleSystem()) {
+        SubmitInstances(fluid, *particles);
+    }
+}
+
+void FluidSystem::SubmitInstances(const SphFluid& fluid, ParticleSystem& particles) {
+    const ParticleProps& props = ParticleLibrary::GetFluidProps();
+    const float size = props.sizeBegin * fluid.Settings().particleSpacing / SphSettings{}.particleSpacing;
+    const float invFoamSpeed2 = 1.0f / (FOAM_SPEED * FOAM_SPEED);
+
+    const size_t count = std::min<size_t>(fluid.Size(), Scene::MAX_FLUID_PARTICLES);
+    m_Instances.resize(count);
+    JobSystem::Get().ParallelFor(count, 2048, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const glm::vec3 v = fluid.Velocity(i);
+            const float foam = std::min(glm::dot(v, v) * invFoamSpeed2, 1.0f);
+
+            ParticleSystem::InstanceData& data = m_Instances[i];
+            data.position = glm::vec4(fluid.Position(i), 1.0f);
+            data.color = glm::mix(props.colorBegin, props.colorEnd, foam);
+            data.size = glm::vec4(size, 0.0f, 0.0f, 0.0f);
+        }
+    });
+    particles.SubmitInstances(m_Instances);
+}
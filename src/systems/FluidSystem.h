@@ -0,0 +1,34 @@
+#pragma once
+#include "ISystem.h"
+#include "../rendering/ParticleSystem.h"
+#include "../../SimulationStaticLib/SphFluid.h"
+#include <vector>
+
+struct FluidStats {
+    size_t particles = 0;
+    int substeps = 0;
+    float stepTimeMs = 0.0f;          // Wall time of all substeps this frame
+    float neighboursPerParticle = 0.0f;
+    double neighboursPerSecond = 0.0;  // Neighbour pairs visited by the density pass per second of step time
+    size_t colliders = 0;              // Colliders near enough to the fluid to be tested this frame
+};
+
+// Steps the scene's SPH fluid and hands the particles to its particle system as instances.
+// Fluid particles bounce off sphere, plane and heightfield colliders but do not push back on them.
+class FluidSystem : public ISystem {
+public:
+    static bool enabled;
+    static SphSettings settings;
+    static int maxSubsteps; // Beyond this the fluid runs slower than real time rather than unstable
+    static FluidStats lastStats;
+
+    void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Fluid"; }
+
+private:
+    void SubmitInstances(const SphFluid& fluid, ParticleSystem& particles);
+
+    ParticleColliders m_Colliders;
+    std::vector<ParticleSystem::InstanceData> m_Instances;
+};
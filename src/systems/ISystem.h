@@ -1,9 +1,75 @@
 #pragma once
 
 #include "../core/ECS.h"
+#include <algorithm>
+#include <vector>
 
 class Scene;
 
+// Component (and shared Scene state) access declared by a system.
+// The scheduler orders two systems only when their declarations conflict.
+class SystemAccess {
+public:
+    template <typename... Ts>
+    SystemAccess& Reads() {
+        (Add<Ts>(reads), ...);
+        return *this;
+    }
+
+    template <typename... Ts>
+    SystemAccess& Writes() {
+        (Add<Ts>(writes), ...);
+        return *this;
+    }
+
+    // Scene-owned state outside the registry: entity name map, particle systems, light list, weather emitters,
+    // published contact events
+    SystemAccess& ReadsScene() { sceneRead = true; return *this; }
+    SystemAccess& WritesScene() { sceneWrite = true; return *this; }
+
+    // Conflicts with every other system (the default for systems that declare nothing)
+    SystemAccess& Exclusive() { exclusive = true; return *this; }
+
+    bool ConflictsWith(const SystemAccess& other) const {
+        if (exclusive || other.exclusive) return true;
+        if ((sceneWrite && (other.sceneRead || other.sceneWrite)) || (other.sceneWrite && sceneRead)) return true;
+        return Overlaps(writes, other.writes) || Overlaps(writes, other.reads) || Overlaps(reads, other.writes);
+    }
+
+    // Lazily created pools are created up front, so concurrent systems never race on pool creation
+    void CreatePools(Registry& registry) const {
+        for (auto create : poolCreators) create(registry);
+    }
+
+    void Clear() {
+        reads.clear();
+        writes.clear();
+        poolCreators.clear();
+        sceneRead = sceneWrite = exclusive = false;
+    }
+
+private:
+    template <typename T>
+    void Add(std::vector<size_t>& list) {
+        list.push_back(ComponentFamily::Id<T>());
+        poolCreators.push_back([](Registry& registry) { registry.RegisterComponent<T>(); });
+    }
+
+    static bool Overlaps(const std::vector<size_t>& a, const std::vector<size_t>& b) {
+        for (size_t id : a) {
+            if (std::find(b.begin(), b.end(), id) != b.end()) return true;
+        }
+        return false;
+    }
+
+    std::vector<size_t> reads;
+    std::vector<size_t> writes;
+    std::vector<void(*)(Registry&)> poolCreators;
+    bool sceneRead = false;
+    bool sceneWrite = false;
+    bool exclusive = false;
+};
+
 // Base interface for all ECS Systems
 class ISystem {
 public:
@@ -11,4 +77,9 @@ public:
 
     // Every system takes the registry and the delta time
     virtual void Update(Scene& scene, float deltaTime) = 0;
-};
\ No newline at end of file
+
+    // Systems that do not override this run alone, in registration order
+    virtual void DeclareAccess(SystemAccess& access) const { access.Exclusive(); }
+
+    virtual const char* GetName() const { return "System"; }
+};
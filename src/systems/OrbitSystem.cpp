@@ -2,24 +2,22 @@
 #include "../rendering/Scene.h"
 #include <glm/gtc/quaternion.hpp>
 
+void OrbitSystem::DeclareAccess(SystemAccess& access) const {
+    access.Writes<OrbitComponent, TransformComponent>();
+}
+
 void OrbitSystem::Update(Scene& scene, float deltaTime) {
     Registry& registry = scene.GetRegistry();
 
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        if (!registry.HasComponent<OrbitComponent>(e) || !registry.HasComponent<TransformComponent>(e)) {
-            continue;
-        }
-
-        auto& orbit = registry.GetComponent<OrbitComponent>(e);
+    registry.Each<OrbitComponent, TransformComponent>([&](Entity e, OrbitComponent& orbit, TransformComponent& transform) {
         if (orbit.isOrbiting) {
-            auto& transform = registry.GetComponent<TransformComponent>(e);
-
             orbit.currentAngle += orbit.speed * deltaTime;
             const glm::quat rotation = glm::angleAxis(orbit.currentAngle, orbit.axis);
             glm::vec3 direction = glm::normalize(orbit.startVector);
             const glm::vec3 offset = rotation * direction * orbit.radius;
             transform.position = orbit.center + offset;
             transform.UpdateMatrix();
+            registry.MarkChanged<TransformComponent>(e);
         }
-    }
+    });
 }
\ No newline at end of file
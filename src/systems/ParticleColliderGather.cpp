@@ -0,0 +1,29 @@
+#include "ParticleColliderGather.h"
+#include "../core/Components.h"
+
+void GatherParticleColliders(Registry& registry, const glm::vec3& lo, const glm::vec3& hi, ParticleColliders& colliders) {
+    colliders.Clear();
+
+    auto view = registry.View<ColliderComponent, TransformComponent>();
+    for (Entity e : view) {
+        const auto& collider = view.Get<ColliderComponent>(e);
+        if (!collider.hasCollision) continue;
+        const glm::vec3& position = view.Get<TransformComponent>(e).position;
+
+        if (collider.type == 0) {
+            const glm::vec3 closest = glm::clamp(position, lo, hi);
+            if (glm::dot(closest - position, closest - position) > collider.radius * collider.radius) continue;
+
+            // A moving body drags the particles it hits along with it
+            const auto* physics = registry.TryGetComponent<PhysicsComponent>(e);
+            const glm::vec3 velocity = (physics && !physics->isStatic) ? physics->velocity : glm::vec3(0.0f);
+            colliders.spheres.push_back({ position, collider.radius, velocity });
+        }
+        else if (collider.type == 1) {
+            colliders.planes.emplace_back(position, collider.normal, collider.radius);
+        }
+        else if (collider.type == 2 && collider.heightfield && !collider.heightfield->Empty()) {
+            colliders.heightfields.push_back({ collider.heightfield.get(), position, collider.radius });
+        }
+    }
+}
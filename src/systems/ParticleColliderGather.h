@@ -0,0 +1,9 @@
+#pragma once
+#include "../core/ECS.h"
+#include "../../SimulationStaticLib/ParticleColliders.h"
+#include <glm/glm.hpp>
+
+// Fills colliders with the registry's sphere, plane and heightfield colliders that a particle solver whose
+// particles lie inside [lo, hi] can reach. Meshes (type 3) are left out: a closest-point query per particle
+// per substep costs more than a whole fluid or cloth step of any size.
+void GatherParticleColliders(Registry& registry, const glm::vec3& lo, const glm::vec3& hi, ParticleColliders& colliders);
@@ -2,15 +2,18 @@
 #include "../rendering/Scene.h"
 #include "../rendering/ParticleLibrary.h"
 
+void ParticleUpdateSystem::DeclareAccess(SystemAccess& access) const {
+    // Emitter updates go through the Scene's particle systems; StopDust also resets the environment rain timer
+    access.Reads<TransformComponent, ColliderComponent>()
+        .Writes<DustCloudComponent, AttachedEmitterComponent, EnvironmentComponent>()
+        .WritesScene();
+}
+
 void ParticleUpdateSystem::Update(Scene& scene, float deltaTime) {
     auto& registry = scene.GetRegistry();
 
     // 1. Update ECS-driven particle effects (like the moving Dust Cloud)
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        if (!registry.HasComponent<DustCloudComponent>(e)) continue;
-
-        auto& dust = registry.GetComponent<DustCloudComponent>(e);
-
+    registry.Each<DustCloudComponent>([&](Entity, DustCloudComponent& dust) {
         if (dust.isActive) {
             dust.position += dust.direction * dust.speed * deltaTime;
 
@@ -24,14 +27,13 @@ void ParticleUpdateSystem::Update(Scene& scene, float deltaTime) {
                 scene.StopDust();
             }
         }
-    }
+    });
 
     // --- NEW: Sync Attached Custom Emitters ---
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        if (!registry.HasComponent<AttachedEmitterComponent>(e) || !registry.HasComponent<TransformComponent>(e)) continue;
-
-        auto& attached = registry.GetComponent<AttachedEmitterComponent>(e);
-        auto& transform = registry.GetComponent<TransformComponent>(e);
+    auto attachedView = registry.View<AttachedEmitterComponent, TransformComponent>();
+    for (Entity e : attachedView) {
+        auto& attached = attachedView.Get<AttachedEmitterComponent>(e);
+        auto& transform = attachedView.Get<TransformComponent>(e);
 
         // Iterate backwards or use an iterator so we can safely delete expired emitters
         for (auto it = attached.emitters.begin(); it != attached.emitters.end(); ) {
@@ -56,8 +58,8 @@ void ParticleUpdateSystem::Update(Scene& scene, float deltaTime) {
 
                 // Lock the emitter position to the object's transform
                 props.position = glm::vec3(transform.matrix[3]);
-                if (registry.HasComponent<ColliderComponent>(e)) {
-                    props.position.y += registry.GetComponent<ColliderComponent>(e).height * 0.5f;
+                if (const auto* collider = registry.TryGetComponent<ColliderComponent>(e)) {
+                    props.position.y += collider->height * 0.5f;
                 }
 
                 scene.GetOrCreateSystem(props)->UpdateEmitter(activeEm.emitterId, props, activeEm.emissionRate);
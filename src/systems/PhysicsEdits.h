@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../core/Components.h"
+#include "../core/ECS.h"
+#include <glm/glm.hpp>
+
+// Edits to physics bodies from outside the physics system (the scene's setters, scripts, tools). Each one marks
+// what it wrote as changed: that is how the physics thread learns of an edit to the bodies it mirrors, and a
+// body whose edit it never hears of keeps being simulated, and written back, as it was.
+
+inline void SetBodyPhysics(Registry& registry, Entity e, bool isStatic, float mass) {
+    auto* physics = registry.TryGetComponent<PhysicsComponent>(e);
+    if (!physics) return;
+    physics->isStatic = isStatic;
+    physics->SetMass(mass);
+    registry.MarkChanged<PhysicsComponent>(e);
+}
+
+inline void SetBodyCollision(Registry& registry, Entity e, bool enabled) {
+    auto* collider = registry.TryGetComponent<ColliderComponent>(e);
+    if (!collider) return;
+    collider->hasCollision = enabled;
+    registry.MarkChanged<ColliderComponent>(e);
+}
+
+inline void SetBodyCollider(Registry& registry, Entity e, int type, float radius, const glm::vec3& normal) {
+    auto* collider = registry.TryGetComponent<ColliderComponent>(e);
+    if (!collider) return;
+    collider->type = type;
+    collider->radius = radius;
+    collider->normal = glm::normalize(normal);
+    registry.MarkChanged<ColliderComponent>(e);
+}
+
+inline void SetBodyCollisionSize(Registry& registry, Entity e, float radius, float height) {
+    auto* collider = registry.TryGetComponent<ColliderComponent>(e);
+    if (!collider) return;
+    collider->radius = radius;
+    collider->height = height;
+    registry.MarkChanged<ColliderComponent>(e);
+}
@@ -1,83 +1,502 @@
 #include "PhysicsSystem.h"
+#include "PhysicsThread.h"
 #include "../core/Components.h"
+#include "../core/JobSystem.h"
 #include "../rendering/Scene.h"
 #include "../../SimulationStaticLib/Sphere.h"
 #include "../../SimulationStaticLib/Plane.h"
 #include "../../SimulationStaticLib/PhysicsHelper.h"
+#include "../../SimulationStaticLib/Heightfield.h"
+#include "../../SimulationStaticLib/TriangleBVH.h"
+#include <algorithm>
 
 // Default settings
 int PhysicsSystem::subSteps = 4;
+bool PhysicsSystem::adaptiveSubsteps = true;
+SubstepSettings PhysicsSystem::substepSettings;
 IntegrationMethod PhysicsSystem::currentMethod = IntegrationMethod::SemiImplicitEuler;
 bool PhysicsSystem::applyGravity = true;
+float PhysicsSystem::airDamping = 0.999f;
+bool PhysicsSystem::useSoA = true;
+bool PhysicsSystem::mutualGravity = false;
+GravitySettings PhysicsSystem::gravitySettings;
+bool PhysicsSystem::parallelContacts = true;
+bool PhysicsSystem::useSequentialImpulse = true;
+ContactSolverSettings PhysicsSystem::solverSettings;
+bool PhysicsSystem::continuousCollision = true;
+bool PhysicsSystem::recordContactEvents = true;
+float PhysicsSystem::ccdMotionFraction = 0.5f;
+bool PhysicsSystem::useFixedTimestep = false;
+bool PhysicsSystem::runOnThread = false;
+float PhysicsSystem::fixedRate = 240.0f;
+int PhysicsSystem::maxStepsPerFrame = 8;
+bool PhysicsSystem::allowSleeping = true;
+SleepSettings PhysicsSystem::sleepSettings;
+PhysicsStats PhysicsSystem::lastStats;
+SampleHistory PhysicsSystem::stepHistory;
+
+namespace {
+    const glm::vec3 GRAVITY = glm::vec3(0.0f, -9.81f, 0.0f);
+
+    // Velocity kept per step. Orbits under mutual gravity would spiral in with any drag, so they get none.
+    float AirDamping(const PhysicsSettings& settings, float dt) {
+        return settings.mutualGravity ? 1.0f : std::pow(settings.airDamping, dt * 60.0f);
+    }
+}
+
+void PhysicsSystem::DeclareAccess(SystemAccess& access) const {
+    // The scene receives each frame's contact events
+    access.Reads<ColliderComponent>()
+        .Writes<TransformComponent, PhysicsComponent>()
+        .WritesScene();
+}
+
+PhysicsSystem::PhysicsSystem() = default;
+PhysicsSystem::~PhysicsSystem() = default;
 
 void PhysicsSystem::Update(Scene& scene, float deltaTime) {
     auto& registry = scene.GetRegistry();
 
-    // Calculate the fixed timestep for each substep
+    // 0. Threaded mode: the scene only exchanges edits and results with the physics thread
+    if (runOnThread) {
+        if (!m_Thread) {
+            m_Thread = std::make_unique<PhysicsThread>();
+            m_Clock.Reset();
+            m_ContactEvents.Clear();
+        }
+        m_Thread->Sync(registry);
+        lastStats = m_Thread->GetStats();
+        scene.PublishContactEvents(m_Thread->GetContactEvents().Events());
+        return;
+    }
+    m_Thread.reset();
+
+    Step(registry, deltaTime);
+    scene.PublishContactEvents(m_ContactEvents.Events());
+}
+
+void PhysicsSystem::Step(Registry& registry, float deltaTime) {
+    // 1. Work out how many steps to take, how long each one is, and how many substeps each is split into
+    int steps = subSteps;
     float dt = deltaTime / static_cast<float>(subSteps);
+    float alpha = 1.0f;
+    int substeps = 1;
+    m_Stats.maxMotionRatio = 0.0f;
 
-    // Run the simulation multiple times per frame
-    for (int i = 0; i < subSteps; ++i) {
-        Integrate(registry, dt);
-        ResolveCollisions(registry);
+    if (useFixedTimestep) {
+        // Results no longer depend on the frame rate; past the step cap the simulation slows down instead of spiralling
+        dt = 1.0f / std::max(fixedRate, 1.0f);
+        steps = m_Clock.Advance(deltaTime, dt, maxStepsPerFrame);
+        alpha = m_Clock.Alpha(dt);
+        if (adaptiveSubsteps && steps > 0) {
+            // Fast bodies split every fixed step rather than changing its length, so the rate stays as set
+            m_Stats.maxMotionRatio = MaxMotionRatio(registry, dt);
+            substeps = ChooseSubsteps(m_Stats.maxMotionRatio, substepSettings);
+        }
+    }
+    else {
+        m_Clock.Reset();
+        if (adaptiveSubsteps) {
+            // Quiet scenes take a single substep; fast bodies buy more, up to the configured cap
+            m_Stats.maxMotionRatio = MaxMotionRatio(registry, deltaTime);
+            steps = ChooseSubsteps(m_Stats.maxMotionRatio, substepSettings);
+            dt = deltaTime / static_cast<float>(steps);
+        }
+    }
+
+    Simulate(registry, steps, dt, useFixedTimestep, alpha, substeps);
+    lastStats = m_Stats;
+    stepHistory.Push(static_cast<float>(m_Stats.stepsThisFrame));
+}
+
+float PhysicsSystem::MaxMotionRatio(Registry& registry, float frameTime) const {
+    // Measured on the velocities the frame starts with, over the bodies Simulate will move and collide
+    float ratio = 0.0f;
+    registry.Each<PhysicsComponent, ColliderComponent>([&](Entity, PhysicsComponent& physics, ColliderComponent& collider) {
+        if (physics.isStatic || physics.isSleeping || !collider.hasCollision || collider.type != 0 || collider.radius <= 0.0f) return;
+        ratio = std::max(ratio, glm::length(physics.velocity) * frameTime / collider.radius);
+    });
+    return ratio;
+}
+
+PhysicsSettings PhysicsSystem::CurrentSettings() {
+    PhysicsSettings settings;
+    settings.method = currentMethod;
+    settings.applyGravity = applyGravity;
+    settings.airDamping = airDamping;
+    settings.useSoA = useSoA;
+    settings.mutualGravity = mutualGravity;
+    settings.gravity = gravitySettings;
+    settings.parallelContacts = parallelContacts;
+    settings.useSequentialImpulse = useSequentialImpulse;
+    settings.solver = solverSettings;
+    settings.continuousCollision = continuousCollision;
+    settings.ccdMotionFraction = ccdMotionFraction;
+    settings.recordContactEvents = recordContactEvents;
+    settings.allowSleeping = allowSleeping;
+    settings.sleep = sleepSettings;
+    return settings;
+}
+
+void PhysicsSystem::Simulate(Registry& registry, int steps, float dt, bool interpolate, float alpha, int substeps) {
+    Simulate(registry, CurrentSettings(), steps, dt, interpolate, alpha, substeps);
+}
+
+void PhysicsSystem::Simulate(Registry& registry, const PhysicsSettings& settings, int steps, float dt, bool interpolate, float alpha, int substeps) {
+    substeps = std::max(substeps, 1);
+    const int total = steps * substeps;
+    const float h = dt / static_cast<float>(substeps);
+
+    m_Settings = settings;
+    m_Interpolate = interpolate;
+    m_Stats.stepsThisFrame = total;
+    m_Stats.interpolationAlpha = alpha;
+    m_ContactEvents.BeginStep();
+    m_Stats.contactEvents = 0;
+
+    if (steps == 0) {
+        // Nothing to simulate, but the rendered poses still move on by the new alpha
+        if (interpolate) InterpolateTransforms(registry, alpha);
+        return;
+    }
+
+    // 1. Wake islands that were hit or edited, then collect collidable bodies once per frame,
+    // split into dynamic / static / plane sets (sleeping bodies count as static)
+    WakeIslands(registry);
+    GatherBodies(registry);
+    BuildStaticGrid();
+    if (m_Settings.useSoA) GatherSoA(registry);
+
+    // 2. Run the simulation multiple times per frame
+    m_Contacts.clear();
+    m_Stats.pairsTested = 0;
+    m_Stats.contactsSolved = 0;
+    m_Stats.sweptBodies = 0;
+    m_Stats.sweptHits = 0;
+    m_Stats.gravityNodes = 0;
+    m_Stats.gravityInteractions = 0;
+    for (int i = 0; i < total; ++i) {
+        // Contacts from the last substep decide which bodies share an island,
+        // and the pose before the last whole step is what the renderer interpolates from
+        const bool lastStep = (i == total - 1);
+        m_RecordContacts = SleepingEnabled() && lastStep;
+        if (interpolate && i == total - substeps) StorePreviousPositions(registry);
+        if (m_Settings.continuousCollision) StoreStepStart();
+        if (m_Settings.mutualGravity) ApplyMutualGravity(registry);
+
+        if (m_Settings.useSoA) {
+            IntegrateSoA(h);
+            ResolveCollisions();
+            PullSoA();
+        }
+        else {
+            Integrate(registry, h);
+            ResolveCollisions();
+        }
+    }
+
+    m_RecordContacts = false;
+
+    // Every substep's touches were recorded as they were solved; one event per pair for the whole frame.
+    // Pairs of bodies that are both asleep or static are no longer tested, but stay touching until one wakes.
+    // Turned off, the touching pairs are forgotten so switching back on starts every contact afresh.
+    if (m_Settings.recordContactEvents) {
+        auto resting = [&](Entity e) {
+            const auto* physics = registry.TryGetComponent<PhysicsComponent>(e);
+            return physics && (physics->isStatic || physics->isSleeping);
+        };
+        m_ContactEvents.EndStep([&](uint32_t a, uint32_t b) { return resting(a) && resting(b); });
+    }
+    else {
+        m_ContactEvents.Clear();
+    }
+    m_Stats.contactEvents = m_ContactEvents.Events().size();
+
+    if (m_Settings.useSoA) FinishSoA(registry);
+    UpdateSleep();
+
+    // Contact corrections can move any dynamic body, not just the ones Integrate advanced
+    for (const auto& body : m_DynamicSpheres) {
+        registry.MarkChanged<TransformComponent>(body.entity);
+    }
+
+    if (interpolate) InterpolateTransforms(registry, alpha);
+}
+
+void PhysicsSystem::StorePreviousPositions(Registry& registry) {
+    auto view = registry.View<TransformComponent, PhysicsComponent>();
+    for (Entity e : view) {
+        auto& physics = view.Get<PhysicsComponent>(e);
+        if (physics.isStatic || physics.isSleeping || physics.inverseMass <= 0.0f) continue;
+        physics.previousPosition = view.Get<TransformComponent>(e).position;
+        physics.hasPreviousPosition = true;
+    }
+}
+
+void PhysicsSystem::InterpolateTransforms(Registry& registry, float alpha) {
+    // position stays the simulated state; only the matrix the renderer reads is blended
+    auto view = registry.View<TransformComponent, PhysicsComponent>();
+    for (Entity e : view) {
+        const auto& physics = view.Get<PhysicsComponent>(e);
+        if (physics.isStatic || physics.isSleeping || !physics.hasPreviousPosition || physics.inverseMass <= 0.0f) continue;
+
+        auto& transform = view.Get<TransformComponent>(e);
+        transform.matrix = transform.LocalMatrix();
+        transform.matrix[3] = glm::vec4(glm::mix(physics.previousPosition, transform.position, alpha), 1.0f);
+        registry.MarkChanged<TransformComponent>(e);
     }
 }
 
 void PhysicsSystem::Integrate(Registry& registry, float dt) {
-    for (Entity i = 0; i < registry.GetEntityCount(); ++i) {
-        if (registry.HasComponent<TransformComponent>(i) && registry.HasComponent<PhysicsComponent>(i)) {
+    const float damping = AirDamping(m_Settings, dt);
 
-            auto& transform = registry.GetComponent<TransformComponent>(i);
-            auto& physics = registry.GetComponent<PhysicsComponent>(i);
+    auto view = registry.View<TransformComponent, PhysicsComponent>();
+    for (Entity i : view) {
+        auto& transform = view.Get<TransformComponent>(i);
+        auto& physics = view.Get<PhysicsComponent>(i);
 
-            if (!physics.isStatic && physics.inverseMass > 0.0f) {
+        if (!physics.isStatic && !physics.isSleeping && physics.inverseMass > 0.0f) {
 
-                // 1. Accumulate Forces (Gravity: F = mg)
-                if (applyGravity) {
-                    glm::vec3 gravityForce = glm::vec3(0.0f, -9.81f, 0.0f) * physics.mass;
-                    physics.forceAccumulator += gravityForce;
-                }
+            // 1. Accumulate Forces (Gravity: F = mg; mutual gravity has already added its pull)
+            if (m_Settings.applyGravity && !m_Settings.mutualGravity) {
+                glm::vec3 gravityForce = GRAVITY * physics.mass;
+                physics.forceAccumulator += gravityForce;
+            }
 
-                // 2. Calculate Acceleration (a = F / m)
-                glm::vec3 acceleration = physics.forceAccumulator * physics.inverseMass;
+            // 2. Calculate Acceleration (a = F / m)
+            glm::vec3 acceleration = physics.forceAccumulator * physics.inverseMass;
 
-                // 3. Integration Methods
-                if (currentMethod == IntegrationMethod::ExplicitEuler) {
-                    transform.position += physics.velocity * dt;
-                    physics.velocity += acceleration * dt;
-                }
-                else if (currentMethod == IntegrationMethod::SemiImplicitEuler) {
-                    physics.velocity += acceleration * dt;
-                    transform.position += physics.velocity * dt;
-                }
-                else if (currentMethod == IntegrationMethod::RK4) {
-                    // RK4 Implementation for constant acceleration
-                    glm::vec3 k1_v = acceleration;
-                    glm::vec3 k1_x = physics.velocity;
+            // 3. Integration Methods
+            if (m_Settings.method == IntegrationMethod::ExplicitEuler) {
+                transform.position += physics.velocity * dt;
+                physics.velocity += acceleration * dt;
+            }
+            else if (m_Settings.method == IntegrationMethod::SemiImplicitEuler) {
+                physics.velocity += acceleration * dt;
+                transform.position += physics.velocity * dt;
+            }
+            else if (m_Settings.method == IntegrationMethod::RK4) {
+                // RK4 Implementation for constant acceleration
+                glm::vec3 k1_v = acceleration;
+                glm::vec3 k1_x = physics.velocity;
 
-                    glm::vec3 k2_v = acceleration; // Assuming constant acceleration over dt
-                    glm::vec3 k2_x = physics.velocity + k1_v * (dt * 0.5f);
+                glm::vec3 k2_v = acceleration; // Assuming constant acceleration over dt
+                glm::vec3 k2_x = physics.velocity + k1_v * (dt * 0.5f);
 
-                    glm::vec3 k3_v = acceleration;
-                    glm::vec3 k3_x = physics.velocity + k2_v * (dt * 0.5f);
+                glm::vec3 k3_v = acceleration;
+                glm::vec3 k3_x = physics.velocity + k2_v * (dt * 0.5f);
 
-                    glm::vec3 k4_v = acceleration;
-                    glm::vec3 k4_x = physics.velocity + k3_v * dt;
+                glm::vec3 k4_v = acceleration;
+                glm::vec3 k4_x = physics.velocity + k3_v * dt;
 
-                    physics.velocity += (k1_v + 2.0f * k2_v + 2.0f * k3_v + k4_v) * (dt / 6.0f);
-                    transform.position += (k1_x + 2.0f * k2_x + 2.0f * k3_x + k4_x) * (dt / 6.0f);
-                }
+                physics.velocity += (k1_v + 2.0f * k2_v + 2.0f * k3_v + k4_v) * (dt / 6.0f);
+                transform.position += (k1_x + 2.0f * k2_x + 2.0f * k3_x + k4_x) * (dt / 6.0f);
+            }
+
+            // 4. Clear the accumulator for the next frame
+            physics.forceAccumulator = glm::vec3(0.0f);
+
+            // (Optional: Apply air resistance here)
+            physics.velocity *= damping;
+
+            transform.UpdateMatrix();
+            registry.MarkChanged<TransformComponent>(i);
+        }
+    }
+}
+
+void PhysicsSystem::ApplyMutualGravity(Registry& registry) {
+    // Sources and targets are the same set: the bodies this substep integrates. The pull is added as the force
+    // that gives exactly the tree's acceleration, so the integrators need no changes.
+    m_GravityBodies.clear();
+    m_GravityMass.clear();
+    const float* x;
+    const float* y;
+    const float* z;
+    if (m_Settings.useSoA) {
+        for (const PhysicsComponent* physics : m_BodyPhysics) m_GravityMass.push_back(physics->mass);
+        x = m_Bodies.posX.data();
+        y = m_Bodies.posY.data();
+        z = m_Bodies.posZ.data();
+    }
+    else {
+        m_GravityX.clear();
+        m_GravityY.clear();
+        m_GravityZ.clear();
+        auto view = registry.View<TransformComponent, PhysicsComponent>();
+        for (Entity e : view) {
+            auto& physics = view.Get<PhysicsComponent>(e);
+            if (physics.isStatic || physics.isSleeping || physics.inverseMass <= 0.0f) continue;
+            const glm::vec3& p = view.Get<TransformComponent>(e).position;
+            m_GravityX.push_back(p.x);
+            m_GravityY.push_back(p.y);
+            m_GravityZ.push_back(p.z);
+            m_GravityMass.push_back(physics.mass);
+            m_GravityBodies.push_back(&physics);
+        }
+        x = m_GravityX.data();
+        y = m_GravityY.data();
+        z = m_GravityZ.data();
+    }
+
+    const size_t count = m_GravityMass.size();
+    m_GravityAccelX.resize(count);
+    m_GravityAccelY.resize(count);
+    m_GravityAccelZ.resize(count);
+    auto parallelFor = [](size_t n, size_t minBatch, auto&& fn) { JobSystem::Get().ParallelFor(n, minBatch, fn); };
+    m_GravityTree.Build(x, y, z, m_GravityMass.data(), count, parallelFor);
+    m_GravityTree.SelfAccelerations(m_Settings.gravity, m_GravityAccelX.data(), m_GravityAccelY.data(), m_GravityAccelZ.data(), parallelFor);
+
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 acceleration(m_GravityAccelX[i], m_GravityAccelY[i], m_GravityAccelZ[i]);
+        if (m_Settings.useSoA) {
+            const float mass = 1.0f / m_Bodies.inverseMass[i];
+            m_Bodies.forceX[i] += acceleration.x * mass;
+            m_Bodies.forceY[i] += acceleration.y * mass;
+            m_Bodies.forceZ[i] += acceleration.z * mass;
+        }
+        else {
+            m_GravityBodies[i]->forceAccumulator += acceleration / m_GravityBodies[i]->inverseMass;
+        }
+    }
+
+    m_Stats.gravityNodes = m_GravityTree.NodeCount();
+    m_Stats.gravityInteractions = m_GravityTree.LastInteractionCount();
+}
 
-                // 4. Clear the accumulator for the next frame
-                physics.forceAccumulator = glm::vec3(0.0f);
+void PhysicsSystem::GatherSoA(Registry& registry) {
+    m_Bodies.Clear();
+    m_BodyEntities.clear();
+    m_BodyTransforms.clear();
+    m_BodyPhysics.clear();
+
+    // Same body set as Integrate: anything with physics that is dynamic, awake and has finite mass
+    auto view = registry.View<TransformComponent, PhysicsComponent>();
+    for (Entity e : view) {
+        auto& transform = view.Get<TransformComponent>(e);
+        auto& physics = view.Get<PhysicsComponent>(e);
+        if (physics.isStatic || physics.isSleeping || physics.inverseMass <= 0.0f) continue;
+
+        m_Bodies.Add(transform.position, physics.velocity, physics.forceAccumulator, physics.inverseMass);
+        m_BodyEntities.push_back(e);
+        m_BodyTransforms.push_back(&transform);
+        m_BodyPhysics.push_back(&physics);
+    }
+}
 
-                // (Optional: Apply air resistance here)
-                physics.velocity *= std::pow(0.999f, dt * 60.0f);
+void PhysicsSystem::IntegrateSoA(float dt) {
+    const glm::vec3 gravity = (m_Settings.applyGravity && !m_Settings.mutualGravity) ? GRAVITY : glm::vec3(0.0f);
+    IntegrateBodies(m_Bodies, dt, gravity, m_Settings.method, AirDamping(m_Settings, dt));
 
-                transform.UpdateMatrix();
+    // The collision pass works on the components, so hand it the new positions and velocities
+    for (size_t i = 0; i < m_Bodies.Size(); ++i) {
+        m_BodyTransforms[i]->position = m_Bodies.Position(i);
+        m_BodyPhysics[i]->velocity = m_Bodies.Velocity(i);
+    }
+}
+
+void PhysicsSystem::PullSoA() {
+    // Pick up the collision response before the next substep
+    for (size_t i = 0; i < m_Bodies.Size(); ++i) {
+        m_Bodies.SetPosition(i, m_BodyTransforms[i]->position);
+        m_Bodies.SetVelocity(i, m_BodyPhysics[i]->velocity);
+    }
+}
+
+void PhysicsSystem::FinishSoA(Registry& registry) {
+    // Matrices are only needed by the renderer, so they are rebuilt once per frame rather than per substep
+    // (with a fixed timestep InterpolateTransforms writes them instead)
+    for (size_t i = 0; i < m_Bodies.Size(); ++i) {
+        m_BodyPhysics[i]->forceAccumulator = glm::vec3(0.0f);
+        if (!m_Interpolate) m_BodyTransforms[i]->UpdateMatrix();
+        registry.MarkChanged<TransformComponent>(m_BodyEntities[i]);
+    }
+}
+
+void PhysicsSystem::WakeIslands(Registry& registry) {
+    const bool wakeAll = m_WakeAll || !SleepingEnabled();
+    m_WakeAll = false;
+    if (m_SleepingCount == 0) {
+        m_WakeIslands.clear();
+        return;
+    }
+
+    auto view = registry.View<TransformComponent, PhysicsComponent>();
+
+    // 1. Sleepers moved or pushed from outside (editor, snapshots, forces) wake their island too
+    if (!wakeAll) {
+        for (Entity e : view) {
+            const auto& physics = view.Get<PhysicsComponent>(e);
+            if (!physics.isSleeping) continue;
+            if (view.Get<TransformComponent>(e).position != physics.sleepPosition
+                || physics.velocity != glm::vec3(0.0f) || physics.forceAccumulator != glm::vec3(0.0f)) {
+                m_WakeIslands.push_back(physics.islandId);
             }
         }
+        if (m_WakeIslands.empty()) return;
+
+        std::sort(m_WakeIslands.begin(), m_WakeIslands.end());
+        m_WakeIslands.erase(std::unique(m_WakeIslands.begin(), m_WakeIslands.end()), m_WakeIslands.end());
     }
+
+    // 2. Islands wake as a whole, so nothing is left resting on a body that has started to move
+    for (Entity e : view) {
+        auto& physics = view.Get<PhysicsComponent>(e);
+        if (!physics.isSleeping) continue;
+        if (wakeAll || std::binary_search(m_WakeIslands.begin(), m_WakeIslands.end(), physics.islandId)) {
+            physics.isSleeping = false;
+            physics.restFrames = 0;
+        }
+    }
+    m_WakeIslands.clear();
+}
+
+void PhysicsSystem::UpdateSleep() {
+    size_t sleptBodies = 0;
+    size_t sleptIslands = 0;
+
+    if (SleepingEnabled() && !m_DynamicSpheres.empty()) {
+        // 1. Count how long each body has stayed under the rest thresholds
+        for (auto& body : m_DynamicSpheres) {
+            auto& physics = *body.physics;
+            physics.restFrames = IsAtRest(physics.velocity, physics.mass, m_Settings.sleep) ? physics.restFrames + 1 : 0;
+        }
+
+        // 2. Group touching bodies; a single restless member keeps its whole island awake
+        m_Islands.Reset(m_DynamicSpheres.size());
+        for (const auto& [a, b] : m_Contacts) m_Islands.Union(a, b);
+        const size_t islandCount = m_Islands.Label(m_IslandOf);
+
+        m_IslandIds.assign(islandCount, 0);
+        for (size_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+            if (m_DynamicSpheres[i].physics->restFrames < m_Settings.sleep.framesToSleep) m_IslandIds[m_IslandOf[i]] = UINT32_MAX;
+        }
+
+        // 3. Put the rest to sleep, with one id per island so they can be woken together
+        for (size_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+            uint32_t& islandId = m_IslandIds[m_IslandOf[i]];
+            if (islandId == UINT32_MAX) continue;
+            if (islandId == 0) {
+                islandId = m_NextIslandId++;
+                ++sleptIslands;
+            }
+
+            auto& physics = *m_DynamicSpheres[i].physics;
+            physics.isSleeping = true;
+            physics.islandId = islandId;
+            physics.velocity = glm::vec3(0.0f);
+            physics.forceAccumulator = glm::vec3(0.0f);
+            physics.sleepPosition = m_DynamicSpheres[i].transform->position;
+            physics.previousPosition = physics.sleepPosition;
+            m_DynamicSpheres[i].transform->UpdateMatrix(); // Sleepers are not interpolated, so settle the pose
+            ++sleptBodies;
+        }
+    }
+
+    m_SleepingCount += sleptBodies;
+    m_Stats.awakeBodies = m_DynamicSpheres.size() - sleptBodies;
+    m_Stats.sleepingBodies = m_SleepingCount;
+    m_Stats.islandsSleptThisFrame = sleptIslands;
 }
 
 void PhysicsSystem::ApplySpherePlaneCorrection(TransformComponent& sphereTrans, float radius, const Plane& plane) {
@@ -89,62 +508,586 @@ void PhysicsSystem::ApplySpherePlaneCorrection(TransformComponent& sphereTrans,
     }
 }
 
-void PhysicsSystem::ResolveCollisions(Registry& registry) {
-    auto entityCount = registry.GetEntityCount();
-    for (Entity i = 0; i < entityCount; ++i) {
-        for (Entity j = i + 1; j < entityCount; ++j) {
-            if (!IsCollidable(registry, i) || !IsCollidable(registry, j)) continue;
+std::optional<Plane> PhysicsSystem::SurfacePlane(uint32_t index, const glm::vec3& point, float reach) const {
+    const BodyProxy& surface = m_Planes[index];
+    const ColliderComponent& collider = *surface.collider;
+    if (collider.type == 1) return Plane(surface.transform->position, collider.normal, collider.radius);
+
+    if (collider.type == 3) {
+        // Meshes are two-sided: the plane faces whichever side the point is on
+        const MeshFrame& frame = m_MeshFrames[index];
+        const float localReach = (reach < std::numeric_limits<float>::max()) ? reach * frame.localPerWorld : reach;
+        TriangleBVH::SurfacePoint closest;
+        if (!collider.mesh->ClosestPoint(glm::vec3(frame.toLocal * glm::vec4(point, 1.0f)), localReach, closest)) return std::nullopt;
+
+        const glm::vec3 onMesh = glm::vec3(surface.transform->matrix * glm::vec4(closest.point, 1.0f));
+        const glm::vec3 delta = point - onMesh;
+        const float dist = glm::length(delta);
+        const glm::vec3 normal = (dist > 1e-6f) ? delta / dist
+            : glm::normalize(glm::vec3(glm::transpose(frame.toLocal) * glm::vec4(closest.normal, 0.0f)));
+        return Plane(onMesh, normal);
+    }
+
+    // Heightfields follow their transform's translation only
+    const glm::vec3 local = point - surface.transform->position;
+    if (!collider.heightfield->Contains(local.x, local.z)) return std::nullopt;
+    if (collider.radius > 0.0f && local.x * local.x + local.z * local.z > collider.radius * collider.radius) return std::nullopt;
+
+    float height;
+    glm::vec3 normal;
+    collider.heightfield->Sample(local.x, local.z, height, normal);
+    return Plane(surface.transform->position + glm::vec3(local.x, height, local.z), normal);
+}
+
+std::optional<Plane> PhysicsSystem::ContactSurface(uint32_t surface, const Sphere& sphere) const {
+    std::optional<Plane> plane = SurfacePlane(surface, sphere.Position(), sphere.m_radius);
+    if (!plane) return std::nullopt;
+    if (m_Planes[surface].collider->type != 2) return plane->Intersects(sphere) ? plane : std::nullopt;
+
+    // Terrain is solid underneath, so a body below its surface is in contact however deep it sank
+    constexpr float EPS = 1e-6f;
+    return (plane->GetSignedDistance(sphere.Position()) <= sphere.m_radius + EPS) ? plane : std::nullopt;
+}
+
+void PhysicsSystem::GatherBodies(Registry& registry) {
+    m_DynamicSpheres.clear();
+    m_StaticSpheres.clear();
+    m_Planes.clear();
+    m_MeshFrames.clear();
+    m_SleepingCount = 0;
+
+    float maxDynamicRadius = 0.0f;
+
+    auto view = registry.View<ColliderComponent, TransformComponent, PhysicsComponent>();
+    for (Entity e : view) {
+        auto& collider = view.Get<ColliderComponent>(e);
+        auto& physics = view.Get<PhysicsComponent>(e);
+        if (!collider.hasCollision) {
+            // Without a collider it can never be hit again, so it must not stay frozen
+            physics.isSleeping = false;
+            continue;
+        }
+
+        BodyProxy proxy{ e, &view.Get<TransformComponent>(e), &physics, &collider };
+
+        if (collider.type >= 1 && collider.type <= 3) {
+            // A heightfield or mesh that was never built has no surface to collide with
+            if (collider.type == 2 && (!collider.heightfield || collider.heightfield->Empty())) continue;
+            if (collider.type == 3 && (!collider.mesh || collider.mesh->Empty())) continue;
+
+            MeshFrame frame{ glm::mat4(1.0f), 1.0f };
+            if (collider.type == 3) {
+                const glm::mat4& m = proxy.transform->matrix;
+                const float minScale = std::min({ glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2])) });
+                if (!(minScale > 0.0f)) continue;
+                frame = { glm::inverse(m), 1.0f / minScale };
+            }
+            m_Planes.push_back(proxy);
+            m_MeshFrames.push_back(frame);
+        }
+        else if (physics.isStatic || physics.isSleeping) {
+            m_StaticSpheres.push_back(proxy);
+            if (physics.isSleeping) {
+                ++m_SleepingCount;
+                // Keeps the cell size (and so the cached static grid) stable as bodies fall asleep
+                if (!physics.isStatic) maxDynamicRadius = std::max(maxDynamicRadius, collider.radius);
+            }
+        }
+        else {
+            m_DynamicSpheres.push_back(proxy);
+            maxDynamicRadius = std::max(maxDynamicRadius, collider.radius);
+        }
+    }
+
+    // A cell at least one diameter wide means a sphere can only touch spheres in the 27 surrounding cells
+    m_CellSize = std::max(2.0f * maxDynamicRadius, 0.01f);
+}
+
+void PhysicsSystem::BuildStaticGrid() {
+    // 1. Anything static moved, added or removed (planes included) may have been holding up a sleeper
+    m_KeyScratch.clear();
+    for (const auto& body : m_StaticSpheres) {
+        if (body.physics->isSleeping) continue;
+        m_KeyScratch.push_back({ body.entity, body.transform->position, glm::vec3(0.0f), body.collider->radius });
+    }
+    for (const auto& plane : m_Planes) {
+        m_KeyScratch.push_back({ plane.entity, plane.transform->position, plane.collider->normal, plane.collider->radius });
+    }
+    if (!(m_KeyScratch == m_WorldKeys)) {
+        m_WorldKeys.swap(m_KeyScratch);
+        if (m_SleepingCount > 0) m_WakeAll = true;
+    }
 
-            auto& t1 = registry.GetComponent<TransformComponent>(i);
-            auto& c1 = registry.GetComponent<ColliderComponent>(i);
-            auto& p1 = registry.GetComponent<PhysicsComponent>(i);
+    m_StaticVisitStamp.assign(m_StaticSpheres.size(), 0);
+    m_VisitCounter = 0;
 
-            auto& t2 = registry.GetComponent<TransformComponent>(j);
-            auto& c2 = registry.GetComponent<ColliderComponent>(j);
-            auto& p2 = registry.GetComponent<PhysicsComponent>(j);
+    // 2. Static and sleeping bodies do not move during the substeps, so they are hashed by their bounds,
+    // and only when the set or a position actually changed since the last build
+    m_KeyScratch.clear();
+    for (const auto& body : m_StaticSpheres) {
+        m_KeyScratch.push_back({ body.entity, body.transform->position, glm::vec3(0.0f), body.collider->radius });
+    }
+    if (m_StaticGridCellSize == m_CellSize && m_KeyScratch == m_StaticKeys) return;
+    m_StaticKeys.swap(m_KeyScratch);
+    m_StaticGridCellSize = m_CellSize;
 
-            // Sphere vs Sphere
-            if (c1.type == 0 && c2.type == 0) {
-                MovingSphere sphereA(t1.position, c1.radius, p1.velocity, p1.mass, p1.restitution);
-                MovingSphere sphereB(t2.position, c2.radius, p2.velocity, p2.mass, p2.restitution);
+    m_StaticGrid.Reset(m_CellSize, m_StaticSpheres.size() * 8);
+    for (uint32_t i = 0; i < m_StaticSpheres.size(); ++i) {
+        const glm::vec3 center = m_StaticSpheres[i].transform->position;
+        const glm::vec3 extent = glm::vec3(m_StaticSpheres[i].collider->radius);
+        m_StaticGrid.InsertBounds(i, center - extent, center + extent);
+    }
+    m_StaticGrid.Build();
+}
 
-                if (sphereA.sphere.CollideWith(sphereB.sphere)) {
-                    ResolveElasticCollision(sphereA, sphereB);
-                    if (!p1.isStatic) p1.velocity = sphereA.velocity;
-                    if (!p2.isStatic) p2.velocity = sphereB.velocity;
-                    ApplyPositionCorrection(t1, t2, c1.radius, c2.radius, p1.isStatic, p2.isStatic);
+void PhysicsSystem::BuildDynamicGrid() {
+    m_DynamicGrid.Reset(m_CellSize, m_DynamicSpheres.size());
+    for (uint32_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        m_DynamicGrid.InsertPoint(i, m_DynamicSpheres[i].transform->position);
+    }
+    m_DynamicGrid.Build();
+}
+
+void PhysicsSystem::StoreStepStart() {
+    m_StepStart.resize(m_DynamicSpheres.size());
+    for (size_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        m_StepStart[i] = m_DynamicSpheres[i].transform->position;
+    }
+}
+
+bool PhysicsSystem::SweepFastBodies() {
+    // Bodies are swept a little smaller than they are, so the stop leaves them just inside whatever they
+    // hit and the discrete contact pass is sure to pick the pair up
+    constexpr float TOI_PENETRATION = 0.01f;
+    bool moved = false;
+
+    for (uint32_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        BodyProxy& body = m_DynamicSpheres[i];
+        const glm::vec3 start = m_StepStart[i];
+        const glm::vec3 displacement = body.transform->position - start;
+        const float radius = body.collider->radius;
+        if (!NeedsSweep(displacement, radius, m_Settings.ccdMotionFraction)) continue;
+        ++m_Stats.sweptBodies;
+
+        const Sphere swept(start, radius * (1.0f - TOI_PENETRATION));
+        const glm::vec3 lo = glm::min(start, body.transform->position) - glm::vec3(radius);
+        const glm::vec3 hi = glm::max(start, body.transform->position) + glm::vec3(radius);
+        float first = 2.0f;
+        float toi;
+
+        // 1. Planes, and heightfields by their tangent plane under the end of the step
+        for (uint32_t p = 0; p < m_Planes.size(); ++p) {
+            const std::optional<Plane> surface = SurfacePlane(p, body.transform->position, glm::length(displacement) + radius);
+            if (surface && SweepSpherePlane(swept, displacement, *surface, toi)) {
+                first = std::min(first, toi);
+            }
+        }
+
+        // 2. Static spheres and sleepers along the path
+        if (!m_StaticGrid.Empty()) {
+            const uint32_t stamp = ++m_VisitCounter;
+            m_StaticGrid.QueryBounds(lo, hi, [&](uint32_t j) {
+                if (m_StaticVisitStamp[j] == stamp) return;
+                m_StaticVisitStamp[j] = stamp;
+                const BodyProxy& other = m_StaticSpheres[j];
+                if (SweepSphereSphere(swept, displacement, Sphere(other.transform->position, other.collider->radius), glm::vec3(0.0f), toi)) {
+                    first = std::min(first, toi);
                 }
+            });
+        }
+
+        // 3. Other dynamic spheres, each moving over the same step. The grid holds end positions, so the
+        // query is widened by a cell; two fast bodies crossing far from both their end points are missed.
+        m_DynamicGrid.QueryBounds(lo - glm::vec3(m_CellSize), hi + glm::vec3(m_CellSize), [&](uint32_t j) {
+            if (j == i) return;
+            const BodyProxy& other = m_DynamicSpheres[j];
+            const glm::vec3 otherDisplacement = other.transform->position - m_StepStart[j];
+            if (SweepSphereSphere(swept, displacement, Sphere(m_StepStart[j], other.collider->radius), otherDisplacement, toi)) {
+                first = std::min(first, toi);
             }
-            // Sphere vs Plane
-            else if (c1.type == 0 && c2.type == 1) {
-                MovingSphere sphereA(t1.position, c1.radius, p1.velocity, p1.mass, p1.restitution);
-                Plane planeB(t2.position, c2.normal, c2.radius);
+        });
 
-                if (planeB.Intersects(sphereA.sphere)) {
-                    ResolveSpherePlaneCollision(sphereA, planeB, p2.restitution);
-                    if (!p1.isStatic) p1.velocity = sphereA.velocity;
-                    if (!p1.isStatic) ApplySpherePlaneCorrection(t1, c1.radius, planeB);
+        if (first <= 1.0f) {
+            body.transform->position = start + displacement * first;
+            body.transform->UpdateMatrix();
+            ++m_Stats.sweptHits;
+            moved = true;
+        }
+    }
+    return moved;
+}
+
+void PhysicsSystem::ResolveCollisions() {
+    // 1. Rebuild the dynamic broadphase from this substep's positions
+    BuildDynamicGrid();
+
+    // 2. Fast bodies are pulled back to their first impact, so the contact pass sees a touching pair rather
+    // than one that has already passed through. Anything moved invalidates the grid.
+    if (m_Settings.continuousCollision && m_StepStart.size() == m_DynamicSpheres.size() && SweepFastBodies()) {
+        BuildDynamicGrid();
+    }
+
+    if (m_Settings.useSequentialImpulse) {
+        GatherContacts();
+        SolveSequentialImpulse();
+        return;
+    }
+
+    // Impulses left over from an earlier sequential solve would be stale by the time it is switched back on
+    m_ContactCache.Clear();
+    m_Stats.cachedContacts = 0;
+
+    if (m_Settings.parallelContacts) {
+        GatherContacts();
+        SolveContactBatches();
+        return;
+    }
+
+    size_t contacts = 0;
+    for (uint32_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        BodyProxy& body = m_DynamicSpheres[i];
+
+        // 3. Dynamic vs Dynamic (each pair is handled once, by its lower index)
+        m_DynamicGrid.QueryNeighbours(body.transform->position, [&](uint32_t j) {
+            if (j <= i) return;
+            ++m_Stats.pairsTested;
+            const glm::vec3 velocityBefore = body.physics->velocity;
+            if (!ResolveSpherePair(body, m_DynamicSpheres[j])) return;
+            ++contacts;
+            if (m_RecordContacts) m_Contacts.emplace_back(i, j);
+            if (m_Settings.recordContactEvents) {
+                const Contact contact{ ContactKind::DynamicSphere, i, j };
+                RecordContactEvent(contact, MeasureContact(contact, velocityBefore));
+            }
+        });
+
+        // 4. Dynamic vs Static spheres (stamped, since a static sphere can span several cells)
+        if (!m_StaticGrid.Empty()) {
+            const uint32_t stamp = ++m_VisitCounter;
+            const glm::vec3 extent = glm::vec3(body.collider->radius);
+            m_StaticGrid.QueryBounds(body.transform->position - extent, body.transform->position + extent, [&](uint32_t j) {
+                if (m_StaticVisitStamp[j] == stamp) return;
+                m_StaticVisitStamp[j] = stamp;
+                ++m_Stats.pairsTested;
+                const glm::vec3 velocityBefore = body.physics->velocity;
+                if (!ResolveSpherePair(body, m_StaticSpheres[j])) return;
+                ++contacts;
+                if (m_Settings.recordContactEvents) {
+                    const Contact contact{ ContactKind::StaticSphere, i, j };
+                    RecordContactEvent(contact, MeasureContact(contact, velocityBefore));
+                }
+            });
+        }
+
+        // 5. Dynamic vs Planes
+        m_Stats.pairsTested += m_Planes.size();
+        for (uint32_t p = 0; p < m_Planes.size(); ++p) {
+            const glm::vec3 velocityBefore = body.physics->velocity;
+            if (!ResolveSpherePlane(body, p)) continue;
+            ++contacts;
+            if (m_Settings.recordContactEvents) {
+                const Contact contact{ ContactKind::Plane, i, p };
+                RecordContactEvent(contact, MeasureContact(contact, velocityBefore));
+            }
+        }
+    }
+
+    m_Stats.contacts = contacts;
+    m_Stats.contactsSolved += contacts;
+    m_Stats.contactBatches = 0;
+}
+
+void PhysicsSystem::GatherContacts() {
+    m_ContactList.clear();
+    m_ContactBodyA.clear();
+    m_ContactBodyB.clear();
+
+    auto add = [&](ContactKind kind, uint32_t a, uint32_t b) {
+        m_ContactList.push_back({ kind, a, b });
+        m_ContactBodyA.push_back(a);
+        m_ContactBodyB.push_back(kind == ContactKind::DynamicSphere ? b : ConstraintColoring::NO_BODY);
+    };
+
+    // Same candidates as the serial loop, but only pairs that overlap now become contacts
+    size_t tested = 0;
+    for (uint32_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        const BodyProxy& body = m_DynamicSpheres[i];
+        const Sphere sphere(body.transform->position, body.collider->radius);
+
+        m_DynamicGrid.QueryNeighbours(body.transform->position, [&](uint32_t j) {
+            if (j <= i) return;
+            ++tested;
+            const BodyProxy& other = m_DynamicSpheres[j];
+            if (sphere.CollideWith(Sphere(other.transform->position, other.collider->radius))) {
+                add(ContactKind::DynamicSphere, i, j);
+            }
+        });
+
+        if (!m_StaticGrid.Empty()) {
+            const uint32_t stamp = ++m_VisitCounter;
+            const glm::vec3 extent = glm::vec3(body.collider->radius);
+            m_StaticGrid.QueryBounds(body.transform->position - extent, body.transform->position + extent, [&](uint32_t j) {
+                if (m_StaticVisitStamp[j] == stamp) return;
+                m_StaticVisitStamp[j] = stamp;
+                ++tested;
+                const BodyProxy& other = m_StaticSpheres[j];
+                if (sphere.CollideWith(Sphere(other.transform->position, other.collider->radius))) {
+                    add(ContactKind::StaticSphere, i, j);
                 }
+            });
+        }
+
+        tested += m_Planes.size();
+        for (uint32_t p = 0; p < m_Planes.size(); ++p) {
+            if (ContactSurface(p, sphere)) {
+                add(ContactKind::Plane, i, p);
+            }
+        }
+    }
+    m_Stats.pairsTested += tested;
+
+    m_Coloring.Build(m_ContactBodyA, m_ContactBodyB, m_DynamicSpheres.size());
+    m_Stats.contacts = m_ContactList.size();
+    m_Stats.contactsSolved += m_ContactList.size();
+    m_Stats.contactBatches = m_Coloring.Batches().size();
+}
+
+// Runs fn(contactIndex) over every batch in turn. A batch touches each dynamic body at most once,
+// so its contacts are spread across the workers; the overflow batch stays on this thread.
+// With parallel contacts off, every contact is visited on this thread in the same order.
+template <typename Fn>
+void PhysicsSystem::ForEachContactBatch(Fn&& fn) {
+    const auto& order = m_Coloring.Order();
+    for (const auto& batch : m_Coloring.Batches()) {
+        auto solveRange = [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) fn(order[batch.begin + k]);
+        };
+        const size_t count = batch.end - batch.begin;
+        if (batch.serial || !m_Settings.parallelContacts) solveRange(0, count);
+        else JobSystem::Get().ParallelFor(count, 64, solveRange);
+    }
+}
+
+void PhysicsSystem::SolveContactBatches() {
+    m_ContactResults.assign(m_ContactList.size(), 0);
+    if (m_Settings.recordContactEvents) m_ContactGeometry.resize(m_ContactList.size());
+
+    // 1. Velocities, against the positions every contact was detected with
+    ForEachContactBatch([&](uint32_t c) {
+        const Contact& contact = m_ContactList[c];
+        BodyProxy& body = m_DynamicSpheres[contact.a];
+        const glm::vec3 velocityBefore = body.physics->velocity;
+        switch (contact.kind) {
+        case ContactKind::DynamicSphere: m_ContactResults[c] = SolveSpherePairVelocity(body, m_DynamicSpheres[contact.b]); break;
+        case ContactKind::StaticSphere: m_ContactResults[c] = SolveSpherePairVelocity(body, m_StaticSpheres[contact.b]); break;
+        case ContactKind::Plane: m_ContactResults[c] = SolveSpherePlaneVelocity(body, contact.b); break;
+        }
+        if (m_Settings.recordContactEvents && (m_ContactResults[c] & CONTACT_TOUCHED)) {
+            m_ContactGeometry[c] = MeasureContact(contact, velocityBefore);
+        }
+    });
+
+    CorrectContactPositions();
+    RecordContactResults();
+}
+
+void PhysicsSystem::SolveSequentialImpulse() {
+    const size_t count = m_ContactList.size();
+
+    // 1. Velocity state of every dynamic sphere
+    m_SolverBodies.resize(m_DynamicSpheres.size());
+    for (size_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        const PhysicsComponent& physics = *m_DynamicSpheres[i].physics;
+        m_SolverBodies[i] = { physics.velocity, physics.inverseMass };
+    }
+
+    // 2. One constraint per contact. Static spheres, sleepers and planes keep b = NO_BODY and hold still.
+    m_SolverContacts.resize(count);
+    m_ContactResults.assign(count, CONTACT_TOUCHED);
+    if (m_Settings.recordContactEvents) m_ContactGeometry.resize(count);
+    JobSystem::Get().ParallelFor(count, 256, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const Contact& contact = m_ContactList[c];
+            const BodyProxy& body = m_DynamicSpheres[contact.a];
+            const BodyProxy& other = ContactOther(contact);
+
+            SolverContact& sc = m_SolverContacts[c];
+            sc.a = contact.a;
+            sc.b = m_ContactBodyB[c];
+            sc.key = ContactCache::Key(body.entity, other.entity);
+
+            if (contact.kind == ContactKind::Plane) {
+                const std::optional<Plane> surface = SurfacePlane(contact.b, body.transform->position);
+                sc.normal = surface ? -surface->GetNormal() : glm::vec3(0.0f, -1.0f, 0.0f);
             }
-            // Plane vs Sphere
-            else if (c1.type == 1 && c2.type == 0) {
-                MovingSphere sphereB(t2.position, c2.radius, p2.velocity, p2.mass, p2.restitution);
-                Plane planeA(t1.position, c1.normal, c1.radius); 
+            else {
+                const glm::vec3 delta = other.transform->position - body.transform->position;
+                const float dist = glm::length(delta);
+                sc.normal = (dist > 0.0f) ? delta / dist : glm::vec3(0.0f, 1.0f, 0.0f);
 
-                if (planeA.Intersects(sphereB.sphere)) {
-                    ResolveSpherePlaneCollision(sphereB, planeA, p1.restitution);
-                    if (!p2.isStatic) p2.velocity = sphereB.velocity;
-                    if (!p2.isStatic) ApplySpherePlaneCorrection(t2, c2.radius, planeA);
+                // A hard enough hit on a sleeper wakes its island for the next frame
+                if (other.physics->isSleeping && glm::dot(body.physics->velocity, sc.normal) > m_Settings.sleep.linearVelocity) {
+                    m_ContactResults[c] |= CONTACT_WAKES;
                 }
             }
+
+            PrepareContact(sc, m_SolverBodies, body.physics->restitution * other.physics->restitution, m_Settings.solver);
+
+            // Where the pair touches; the solver fills in its impulse below
+            if (m_Settings.recordContactEvents) m_ContactGeometry[c] = { body.transform->position + sc.normal * body.collider->radius, sc.normal, 0.0f };
         }
+    });
+
+    // 3. Warm start, then iterate. Each batch is a Gauss-Seidel sweep over bodies it alone touches.
+    ForEachContactBatch([&](uint32_t c) {
+        SolverContact& sc = m_SolverContacts[c];
+        WarmStartContact(sc, m_SolverBodies, m_Settings.solver.warmStarting ? m_ContactCache.Find(sc.key) : 0.0f);
+    });
+    for (int i = 0; i < std::max(m_Settings.solver.iterations, 1); ++i) {
+        ForEachContactBatch([&](uint32_t c) { SolveContact(m_SolverContacts[c], m_SolverBodies); });
+    }
+
+    // 4. Write the velocities back and keep each pair's impulse for the next substep
+    for (size_t i = 0; i < m_DynamicSpheres.size(); ++i) {
+        m_DynamicSpheres[i].physics->velocity = m_SolverBodies[i].velocity;
     }
+    for (size_t c = 0; c < count; ++c) {
+        const SolverContact& sc = m_SolverContacts[c];
+        m_ContactCache.Store(sc.key, sc.impulse);
+        if (m_Settings.recordContactEvents) m_ContactGeometry[c].impulse = sc.impulse;
+    }
+    m_ContactCache.EndStep();
+    m_Stats.cachedContacts = m_ContactCache.Size();
+
+    CorrectContactPositions();
+    RecordContactResults();
+}
+
+void PhysicsSystem::CorrectContactPositions() {
+    // Position corrections for the contacts that touched
+    ForEachContactBatch([&](uint32_t c) {
+        if (!(m_ContactResults[c] & CONTACT_TOUCHED)) return;
+        const Contact& contact = m_ContactList[c];
+        BodyProxy& body = m_DynamicSpheres[contact.a];
+        if (contact.kind == ContactKind::Plane) {
+            const std::optional<Plane> surface = SurfacePlane(contact.b, body.transform->position);
+            if (surface && !body.physics->isStatic) {
+                ApplySpherePlaneCorrection(*body.transform, body.collider->radius, *surface);
+            }
+            return;
+        }
+
+        BodyProxy& other = (contact.kind == ContactKind::DynamicSphere) ? m_DynamicSpheres[contact.b] : m_StaticSpheres[contact.b];
+        ApplyPositionCorrection(*body.transform, *other.transform, body.collider->radius, other.collider->radius,
+            body.physics->isStatic || body.physics->isSleeping, other.physics->isStatic || other.physics->isSleeping);
+    });
 }
 
-bool PhysicsSystem::IsCollidable(const Registry& reg, Entity e) {
-    return reg.HasComponent<TransformComponent>(e) &&
-        reg.HasComponent<ColliderComponent>(e) &&
-        reg.HasComponent<PhysicsComponent>(e);
+void PhysicsSystem::RecordContactResults() {
+    // Shared bookkeeping, back on this thread
+    for (size_t c = 0; c < m_ContactList.size(); ++c) {
+        const Contact& contact = m_ContactList[c];
+        if (m_ContactResults[c] & CONTACT_WAKES) m_WakeIslands.push_back(m_StaticSpheres[contact.b].physics->islandId);
+        if (!(m_ContactResults[c] & CONTACT_TOUCHED)) continue;
+        if (m_RecordContacts && contact.kind == ContactKind::DynamicSphere) {
+            m_Contacts.emplace_back(contact.a, contact.b);
+        }
+        if (m_Settings.recordContactEvents) RecordContactEvent(contact, m_ContactGeometry[c]);
+    }
+}
+
+const PhysicsSystem::BodyProxy& PhysicsSystem::ContactOther(const Contact& contact) const {
+    switch (contact.kind) {
+    case ContactKind::DynamicSphere: return m_DynamicSpheres[contact.b];
+    case ContactKind::StaticSphere: return m_StaticSpheres[contact.b];
+    default: return m_Planes[contact.b];
+    }
+}
+
+PhysicsSystem::ContactGeometry PhysicsSystem::MeasureContact(const Contact& contact, const glm::vec3& velocityBefore) const {
+    const BodyProxy& body = m_DynamicSpheres[contact.a];
+    const glm::vec3 position = body.transform->position;
+
+    // Normal from the dynamic body towards the other side, as the sequential solver builds it
+    glm::vec3 normal(0.0f, -1.0f, 0.0f);
+    if (contact.kind == ContactKind::Plane) {
+        const std::optional<Plane> surface = SurfacePlane(contact.b, position);
+        if (surface) normal = -surface->GetNormal();
+    }
+    else {
+        const glm::vec3 delta = ContactOther(contact).transform->position - position;
+        const float dist = glm::length(delta);
+        normal = (dist > 0.0f) ? delta / dist : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+
+    // The other side pushed the body back along -normal
+    const float impulse = body.physics->mass * glm::dot(velocityBefore - body.physics->velocity, normal);
+    return { position + normal * body.collider->radius, normal, std::max(impulse, 0.0f) };
+}
+
+void PhysicsSystem::RecordContactEvent(const Contact& contact, const ContactGeometry& geometry) {
+    m_ContactEvents.Record(m_DynamicSpheres[contact.a].entity, ContactOther(contact).entity, geometry.point, geometry.normal, geometry.impulse);
+}
+
+bool PhysicsSystem::ResolveSpherePair(BodyProxy& a, BodyProxy& b) {
+    const uint8_t result = SolveSpherePairVelocity(a, b);
+    if (!(result & CONTACT_TOUCHED)) return false;
+    if (result & CONTACT_WAKES) m_WakeIslands.push_back(b.physics->islandId);
+
+    ApplyPositionCorrection(*a.transform, *b.transform, a.collider->radius, b.collider->radius,
+        a.physics->isStatic || a.physics->isSleeping, b.physics->isStatic || b.physics->isSleeping);
+    return true;
+}
+
+uint8_t PhysicsSystem::SolveSpherePairVelocity(BodyProxy& a, BodyProxy& b) {
+    auto& t1 = *a.transform;
+    auto& p1 = *a.physics;
+    auto& t2 = *b.transform;
+    auto& p2 = *b.physics;
+
+    MovingSphere sphereA(t1.position, a.collider->radius, p1.velocity, p1.mass, p1.restitution);
+    MovingSphere sphereB(t2.position, b.collider->radius, p2.velocity, p2.mass, p2.restitution);
+
+    if (!sphereA.sphere.CollideWith(sphereB.sphere)) return 0;
+    uint8_t result = CONTACT_TOUCHED;
+
+    // A sleeping body holds still like a static one for the rest of the frame; a hard enough
+    // hit wakes its whole island for the next one
+    const bool fixed1 = p1.isStatic || p1.isSleeping;
+    const bool fixed2 = p2.isStatic || p2.isSleeping;
+    if (p2.isSleeping) {
+        const glm::vec3 delta = t2.position - t1.position;
+        const float dist = glm::length(delta);
+        const float approachSpeed = (dist > 0.0f) ? glm::dot(p1.velocity - p2.velocity, delta) / dist : 0.0f;
+        if (approachSpeed > m_Settings.sleep.linearVelocity) result |= CONTACT_WAKES;
+    }
+
+    ResolveElasticCollision(sphereA, sphereB);
+    if (!fixed1) p1.velocity = sphereA.velocity;
+    if (!fixed2) p2.velocity = sphereB.velocity;
+    return result;
+}
+
+bool PhysicsSystem::ResolveSpherePlane(BodyProxy& sphere, uint32_t surface) {
+    if (!SolveSpherePlaneVelocity(sphere, surface)) return false;
+    const std::optional<Plane> plane = SurfacePlane(surface, sphere.transform->position);
+    if (plane && !sphere.physics->isStatic) {
+        ApplySpherePlaneCorrection(*sphere.transform, sphere.collider->radius, *plane);
+    }
+    return true;
+}
+
+uint8_t PhysicsSystem::SolveSpherePlaneVelocity(BodyProxy& sphere, uint32_t surface) {
+    auto& t1 = *sphere.transform;
+    auto& p1 = *sphere.physics;
+
+    MovingSphere sphereA(t1.position, sphere.collider->radius, p1.velocity, p1.mass, p1.restitution);
+    const std::optional<Plane> planeB = ContactSurface(surface, sphereA.sphere);
+
+    if (!planeB) return 0;
+    ResolveSpherePlaneCollision(sphereA, *planeB, m_Planes[surface].physics->restitution);
+    if (!p1.isStatic) p1.velocity = sphereA.velocity;
+    return CONTACT_TOUCHED;
 }
 
 void PhysicsSystem::ApplyPositionCorrection(TransformComponent& t1, TransformComponent& t2, float r1, float r2, bool static1, bool static2) {
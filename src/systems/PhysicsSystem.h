@@ -3,26 +3,294 @@
 
 #include "ISystem.h"
 #include "../core/ECS.h"
+#include "../../SimulationStaticLib/SpatialHash.h"
+#include "../../SimulationStaticLib/BodySoA.h"
+#include "../../SimulationStaticLib/SleepIslands.h"
+#include "../../SimulationStaticLib/FixedTimestep.h"
+#include "../../SimulationStaticLib/ConstraintColoring.h"
+#include "../../SimulationStaticLib/ContactSolver.h"
+#include "../../SimulationStaticLib/SweptSphere.h"
+#include "../../SimulationStaticLib/AdaptiveSubsteps.h"
+#include "../../SimulationStaticLib/BarnesHut.h"
+#include "../../SimulationStaticLib/ContactEvents.h"
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
-enum class IntegrationMethod {
-    ExplicitEuler,
-    SemiImplicitEuler,
-    RK4
+struct PhysicsStats {
+    size_t awakeBodies = 0;
+    size_t sleepingBodies = 0;
+    size_t islandsSleptThisFrame = 0;
+    int stepsThisFrame = 0; // Substeps, where the steps were split
+    float interpolationAlpha = 1.0f;
+    float maxMotionRatio = 0.0f; // Largest |v| * stepTime / radius among awake bodies, over the frame or fixed step (adaptive substeps only)
+    float stepTimeMs = 0.0f; // Wall time of the last batch of steps on the physics thread
+    size_t contacts = 0;     // Contacts solved in the last substep
+    size_t pairsTested = 0;  // Broadphase candidates given an overlap test, over all of the frame's substeps
+    size_t contactsSolved = 0; // Contacts solved, over all of the frame's substeps
+    size_t contactBatches = 0;
+    size_t cachedContacts = 0; // Body pairs carrying a warm-start impulse into the next substep
+    size_t sweptBodies = 0;    // Fast bodies swept this frame, summed over the substeps
+    size_t sweptHits = 0;      // ...and how many of those sweeps stopped at an impact
+    size_t gravityNodes = 0;   // Octree cells over the bodies in the last substep (mutual gravity only)
+    uint64_t gravityInteractions = 0; // Cell and body pulls summed in the last substep
+    size_t contactEvents = 0;  // Begin, persist and end events of the last frame
 };
 
+// The solver settings one Simulate call runs with. The editor writes the PhysicsSystem statics; a system
+// stepping on another thread is handed a copy of them instead of reading them while they change.
+struct PhysicsSettings {
+    IntegrationMethod method = IntegrationMethod::SemiImplicitEuler;
+    bool applyGravity = true;
+    float airDamping = 0.999f;
+    bool useSoA = true;
+    bool mutualGravity = false;
+    GravitySettings gravity;
+    bool parallelContacts = true;
+    bool useSequentialImpulse = true;
+    ContactSolverSettings solver;
+    bool continuousCollision = true;
+    float ccdMotionFraction = 0.5f;
+    bool recordContactEvents = true;
+    bool allowSleeping = true;
+    SleepSettings sleep;
+};
+
+class PhysicsThread;
+
 class PhysicsSystem : public ISystem {
 public:
-    static int subSteps;
+    static int subSteps; // Steps per frame when the fixed timestep is off
+
+    // Adaptive substeps: each frame, or each fixed step with the fixed timestep on, is split into as many
+    // substeps as the fastest awake body needs to move no more than substepSettings.maxMotion of its radius
+    // per substep. Replaces subSteps; the physics thread does not use it.
+    static bool adaptiveSubsteps;
+    static SubstepSettings substepSettings;
     static IntegrationMethod currentMethod;
 
+    // Fixed timestep: frame time is accumulated and simulated in steps of 1 / fixedRate seconds.
+    // Off by default, so scenes step with the frame time as they always have until it is turned on.
+    static bool useFixedTimestep;
+    static float fixedRate;
+    static int maxStepsPerFrame;
+
+    // Steps the simulation on its own thread at fixedRate; the scene reads the latest published state
+    static bool runOnThread;
+
     static bool applyGravity;
+    static float airDamping; // Share of its velocity a body keeps per 1/60 s; 1 = no drag
+    static bool useSoA;
+
+    // Mutual gravity: every dynamic body pulls every other through a Barnes-Hut octree rebuilt each substep,
+    // in place of the uniform field and without air damping. Bodies never sleep in this mode, since nothing
+    // under gravity is at rest.
+    static bool mutualGravity;
+    static GravitySettings gravitySettings;
+
+    // Contacts are gathered, coloured into batches that share no dynamic body, and each batch is
+    // solved across the job system (velocities for every batch first, then position corrections)
+    static bool parallelContacts;
+
+    // Sequential impulses: every contact is solved over several iterations with its accumulated impulse
+    // clamped, starting from the impulse the same body pair ended the previous substep with
+    static bool useSequentialImpulse;
+    static ContactSolverSettings solverSettings;
+
+    // Continuous collision: a body that moves further than ccdMotionFraction of its radius in one step is
+    // swept from where the step started and stopped at its first impact, so it cannot pass through thin planes
+    static bool continuousCollision;
+    static float ccdMotionFraction;
+
+    // Contact events: every frame's touching body pairs, merged over its substeps and classified as
+    // begin / persist / end against the frame before, for other systems to read through the scene
+    static bool recordContactEvents;
+
+    static bool allowSleeping;
+    static SleepSettings sleepSettings;
+    static PhysicsStats lastStats;
+    static SampleHistory stepHistory; // Steps taken in each recent frame
+
+    PhysicsSystem();
+    ~PhysicsSystem() override;
 
     void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Physics"; }
+
+    // The statics above, copied; only safe to call where the editor writes them (the main thread)
+    static PhysicsSettings CurrentSettings();
+
+    // One frame of deltaTime on the registry with the statics' timestep settings; Update runs this
+    // unless the simulation is on the physics thread
+    void Step(Registry& registry, float deltaTime);
+
+    // Runs the given number of steps of length dt on the registry, each split into equal substeps. With
+    // interpolate set, matrices are blended by alpha between the poses before and after the last step
+    // instead of rebuilt. Without settings, the statics are read as the call starts.
+    void Simulate(Registry& registry, int steps, float dt, bool interpolate, float alpha = 1.0f, int substeps = 1);
+    void Simulate(Registry& registry, const PhysicsSettings& settings, int steps, float dt, bool interpolate, float alpha = 1.0f, int substeps = 1);
+    const PhysicsStats& GetStats() const { return m_Stats; }
+    const ContactEventBuffer& GetContactEvents() const { return m_ContactEvents; }
 
 private:
+    // Cached component pointers for one collidable body, gathered once per frame
+    struct BodyProxy {
+        Entity entity;
+        struct TransformComponent* transform;
+        struct PhysicsComponent* physics;
+        struct ColliderComponent* collider;
+    };
+
     void Integrate(Registry& registry, float dt);
-    void ResolveCollisions(Registry& registry);
-    bool IsCollidable(const Registry& reg, Entity e);
+    void ApplyMutualGravity(Registry& registry);
+    bool SleepingEnabled() const { return m_Settings.allowSleeping && !m_Settings.mutualGravity; }
+    float MaxMotionRatio(Registry& registry, float frameTime) const;
+
+    // Structure-of-arrays path: hot state is copied out once per frame, integrated in SIMD columns,
+    // and synced with the components around each collision pass
+    void GatherSoA(Registry& registry);
+    void IntegrateSoA(float dt);
+    void PullSoA();
+    void FinishSoA(Registry& registry);
+    void GatherBodies(Registry& registry);
+    void BuildStaticGrid();
+    void ResolveCollisions();
+    void BuildDynamicGrid();
+    void StoreStepStart();
+    bool SweepFastBodies();
+    bool ResolveSpherePair(BodyProxy& a, BodyProxy& b);
+    bool ResolveSpherePlane(BodyProxy& sphere, uint32_t surface);
+
+    // Velocity halves of the two resolves above. They only write the bodies they are given and
+    // report CONTACT_TOUCHED / CONTACT_WAKES instead of recording anything, so they can run in parallel.
+    uint8_t SolveSpherePairVelocity(BodyProxy& a, BodyProxy& b);
+    uint8_t SolveSpherePlaneVelocity(BodyProxy& sphere, uint32_t surface);
+
+    // Parallel contact path
+    void GatherContacts();
+    void SolveContactBatches();
+    void SolveSequentialImpulse();
+    void CorrectContactPositions();
+    void RecordContactResults();
+    template <typename Fn> void ForEachContactBatch(Fn&& fn);
     void ApplyPositionCorrection(struct TransformComponent& t1, struct TransformComponent& t2, float r1, float r2, bool static1, bool static2);
     void ApplySpherePlaneCorrection(struct TransformComponent& sphereTrans, float radius, const class Plane& plane);
-};
\ No newline at end of file
+
+    // Surfaces (planes, heightfields and meshes, indexed into m_Planes) are resolved as the plane they present
+    // to a point: the plane itself, a heightfield's tangent plane under it, or the plane through a mesh's
+    // closest point, facing it. Empty outside a heightfield's footprint or when no triangle is within reach.
+    std::optional<Plane> SurfacePlane(uint32_t surface, const glm::vec3& point, float reach = std::numeric_limits<float>::max()) const;
+    std::optional<Plane> ContactSurface(uint32_t surface, const Sphere& sphere) const;
+
+    // Render interpolation between the poses before and after the frame's last fixed step
+    void StorePreviousPositions(Registry& registry);
+    void InterpolateTransforms(Registry& registry, float alpha);
+
+    // Sleeping: islands are woken before the bodies are gathered, and put to sleep after the substeps
+    void WakeIslands(Registry& registry);
+    void UpdateSleep();
+
+    FixedTimestep m_Clock;
+    std::unique_ptr<PhysicsThread> m_Thread;
+    PhysicsStats m_Stats;
+    bool m_Interpolate = false;
+    PhysicsSettings m_Settings; // Those of the current Simulate call
+
+    // Broadphase state. Dynamic spheres are re-hashed every substep,
+    // static spheres once per frame, and planes are tested directly.
+    std::vector<BodyProxy> m_DynamicSpheres;
+    std::vector<BodyProxy> m_StaticSpheres;
+    std::vector<BodyProxy> m_Planes; // Planes, heightfields and meshes
+
+    // Per surface, filled for meshes: the inverse of the instance transform, and how far a world distance
+    // can stretch in mesh space (one over the smallest scale)
+    struct MeshFrame {
+        glm::mat4 toLocal;
+        float localPerWorld;
+    };
+    std::vector<MeshFrame> m_MeshFrames;
+    std::vector<glm::vec3> m_StepStart; // Dynamic sphere positions before this substep's integration
+    std::vector<uint32_t> m_StaticVisitStamp;
+    uint32_t m_VisitCounter = 0;
+    float m_CellSize = 1.0f;
+
+    SpatialHash m_DynamicGrid;
+    SpatialHash m_StaticGrid;
+
+    // Static grid inputs from the last rebuild. Sleeping bodies are hashed with the static ones,
+    // so a settled scene keeps reusing the same grid.
+    struct StaticKey {
+        Entity entity;
+        glm::vec3 position;
+        glm::vec3 normal;
+        float radius;
+        bool operator==(const StaticKey& o) const {
+            return entity == o.entity && position == o.position && normal == o.normal && radius == o.radius;
+        }
+    };
+    std::vector<StaticKey> m_StaticKeys;
+    std::vector<StaticKey> m_WorldKeys; // Static spheres and planes only; a change here wakes everything
+    std::vector<StaticKey> m_KeyScratch;
+    float m_StaticGridCellSize = 0.0f; // 0 until the first build
+
+    // Contacts of the current substep. a is always a dynamic sphere; b indexes the dynamic spheres,
+    // static spheres or planes depending on kind.
+    enum class ContactKind : uint8_t { DynamicSphere, StaticSphere, Plane };
+    struct Contact {
+        ContactKind kind;
+        uint32_t a;
+        uint32_t b;
+    };
+    static constexpr uint8_t CONTACT_TOUCHED = 0x1;
+    static constexpr uint8_t CONTACT_WAKES = 0x2;
+
+    // Contact events. MeasureContact reads a contact right after its velocity solve: where the dynamic body
+    // touches the other side, the normal towards it, and the normal impulse it took since velocityBefore.
+    struct ContactGeometry {
+        glm::vec3 point;
+        glm::vec3 normal;
+        float impulse;
+    };
+    const BodyProxy& ContactOther(const Contact& contact) const;
+    ContactGeometry MeasureContact(const Contact& contact, const glm::vec3& velocityBefore) const;
+    void RecordContactEvent(const Contact& contact, const ContactGeometry& geometry);
+
+    std::vector<Contact> m_ContactList;
+    std::vector<uint32_t> m_ContactBodyA; // Dynamic body indices per contact, for colouring
+    std::vector<uint32_t> m_ContactBodyB;
+    std::vector<uint8_t> m_ContactResults;
+    std::vector<ContactGeometry> m_ContactGeometry; // Per contact, filled by the solve for RecordContactResults
+    ConstraintColoring m_Coloring;
+    ContactEventBuffer m_ContactEvents;
+
+    // Sequential impulse state; solver contacts line up with m_ContactList, solver bodies with m_DynamicSpheres
+    std::vector<SolverBody> m_SolverBodies;
+    std::vector<SolverContact> m_SolverContacts;
+    ContactCache m_ContactCache;
+
+    // Dynamic sphere index pairs that touched during the last substep, for island building
+    std::vector<std::pair<uint32_t, uint32_t>> m_Contacts;
+    bool m_RecordContacts = false;
+    IslandBuilder m_Islands;
+    std::vector<uint32_t> m_IslandOf;
+    std::vector<uint32_t> m_IslandIds; // Per island this frame: 0 = undecided, UINT32_MAX = stays awake
+    std::vector<uint32_t> m_WakeIslands;
+    bool m_WakeAll = false;
+    uint32_t m_NextIslandId = 1;
+    size_t m_SleepingCount = 0; // Sleepers gathered this frame plus those that fell asleep in it
+
+    // SoA state; index i in m_Bodies belongs to m_BodyEntities[i]
+    BodySoA m_Bodies;
+    std::vector<Entity> m_BodyEntities;
+    std::vector<struct TransformComponent*> m_BodyTransforms;
+    std::vector<struct PhysicsComponent*> m_BodyPhysics;
+
+    // Mutual gravity: the octree and per-body columns of the substep being stepped
+    BarnesHutTree m_GravityTree;
+    std::vector<float> m_GravityX, m_GravityY, m_GravityZ, m_GravityMass;
+    std::vector<float> m_GravityAccelX, m_GravityAccelY, m_GravityAccelZ;
+    std::vector<struct PhysicsComponent*> m_GravityBodies;
+};
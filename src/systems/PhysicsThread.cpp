@@ -0,0 +1,275 @@
+#include "PhysicsThread.h"
+#include "../../SimulationStaticLib/FixedTimestep.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+PhysicsThread::PhysicsThread() {
+    m_Mirror.RegisterComponent<TransformComponent>();
+    m_Mirror.RegisterComponent<PhysicsComponent>();
+    m_Mirror.RegisterComponent<ColliderComponent>();
+    m_QueuedSettings = PhysicsSystem::CurrentSettings();
+
+    m_Running = true;
+    m_Thread = std::thread(&PhysicsThread::Run, this);
+}
+
+PhysicsThread::~PhysicsThread() {
+    m_Running = false;
+    if (m_Thread.joinable()) m_Thread.join();
+}
+
+void PhysicsThread::Sync(Registry& registry) {
+    m_StepTime.store(1.0f / std::max(PhysicsSystem::fixedRate, 1.0f), std::memory_order_relaxed);
+    m_MaxSteps.store(PhysicsSystem::maxStepsPerFrame, std::memory_order_relaxed);
+
+    // Edits go out before results come in, so a body edited this frame is not overwritten by a stale result
+    QueueEdits(registry);
+    const uint32_t tick = registry.GetChangeTick();
+    ApplyResults(registry);
+
+    // Next frame, everything changed from this tick on counts as an edit, so systems scheduled after physics
+    // are heard too. The writes ApplyResults just made carry this tick as well; IsOwnWriteback tells them apart.
+    m_SyncTick = tick;
+}
+
+void PhysicsThread::EnsureTracked(Entity e) {
+    if (e < m_Mirrored.size()) return;
+    const size_t size = std::max<size_t>(static_cast<size_t>(e) + 1, m_Mirrored.size() * 2);
+    m_Mirrored.resize(size, 0);
+    m_QueuedThisFrame.resize(size, 0);
+    m_LastEditSeq.resize(size, 0);
+    m_WrittenBack.resize(size);
+}
+
+bool PhysicsThread::IsOwnWriteback(Registry& registry, Entity e) const {
+    // Byte comparison: a component that was reassigned whole may differ only in padding, and is then
+    // sent as an edit it did not need to be, which is harmless
+    const WrittenBack& written = m_WrittenBack[e];
+    return written.tick == m_SyncTick
+        && std::memcmp(&registry.GetComponent<TransformComponent>(e), &written.transform, sizeof(TransformComponent)) == 0
+        && std::memcmp(&registry.GetComponent<PhysicsComponent>(e), &written.physics, sizeof(PhysicsComponent)) == 0;
+}
+
+void PhysicsThread::QueueEdits(Registry& registry) {
+    m_Outgoing.clear();
+
+    // 1. Bodies added or removed (or that gained or lost a collider) since the last sync
+    const uint64_t structureKey = registry.GetStructureVersion<TransformComponent>()
+        ^ (registry.GetStructureVersion<PhysicsComponent>() << 21)
+        ^ (registry.GetStructureVersion<ColliderComponent>() << 42);
+    if (structureKey != m_StructureKey) {
+        m_StructureKey = structureKey;
+
+        for (Entity e = 0; e < m_Mirrored.size(); ++e) {
+            if (m_Mirrored[e] && !(registry.HasComponent<TransformComponent>(e) && registry.HasComponent<PhysicsComponent>(e))) {
+                QueueRemove(e);
+            }
+        }
+
+        auto view = registry.View<TransformComponent, PhysicsComponent>();
+        for (Entity e : view) {
+            EnsureTracked(e);
+            const uint8_t wanted = registry.HasComponent<ColliderComponent>(e) ? (MIRRORED | MIRRORED_COLLIDER) : MIRRORED;
+            if (m_Mirrored[e] != wanted) QueueBody(registry, e);
+        }
+    }
+
+    // 2. Bodies the editor, snapshots or other systems wrote to since the last sync. Transforms and physics
+    // state left exactly as the last ApplyResults wrote them are that write, not an edit; it never touches colliders.
+    auto isBody = [&](Entity e) {
+        return registry.HasComponent<TransformComponent>(e) && registry.HasComponent<PhysicsComponent>(e);
+    };
+    auto queueIfEdited = [&](Entity e) {
+        if (isBody(e) && !(e < m_WrittenBack.size() && IsOwnWriteback(registry, e))) QueueBody(registry, e);
+    };
+    registry.ForEachChangedSince<TransformComponent>(m_SyncTick, queueIfEdited);
+    registry.ForEachChangedSince<PhysicsComponent>(m_SyncTick, queueIfEdited);
+    registry.ForEachChangedSince<ColliderComponent>(m_SyncTick, [&](Entity e) {
+        if (isBody(e)) QueueBody(registry, e);
+    });
+
+    // 3. Hand the batch over under one sequence number, with this frame's solver settings. The thread steps
+    // with its own copy of those, since the editor writes the statics while it runs.
+    const PhysicsSettings settings = PhysicsSystem::CurrentSettings();
+    m_EditsSent = m_Outgoing.size();
+    const uint64_t seq = m_Outgoing.empty() ? 0 : m_NextEditSeq++;
+    for (const auto& edit : m_Outgoing) {
+        m_LastEditSeq[edit.entity] = seq;
+        m_QueuedThisFrame[edit.entity] = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_EditMutex);
+    m_QueuedSettings = settings;
+    if (m_Outgoing.empty()) return;
+    m_EditQueue.insert(m_EditQueue.end(), m_Outgoing.begin(), m_Outgoing.end());
+    m_QueuedEditSeq = seq;
+}
+
+void PhysicsThread::QueueBody(Registry& registry, Entity e) {
+    EnsureTracked(e);
+    if (m_QueuedThisFrame[e]) return;
+    m_QueuedThisFrame[e] = 1;
+
+    BodyEdit edit;
+    edit.entity = e;
+    edit.transform = registry.GetComponent<TransformComponent>(e);
+
+    // Forces are handed to the thread once; it clears them after the step that applies them
+    auto& physics = registry.GetComponent<PhysicsComponent>(e);
+    edit.physics = physics;
+    physics.forceAccumulator = glm::vec3(0.0f);
+
+    if (const auto* collider = registry.TryGetComponent<ColliderComponent>(e)) {
+        edit.hasCollider = true;
+        edit.collider = *collider;
+    }
+
+    m_Mirrored[e] = edit.hasCollider ? (MIRRORED | MIRRORED_COLLIDER) : MIRRORED;
+    m_Outgoing.push_back(edit);
+}
+
+void PhysicsThread::QueueRemove(Entity e) {
+    if (m_QueuedThisFrame[e]) return;
+    m_QueuedThisFrame[e] = 1;
+
+    BodyEdit edit;
+    edit.entity = e;
+    edit.remove = true;
+
+    m_Mirrored[e] = 0;
+    m_Outgoing.push_back(edit);
+}
+
+void PhysicsThread::ApplyResults(Registry& registry) {
+    const uint32_t tick = registry.GetChangeTick();
+
+    // A frame without new results has no contact events, but the touching pairs are kept
+    m_ContactEvents.BeginStep();
+    if (!m_Results.Consume()) return;
+    const Published& published = m_Results.ReadBuffer();
+
+    for (const BodyState& state : published.bodies) {
+        // Skip bodies the thread has not caught up with: either edited since, or no longer bodies at all
+        if (state.entity >= m_Mirrored.size() || !m_Mirrored[state.entity]) continue;
+        if (m_LastEditSeq[state.entity] > published.editSequence) continue;
+
+        auto* transform = registry.TryGetComponent<TransformComponent>(state.entity);
+        auto* physics = registry.TryGetComponent<PhysicsComponent>(state.entity);
+        if (!transform || !physics) continue;
+
+        transform->position = state.position;
+        transform->UpdateMatrix();
+        physics->velocity = state.velocity;
+        physics->sleepPosition = state.sleepPosition;
+        physics->islandId = state.islandId;
+        physics->restFrames = state.restFrames;
+        physics->isSleeping = state.isSleeping;
+
+        registry.MarkChanged<TransformComponent>(state.entity);
+        registry.MarkChanged<PhysicsComponent>(state.entity);
+        // Copied as bytes, padding included, for IsOwnWriteback to compare against
+        WrittenBack& written = m_WrittenBack[state.entity];
+        written.tick = tick;
+        std::memcpy(&written.transform, transform, sizeof(TransformComponent));
+        std::memcpy(&written.physics, physics, sizeof(PhysicsComponent));
+    }
+
+    m_Stats = published.stats;
+
+    if (PhysicsSystem::recordContactEvents) {
+        for (const ContactEvent& contact : published.contacts) {
+            m_ContactEvents.Record(contact.a, contact.b, contact.point, contact.normal, contact.impulse);
+        }
+        // Like the worker, pairs that went to sleep together stay touching without events
+        auto resting = [&](Entity e) {
+            const auto* physics = registry.TryGetComponent<PhysicsComponent>(e);
+            return physics && (physics->isStatic || physics->isSleeping);
+        };
+        m_ContactEvents.EndStep([&](uint32_t a, uint32_t b) { return resting(a) && resting(b); });
+    }
+    else {
+        m_ContactEvents.Clear();
+    }
+    m_Stats.contactEvents = m_ContactEvents.Events().size();
+}
+
+void PhysicsThread::Run() {
+    using Clock = std::chrono::steady_clock;
+
+    FixedTimestep clock;
+    Clock::time_point last = Clock::now();
+    float lastStepTimeMs = 0.0f;
+
+    while (m_Running.load(std::memory_order_acquire)) {
+        const uint64_t appliedBefore = m_AppliedEditSeq;
+        ApplyEdits();
+
+        const float stepTime = m_StepTime.load(std::memory_order_relaxed);
+        const Clock::time_point now = Clock::now();
+        const int steps = clock.Advance(std::chrono::duration<float>(now - last).count(), stepTime, m_MaxSteps.load(std::memory_order_relaxed));
+        last = now;
+
+        if (steps > 0) {
+            // Nobody draws the mirror, so there is nothing to interpolate
+            m_Worker.Simulate(m_Mirror, m_Settings, steps, stepTime, false);
+            lastStepTimeMs = std::chrono::duration<float, std::milli>(Clock::now() - now).count();
+            Publish(lastStepTimeMs);
+        }
+        else if (m_AppliedEditSeq != appliedBefore) {
+            // Lets the main thread know the edits arrived, so it stops holding those bodies back
+            Publish(lastStepTimeMs);
+        }
+
+        // Sleep until the next step is due
+        const float untilNextStep = std::max(stepTime - clock.accumulator, 0.0f);
+        std::this_thread::sleep_until(now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(untilNextStep)));
+    }
+}
+
+void PhysicsThread::ApplyEdits() {
+    {
+        std::lock_guard<std::mutex> lock(m_EditMutex);
+        m_Settings = m_QueuedSettings;
+        if (m_EditQueue.empty()) return;
+        m_Incoming.swap(m_EditQueue);
+        m_AppliedEditSeq = m_QueuedEditSeq;
+    }
+
+    for (BodyEdit& edit : m_Incoming) {
+        if (edit.remove) {
+            m_Mirror.RemoveComponent<TransformComponent>(edit.entity);
+            m_Mirror.RemoveComponent<PhysicsComponent>(edit.entity);
+            m_Mirror.RemoveComponent<ColliderComponent>(edit.entity);
+            continue;
+        }
+
+        m_Mirror.AddComponent(edit.entity, edit.transform);
+        m_Mirror.AddComponent(edit.entity, edit.physics);
+        if (edit.hasCollider) m_Mirror.AddComponent(edit.entity, edit.collider);
+        else m_Mirror.RemoveComponent<ColliderComponent>(edit.entity);
+    }
+    m_Incoming.clear();
+}
+
+void PhysicsThread::Publish(float stepTimeMs) {
+    Published& out = m_Results.WriteBuffer();
+    out.bodies.clear();
+
+    // Static bodies never move, so only dynamic ones are sent back
+    m_Mirror.Each<TransformComponent, PhysicsComponent>([&](Entity e, TransformComponent& transform, PhysicsComponent& physics) {
+        if (physics.isStatic) return;
+        out.bodies.push_back({ e, transform.position, physics.velocity, physics.sleepPosition,
+            physics.islandId, physics.restFrames, physics.isSleeping });
+    });
+
+    out.contacts.clear();
+    for (const ContactEvent& contact : m_Worker.GetContactEvents().Events()) {
+        if (contact.phase != ContactPhase::End) out.contacts.push_back(contact);
+    }
+
+    out.stats = m_Worker.GetStats();
+    out.stats.stepTimeMs = stepTimeMs;
+    out.editSequence = m_AppliedEditSeq;
+    m_Results.Publish();
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "PhysicsSystem.h"
+#include "../core/Components.h"
+#include "../core/ECS.h"
+#include "../core/TripleBuffer.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs the physics simulation on its own thread at PhysicsSystem::fixedRate.
+// The thread steps a private PhysicsSystem against a mirror registry that holds only the Transform,
+// Physics and Collider components of physics bodies. The main thread never touches the mirror:
+// edits go to the thread through a small locked queue, and results come back through a triple
+// buffer, so a frame costs max(physics, render) rather than their sum. The solver settings travel with
+// the edits, so the thread never reads the PhysicsSystem statics the editor writes.
+class PhysicsThread {
+public:
+    PhysicsThread();
+    ~PhysicsThread();
+
+    PhysicsThread(const PhysicsThread&) = delete;
+    PhysicsThread& operator=(const PhysicsThread&) = delete;
+
+    // Main thread, once per frame: queues edits made to physics bodies since the last call, then copies
+    // the newest published state into the scene's components
+    void Sync(Registry& registry);
+
+    const PhysicsStats& GetStats() const { return m_Stats; }
+    size_t GetEditsSent() const { return m_EditsSent; } // Bodies the last Sync sent to the thread
+
+    // Contact events as the main thread sees them. The thread publishes the pairs touching after each batch of
+    // steps, and Sync classifies them against the last batch it received, so a batch the main thread never
+    // picked up cannot lose a begin or an end. Impulses are those of the received batch only.
+    const ContactEventBuffer& GetContactEvents() const { return m_ContactEvents; }
+
+private:
+    // Full component state for one body; remove = the entity is no longer a physics body
+    struct BodyEdit {
+        Entity entity = MAX_ENTITIES;
+        bool remove = false;
+        bool hasCollider = false;
+        TransformComponent transform;
+        PhysicsComponent physics;
+        ColliderComponent collider;
+    };
+
+    // Simulation output for one body (user settings such as mass are never copied back)
+    struct BodyState {
+        Entity entity;
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::vec3 sleepPosition;
+        uint32_t islandId;
+        int restFrames;
+        bool isSleeping;
+    };
+
+    struct Published {
+        std::vector<BodyState> bodies;
+        PhysicsStats stats;
+        std::vector<ContactEvent> contacts; // Begin and persist events of the batch: the pairs left touching
+        uint64_t editSequence = 0; // Every edit up to this sequence number is reflected in bodies
+    };
+
+    // A body as ApplyResults left it, and the tick it did so at
+    struct WrittenBack {
+        uint32_t tick = UINT32_MAX;
+        TransformComponent transform;
+        PhysicsComponent physics;
+    };
+
+    static constexpr uint8_t MIRRORED = 0x1;
+    static constexpr uint8_t MIRRORED_COLLIDER = 0x2;
+
+    // Main thread
+    void EnsureTracked(Entity e);
+    bool IsOwnWriteback(Registry& registry, Entity e) const;
+    void QueueEdits(Registry& registry);
+    void QueueBody(Registry& registry, Entity e);
+    void QueueRemove(Entity e);
+    void ApplyResults(Registry& registry);
+
+    // Physics thread
+    void Run();
+    void ApplyEdits();
+    void Publish(float stepTimeMs);
+
+    // --- Main thread state ---
+    std::vector<BodyEdit> m_Outgoing;
+    std::vector<uint8_t> m_Mirrored;        // By entity: MIRRORED / MIRRORED_COLLIDER as last sent to the thread
+    std::vector<uint8_t> m_QueuedThisFrame; // By entity: already in m_Outgoing
+    std::vector<uint64_t> m_LastEditSeq;    // By entity: sequence number of the newest edit sent
+    std::vector<WrittenBack> m_WrittenBack; // By entity: its last result, to tell that write from edits
+    uint64_t m_StructureKey = UINT64_MAX;
+    uint64_t m_NextEditSeq = 1;
+    uint32_t m_SyncTick = 0;
+    size_t m_EditsSent = 0;
+    PhysicsStats m_Stats;
+    ContactEventBuffer m_ContactEvents;
+
+    // --- Shared ---
+    std::mutex m_EditMutex;
+    std::vector<BodyEdit> m_EditQueue;
+    uint64_t m_QueuedEditSeq = 0;           // Guarded by m_EditMutex
+    PhysicsSettings m_QueuedSettings;       // Guarded by m_EditMutex
+    TripleBuffer<Published> m_Results;
+    std::atomic<bool> m_Running{ false };
+    std::atomic<float> m_StepTime{ 1.0f / 240.0f };
+    std::atomic<int> m_MaxSteps{ 8 };
+
+    // --- Physics thread state ---
+    Registry m_Mirror;
+    PhysicsSystem m_Worker;
+    PhysicsSettings m_Settings; // Copied from m_QueuedSettings before each batch of steps
+    std::vector<BodyEdit> m_Incoming;
+    uint64_t m_AppliedEditSeq = 0;
+    std::thread m_Thread;
+};
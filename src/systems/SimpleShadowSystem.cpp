@@ -3,6 +3,13 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
 
+void SimpleShadowSystem::DeclareAccess(SystemAccess& access) const {
+    // Shadow quads are separate entities whose Transform/Render this system overwrites
+    access.Reads<EnvironmentComponent>()
+        .Writes<RenderComponent, TransformComponent>()
+        .ReadsScene();
+}
+
 void SimpleShadowSystem::Update(Scene& scene, float deltaTime) {
     auto& registry = scene.GetRegistry();
     Entity envEntity = scene.GetEnvironmentEntity();
@@ -11,55 +18,83 @@ void SimpleShadowSystem::Update(Scene& scene, float deltaTime) {
     auto& env = registry.GetComponent<EnvironmentComponent>(envEntity);
 
     // Only process if enabled
-    if (!env.useSimpleShadows) return;
+    if (!env.useSimpleShadows) {
+        m_HasRun = false;
+        return;
+    }
 
     glm::vec3 lightPos = glm::vec3(0.0f, 100.0f, 0.0f);
     bool sunIsUp = false;
 
-    Entity sunEntity = scene.GetEntityByName("Sun");
+    Entity sunEntity = scene.GetSunEntity();
     if (sunEntity != MAX_ENTITIES && registry.HasComponent<TransformComponent>(sunEntity)) {
         auto& sunTransform = registry.GetComponent<TransformComponent>(sunEntity);
         lightPos = glm::vec3(sunTransform.matrix[3]);
         if (lightPos.y > -20.0f) sunIsUp = true;
     }
 
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        if (!registry.HasComponent<RenderComponent>(e) || !registry.HasComponent<TransformComponent>(e)) continue;
+    // Shadows depend only on the caster's transform and the sun position. While the sun is still,
+    // only casters whose Transform or Render changed since the last pass need to be recomputed.
+    const bool fullUpdate = !m_HasRun || lightPos != m_LastLightPos || sunIsUp != m_LastSunIsUp;
+    const uint32_t sinceTick = m_LastTick;
+    m_LastTick = registry.GetChangeTick();
+    m_LastLightPos = lightPos;
+    m_LastSunIsUp = sunIsUp;
+    m_HasRun = true;
+
+    if (fullUpdate) {
+        auto view = registry.View<RenderComponent, TransformComponent>();
+        for (Entity e : view) {
+            UpdateShadow(registry, e, lightPos, sunIsUp);
+        }
+    }
+    else {
+        registry.ForEachChangedSince<TransformComponent>(sinceTick, [&](Entity e) { UpdateShadow(registry, e, lightPos, sunIsUp); });
+        registry.ForEachChangedSince<RenderComponent>(sinceTick, [&](Entity e) { UpdateShadow(registry, e, lightPos, sunIsUp); });
+    }
+}
 
-        auto& render = registry.GetComponent<RenderComponent>(e);
-        if (render.simpleShadowEntity == MAX_ENTITIES) continue;
+void SimpleShadowSystem::UpdateShadow(Registry& registry, Entity e, const glm::vec3& lightPos, bool sunIsUp) {
+    auto* render = registry.TryGetComponent<RenderComponent>(e);
+    auto* parentTransform = registry.TryGetComponent<TransformComponent>(e);
+    if (!render || !parentTransform || render->simpleShadowEntity == MAX_ENTITIES) return;
 
-        auto& shadowRender = registry.GetComponent<RenderComponent>(render.simpleShadowEntity);
-        auto& shadowTransform = registry.GetComponent<TransformComponent>(render.simpleShadowEntity);
-        auto& parentTransform = registry.GetComponent<TransformComponent>(e);
+    auto& shadowRender = registry.GetComponent<RenderComponent>(render->simpleShadowEntity);
+    auto& shadowTransform = registry.GetComponent<TransformComponent>(render->simpleShadowEntity);
 
-        if (sunIsUp && render.visible) {
-            const glm::vec3 parentPos = glm::vec3(parentTransform.matrix[3]);
-            const glm::vec3 rawLightDir = parentPos + glm::vec3(0.0f, 0.15f, 0.0f) - lightPos;
-            const glm::vec3 lightDir3D = glm::normalize(rawLightDir);
+    if (sunIsUp && render->visible) {
+        const glm::vec3 parentPos = glm::vec3(parentTransform->matrix[3]);
+        const glm::vec3 rawLightDir = parentPos + glm::vec3(0.0f, 0.15f, 0.0f) - lightPos;
+        const glm::vec3 lightDir3D = glm::normalize(rawLightDir);
 
-            glm::vec3 flatDir = glm::vec3(lightDir3D.x, 0.0f, lightDir3D.z);
-            flatDir = (glm::length(flatDir) > 0.001f) ? glm::normalize(flatDir) : glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::vec3 flatDir = glm::vec3(lightDir3D.x, 0.0f, lightDir3D.z);
+        flatDir = (glm::length(flatDir) > 0.001f) ? glm::normalize(flatDir) : glm::vec3(0.0f, 0.0f, 1.0f);
 
-            const float angle = std::atan2(flatDir.x, flatDir.z);
-            const float dotY = std::abs(lightDir3D.y);
-            float stretch = std::clamp(1.0f + (1.0f - dotY) * 8.0f, 1.0f, 12.0f);
+        const float angle = std::atan2(flatDir.x, flatDir.z);
+        const float dotY = std::abs(lightDir3D.y);
+        float stretch = std::clamp(1.0f + (1.0f - dotY) * 8.0f, 1.0f, 12.0f);
 
-            const float parentScale = glm::length(glm::vec3(parentTransform.matrix[0]));
-            const float shadowRadius = std::max(parentScale * 1.5f, 0.5f);
-            const float shiftAmount = shadowRadius * (stretch - 1.0f);
-            const glm::vec3 finalPos = parentPos + glm::vec3(0.0f, 0.15f, 0.0f) + (flatDir * shiftAmount);
+        const float parentScale = glm::length(glm::vec3(parentTransform->matrix[0]));
+        const float shadowRadius = std::max(parentScale * 1.5f, 0.5f);
+        const float shiftAmount = shadowRadius * (stretch - 1.0f);
+        const glm::vec3 finalPos = parentPos + glm::vec3(0.0f, 0.15f, 0.0f) + (flatDir * shiftAmount);
 
-            glm::mat4 m = glm::mat4(1.0f);
-            m = glm::translate(m, finalPos);
-            m = glm::rotate(m, angle, glm::vec3(0.0f, 1.0f, 0.0f));
-            m = glm::scale(m, glm::vec3(1.0f, 1.0f, stretch));
+        glm::mat4 m = glm::mat4(1.0f);
+        m = glm::translate(m, finalPos);
+        m = glm::rotate(m, angle, glm::vec3(0.0f, 1.0f, 0.0f));
+        m = glm::scale(m, glm::vec3(1.0f, 1.0f, stretch));
 
-            shadowTransform.matrix = m;
-            shadowRender.visible = true;
-        }
-        else {
-            shadowRender.visible = false;
-        }
+        shadowTransform.matrix = m;
+        registry.MarkChanged<TransformComponent>(render->simpleShadowEntity);
+        SetShadowVisible(registry, render->simpleShadowEntity, shadowRender, true);
     }
-}
\ No newline at end of file
+    else {
+        SetShadowVisible(registry, render->simpleShadowEntity, shadowRender, false);
+    }
+}
+
+void SimpleShadowSystem::SetShadowVisible(Registry& registry, Entity shadowEntity, RenderComponent& shadowRender, bool visible) {
+    if (shadowRender.visible == visible) return;
+    shadowRender.visible = visible;
+    registry.MarkChanged<RenderComponent>(shadowEntity);
+}
@@ -5,4 +5,16 @@
 class SimpleShadowSystem : public ISystem {
 public:
     void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Simple Shadow"; }
+
+private:
+    void UpdateShadow(Registry& registry, Entity e, const glm::vec3& lightPos, bool sunIsUp);
+    void SetShadowVisible(Registry& registry, Entity shadowEntity, RenderComponent& shadowRender, bool visible);
+
+    // State of the last pass, used to skip casters that have not moved
+    bool m_HasRun = false;
+    bool m_LastSunIsUp = false;
+    glm::vec3 m_LastLightPos = glm::vec3(0.0f);
+    uint32_t m_LastTick = 0;
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "SystemScheduler.h"
+#include "../core/JobSystem.h"
+#include "../rendering/Scene.h"
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+bool SystemScheduler::runParallel = true;
+
+namespace {
+    long long NowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+std::vector<std::vector<size_t>> SystemScheduler::BuildDependencies(const std::vector<SystemAccess>& accesses) {
+    std::vector<std::vector<size_t>> dependencies(accesses.size());
+    for (size_t later = 0; later < accesses.size(); ++later) {
+        for (size_t earlier = 0; earlier < later; ++earlier) {
+            if (accesses[earlier].ConflictsWith(accesses[later])) {
+                dependencies[later].push_back(earlier);
+            }
+        }
+    }
+    return dependencies;
+}
+
+void SystemScheduler::Run(Scene& scene, float deltaTime, std::vector<std::unique_ptr<ISystem>>& systems) {
+    const size_t count = systems.size();
+
+    // 1. Collect this frame's declarations and make sure every pool they mention exists
+    m_Accesses.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_Accesses[i].Clear();
+        systems[i]->DeclareAccess(m_Accesses[i]);
+        m_Accesses[i].CreatePools(scene.GetRegistry());
+    }
+
+    // 2. Build the DAG
+    m_Dependencies = BuildDependencies(m_Accesses);
+    m_Successors.assign(count, {});
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t dep : m_Dependencies[i]) m_Successors[dep].push_back(i);
+    }
+
+    m_Timings.assign(count, SystemTiming{});
+    m_FrameStartNs = NowNs();
+
+    // 3. Execute
+    if (runParallel && JobSystem::Get().GetThreadCount() > 1 && count > 1) {
+        RunGraph(scene, deltaTime, systems);
+    }
+    else {
+        RunSequential(scene, deltaTime, systems);
+    }
+
+    m_FrameTimeMs = static_cast<double>(NowNs() - m_FrameStartNs) * 1e-6;
+    ComputeCriticalPath();
+}
+
+void SystemScheduler::RunSequential(Scene& scene, float deltaTime, std::vector<std::unique_ptr<ISystem>>& systems) {
+    for (size_t i = 0; i < systems.size(); ++i) {
+        RunOne(i, scene, deltaTime, *systems[i]);
+    }
+}
+
+void SystemScheduler::RunGraph(Scene& scene, float deltaTime, std::vector<std::unique_ptr<ISystem>>& systems) {
+    const size_t count = systems.size();
+    if (m_RemainingCapacity < count) {
+        m_Remaining.reset(new std::atomic<int>[count]);
+        m_RemainingCapacity = count;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        m_Remaining[i].store(static_cast<int>(m_Dependencies[i].size()), std::memory_order_relaxed);
+    }
+
+    JobSystem& jobs = JobSystem::Get();
+    JobGroup group;
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+
+    // A finished system releases its successors; the last dependency to finish launches each one
+    std::function<void(size_t)> launch = [&](size_t index) {
+        jobs.Submit(group, [&, index]() {
+            try {
+                RunOne(index, scene, deltaTime, *systems[index]);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) firstError = std::current_exception();
+            }
+
+            for (size_t next : m_Successors[index]) {
+                if (m_Remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    launch(next);
+                }
+            }
+        });
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        if (m_Dependencies[i].empty()) launch(i);
+    }
+    jobs.Wait(group);
+
+    if (firstError) std::rethrow_exception(firstError);
+}
+
+void SystemScheduler::RunOne(size_t index, Scene& scene, float deltaTime, ISystem& system) {
+    const long long start = NowNs();
+    system.Update(scene, deltaTime);
+    const long long end = NowNs();
+
+    SystemTiming& timing = m_Timings[index];
+    timing.name = system.GetName();
+    timing.startMs = static_cast<double>(start - m_FrameStartNs) * 1e-6;
+    timing.durationMs = static_cast<double>(end - start) * 1e-6;
+    timing.thread = JobSystem::CurrentThreadIndex();
+}
+
+void SystemScheduler::ComputeCriticalPath() {
+    // Dependencies always point at earlier systems, so one forward pass gives the longest chain
+    const size_t count = m_Timings.size();
+    std::vector<double> finish(count, 0.0);
+    std::vector<size_t> parent(count, count);
+
+    size_t last = count;
+    m_CriticalPathMs = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double ready = 0.0;
+        for (size_t dep : m_Dependencies[i]) {
+            if (finish[dep] > ready) {
+                ready = finish[dep];
+                parent[i] = dep;
+            }
+        }
+        finish[i] = ready + m_Timings[i].durationMs;
+        if (finish[i] >= m_CriticalPathMs) {
+            m_CriticalPathMs = finish[i];
+            last = i;
+        }
+    }
+
+    for (size_t i = last; i < count; i = parent[i]) {
+        m_Timings[i].onCriticalPath = true;
+    }
+}
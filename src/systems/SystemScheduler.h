@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ISystem.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct SystemTiming {
+    const char* name = "";
+    double startMs = 0.0;      // Relative to the start of the frame's update
+    double durationMs = 0.0;
+    unsigned int thread = 0;   // 0 = main thread
+    bool onCriticalPath = false;
+};
+
+// Runs the scene's systems as a dependency graph.
+// Each frame the declared accesses are turned into a DAG: a system waits for every earlier-registered
+// system it conflicts with, so registration order is kept wherever there is a real data hazard and
+// everything else may run concurrently on the JobSystem workers.
+class SystemScheduler {
+public:
+    static bool runParallel;
+
+    void Run(Scene& scene, float deltaTime, std::vector<std::unique_ptr<ISystem>>& systems);
+
+    const std::vector<SystemTiming>& GetTimings() const { return m_Timings; }
+    double GetFrameTimeMs() const { return m_FrameTimeMs; }
+    double GetCriticalPathMs() const { return m_CriticalPathMs; }
+
+    // Indices of the systems each system must wait for (rebuilt every Run)
+    const std::vector<std::vector<size_t>>& GetDependencies() const { return m_Dependencies; }
+
+    // Builds the dependency lists from a set of declarations; exposed for tests
+    static std::vector<std::vector<size_t>> BuildDependencies(const std::vector<SystemAccess>& accesses);
+
+private:
+    void RunSequential(Scene& scene, float deltaTime, std::vector<std::unique_ptr<ISystem>>& systems);
+    void RunGraph(Scene& scene, float deltaTime, std::vector<std::unique_ptr<ISystem>>& systems);
+    void RunOne(size_t index, Scene& scene, float deltaTime, ISystem& system);
+    void ComputeCriticalPath();
+
+    std::vector<SystemAccess> m_Accesses;
+    std::vector<std::vector<size_t>> m_Dependencies;
+    std::vector<std::vector<size_t>> m_Successors;
+    std::unique_ptr<std::atomic<int>[]> m_Remaining;
+    size_t m_RemainingCapacity = 0;
+
+    std::vector<SystemTiming> m_Timings;
+    double m_FrameTimeMs = 0.0;
+    double m_CriticalPathMs = 0.0;
+    long long m_FrameStartNs = 0;
+};
@@ -5,6 +5,16 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 
+float ThermodynamicsSystem::impactHeat = 4.0f;
+float ThermodynamicsSystem::minImpactImpulse = 2.0f;
+
+void ThermodynamicsSystem::DeclareAccess(SystemAccess& access) const {
+    // Fire lights are created on demand (AddLight adds Name/Transform/Orbit/Light to a new entity) and parented to the burning object
+    access.Reads<EnvironmentComponent, ColliderComponent>()
+        .Writes<ThermoComponent, TransformComponent, RenderComponent, LightComponent, NameComponent, OrbitComponent, FireLightTag, HierarchyComponent>()
+        .WritesScene();
+}
+
 void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
     auto& registry = scene.GetRegistry();
     Entity envEntity = scene.GetEnvironmentEntity();
@@ -20,22 +30,28 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
     static std::mt19937 gen(rd());
     std::uniform_real_distribution<float> chance(0.0f, 1.0f);
 
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        // FIX 2: Remove RenderComponent requirement! (Allows invisible colliders to burn)
-        if (!registry.HasComponent<ThermoComponent>(e) ||
-            !registry.HasComponent<TransformComponent>(e)) {
-            continue;
+    // Hard collisions heat whichever side can burn
+    for (const ContactEvent& contact : scene.GetContactEvents()) {
+        if (contact.phase != ContactPhase::Begin || contact.impulse < minImpactImpulse) continue;
+        for (Entity e : { static_cast<Entity>(contact.a), static_cast<Entity>(contact.b) }) {
+            auto* thermo = registry.TryGetComponent<ThermoComponent>(e);
+            if (!thermo || !thermo->isFlammable) continue;
+            if (thermo->state != ObjectState::NORMAL && thermo->state != ObjectState::HEATING) continue;
+            thermo->currentTemp += contact.impulse * impactHeat;
+            registry.MarkChanged<ThermoComponent>(e);
         }
+    }
 
-        auto& thermo = registry.GetComponent<ThermoComponent>(e);
+    // FIX 2: Remove RenderComponent requirement! (Allows invisible colliders to burn)
+    auto view = registry.View<ThermoComponent, TransformComponent>();
+    for (Entity e : view) {
+        auto& thermo = view.Get<ThermoComponent>(e);
         if (!thermo.isFlammable) continue;
 
-        auto& transform = registry.GetComponent<TransformComponent>(e);
+        auto& transform = view.Get<TransformComponent>(e);
 
         // Safely extract render component ONLY if it exists
-        RenderComponent* render = registry.HasComponent<RenderComponent>(e)
-            ? &registry.GetComponent<RenderComponent>(e)
-            : nullptr;
+        RenderComponent* render = registry.TryGetComponent<RenderComponent>(e);
 
         const glm::vec3 basePos = glm::vec3(transform.matrix[3]);
 
@@ -94,6 +110,7 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
 
             const float growth = glm::clamp(thermo.burnTimer / (thermo.maxBurnDuration * 0.6f), 0.0f, 1.0f);
             thermo.burnFactor = glm::clamp(thermo.burnTimer / thermo.maxBurnDuration, 0.0f, 1.0f);
+            registry.MarkChanged<ThermoComponent>(e);
 
             // Extract true world scale
             const float scaleX = glm::length(glm::vec3(transform.matrix[0]));
@@ -101,9 +118,8 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
             const float scaleZ = glm::length(glm::vec3(transform.matrix[2]));
             const float maxWorldScale = std::max({ scaleX, scaleY, scaleZ });
             float objectSize = maxWorldScale;
-            if (registry.HasComponent<ColliderComponent>(e)) {
-                auto& collider = registry.GetComponent<ColliderComponent>(e);
-                objectSize = std::max(collider.radius, collider.height * 0.5f) * maxWorldScale;
+            if (const auto* collider = registry.TryGetComponent<ColliderComponent>(e)) {
+                objectSize = std::max(collider->radius, collider->height * 0.5f) * maxWorldScale;
             }
             // Clamp so we don't spawn millions of particles for a mountain, or 0 for a pebble
             objectSize = glm::clamp(objectSize, 0.5f, 5.0f);
@@ -155,15 +171,20 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
                 const float rate = (20.0f + (80.0f * growth)) * objectSize;
                 scene.GetOrCreateSystem(smokeProps)->UpdateEmitter(thermo.smokeEmitterId, smokeProps, rate);
             }
-            glm::vec3 lightPos = basePos;
-            lightPos.y += currentFireHeight * 0.5f;
+            // The light sits halfway up the flames, in the burning object's local space
+            const glm::vec3 lightOffset = glm::vec3(0.0f, (currentFireHeight * 0.5f) / std::max(scaleY, 0.001f), 0.0f);
 
             // FIX 3: Bulletproof ECS Reallocation Strategy
             if (thermo.fireLightEntity == -1) {
-                std::string lightName = "FireLight_" + std::to_string(e);
-                int newLight = scene.AddLight(lightName, lightPos, glm::vec3(1.0f, 0.5f, 0.1f), 0.0f, 1);
+                // Fire lights are anonymous: tagged rather than named, so starting a fire builds no strings.
+                // Parenting the light to the object lets it follow the object when it moves.
+                const Entity newLight = scene.AddLight("", basePos, glm::vec3(1.0f, 0.5f, 0.1f), 0.0f, 1);
+                if (newLight != MAX_ENTITIES) {
+                    registry.AddComponent<FireLightTag>(newLight, FireLightTag{});
+                    scene.SetParent(newLight, e);
+                }
 
-                thermo.fireLightEntity = newLight;
+                thermo.fireLightEntity = static_cast<int>(newLight);
             }
             // Since we break on creation, it is mathematically guaranteed that `thermo` here is 100% memory safe.
             if (registry.HasComponent<LightComponent>(thermo.fireLightEntity)) {
@@ -174,7 +195,11 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
                 const float flicker = 1.0f + 0.3f * std::sin(t * 15.0f) + 0.15f * std::sin(t * 37.0f);
                 const float targetIntensity = 50.05f * growth * objectSize;
 
-                fireLightTransform.matrix[3] = glm::vec4(lightPos, 1.0f);
+                if (fireLightTransform.position != lightOffset) {
+                    fireLightTransform.position = lightOffset;
+                    fireLightTransform.UpdateMatrix();
+                    registry.MarkChanged<TransformComponent>(thermo.fireLightEntity);
+                }
                 fireLightComp.intensity = targetIntensity * flicker;
             }
             // Burnout logic
@@ -219,6 +244,8 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
                     // Shrink the object to a tiny pile of ash
                     transform.scale = glm::vec3(0.003f);
                     transform.UpdateMatrix();
+                    registry.MarkChanged<TransformComponent>(e);
+                    registry.MarkChanged<RenderComponent>(e);
 
                     thermo.regrowTimer = 0.0f;
                     thermo.burnFactor = 0.0f;
@@ -259,6 +286,7 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
                             thermo.storedOriginalGeometry = nullptr;
                         }
                         render->texturePath = render->originalTexturePath;
+                        registry.MarkChanged<RenderComponent>(e);
                     }
                 }
             }
@@ -274,6 +302,7 @@ void ThermodynamicsSystem::Update(Scene& scene, float deltaTime) {
                 transform.rotation = thermo.storedOriginalRotation;
                 transform.scale = thermo.storedOriginalScale * currentScale;
                 transform.UpdateMatrix();
+                registry.MarkChanged<TransformComponent>(e);
 
                 if (t >= 1.0f) {
                     thermo.state = ObjectState::NORMAL;
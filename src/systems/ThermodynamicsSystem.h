@@ -5,6 +5,13 @@
 class ThermodynamicsSystem : public ISystem {
 public:
     void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Thermodynamics"; }
+
+    // Impact heating: a flammable body warms by impactHeat degrees per unit of impulse when a collision begins,
+    // for hits of at least minImpactImpulse (so resting contacts that wake up again do not count)
+    static float impactHeat;
+    static float minImpactImpulse;
 
 private:
     std::mt19937 m_Gen{ std::random_device{}() };
@@ -2,15 +2,17 @@
 #include "../rendering/Scene.h"
 #include <iostream>
 
+void TimeSystem::DeclareAccess(SystemAccess& access) const {
+    // NextSeason swaps the precipitation emitters
+    access.Writes<EnvironmentComponent>()
+        .WritesScene();
+}
+
 void TimeSystem::Update(Scene& scene, float deltaTime) {
     auto& registry = scene.GetRegistry();
 
     // Iterate through all entities (there should only be one) with an EnvironmentComponent
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        if (!registry.HasComponent<EnvironmentComponent>(e)) continue;
-
-        auto& env = registry.GetComponent<EnvironmentComponent>(e);
-
+    registry.Each<EnvironmentComponent>([&](Entity, EnvironmentComponent& env) {
         env.seasonTimer += deltaTime;
         const float fullSeasonDuration = env.timeConfig.dayLengthSeconds * static_cast<float>(env.timeConfig.daysPerSeason);
 
@@ -25,5 +27,5 @@ void TimeSystem::Update(Scene& scene, float deltaTime) {
             // Note: Once we extract the WeatherSystem, we won't need to call back into Scene for this!
             scene.NextSeason();
         }
-    }
+    });
 }
\ No newline at end of file
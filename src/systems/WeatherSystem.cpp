@@ -18,14 +18,20 @@ void WeatherSystem::PickNextWeatherDuration(EnvironmentComponent& env) {
     }
 }
 
+void WeatherSystem::DeclareAccess(SystemAccess& access) const {
+    // Starts/stops precipitation and the dust cloud, and looks the sun up by name
+    access.Reads<TransformComponent>()
+        .Writes<EnvironmentComponent, DustCloudComponent, LightComponent>()
+        .WritesScene();
+}
+
 void WeatherSystem::Update(Scene& scene, float deltaTime) {
     auto& registry = scene.GetRegistry();
 
     // Find the environment singleton
-    for (Entity e = 0; e < registry.GetEntityCount(); ++e) {
-        if (!registry.HasComponent<EnvironmentComponent>(e)) continue;
-
-        auto& env = registry.GetComponent<EnvironmentComponent>(e);
+    auto view = registry.View<EnvironmentComponent>();
+    for (Entity e : view) {
+        auto& env = view.Get<EnvironmentComponent>(e);
 
         // --- 1. Rain & Dust Timers ---
         if (env.isPrecipitating) {
@@ -63,7 +69,7 @@ void WeatherSystem::Update(Scene& scene, float deltaTime) {
 
         // --- 3. Sun Height & Temperature Calculations ---
         float sunHeight = 0.0f;
-        Entity sunEntity = scene.GetEntityByName("Sun");
+        Entity sunEntity = scene.GetSunEntity();
 
         if (sunEntity != MAX_ENTITIES && registry.HasComponent<TransformComponent>(sunEntity)) {
             const auto& sunTransform = registry.GetComponent<TransformComponent>(sunEntity);
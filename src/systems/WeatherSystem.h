@@ -5,6 +5,8 @@
 class WeatherSystem : public ISystem {
 public:
     void Update(Scene& scene, float deltaTime) override;
+    void DeclareAccess(SystemAccess& access) const override;
+    const char* GetName() const override { return "Weather"; }
     void PickNextWeatherDuration(EnvironmentComponent& env);
 
 